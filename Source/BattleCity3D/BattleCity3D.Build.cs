@@ -16,6 +16,7 @@ public class BattleCity3D : ModuleRules
             "BattleCity3D/Private/Components/GridPathFollow",
             "BattleCity3D/Private/Enemies",
             "BattleCity3D/Private/Enemies/EnemyGoalPolicies",
+            "BattleCity3D/Private/Enemies/Horde",
             "BattleCity3D/Private/GameClasses",
             "BattleCity3D/Private/Map",
             "BattleCity3D/Private/Player",
@@ -26,7 +27,7 @@ public class BattleCity3D : ModuleRules
         });
 
 	
-		PublicDependencyModuleNames.AddRange(new string[] { "Core", "CoreUObject", "Engine", "InputCore", "EnhancedInput" });
+		PublicDependencyModuleNames.AddRange(new string[] { "Core", "CoreUObject", "Engine", "InputCore", "EnhancedInput", "NavigationSystem", "AIModule", "MassEntity" });
 
 		PrivateDependencyModuleNames.AddRange(new string[] { "Json", "JsonUtilities" });
 
@@ -4,6 +4,7 @@
 #include "Engine/StaticMesh.h"
 #include "Kismet/GameplayStatics.h"
 #include "GameClasses/BattleGameMode.h"
+#include "Common/BattleTargetRegistry.h"
 
 ABattleBase::ABattleBase()
 {
@@ -30,6 +31,20 @@ ABattleBase::ABattleBase()
 void ABattleBase::BeginPlay()
 {
 	Super::BeginPlay();
+
+	if (UBattleTargetRegistry* Targets = GetWorld()->GetSubsystem<UBattleTargetRegistry>())
+	{
+		Targets->Register(this, EBattleTargetKind::Base, bIsEnemyBase ? EBattleTeam::Enemy : EBattleTeam::Player);
+	}
+}
+
+void ABattleBase::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UBattleTargetRegistry* Targets = GetWorld()->GetSubsystem<UBattleTargetRegistry>())
+	{
+		Targets->Unregister(this);
+	}
+	Super::EndPlay(EndPlayReason);
 }
 
 void ABattleBase::Tick(float DeltaTime)
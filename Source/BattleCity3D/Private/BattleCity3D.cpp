@@ -2,8 +2,21 @@
 
 #include "BattleCity3D.h"
 #include "Modules/ModuleManager.h"
+#include "Components/EnemyMovement/EnemyAIManager.h"
 
-IMPLEMENT_PRIMARY_GAME_MODULE( FDefaultGameModuleImpl, BattleCity3D, "BattleCity3D" );
+class FBattleCity3DModule : public FDefaultGameModuleImpl
+{
+public:
+	virtual void StartupModule() override
+	{
+#if BC_AI_ALLOC_COUNT
+		// Antes de cualquier mundo: bc.ai.alloccount necesita su proxy de GMalloc desde el arranque
+		UEnemyAIManager::InstallAllocCounter();
+#endif
+	}
+};
+
+IMPLEMENT_PRIMARY_GAME_MODULE( FBattleCity3DModule, BattleCity3D, "BattleCity3D" );
 // Uso en consola: bc.collision.debug 1
 TAutoConsoleVariable<int32> CVarBcCollisionDebug(
     TEXT("bc.collision.debug"),
@@ -147,4 +147,12 @@ void ABattleTankPawn::UpdateTankMovement(float DT)
 
     if (!bBlocked) SetActorLocation(FuturePos);
     else Velocity = FVector2D::ZeroVector;
-}
\ No newline at end of file
+}
+
+float ABattleTankPawn::GetTurnPathCost(float TileSize, float FreeCost) const
+{
+    if (TileSize <= 0.f || MoveSpeed <= 0.f) return 0.f;
+    // Vector2DInterpTo tarda ~1/AccelRate s en recuperar la velocidad tras el parn
+    const float LostSeconds = TurnDelay + (AccelRate > 0.f ? 1.f / AccelRate : 0.f);
+    return FreeCost * LostSeconds * MoveSpeed / TileSize;
+}
@@ -0,0 +1,151 @@
+#include "Common/BattleTargetRegistry.h"
+#include "Map/MapGridSubsystem.h"
+#include "Engine/World.h"
+#include "Engine/GameInstance.h"
+#include "GameFramework/Actor.h"
+
+void FBattleTargetTickFunction::ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent)
+{
+	if (Registry && TickType != LEVELTICK_ViewportsOnly) Registry->RefreshSnapshot();
+}
+
+bool UBattleTargetRegistry::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UBattleTargetRegistry::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	// Antes que los tanques (TG_PrePhysics) y que EnemyAIManager (TG_DuringPhysics)
+	TickFunction.Registry = this;
+	TickFunction.bCanEverTick = true;
+	TickFunction.bStartWithTickEnabled = true;
+	TickFunction.bHighPriority = true;
+	TickFunction.TickGroup = TG_PrePhysics;
+	TickFunction.RegisterTickFunction(InWorld.PersistentLevel);
+}
+
+void UBattleTargetRegistry::Deinitialize()
+{
+	if (TickFunction.IsTickFunctionRegistered()) TickFunction.UnRegisterTickFunction();
+	TickFunction.Registry = nullptr;
+	Entries.Reset();
+	IndexOf.Reset();
+	KindCount[0] = KindCount[1] = KindCount[2] = 0;
+	RefreshRoles();
+	Super::Deinitialize();
+}
+
+void UBattleTargetRegistry::UpdateEntry(FBattleTargetEntry& E) const
+{
+	const AActor* A = E.Actor.Get();
+	if (!A) return;
+	E.Location = A->GetActorLocation();
+	int32 X, Y;
+	E.bHasCell = Grid.IsValid() && Grid->WorldToGrid(E.Location, X, Y);
+	E.Cell = E.bHasCell ? FIntPoint(X, Y) : FIntPoint(INDEX_NONE, INDEX_NONE);
+}
+
+void UBattleTargetRegistry::Register(AActor* Actor, EBattleTargetKind Kind, EBattleTeam Team)
+{
+	if (!Actor) return;
+	if (!Grid.IsValid())
+	{
+		UGameInstance* GI = GetWorld() ? GetWorld()->GetGameInstance() : nullptr;
+		Grid = GI ? GI->GetSubsystem<UMapGridSubsystem>() : nullptr;
+	}
+
+	int32* Existing = IndexOf.Find(FObjectKey(Actor));
+	const int32 Index = Existing ? *Existing : Entries.AddDefaulted();
+	FBattleTargetEntry& E = Entries[Index];
+	if (Existing) --KindCount[(int32)E.Kind];
+	E.Actor = Actor;
+	E.Key = FObjectKey(Actor);
+	E.Kind = Kind;
+	E.Team = Team;
+	E.Serial = Existing ? E.Serial : ++RegisterSerial;
+	++KindCount[(int32)Kind];
+	IndexOf.Add(FObjectKey(Actor), Index);
+
+	// Entra ya con posicin: se puede consultar en el mismo frame
+	UpdateEntry(E);
+	RefreshRoles();
+}
+
+void UBattleTargetRegistry::Unregister(AActor* Actor)
+{
+	int32 Index = INDEX_NONE;
+	if (!Actor || !IndexOf.RemoveAndCopyValue(FObjectKey(Actor), Index)) return;
+	RemoveAtSwap(Index);
+	RefreshRoles();
+}
+
+void UBattleTargetRegistry::RemoveAtSwap(int32 Index)
+{
+	--KindCount[(int32)Entries[Index].Kind];
+	Entries.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	// El ltimo ocupa su hueco
+	if (Index < Entries.Num()) IndexOf.Add(Entries[Index].Key, Index);
+}
+
+void UBattleTargetRegistry::RefreshRoles()
+{
+	// Slo al registrar / dar de baja: el jugador y las bases salen del menor Serial de su tipo
+	PlayerIndex = INDEX_NONE;
+	BaseIndex[0] = BaseIndex[1] = INDEX_NONE;
+	for (int32 i = 0; i < Entries.Num(); ++i)
+	{
+		const FBattleTargetEntry& E = Entries[i];
+		int32* Slot = E.Kind == EBattleTargetKind::Player ? &PlayerIndex
+			: (E.Kind == EBattleTargetKind::Base ? &BaseIndex[(int32)E.Team] : nullptr);
+		if (Slot && (*Slot == INDEX_NONE || E.Serial < Entries[*Slot].Serial)) *Slot = i;
+	}
+}
+
+void UBattleTargetRegistry::RefreshSnapshot()
+{
+	++SnapshotFrame;
+
+	// Actores destruidos sin EndPlay (no debera pasar): fuera
+	bool bRemoved = false;
+	for (int32 i = Entries.Num() - 1; i >= 0; --i)
+	{
+		if (Entries[i].Actor.IsValid()) continue;
+		IndexOf.Remove(Entries[i].Key);
+		RemoveAtSwap(i);
+		bRemoved = true;
+	}
+	if (bRemoved) RefreshRoles();
+
+	for (FBattleTargetEntry& E : Entries) UpdateEntry(E);
+}
+
+bool UBattleTargetRegistry::GetPlayerLocation(FVector& Out) const
+{
+	const FBattleTargetEntry* P = GetPlayer();
+	if (!P) return false;
+	Out = P->Location;
+	return true;
+}
+
+bool UBattleTargetRegistry::GetPlayerCell(FIntPoint& Out) const
+{
+	const FBattleTargetEntry* P = GetPlayer();
+	if (!P || !P->bHasCell) return false;
+	Out = P->Cell;
+	return true;
+}
+
+const FBattleTargetEntry* UBattleTargetRegistry::GetBase(EBattleTeam Team) const
+{
+	const int32 Index = BaseIndex[(int32)Team];
+	return Index != INDEX_NONE ? &Entries[Index] : nullptr;
+}
+
+const FBattleTargetEntry* UBattleTargetRegistry::Find(const AActor* Actor) const
+{
+	const int32* Index = Actor ? IndexOf.Find(FObjectKey(Actor)) : nullptr;
+	return Index ? &Entries[*Index] : nullptr;
+}
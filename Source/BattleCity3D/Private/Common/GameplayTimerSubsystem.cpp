@@ -0,0 +1,99 @@
+#include "Common/GameplayTimerSubsystem.h"
+#include "Engine/World.h"
+#include "Engine/Level.h"
+
+DECLARE_STATS_GROUP(TEXT("BattleCity Timers"), STATGROUP_BCTimers, STATCAT_Advanced);
+DECLARE_CYCLE_STAT(TEXT("Timers tick"), STAT_BCTimers_Tick, STATGROUP_BCTimers);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Scheduled (time)"), STAT_BCTimers_Time, STATGROUP_BCTimers);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Scheduled (frames)"), STAT_BCTimers_Frames, STATGROUP_BCTimers);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Fired this frame"), STAT_BCTimers_Fired, STATGROUP_BCTimers);
+
+void FGameplayTimerTickFunction::ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent)
+{
+	if (Timers && TickType != LEVELTICK_ViewportsOnly) Timers->TickTimers();
+}
+
+bool UGameplayTimerSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UGameplayTimerSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	// Antes que todo lo de TG_PrePhysics: lo que venza este frame se ve ya en tanques e IA
+	TickFunction.Timers = this;
+	TickFunction.bCanEverTick = true;
+	TickFunction.bStartWithTickEnabled = true;
+	TickFunction.bHighPriority = true;
+	TickFunction.TickGroup = TG_PrePhysics;
+	TickFunction.RegisterTickFunction(InWorld.PersistentLevel);
+}
+
+void UGameplayTimerSubsystem::Deinitialize()
+{
+	if (TickFunction.IsTickFunctionRegistered()) TickFunction.UnRegisterTickFunction();
+	TickFunction.Timers = nullptr;
+	TimeWheel.Reset(0);
+	FrameWheel.Reset(0);
+	Super::Deinitialize();
+}
+
+int64 UGameplayTimerSubsystem::SecondsToSlot(double Seconds) const
+{
+	return FMath::FloorToInt64(Seconds / FMath::Max(SlotSeconds, 0.001f));
+}
+
+int64 UGameplayTimerSubsystem::GetExpireSlot(float Delay) const
+{
+	// Hacia arriba: nunca antes de tiempo (FTimerManager tampoco)
+	const UWorld* W = GetWorld();
+	const double Now = W ? W->GetTimeSeconds() : 0.0;
+	return FMath::CeilToInt64((Now + FMath::Max(Delay, 0.f)) / FMath::Max(SlotSeconds, 0.001f));
+}
+
+uint32 UGameplayTimerSubsystem::GetIntervalSlots(float Rate) const
+{
+	return (uint32)FMath::Max<int64>(1, FMath::RoundToInt64(Rate / FMath::Max(SlotSeconds, 0.001f)));
+}
+
+FGameplayTimerHandle UGameplayTimerSubsystem::SetTimer(FTimerDelegate&& Delegate, float Rate, bool bLoop, float FirstDelay)
+{
+	return TimeWheel.Schedule(MoveTemp(Delegate), GetExpireSlot(FirstDelay >= 0.f ? FirstDelay : Rate), bLoop ? GetIntervalSlots(Rate) : 0);
+}
+
+FGameplayTimerHandle UGameplayTimerSubsystem::SetTimer(FGameplayTimerTarget* Target, uint32 Payload, float Rate, bool bLoop, float FirstDelay)
+{
+	return TimeWheel.Schedule(Target, Payload, GetExpireSlot(FirstDelay >= 0.f ? FirstDelay : Rate), bLoop ? GetIntervalSlots(Rate) : 0);
+}
+
+FGameplayTimerHandle UGameplayTimerSubsystem::SetFrameTimer(FGameplayTimerTarget* Target, uint32 Payload, int32 Frames, bool bLoop, int32 FirstDelayFrames)
+{
+	const int32 First = FirstDelayFrames >= 0 ? FirstDelayFrames : Frames;
+	return FrameWheel.Schedule(Target, Payload, FrameWheel.GetCurrentSlot() + FMath::Max(First, 0), bLoop ? (uint32)FMath::Max(Frames, 1) : 0);
+}
+
+void UGameplayTimerSubsystem::ClearTimer(FGameplayTimerHandle& Handle)
+{
+	if (!Handle.IsValid()) return;
+	if (Handle.Wheel == FrameWheelId) FrameWheel.Cancel(Handle);
+	else TimeWheel.Cancel(Handle);
+}
+
+bool UGameplayTimerSubsystem::IsTimerActive(const FGameplayTimerHandle& Handle) const
+{
+	return Handle.Wheel == FrameWheelId ? FrameWheel.IsActive(Handle) : TimeWheel.IsActive(Handle);
+}
+
+void UGameplayTimerSubsystem::TickTimers()
+{
+	SCOPE_CYCLE_COUNTER(STAT_BCTimers_Tick);
+
+	int32 Fired = TimeWheel.AdvanceTo(SecondsToSlot(GetWorld()->GetTimeSeconds()));
+	Fired += FrameWheel.AdvanceTo(FrameWheel.GetCurrentSlot() + 1);
+
+	SET_DWORD_STAT(STAT_BCTimers_Time, TimeWheel.GetNumScheduled());
+	SET_DWORD_STAT(STAT_BCTimers_Frames, FrameWheel.GetNumScheduled());
+	SET_DWORD_STAT(STAT_BCTimers_Fired, Fired);
+}
@@ -0,0 +1,246 @@
+#include "Common/GameplayTimerWheel.h"
+
+FGameplayTimerWheel::FGameplayTimerWheel(uint8 InId)
+	: Id(InId)
+{
+	for (int32 b = 0; b < NumLevels * SlotsPerLevel; ++b) Heads[b] = Tails[b] = INDEX_NONE;
+}
+
+void FGameplayTimerWheel::AddChunk()
+{
+	// Bloque nuevo delante de la lista libre, en orden de ndice
+	const int32 Base = Chunks.Num() * ChunkSize;
+	Chunks.Add(MakeUnique<FEntry[]>(ChunkSize));
+	for (int32 i = ChunkSize - 1; i >= 0; --i)
+	{
+		Get(Base + i).Next = FreeHead;
+		FreeHead = Base + i;
+	}
+}
+
+void FGameplayTimerWheel::Reserve(int32 NumEntries)
+{
+	Chunks.Reserve(FMath::DivideAndRoundUp(NumEntries, ChunkSize));
+	while (GetCapacity() < NumEntries) AddChunk();
+}
+
+int32 FGameplayTimerWheel::Allocate(int64 ExpireSlot, uint32 IntervalSlots)
+{
+	if (FreeHead == INDEX_NONE) AddChunk();
+
+	const int32 Index = FreeHead;
+	FEntry& E = Get(Index);
+	FreeHead = E.Next;
+
+	E.Expire = FMath::Min(ExpireSlot, CurrentSlot + MaxDelaySlots);
+	E.Interval = (uint32)FMath::Min<int64>(IntervalSlots, MaxDelaySlots);
+	E.Serial = NextSerial++;
+	if (NextSerial == 0) NextSerial = 1;
+	E.Prev = E.Next = INDEX_NONE;
+	E.Bucket = INDEX_NONE;
+	E.bPendingFree = false;
+	return Index;
+}
+
+void FGameplayTimerWheel::Release(int32 Index)
+{
+	FEntry& E = Get(Index);
+	E.Delegate.Unbind();
+	E.Target = nullptr;
+	E.Serial = 0;
+	E.bPendingFree = false;
+	E.Prev = INDEX_NONE;
+	E.Bucket = INDEX_NONE;
+	E.Next = FreeHead;
+	FreeHead = Index;
+}
+
+FGameplayTimerHandle FGameplayTimerWheel::MakeHandle(int32 Index) const
+{
+	FGameplayTimerHandle H;
+	H.Index = Index;
+	H.Serial = Get(Index).Serial;
+	H.Wheel = Id;
+	return H;
+}
+
+FGameplayTimerHandle FGameplayTimerWheel::Schedule(FTimerDelegate&& Delegate, int64 ExpireSlot, uint32 IntervalSlots)
+{
+	const int32 Index = Allocate(ExpireSlot, IntervalSlots);
+	Get(Index).Delegate = MoveTemp(Delegate);
+	Link(Index);
+	return MakeHandle(Index);
+}
+
+FGameplayTimerHandle FGameplayTimerWheel::Schedule(FGameplayTimerTarget* Target, uint32 Payload, int64 ExpireSlot, uint32 IntervalSlots)
+{
+	check(Target);
+	const int32 Index = Allocate(ExpireSlot, IntervalSlots);
+	FEntry& E = Get(Index);
+	E.Target = Target;
+	E.Payload = Payload;
+	Link(Index);
+	return MakeHandle(Index);
+}
+
+bool FGameplayTimerWheel::IsActive(const FGameplayTimerHandle& Handle) const
+{
+	return Handle.Serial != 0 && Handle.Wheel == Id && Handle.Index >= 0 && Handle.Index < GetCapacity()
+		&& Get(Handle.Index).Serial == Handle.Serial;
+}
+
+bool FGameplayTimerWheel::Cancel(FGameplayTimerHandle& Handle)
+{
+	if (!IsActive(Handle))
+	{
+		Handle.Invalidate();
+		return false;
+	}
+
+	const int32 Index = Handle.Index;
+	Handle.Invalidate();
+	FEntry& E = Get(Index);
+	if (E.Bucket != INDEX_NONE) Unlink(Index);
+
+	// Desde su propio callback no se puede soltar el delegate: se suelta al volver
+	if (Index == Executing)
+	{
+		E.Serial = 0;
+		E.bPendingFree = true;
+	}
+	else
+	{
+		Release(Index);
+	}
+	return true;
+}
+
+void FGameplayTimerWheel::Link(int32 Index)
+{
+	FEntry& E = Get(Index);
+	// Lo vencido (o programado para ya) cae en el prximo slot a procesar
+	const int64 NextSlot = CurrentSlot + 1;
+	E.Expire = FMath::Max(E.Expire, NextSlot);
+	const int64 Delta = E.Expire - NextSlot;
+
+	int32 Level = 0;
+	while (Level < NumLevels - 1 && Delta >= (int64(1) << (LevelBits * (Level + 1)))) ++Level;
+	const int32 Slot = (int32)((E.Expire >> (LevelBits * Level)) & (SlotsPerLevel - 1));
+	const int32 Bucket = Level * SlotsPerLevel + Slot;
+
+	// Al final: mismo vencimiento, orden de programacin
+	E.Bucket = (int16)Bucket;
+	E.Next = INDEX_NONE;
+	E.Prev = Tails[Bucket];
+	if (E.Prev != INDEX_NONE) Get(E.Prev).Next = Index;
+	else Heads[Bucket] = Index;
+	Tails[Bucket] = Index;
+	++NumLinked;
+}
+
+void FGameplayTimerWheel::Unlink(int32 Index)
+{
+	FEntry& E = Get(Index);
+	const int32 Bucket = E.Bucket;
+	if (E.Prev != INDEX_NONE) Get(E.Prev).Next = E.Next;
+	else Heads[Bucket] = E.Next;
+	if (E.Next != INDEX_NONE) Get(E.Next).Prev = E.Prev;
+	else Tails[Bucket] = E.Prev;
+	E.Prev = E.Next = INDEX_NONE;
+	E.Bucket = INDEX_NONE;
+	--NumLinked;
+}
+
+int32 FGameplayTimerWheel::DetachBucket(int32 Bucket)
+{
+	const int32 Head = Heads[Bucket];
+	Heads[Bucket] = Tails[Bucket] = INDEX_NONE;
+	for (int32 i = Head; i != INDEX_NONE; i = Get(i).Next)
+	{
+		Get(i).Bucket = INDEX_NONE;
+		--NumLinked;
+	}
+	return Head;
+}
+
+void FGameplayTimerWheel::Cascade(int32 Level, int32 Slot)
+{
+	int32 i = DetachBucket(Level * SlotsPerLevel + Slot);
+	while (i != INDEX_NONE)
+	{
+		const int32 Next = Get(i).Next;
+		Link(i);
+		i = Next;
+	}
+}
+
+int32 FGameplayTimerWheel::AdvanceTo(int64 Slot)
+{
+	Batch.Reset();
+	while (CurrentSlot < Slot)
+	{
+		// Rueda vaca: saltar directamente
+		if (NumLinked == 0)
+		{
+			CurrentSlot = Slot;
+			break;
+		}
+
+		const int64 Now = CurrentSlot + 1;
+		const int32 Index0 = (int32)(Now & (SlotsPerLevel - 1));
+		if (Index0 == 0)
+		{
+			// Vuelta del nivel 0: baja el cubo que toca de cada nivel superior que tambin d la vuelta
+			for (int32 Level = 1; Level < NumLevels; ++Level)
+			{
+				const int32 LevelSlot = (int32)((Now >> (LevelBits * Level)) & (SlotsPerLevel - 1));
+				Cascade(Level, LevelSlot);
+				if (LevelSlot != 0) break;
+			}
+		}
+
+		int32 i = DetachBucket(Index0);
+		CurrentSlot = Now;
+		while (i != INDEX_NONE)
+		{
+			FEntry& E = Get(i);
+			const int32 Next = E.Next;
+			E.Prev = E.Next = INDEX_NONE;
+			Batch.Add({ i, E.Serial });
+			if (E.Interval > 0)
+			{
+				E.Expire += E.Interval;
+				Link(i);
+			}
+			i = Next;
+		}
+	}
+
+	// Disparo en lote: lo cancelado por un callback anterior ya no coincide en serial
+	for (int32 k = 0; k < Batch.Num(); ++k)
+	{
+		const FFired Fired = Batch[k];
+		FEntry& E = Get(Fired.Index);
+		if (E.Serial != Fired.Serial) continue;
+
+		Executing = Fired.Index;
+		if (E.Target) E.Target->OnGameplayTimer(E.Payload);
+		else E.Delegate.ExecuteIfBound();
+		Executing = INDEX_NONE;
+
+		// Un solo disparo (o cancelado dentro del callback): se libera al terminar
+		if (E.bPendingFree || (E.Interval == 0 && E.Serial == Fired.Serial)) Release(Fired.Index);
+	}
+	return Batch.Num();
+}
+
+void FGameplayTimerWheel::Reset(int64 StartSlot)
+{
+	check(Executing == INDEX_NONE);
+	FreeHead = INDEX_NONE;
+	for (int32 i = GetCapacity() - 1; i >= 0; --i) Release(i);
+	for (int32 b = 0; b < NumLevels * SlotsPerLevel; ++b) Heads[b] = Tails[b] = INDEX_NONE;
+	NumLinked = 0;
+	CurrentSlot = StartSlot;
+	Batch.Reset();
+}
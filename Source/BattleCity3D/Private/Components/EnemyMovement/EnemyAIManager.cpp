@@ -0,0 +1,790 @@
+#include "Components/EnemyMovement/EnemyAIManager.h"
+#include "Components/EnemyMovement/EnemyMovementComponent.h"
+#include "Components/EnemyMovement/EnemyMovePolicies/EnemyMovePolicy.h"
+#include "Enemies/EnemyPawn.h"
+#include "Map/MapGridSubsystem.h"
+#include "Projectiles/ProjectileLaneSubsystem.h"
+#include "Common/BattleTargetRegistry.h"
+#include "Common/GameplayTimerSubsystem.h"
+#include "Engine/World.h"
+#include "Engine/Level.h"
+#include "Async/ParallelFor.h"
+#include "HAL/MemoryBase.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/CommandLine.h"
+#include "Misc/Parse.h"
+#include "UObject/UObjectHash.h"
+#include "UObject/UObjectArray.h"
+#include "UObject/UnrealType.h"
+#include <atomic>
+
+DECLARE_STATS_GROUP(TEXT("BattleCity AI"), STATGROUP_BCAI, STATCAT_Advanced);
+DECLARE_CYCLE_STAT(TEXT("AI tick"), STAT_BCAI_Tick, STATGROUP_BCAI);
+DECLARE_CYCLE_STAT(TEXT("LOD"), STAT_BCAI_LOD, STATGROUP_BCAI);
+DECLARE_CYCLE_STAT(TEXT("Contexts"), STAT_BCAI_Contexts, STATGROUP_BCAI);
+DECLARE_CYCLE_STAT(TEXT("Decide"), STAT_BCAI_Decide, STATGROUP_BCAI);
+DECLARE_CYCLE_STAT(TEXT("Apply"), STAT_BCAI_Apply, STATGROUP_BCAI);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Agents"), STAT_BCAI_Agents, STATGROUP_BCAI);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Tier High"), STAT_BCAI_TierHigh, STATGROUP_BCAI);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Tier Medium"), STAT_BCAI_TierMedium, STATGROUP_BCAI);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Tier Low"), STAT_BCAI_TierLow, STATGROUP_BCAI);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Decisions this frame"), STAT_BCAI_Decisions, STATGROUP_BCAI);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Deferred by budget"), STAT_BCAI_Deferred, STATGROUP_BCAI);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Forced (blocked)"), STAT_BCAI_Forced, STATGROUP_BCAI);
+
+// Uso en consola: bc.ai.batched 0
+static TAutoConsoleVariable<int32> CVarBcAIBatched(
+	TEXT("bc.ai.batched"),
+	1,
+	TEXT("1: UEnemyAIManager actualiza a todos los enemigos en un solo tick (componentes sin tick). 0: cada UEnemyMovementComponent tickea por su cuenta."),
+	ECVF_Default);
+
+// Uso en consola: bc.ai.lod 0
+static TAutoConsoleVariable<int32> CVarBcAILOD(
+	TEXT("bc.ai.lod"),
+	1,
+	TEXT("1: Frecuencia de decision por nivel de relevancia y presupuesto round-robin (stat BCAI). 0: todos deciden cada frame."),
+	ECVF_Default);
+
+// Uso en consola: bc.ai.parallel 0
+static TAutoConsoleVariable<int32> CVarBcAIParallel(
+	TEXT("bc.ai.parallel"),
+	1,
+	TEXT("1: Las decisiones de las policies IsParallelSafe se calculan en un ParallelFor. 0: todas en serie (mismo resultado)."),
+	ECVF_Default);
+
+// Uso en consola: bc.ai.parallel.minbatch 4
+static TAutoConsoleVariable<int32> CVarBcAIParallelMinBatch(
+	TEXT("bc.ai.parallel.minbatch"),
+	4,
+	TEXT("Agentes mnimos por tarea del ParallelFor de decisiones."),
+	ECVF_Default);
+
+// Uso en consola: bc.ai.sharedpolicies 0
+static TAutoConsoleVariable<int32> CVarBcAISharedPolicies(
+	TEXT("bc.ai.sharedpolicies"),
+	1,
+	TEXT("1: Los enemigos con la misma clase y configuracion de policy comparten una instancia (estado por agente en bloques). 0: una instancia por enemigo (afecta a los que aparezcan despues)."),
+	ECVF_Default);
+
+// Uso en consola: bc.ai.objstats
+static FAutoConsoleCommandWithWorldAndArgs GBcAIObjStatsCmd(
+	TEXT("bc.ai.objstats"),
+	TEXT("Hace un GC completo y muestra en el log su tiempo, los UObjects por enemigo, las policies compartidas y sus bloques de estado. Para comparar: bc.ai.sharedpolicies 0, nueva oleada y repetir."),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+		{
+			if (UEnemyAIManager* Mgr = World ? World->GetSubsystem<UEnemyAIManager>() : nullptr) Mgr->LogObjectStats();
+		}));
+
+#if BC_AI_ALLOC_COUNT
+// Proxy sobre GMalloc que cuenta reservas (Malloc/Realloc) hechas dentro de una fase del tick de IA
+// (BC_AI_ALLOC_SCOPE) o de un FBCAllocCountScope. Slo se instala al arrancar con -bcaialloccount (cambiar GMalloc con hilos
+// reservando no es seguro) y se queda: fuera de las fases slo reenva. No ve las plataformas con
+// GMalloc fijo en compilacin.
+namespace BCAIAlloc
+{
+	enum EPhase : int32 { Context, ParallelDecide, SerialDecide, Apply, NumPhases };
+	static const TCHAR* PhaseNames[NumPhases] = { TEXT("contextos"), TEXT("decisiones paralelas"), TEXT("decisiones en serie"), TEXT("aplicar") };
+
+	static std::atomic<bool> bCounting{ false };
+	static std::atomic<int64> Counts[NumPhases];
+	static thread_local int32 CurrentPhase = INDEX_NONE;
+
+	// FBCAllocCountScope: totales del hilo mientras haya alguno abierto
+	static thread_local int32 ScopeDepth = 0;
+	static thread_local int64 ScopeAllocs = 0;
+	static thread_local int64 ScopeBytes = 0;
+
+	FORCEINLINE void Count(SIZE_T Size)
+	{
+		if (CurrentPhase != INDEX_NONE && bCounting.load(std::memory_order_relaxed))
+		{
+			Counts[CurrentPhase].fetch_add(1, std::memory_order_relaxed);
+		}
+		if (ScopeDepth > 0)
+		{
+			++ScopeAllocs;
+			ScopeBytes += (int64)Size;
+		}
+	}
+
+	class FCountingMalloc final : public FMalloc
+	{
+	public:
+		explicit FCountingMalloc(FMalloc* InInner) : Inner(InInner) {}
+
+		virtual void* Malloc(SIZE_T Size, uint32 Alignment) override { Count(Size); return Inner->Malloc(Size, Alignment); }
+		virtual void* TryMalloc(SIZE_T Size, uint32 Alignment) override { Count(Size); return Inner->TryMalloc(Size, Alignment); }
+		virtual void* Realloc(void* Ptr, SIZE_T NewSize, uint32 Alignment) override { Count(NewSize); return Inner->Realloc(Ptr, NewSize, Alignment); }
+		virtual void* TryRealloc(void* Ptr, SIZE_T NewSize, uint32 Alignment) override { Count(NewSize); return Inner->TryRealloc(Ptr, NewSize, Alignment); }
+		virtual void Free(void* Ptr) override { Inner->Free(Ptr); }
+		virtual bool GetAllocationSize(void* Original, SIZE_T& SizeOut) override { return Inner->GetAllocationSize(Original, SizeOut); }
+		virtual SIZE_T QuantizeSize(SIZE_T Size, uint32 Alignment) override { return Inner->QuantizeSize(Size, Alignment); }
+		virtual void Trim(bool bTrimThreadCaches) override { Inner->Trim(bTrimThreadCaches); }
+		virtual void SetupTLSCachesOnCurrentThread() override { Inner->SetupTLSCachesOnCurrentThread(); }
+		virtual void ClearAndDisableTLSCachesOnCurrentThread() override { Inner->ClearAndDisableTLSCachesOnCurrentThread(); }
+		virtual void InitializeStatsMetadata() override { Inner->InitializeStatsMetadata(); }
+		virtual void UpdateStats() override { Inner->UpdateStats(); }
+		virtual void GetAllocatorStats(FGenericMemoryStats& OutStats) override { Inner->GetAllocatorStats(OutStats); }
+		virtual void DumpAllocatorStats(FOutputDevice& Ar) override { Inner->DumpAllocatorStats(Ar); }
+		virtual bool IsInternallyThreadSafe() const override { return Inner->IsInternallyThreadSafe(); }
+		virtual bool ValidateHeap() override { return Inner->ValidateHeap(); }
+		virtual const TCHAR* GetDescriptiveName() override { return Inner->GetDescriptiveName(); }
+
+	private:
+		FMalloc* Inner;
+	};
+
+	static bool bInstalled = false;
+
+	struct FScope
+	{
+		int32 Prev;
+		explicit FScope(EPhase Phase) : Prev(CurrentPhase) { CurrentPhase = Phase; }
+		~FScope() { CurrentPhase = Prev; }
+	};
+}
+#define BC_AI_ALLOC_SCOPE(Phase) BCAIAlloc::FScope BCAIAllocScope(BCAIAlloc::Phase)
+
+FBCAllocCountScope::FBCAllocCountScope()
+	: StartAllocs(BCAIAlloc::ScopeAllocs), StartBytes(BCAIAlloc::ScopeBytes)
+{
+	++BCAIAlloc::ScopeDepth;
+}
+
+FBCAllocCountScope::~FBCAllocCountScope()
+{
+	--BCAIAlloc::ScopeDepth;
+}
+
+int64 FBCAllocCountScope::GetAllocs() const { return BCAIAlloc::ScopeAllocs - StartAllocs; }
+int64 FBCAllocCountScope::GetBytes() const { return BCAIAlloc::ScopeBytes - StartBytes; }
+bool FBCAllocCountScope::IsInstalled() { return BCAIAlloc::bInstalled; }
+
+// Uso en consola: bc.ai.alloccount [ticks=120]
+static FAutoConsoleCommandWithWorldAndArgs GBcAIAllocCountCmd(
+	TEXT("bc.ai.alloccount"),
+	TEXT("Cuenta las reservas de memoria de cada fase del tick de IA por lotes durante N ticks y las muestra en el log (contextos y decisiones paralelas deben dar 0)."),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+		{
+			UEnemyAIManager* Mgr = World ? World->GetSubsystem<UEnemyAIManager>() : nullptr;
+			if (!Mgr) return;
+			Mgr->StartAllocCount(Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : 120);
+		}));
+#else
+#define BC_AI_ALLOC_SCOPE(Phase)
+#endif
+
+void FEnemyAITickFunction::ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent)
+{
+	if (Manager && TickType != LEVELTICK_ViewportsOnly) Manager->TickAgents(DeltaTime);
+}
+
+void FEnemyAIAgents::Add(UEnemyMovementComponent* Comp, AEnemyPawn* Pawn, UEnemyMovePolicy* Policy, const FVector2D& InFacing, uint32 InLastDecisionFrame)
+{
+	Components.Add(Comp);
+	Pawns.Add(Pawn);
+	Policies.Add(Policy);
+	ParallelSafe.Add(Policy && Policy->IsParallelSafe());
+	Facing.Add(InFacing);
+	LockAxis.Add(EMoveLockAxis::None);
+	LockUntil.Add(0.0);
+	Score.Add(0.f);
+	Tier.Add(EEnemyAILOD::High);
+	LastDecisionFrame.Add(InLastDecisionFrame);
+	DecisionDue.Add(true);
+	DecisionTimer.AddDefaulted();
+	DecisionPeriod.Add(0);
+	Contexts.AddDefaulted();
+	Decisions.AddDefaulted();
+}
+
+void FEnemyAIAgents::RemoveAt(int32 Index)
+{
+	// Sin swap: el orden de registro es el orden de actualizacin
+	Components.RemoveAt(Index, 1, EAllowShrinking::No);
+	Pawns.RemoveAt(Index, 1, EAllowShrinking::No);
+	Policies.RemoveAt(Index, 1, EAllowShrinking::No);
+	ParallelSafe.RemoveAt(Index, 1, EAllowShrinking::No);
+	Facing.RemoveAt(Index, 1, EAllowShrinking::No);
+	LockAxis.RemoveAt(Index, 1, EAllowShrinking::No);
+	LockUntil.RemoveAt(Index, 1, EAllowShrinking::No);
+	Score.RemoveAt(Index, 1, EAllowShrinking::No);
+	Tier.RemoveAt(Index, 1, EAllowShrinking::No);
+	LastDecisionFrame.RemoveAt(Index, 1, EAllowShrinking::No);
+	DecisionDue.RemoveAt(Index, 1, EAllowShrinking::No);
+	DecisionTimer.RemoveAt(Index, 1, EAllowShrinking::No);
+	DecisionPeriod.RemoveAt(Index, 1, EAllowShrinking::No);
+	Contexts.RemoveAt(Index, 1, EAllowShrinking::No);
+	Decisions.RemoveAt(Index, 1, EAllowShrinking::No);
+}
+
+void FEnemyAIAgents::Remove(int32 Index)
+{
+	if (!bDeferRemovals)
+	{
+		RemoveAt(Index);
+		return;
+	}
+	Components[Index] = nullptr;
+	Pawns[Index] = nullptr;
+	Policies[Index] = nullptr;
+	ParallelSafe[Index] = false;
+	DecisionDue[Index] = false;
+	PendingRemovals.Add(Index);
+}
+
+int32 FEnemyAIAgents::EndDeferRemovals()
+{
+	bDeferRemovals = false;
+	if (PendingRemovals.Num() == 0) return INDEX_NONE;
+
+	// De atrs hacia delante: los ndices pendientes no se desplazan entre s
+	PendingRemovals.Sort(TGreater<int32>());
+	for (const int32 Index : PendingRemovals) RemoveAt(Index);
+	const int32 First = PendingRemovals.Last();
+	PendingRemovals.Reset();
+	return First;
+}
+
+void FEnemyAIAgents::Reset()
+{
+	bDeferRemovals = false;
+	PendingRemovals.Reset();
+	Components.Reset();
+	Pawns.Reset();
+	Policies.Reset();
+	ParallelSafe.Reset();
+	Facing.Reset();
+	LockAxis.Reset();
+	LockUntil.Reset();
+	Score.Reset();
+	Tier.Reset();
+	LastDecisionFrame.Reset();
+	DecisionDue.Reset();
+	DecisionTimer.Reset();
+	DecisionPeriod.Reset();
+	Contexts.Reset();
+	Decisions.Reset();
+}
+
+bool UEnemyAIManager::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UEnemyAIManager::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	// Un timer de cadencia por agente: con la rueda ya dimensionada, registrar no reserva en el tick
+	Timers = Collection.InitializeDependency<UGameplayTimerSubsystem>();
+	if (Timers.IsValid()) Timers->ReserveFrameTimers(MaxAgents);
+	DueAgents.Reserve(MaxAgents);
+	ParallelAgents.Reserve(MaxAgents);
+	SerialAgents.Reserve(MaxAgents);
+}
+
+void UEnemyAIManager::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	bBatched = CVarBcAIBatched.GetValueOnGameThread() != 0;
+
+	// Despus de TG_PrePhysics: todos los tanques ya se han movido este frame
+	TickFunction.Manager = this;
+	TickFunction.bCanEverTick = true;
+	TickFunction.bStartWithTickEnabled = true;
+	TickFunction.TickGroup = TG_DuringPhysics;
+	TickFunction.RegisterTickFunction(InWorld.PersistentLevel);
+
+	if (!Timers.IsValid()) Timers = InWorld.GetSubsystem<UGameplayTimerSubsystem>();
+}
+
+void UEnemyAIManager::Deinitialize()
+{
+	if (TickFunction.IsTickFunctionRegistered()) TickFunction.UnRegisterTickFunction();
+	TickFunction.Manager = nullptr;
+
+	for (int32 i = 0; i < Agents.Num(); ++i) CancelDecisionTimer(i);
+	for (UEnemyMovementComponent* Comp : Agents.Components)
+	{
+		Comp->AIManager = nullptr;
+		Comp->AIAgentIndex = INDEX_NONE;
+	}
+	Agents.Reset();
+	SharedPolicies.Reset();
+	Super::Deinitialize();
+}
+
+int32 UEnemyAIManager::RegisterAgent(UEnemyMovementComponent* Comp)
+{
+	if (!Comp) return INDEX_NONE;
+	if (Comp->AIManager == this) return Comp->AIAgentIndex;
+
+	AEnemyPawn* Pawn = Comp->GetPawn();
+	if (!Pawn) return INDEX_NONE;
+
+	FVector2D Facing(1.f, 0.f);
+	const FVector2D PawnFacing = Pawn->GetFacingDir();
+	if (!PawnFacing.IsNearlyZero()) Facing = FVector2D(Sign01(PawnFacing.X), Sign01(PawnFacing.Y));
+
+	Comp->AIManager = this;
+	// Desfase por agente: los que aparecen juntos no deciden en el mismo frame
+	const int32 Spread = FMath::Max(1, LowIntervalFrames);
+	const uint32 LastDecision = FrameCounter + (uint32)(RegisterSerial++ % Spread) - (uint32)Spread;
+
+	Comp->AIAgentIndex = Agents.Num();
+	Agents.Add(Comp, Pawn, Comp->MovePolicy, Facing, LastDecision);
+	RescheduleDecision(Comp->AIAgentIndex);
+
+	Comp->SetComponentTickEnabled(!bBatched);
+	return Comp->AIAgentIndex;
+}
+
+void UEnemyAIManager::UnregisterAgent(UEnemyMovementComponent* Comp)
+{
+	if (!Comp || Comp->AIManager != this) return;
+
+	const int32 Index = Comp->AIAgentIndex;
+	Comp->AIManager = nullptr;
+	Comp->AIAgentIndex = INDEX_NONE;
+	if (!Agents.Components.IsValidIndex(Index) || Agents.Components[Index] != Comp) return;
+
+	CancelDecisionTimer(Index);
+	// Dentro de TickAgents (un disparo que mata a otro) slo queda el hueco; se compacta al final
+	Agents.Remove(Index);
+	if (!Agents.bDeferRemovals) RenumberAgentsFrom(Index);
+}
+
+void UEnemyAIManager::RenumberAgentsFrom(int32 Index)
+{
+	for (int32 i = FMath::Max(0, Index); i < Agents.Num(); ++i) Agents.Components[i]->AIAgentIndex = i;
+}
+
+void UEnemyAIManager::RefreshAgentPolicy(UEnemyMovementComponent* Comp)
+{
+	if (Comp && Comp->AIManager == this && Agents.Components.IsValidIndex(Comp->AIAgentIndex))
+	{
+		Agents.Policies[Comp->AIAgentIndex] = Comp->MovePolicy;
+		Agents.ParallelSafe[Comp->AIAgentIndex] = Comp->MovePolicy && Comp->MovePolicy->IsParallelSafe();
+	}
+}
+
+// Misma clase y mismos valores; las sub-policies instanciadas se comparan por contenido
+static bool IsSamePolicyConfig(const UObject* A, const UObject* B)
+{
+	if (A == B) return true;
+	if (!A || !B || A->GetClass() != B->GetClass()) return false;
+
+	for (TFieldIterator<FProperty> It(A->GetClass()); It; ++It)
+	{
+		const FProperty* Prop = *It;
+		if (Prop->HasAnyPropertyFlags(CPF_Transient)) continue;
+
+		if (const FArrayProperty* Arr = CastField<FArrayProperty>(Prop))
+		{
+			const FObjectPropertyBase* Inner = CastField<FObjectPropertyBase>(Arr->Inner);
+			if (Inner && Inner->HasAnyPropertyFlags(CPF_InstancedReference))
+			{
+				FScriptArrayHelper HA(Arr, Arr->ContainerPtrToValuePtr<void>(A));
+				FScriptArrayHelper HB(Arr, Arr->ContainerPtrToValuePtr<void>(B));
+				if (HA.Num() != HB.Num()) return false;
+				for (int32 i = 0; i < HA.Num(); ++i)
+				{
+					if (!IsSamePolicyConfig(Inner->GetObjectPropertyValue(HA.GetRawPtr(i)), Inner->GetObjectPropertyValue(HB.GetRawPtr(i)))) return false;
+				}
+				continue;
+			}
+		}
+
+		for (int32 i = 0; i < Prop->ArrayDim; ++i)
+		{
+			const FObjectPropertyBase* Obj = CastField<FObjectPropertyBase>(Prop);
+			if (Obj && Prop->HasAnyPropertyFlags(CPF_InstancedReference))
+			{
+				if (!IsSamePolicyConfig(Obj->GetObjectPropertyValue_InContainer(A, i), Obj->GetObjectPropertyValue_InContainer(B, i))) return false;
+			}
+			else if (!Prop->Identical_InContainer(A, B, i))
+			{
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+UEnemyMovePolicy* UEnemyAIManager::GetSharedPolicy(UEnemyMovePolicy* Config)
+{
+	if (!Config || CVarBcAISharedPolicies.GetValueOnGameThread() == 0) return nullptr;
+
+	// Ya compartida (la config que cachea el spawner): slo punteros
+	if (SharedPolicies.Contains(Config)) return Config;
+
+	// Pocas configuraciones distintas (una por tipo de enemigo): bsqueda lineal
+	for (UEnemyMovePolicy* P : SharedPolicies)
+	{
+		if (IsSamePolicyConfig(P, Config)) return P;
+	}
+
+	UEnemyMovePolicy* Shared = NewObject<UEnemyMovePolicy>(this, Config->GetClass(), NAME_None, RF_Transient, Config);
+	Shared->Initialize(GetWorld());
+	SharedPolicies.Add(Shared);
+	return Shared;
+}
+
+void UEnemyAIManager::LogObjectStats()
+{
+	// Primero el GC: las copias inline que ya no usa nadie no cuentan
+	const double T0 = FPlatformTime::Seconds();
+	CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS, true);
+	const double GCMs = (FPlatformTime::Seconds() - T0) * 1000.0;
+
+	// UObjects que cuelgan de cada enemigo (componentes, policies propias y sus hijas)
+	TArray<UObject*> Inner;
+	int64 EnemyObjects = 0;
+	int32 NumEnemies = 0;
+	TSet<UEnemyMovePolicy*> Roots;
+	for (int32 i = 0; i < Agents.Num(); ++i)
+	{
+		if (!IsValid(Agents.Pawns[i])) continue;
+		Inner.Reset();
+		GetObjectsWithOuter(Agents.Pawns[i], Inner, true);
+		EnemyObjects += 1 + Inner.Num();
+		++NumEnemies;
+		if (Agents.Policies[i]) Roots.Add(Agents.Policies[i]);
+	}
+
+	int64 SharedObjects = 0;
+	for (UEnemyMovePolicy* P : SharedPolicies)
+	{
+		Inner.Reset();
+		GetObjectsWithOuter(P, Inner, true);
+		SharedObjects += 1 + Inner.Num();
+	}
+
+	int64 Blocks = 0, Bytes = 0;
+	for (const UEnemyMovePolicy* P : Roots)
+	{
+		Blocks += P->GetStatePool().GetNumLive();
+		Bytes += P->GetStatePool().GetReservedBytes();
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("[AI obj] GC completo %.2f ms, %d UObjects vivos (bc.ai.sharedpolicies %d)"),
+		GCMs, GUObjectArray.GetObjectArrayNumMinusAvailable(), CVarBcAISharedPolicies.GetValueOnGameThread());
+	UE_LOG(LogTemp, Log, TEXT("[AI obj] %d enemigos, %.1f UObjects por enemigo; %d policies compartidas (%lld UObjects)"),
+		NumEnemies, NumEnemies > 0 ? (double)EnemyObjects / NumEnemies : 0.0, SharedPolicies.Num(), SharedObjects);
+	UE_LOG(LogTemp, Log, TEXT("[AI obj] %lld bloques de estado en %d pools, %lld bytes reservados"), Blocks, Roots.Num(), Bytes);
+}
+
+void UEnemyAIManager::MarkDecisionDue(int32 Index)
+{
+	if (!Agents.DecisionDue.IsValidIndex(Index)) return;
+	Agents.DecisionDue[Index] = true;
+}
+
+void UEnemyAIManager::CancelDecisionTimer(int32 Index)
+{
+	if (UGameplayTimerSubsystem* T = Timers.Get()) T->ClearTimer(Agents.DecisionTimer[Index]);
+	Agents.DecisionTimer[Index].Invalidate();
+}
+
+void UEnemyAIManager::RescheduleDecision(int32 Index)
+{
+	// Mismo turno que antes (ltimo frame en que decidi + intervalo del nivel) y luego cada intervalo
+	const int32 Interval = GetIntervalFrames(Agents.Tier[Index]);
+	const int32 Remaining = (int32)(Agents.LastDecisionFrame[Index] + (uint32)Interval - FrameCounter);
+	Agents.DecisionPeriod[Index] = Interval;
+	CancelDecisionTimer(Index);
+	if (Remaining <= 0) Agents.DecisionDue[Index] = true;
+	if (UGameplayTimerSubsystem* T = Timers.Get())
+	{
+		Agents.DecisionTimer[Index] = T->SetFrameTimer(Agents.Components[Index], 0, Interval, true, Remaining > 0 ? Remaining : Interval);
+	}
+}
+
+void UEnemyAIManager::SetBatched(bool bInBatched)
+{
+	bBatched = bInBatched;
+	for (UEnemyMovementComponent* Comp : Agents.Components) Comp->SetComponentTickEnabled(!bBatched);
+}
+
+void UEnemyAIManager::ResetDecision(int32 Index)
+{
+	Agents.Decisions[Index].Reset();
+}
+
+void UEnemyAIManager::UpdateAgent(int32 Index, double Now)
+{
+	UEnemyMovementComponent* Comp = Agents.Components[Index];
+	UEnemyMovePolicy* Policy = Agents.Policies[Index];
+	if (!Policy || !IsValid(Agents.Pawns[Index])) return;
+
+	FMoveContext& Ctx = Agents.Contexts[Index];
+	Comp->BuildMoveContext(Ctx);
+
+	ResetDecision(Index);
+	FMoveDecision& Dec = Agents.Decisions[Index];
+	Policy->ComputeMove(Ctx, Dec);
+
+	Comp->ApplyAxisLock(Dec, Now);
+	Comp->ApplyDecision(Dec);
+}
+
+#if BC_AI_ALLOC_COUNT
+void UEnemyAIManager::StartAllocCount(int32 Ticks)
+{
+	if (!bBatched)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[AI alloc] Slo se mide el tick por lotes (bc.ai.batched 1)"));
+		return;
+	}
+	if (!BCAIAlloc::bInstalled)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[AI alloc] Hay que arrancar con -bcaialloccount para contar reservas"));
+		return;
+	}
+	for (std::atomic<int64>& C : BCAIAlloc::Counts) C.store(0);
+	AllocCountTicksLeft = AllocCountTicks = Ticks;
+	AllocCountAgentTicks = 0;
+	BCAIAlloc::bCounting.store(true);
+}
+
+void UEnemyAIManager::InstallAllocCounter()
+{
+	if (BCAIAlloc::bInstalled || !GMalloc || !FParse::Param(FCommandLine::Get(), TEXT("bcaialloccount"))) return;
+	// Vive lo que el proceso, como los proxies de GMalloc del motor
+	GMalloc = new BCAIAlloc::FCountingMalloc(GMalloc);
+	BCAIAlloc::bInstalled = true;
+	UE_LOG(LogTemp, Log, TEXT("[AI alloc] Contador de reservas instalado (bc.ai.alloccount)"));
+}
+
+void UEnemyAIManager::FinishAllocCountTick()
+{
+	AllocCountAgentTicks += DueAgents.Num();
+	if (--AllocCountTicksLeft > 0) return;
+
+	BCAIAlloc::bCounting.store(false);
+	int64 Steady = 0;
+	for (int32 P = 0; P < BCAIAlloc::NumPhases; ++P)
+	{
+		const int64 C = BCAIAlloc::Counts[P].load();
+		if (P == BCAIAlloc::Context || P == BCAIAlloc::ParallelDecide) Steady += C;
+		UE_LOG(LogTemp, Log, TEXT("[AI alloc] %-22s %8lld  (%.2f por tick)"), BCAIAlloc::PhaseNames[P], C, (double)C / AllocCountTicks);
+	}
+	UE_LOG(LogTemp, Log, TEXT("[AI alloc] ticks=%d agente-ticks=%lld"), AllocCountTicks, AllocCountAgentTicks);
+	if (Steady > 0)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[AI alloc] %lld reservas en contextos/decisiones paralelas: el pipeline debera ser sin reservas"), Steady);
+	}
+}
+#endif
+
+int32 UEnemyAIManager::GetIntervalFrames(EEnemyAILOD InTier) const
+{
+	switch (InTier)
+	{
+	case EEnemyAILOD::Medium: return FMath::Max(1, MediumIntervalFrames);
+	case EEnemyAILOD::Low:    return FMath::Max(1, LowIntervalFrames);
+	default:                  return FMath::Max(1, HighIntervalFrames);
+	}
+}
+
+void UEnemyAIManager::UpdateLOD()
+{
+	SCOPE_CYCLE_COUNTER(STAT_BCAI_LOD);
+
+	UWorld* W = GetWorld();
+	if (!Grid.IsValid()) Grid = W->GetGameInstance() ? W->GetGameInstance()->GetSubsystem<UMapGridSubsystem>() : nullptr;
+	if (!Lanes.IsValid()) Lanes = W->GetSubsystem<UProjectileLaneSubsystem>();
+	const UMapGridSubsystem* G = Grid.Get();
+	if (!G) return;
+
+	FIntPoint PlayerCell(INDEX_NONE, INDEX_NONE);
+	if (const UBattleTargetRegistry* Targets = W->GetSubsystem<UBattleTargetRegistry>()) Targets->GetPlayerCell(PlayerCell);
+	int32 X, Y;
+	const TArray<FIntPoint>& BaseCells = G->GetBaseCells();
+	const FProjectileLaneIndex* LaneIndex = Lanes.IsValid() ? &Lanes->GetIndex() : nullptr;
+
+	const float Range = FMath::Max(1.f, FarCells - NearCells);
+	auto Proximity = [&](int32 DistCells) { return 1.f - FMath::Clamp((DistCells - NearCells) / Range, 0.f, 1.f); };
+
+	int32 TierCount[3] = { 0, 0, 0 };
+	for (int32 i = 0; i < Agents.Num(); ++i)
+	{
+		const AEnemyPawn* Pawn = Agents.Pawns[i];
+		if (!IsValid(Pawn) || !G->WorldToGrid(Pawn->GetActorLocation(), X, Y)) continue;
+		const FIntPoint Cell(X, Y);
+
+		float S = 0.f;
+		bool bThreat = false;
+		if (PlayerCell.X != INDEX_NONE)
+		{
+			const int32 D = FMath::Abs(Cell.X - PlayerCell.X) + FMath::Abs(Cell.Y - PlayerCell.Y);
+			S += PlayerWeight * Proximity(D);
+			// Alineado con el jugador: puede disparar o recibir
+			bThreat = (Cell.X == PlayerCell.X || Cell.Y == PlayerCell.Y) && D <= FarCells;
+		}
+		int32 BaseDist = MAX_int32;
+		for (const FIntPoint& B : BaseCells) BaseDist = FMath::Min(BaseDist, FMath::Abs(Cell.X - B.X) + FMath::Abs(Cell.Y - B.Y));
+		if (BaseDist != MAX_int32) S += BaseWeight * Proximity(BaseDist);
+		if (Pawn->WasRecentlyRendered(0.25f)) S += VisibleWeight;
+		if (!bThreat && LaneIndex) bThreat = LaneIndex->IsThreatened(Cell, EProjectileTeam::Player, 1.f);
+		if (bThreat) S += ThreatWeight;
+
+		const EEnemyAILOD NewTier = S >= HighScore ? EEnemyAILOD::High : (S >= MediumScore ? EEnemyAILOD::Medium : EEnemyAILOD::Low);
+		Agents.Score[i] = S;
+		if (NewTier != Agents.Tier[i])
+		{
+			Agents.Tier[i] = NewTier;
+			Agents.Components[i]->MoveAgent.LODTier = NewTier;
+			RescheduleDecision(i);
+		}
+		else if (Agents.DecisionPeriod[i] != GetIntervalFrames(NewTier))
+		{
+			RescheduleDecision(i); // cambi el intervalo del nivel (config)
+		}
+		++TierCount[(int32)NewTier];
+	}
+
+	SET_DWORD_STAT(STAT_BCAI_TierHigh, TierCount[0]);
+	SET_DWORD_STAT(STAT_BCAI_TierMedium, TierCount[1]);
+	SET_DWORD_STAT(STAT_BCAI_TierLow, TierCount[2]);
+}
+
+void UEnemyAIManager::SelectDueAgents(bool bUseLOD)
+{
+	DueAgents.Reset();
+	const int32 Num = Agents.Num();
+	if (Num == 0) return;
+
+	const int32 Budget = (bUseLOD && MaxDecisionsPerFrame > 0) ? MaxDecisionsPerFrame : Num;
+	const float Tile = Grid.IsValid() ? Grid->GetTileSize() : 200.f;
+	int32 Deferred = 0;
+	int32 Forced = 0;
+	int32 LastPicked = INDEX_NONE;
+
+	// Round-robin desde el cursor: los que se quedaron sin presupuesto van primero el frame siguiente
+	for (int32 n = 0; n < Num; ++n)
+	{
+		const int32 i = (RoundRobinCursor + n) % Num;
+		const AEnemyPawn* Pawn = Agents.Pawns[i];
+		if (!Agents.Policies[i] || !IsValid(Pawn)) continue;
+
+		// El timer de cadencia ya marc a los que les toca (los aplazados por presupuesto siguen marcados)
+		bool bDue = !bUseLOD || Agents.DecisionDue[i];
+		if (!bDue && !Pawn->RawMoveInput.IsNearlyZero())
+		{
+			// Va a chocar con su ltima orden: decide ya
+			const FVector2D& F = Agents.Facing[i];
+			const bool bAxisX = FMath::Abs(F.X) >= FMath::Abs(F.Y);
+			const int Dir = bAxisX ? (F.X >= 0.f ? 1 : -1) : (F.Y >= 0.f ? 1 : -1);
+			const UEnemyMovementComponent* Comp = Agents.Components[i];
+			if (Comp->IsAheadBlocked(bAxisX, Dir, Tile * Comp->LookAheadTiles))
+			{
+				bDue = true;
+				++Forced;
+			}
+		}
+		if (!bDue) continue;
+
+		if (DueAgents.Num() >= Budget) { ++Deferred; continue; }
+		DueAgents.Add(i);
+		LastPicked = i;
+	}
+	if (LastPicked != INDEX_NONE) RoundRobinCursor = (LastPicked + 1) % Num;
+
+	// Fases siguientes en orden de agente
+	DueAgents.Sort();
+
+	SET_DWORD_STAT(STAT_BCAI_Decisions, DueAgents.Num());
+	SET_DWORD_STAT(STAT_BCAI_Deferred, Deferred);
+	SET_DWORD_STAT(STAT_BCAI_Forced, Forced);
+}
+
+void UEnemyAIManager::TickAgents(float DeltaTime)
+{
+	const bool bWantBatched = CVarBcAIBatched.GetValueOnGameThread() != 0;
+	if (bWantBatched != bBatched) SetBatched(bWantBatched);
+	if (!bBatched) return;
+
+	SCOPE_CYCLE_COUNTER(STAT_BCAI_Tick);
+	SET_DWORD_STAT(STAT_BCAI_Agents, Agents.Num());
+
+	const double Now = GetWorld()->GetTimeSeconds();
+	++FrameCounter;
+
+	// DueAgents y las listas por fase guardan ndices: ninguna baja los mueve hasta el final
+	Agents.BeginDeferRemovals();
+
+	// 0) Quin decide este frame
+	const bool bUseLOD = CVarBcAILOD.GetValueOnGameThread() != 0;
+	if (bUseLOD) UpdateLOD();
+	SelectDueAgents(bUseLOD);
+
+	// 1) Contextos (hilo de juego): lee pawns y estado de disparo
+	ParallelAgents.Reset();
+	SerialAgents.Reset();
+	{
+		SCOPE_CYCLE_COUNTER(STAT_BCAI_Contexts);
+		for (const int32 i : DueAgents)
+		{
+			BC_AI_ALLOC_SCOPE(Context);
+			Agents.Components[i]->BuildMoveContext(Agents.Contexts[i]);
+			ResetDecision(i);
+			Agents.LastDecisionFrame[i] = FrameCounter;
+			// El timer en bucle lo vuelve a marcar; sin timer (mundo sin la rueda) decide cada frame
+			Agents.DecisionDue[i] = !Agents.DecisionTimer[i].IsValid();
+			if (Agents.ParallelSafe[i])
+			{
+				Agents.Policies[i]->PrepareParallel();
+				ParallelAgents.Add(i);
+			}
+			else
+			{
+				SerialAgents.Add(i);
+			}
+		}
+	}
+
+	// 2) Decisiones: cada agente escribe slo su Decisions[i] y el estado de su policy
+	{
+		SCOPE_CYCLE_COUNTER(STAT_BCAI_Decide);
+		const EParallelForFlags Flags = CVarBcAIParallel.GetValueOnGameThread() != 0 ? EParallelForFlags::None : EParallelForFlags::ForceSingleThread;
+		ParallelFor(TEXT("BCAI.Decide"), ParallelAgents.Num(), FMath::Max(1, CVarBcAIParallelMinBatch.GetValueOnGameThread()),
+			[this](int32 k)
+			{
+				BC_AI_ALLOC_SCOPE(ParallelDecide);
+				const int32 i = ParallelAgents[k];
+				Agents.Policies[i]->ComputeMove(Agents.Contexts[i], Agents.Decisions[i]);
+			}, Flags);
+
+		// Policies con estado compartido (PathFollow: cach de rutas, reservas, escuadras)
+		for (const int32 i : SerialAgents)
+		{
+			if (!Agents.IsLive(i)) continue;
+			BC_AI_ALLOC_SCOPE(SerialDecide);
+			Agents.Policies[i]->ComputeMove(Agents.Contexts[i], Agents.Decisions[i]);
+		}
+	}
+
+	// 3) Aplicacin en orden de agente (un disparo puede dar de baja a otro: su hueco queda vaco)
+	{
+		SCOPE_CYCLE_COUNTER(STAT_BCAI_Apply);
+		for (const int32 i : DueAgents)
+		{
+			if (!Agents.IsLive(i) || !Agents.Policies[i] || !IsValid(Agents.Pawns[i])) continue;
+			BC_AI_ALLOC_SCOPE(Apply);
+			UEnemyMovementComponent* Comp = Agents.Components[i];
+			Comp->ApplyAxisLock(Agents.Decisions[i], Now);
+			Comp->ApplyDecision(Agents.Decisions[i]);
+		}
+	}
+
+	const int32 FirstMoved = Agents.EndDeferRemovals();
+	if (FirstMoved != INDEX_NONE) RenumberAgentsFrom(FirstMoved);
+
+#if BC_AI_ALLOC_COUNT
+	if (AllocCountTicksLeft > 0) FinishAllocCountTick();
+#endif
+}
@@ -0,0 +1,122 @@
+#include "Components/EnemyMovement/EnemyAIManager.h"
+#include "Components/EnemyMovement/EnemyMovementComponent.h"
+#include "Components/EnemyMovement/EnemyMovePolicies/EnemyMovePolicy_Composite.h"
+#include "Components/EnemyMovement/EnemyMovePolicies/EnemyMovePolicy_AxisPathShoot.h"
+
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "UObject/Package.h"
+
+// Composite dinmico [GridAxisLock, PathFollow, ShootWhenBlocking] contra el pipeline nativo
+// UEnemyMovePolicy_AxisPathShoot, con los contextos de los enemigos vivos. Cada uno con su propio
+// estado por agente para que las rutas de uno no contaminen al otro.
+
+namespace EnemyPipelineBench
+{
+	struct FCase
+	{
+		FMoveContext Ctx;
+		FEnemyMoveAgent DynAgent;
+		FEnemyMoveAgent NatAgent;
+	};
+
+	static double RunPass(UEnemyMovePolicy* Policy, TArray<FCase>& Cases, bool bNative, TArray<FMoveDecision>* OutDecisions)
+	{
+		FMoveDecision Out;
+		const double T0 = FPlatformTime::Seconds();
+		for (int32 i = 0; i < Cases.Num(); ++i)
+		{
+			FCase& C = Cases[i];
+			C.Ctx.Agent = bNative ? &C.NatAgent : &C.DynAgent;
+			Policy->ComputeMove(C.Ctx, Out);
+			if (OutDecisions) (*OutDecisions)[i] = Out;
+		}
+		return FPlatformTime::Seconds() - T0;
+	}
+
+	static bool SameDecision(const FMoveDecision& A, const FMoveDecision& B)
+	{
+		return A.RawMoveInput.Equals(B.RawMoveInput) && A.LockAxis == B.LockAxis
+			&& FMath::IsNearlyEqual(A.LockTime, B.LockTime) && A.bRequestFrontShot == B.bRequestFrontShot;
+	}
+}
+
+// Uso en consola: bc.ai.pipelinebench [iters=200]
+static FAutoConsoleCommandWithWorldAndArgs GCmdBC_AI_PipelineBench(
+	TEXT("bc.ai.pipelinebench"),
+	TEXT("Compara Composite dinmico vs pipeline nativo AxisPathShoot sobre los enemigos vivos. Uso: bc.ai.pipelinebench [iters=200]"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+		{
+			using namespace EnemyPipelineBench;
+			UEnemyAIManager* Manager = World ? World->GetSubsystem<UEnemyAIManager>() : nullptr;
+			if (!Manager) return;
+
+			const int32 Iters = Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : 200;
+
+			UEnemyMovePolicy_Composite* Dyn = NewObject<UEnemyMovePolicy_Composite>(GetTransientPackage());
+			Dyn->Policies.Add(NewObject<UEnemyMovePolicy_GridAxisLock>(Dyn));
+			Dyn->Policies.Add(NewObject<UEnemyMovePolicy_PathFollow>(Dyn));
+			Dyn->Policies.Add(NewObject<UEnemyMovePolicy_ShootWhenBlocking>(Dyn));
+			UEnemyMovePolicy_AxisPathShoot* Nat = NewObject<UEnemyMovePolicy_AxisPathShoot>(GetTransientPackage());
+			Dyn->Initialize(World);
+			Nat->Initialize(World);
+
+			TArray<FCase> Cases;
+			for (UEnemyMovementComponent* Comp : Manager->GetAgents().Components)
+			{
+				if (!IsValid(Comp)) continue;
+				FCase& C = Cases.AddDefaulted_GetRef();
+				Comp->BuildMoveContext(C.Ctx);
+				const FEnemyMoveAgent& Src = Comp->GetMoveAgent();
+				C.DynAgent.Component = C.NatAgent.Component = Src.Component;
+				C.DynAgent.Pawn = C.NatAgent.Pawn = Src.Pawn;
+				C.DynAgent.LODTier = C.NatAgent.LODTier = Src.LODTier;
+				Dyn->AcquireAgentState(C.DynAgent);
+				Nat->AcquireAgentState(C.NatAgent);
+			}
+			if (Cases.Num() == 0)
+			{
+				UE_LOG(LogTemp, Warning, TEXT("[AI] pipelinebench: no hay enemigos vivos"));
+				return;
+			}
+
+			// Primera pasada: calienta rutas y compara decisiones
+			TArray<FMoveDecision> DynOut, NatOut;
+			DynOut.SetNum(Cases.Num());
+			NatOut.SetNum(Cases.Num());
+			RunPass(Dyn, Cases, false, &DynOut);
+			RunPass(Nat, Cases, true, &NatOut);
+			int32 Mismatch = 0;
+			for (int32 i = 0; i < Cases.Num(); ++i)
+			{
+				if (!SameDecision(DynOut[i], NatOut[i])) ++Mismatch;
+			}
+
+			// Orden alterno para no regalar la cach a uno de los dos
+			double DynSec = 0.0, NatSec = 0.0;
+			for (int32 It = 0; It < Iters; ++It)
+			{
+				if (It & 1)
+				{
+					NatSec += RunPass(Nat, Cases, true, nullptr);
+					DynSec += RunPass(Dyn, Cases, false, nullptr);
+				}
+				else
+				{
+					DynSec += RunPass(Dyn, Cases, false, nullptr);
+					NatSec += RunPass(Nat, Cases, true, nullptr);
+				}
+			}
+
+			for (FCase& C : Cases)
+			{
+				Dyn->ReleaseAgentState(C.DynAgent);
+				Nat->ReleaseAgentState(C.NatAgent);
+			}
+
+			const double Decisions = double(Cases.Num()) * Iters;
+			const double DynNs = DynSec * 1e9 / Decisions;
+			const double NatNs = NatSec * 1e9 / Decisions;
+			UE_LOG(LogTemp, Log, TEXT("[AI] pipelinebench: agentes=%d iters=%d | composite=%.1f ns/dec | nativo=%.1f ns/dec | x%.2f | distintas=%d"),
+				Cases.Num(), Iters, DynNs, NatNs, NatNs > 0.0 ? DynNs / NatNs : 0.0, Mismatch);
+		}));
@@ -5,9 +5,53 @@
 #include "Map/MapGridSubsystem.h"
 #include "Components/EnemyMovement/EnemyMovementComponent.h"
 
-void UEnemyMovePolicy::Initialize(UEnemyMovementComponent* InOwner)
+FEnemyMoveStatePool::~FEnemyMoveStatePool()
 {
-	{ Owner = MakeWeakObjectPtr(InOwner); }
+	// Los bloques vivos ya deberan haberse devuelto (EndPlay del componente)
+	ensureMsgf(NumLive == 0, TEXT("FEnemyMoveStatePool: %d bloques sin liberar"), NumLive);
+	for (uint8* Chunk : Chunks) FMemory::Free(Chunk);
+}
+
+uint8* FEnemyMoveStatePool::Allocate()
+{
+	if (FreeList.Num() == 0)
+	{
+		uint8* Chunk = (uint8*)FMemory::Malloc((SIZE_T)BlockSize * BlocksPerChunk, 16);
+		Chunks.Add(Chunk);
+		// Al revs: el primero que sale es el del principio del trozo
+		for (int32 i = BlocksPerChunk - 1; i >= 0; --i) FreeList.Add(Chunk + (SIZE_T)i * BlockSize);
+	}
+	++NumLive;
+	return FreeList.Pop(EAllowShrinking::No);
+}
+
+void FEnemyMoveStatePool::Free(uint8* Block)
+{
+	if (!Block) return;
+	--NumLive;
+	FreeList.Add(Block);
+}
+
+void UEnemyMovePolicy::AcquireAgentState(FEnemyMoveAgent& Agent)
+{
+	check(Agent.State == nullptr);
+	if (StateSize == INDEX_NONE)
+	{
+		StateSize = LayoutState(0);
+		if (StateSize > 0) StatePool.SetBlockSize(StateSize);
+	}
+	if (StateSize <= 0) return; // sin estado (GridAxisLock, ShootWhenBlocking)
+
+	Agent.State = StatePool.Allocate();
+	ConstructState(Agent);
+}
+
+void UEnemyMovePolicy::ReleaseAgentState(FEnemyMoveAgent& Agent)
+{
+	if (!Agent.State) return;
+	DestroyState(Agent);
+	StatePool.Free(Agent.State);
+	Agent.State = nullptr;
 }
 
 bool UEnemyMovePolicy::BuildCandidateOrder(UMapGridSubsystem* Grid, TArray<FIntPoint>& Out)
@@ -22,3 +66,24 @@ bool UEnemyMovePolicy::BuildCandidateOrder(UMapGridSubsystem* Grid, TArray<FIntP
     }
     return true;
 }
+
+#if BC_AI_DEBUG_TRACE
+FString FMoveDebugTrace::ToString() const
+{
+    static const TCHAR* Names[] = {
+        TEXT("None"),
+        TEXT("Stop&Shoot Front Brick"), TEXT("Go X"), TEXT("Go Y"), TEXT("Fallback X"), TEXT("Fallback Y"),
+        TEXT("Keep X"), TEXT("Keep Y"), TEXT("Major X"), TEXT("Major Y"), TEXT("Blocked/Wait"),
+        TEXT("PathFollow"), TEXT("PathFollow (wait)"), TEXT("PathFollow (squad wait)"),
+        TEXT("WanderFar"), TEXT("ShootCheck"), TEXT("Dodge"), TEXT("DodgeShoot"),
+    };
+    FString Out;
+    for (int32 i = 0; i < Num; ++i)
+    {
+        if (i > 0) Out += TEXT(" -> ");
+        const int32 Idx = (int32)Tags[i];
+        Out += Idx < UE_ARRAY_COUNT(Names) ? Names[Idx] : TEXT("?");
+    }
+    return Out;
+}
+#endif
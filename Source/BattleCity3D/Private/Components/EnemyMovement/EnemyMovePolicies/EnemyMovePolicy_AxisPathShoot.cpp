@@ -0,0 +1,43 @@
+#include "Components/EnemyMovement/EnemyMovePolicies/EnemyMovePolicy_AxisPathShoot.h"
+
+UEnemyMovePolicy_AxisPathShoot::UEnemyMovePolicy_AxisPathShoot()
+{
+	AxisLock = CreateDefaultSubobject<UEnemyMovePolicy_GridAxisLock>(TEXT("AxisLock"));
+	PathFollow = CreateDefaultSubobject<UEnemyMovePolicy_PathFollow>(TEXT("PathFollow"));
+	Shoot = CreateDefaultSubobject<UEnemyMovePolicy_ShootWhenBlocking>(TEXT("Shoot"));
+}
+
+void UEnemyMovePolicy_AxisPathShoot::Initialize(UWorld* World)
+{
+	FPipeline::Initialize(World, AxisLock, PathFollow, Shoot);
+}
+
+void UEnemyMovePolicy_AxisPathShoot::ComputeMove(const FMoveContext& Ctx, FMoveDecision& Out)
+{
+	FPipeline::ComputeMove(Ctx, Out, AxisLock, PathFollow, Shoot);
+}
+
+bool UEnemyMovePolicy_AxisPathShoot::IsParallelSafe() const
+{
+	return FPipeline::IsParallelSafe(AxisLock, PathFollow, Shoot);
+}
+
+void UEnemyMovePolicy_AxisPathShoot::PrepareParallel()
+{
+	FPipeline::PrepareParallel(AxisLock, PathFollow, Shoot);
+}
+
+int32 UEnemyMovePolicy_AxisPathShoot::LayoutState(int32 Offset)
+{
+	return FPipeline::LayoutState(Offset, AxisLock, PathFollow, Shoot);
+}
+
+void UEnemyMovePolicy_AxisPathShoot::ConstructState(FEnemyMoveAgent& Agent) const
+{
+	FPipeline::ConstructState(Agent, AxisLock, PathFollow, Shoot);
+}
+
+void UEnemyMovePolicy_AxisPathShoot::DestroyState(FEnemyMoveAgent& Agent) const
+{
+	FPipeline::DestroyState(Agent, AxisLock, PathFollow, Shoot);
+}
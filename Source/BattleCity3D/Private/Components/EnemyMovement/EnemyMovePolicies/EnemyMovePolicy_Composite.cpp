@@ -1,34 +1,71 @@
 #include "Components/EnemyMovement/EnemyMovePolicies/EnemyMovePolicy_Composite.h"
+#include "Components/EnemyMovement/EnemyMovePolicies/EnemyMovePipeline.h"
 
-void UEnemyMovePolicy_Composite::Initialize(UEnemyMovementComponent* InOwner)
+void UEnemyMovePolicy_Composite::Initialize(UWorld* World)
 {
 	for (UEnemyMovePolicy* P : Policies)
 	{
 		if (!P) continue;
-		P->Initialize(InOwner);
+		P->Initialize(World);
+	}
+}
+
+int32 UEnemyMovePolicy_Composite::LayoutState(int32 Offset)
+{
+	for (UEnemyMovePolicy* P : Policies)
+	{
+		if (P) Offset = P->LayoutState(Offset);
+	}
+	return Offset;
+}
+
+void UEnemyMovePolicy_Composite::ConstructState(FEnemyMoveAgent& Agent) const
+{
+	for (const UEnemyMovePolicy* P : Policies)
+	{
+		if (P) P->ConstructState(Agent);
+	}
+}
+
+void UEnemyMovePolicy_Composite::DestroyState(FEnemyMoveAgent& Agent) const
+{
+	for (const UEnemyMovePolicy* P : Policies)
+	{
+		if (P) P->DestroyState(Agent);
+	}
+}
+
+bool UEnemyMovePolicy_Composite::IsParallelSafe() const
+{
+	for (const UEnemyMovePolicy* P : Policies)
+	{
+		if (P && !P->IsParallelSafe()) return false;
+	}
+	return true;
+}
+
+void UEnemyMovePolicy_Composite::PrepareParallel()
+{
+	for (UEnemyMovePolicy* P : Policies)
+	{
+		if (P) P->PrepareParallel();
 	}
 }
 
 void UEnemyMovePolicy_Composite::ComputeMove(const FMoveContext& Ctx, FMoveDecision& Out)
 {
-	FMoveDecision Accum = bStartFromEmpty ? FMoveDecision{} : Out;
+	if (bStartFromEmpty) Out.Reset();
 
+	// Sobre Out directamente: cada hija ve lo acumulado y slo se guarda la orden previa (sin copias
+	// de la decisin entera). La traza la van aadiendo las hijas.
 	for (UEnemyMovePolicy* P : Policies)
 	{
 		if (!P) continue;
-		FMoveDecision Tmp = Accum;
-		P->ComputeMove(Ctx, Tmp);
+		const EnemyMovePipeline::FPrevMove Prev = EnemyMovePipeline::Save(Out);
+
+		P->ComputeMove(Ctx, Out);
 
 		// Mezcla: priorizamos campos no triviales del ltimo que habl
-		if (!Tmp.RawMoveInput.IsNearlyZero()) Accum.RawMoveInput = Tmp.RawMoveInput;
-		if (Tmp.LockAxis != EMoveLockAxis::None) { Accum.LockAxis = Tmp.LockAxis; Accum.LockTime = Tmp.LockTime; }
-		Accum.bRequestFrontShot |= Tmp.bRequestFrontShot;
-
-		if (!Tmp.DebugText.IsEmpty())
-		{
-			if (!Accum.DebugText.IsEmpty()) Accum.DebugText.Append(TEXT(" -> "));
-			Accum.DebugText.Append(Tmp.DebugText);
-		}
+		EnemyMovePipeline::Merge(Out, Prev);
 	}
-	Out = Accum;
 }
@@ -0,0 +1,80 @@
+#include "Components/EnemyMovement/EnemyMovePolicies/EnemyMovePolicy_Dodge.h"
+#include "Components/GridPathFollow/GridSearch.h"
+#include "Projectiles/ProjectileLaneSubsystem.h"
+#include "Map/MapGridSubsystem.h"
+#include "Engine/World.h"
+#include "Engine/GameInstance.h"
+
+static FVector2D ToCardinal(const FVector& DirWorld)
+{
+	if (FMath::Abs(DirWorld.X) >= FMath::Abs(DirWorld.Y)) return FVector2D(DirWorld.X >= 0.f ? 1.f : -1.f, 0.f);
+	return FVector2D(0.f, DirWorld.Y >= 0.f ? 1.f : -1.f);
+}
+
+void UEnemyMovePolicy_Dodge::Initialize(UWorld* World)
+{
+	UGameInstance* GI = World ? World->GetGameInstance() : nullptr;
+	Grid = GI ? GI->GetSubsystem<UMapGridSubsystem>() : nullptr;
+	CostLut = FGridCostLUT(Cost);
+	Lanes = World ? World->GetSubsystem<UProjectileLaneSubsystem>() : nullptr;
+}
+
+void UEnemyMovePolicy_Dodge::ComputeMove(const FMoveContext& Ctx, FMoveDecision& Out)
+{
+	FEnemyDodgeState* S = GetState<FEnemyDodgeState>(Ctx);
+	if (!Grid || !Lanes || !S) return;
+
+	auto ApplyDodge = [S, &Out](float Remaining)
+		{
+			Out.RawMoveInput = S->DodgeInput;
+			Out.LockAxis = S->DodgeInput.X != 0.f ? EMoveLockAxis::X : EMoveLockAxis::Y;
+			Out.LockTime = Remaining;
+			Out.Debug.Add(EMoveDebugTag::Dodge);
+		};
+
+	const float Now = (float)Ctx.Now;
+	if (Now < S->DodgeUntil)
+	{
+		ApplyDodge(S->DodgeUntil - Now);
+		return;
+	}
+
+	int32 X, Y;
+	if (!Grid->WorldToGrid(Ctx.Location, X, Y)) return;
+	const FIntPoint Cell(X, Y);
+
+	FProjectileLaneEntry Incoming;
+	float Arrival = 0.f;
+	if (!Lanes->GetIndex().FindIncoming(Cell, EProjectileTeam::Player, ReactSeconds, Incoming, Arrival)) return;
+
+	// Lados perpendiculares a la bala; primero el que acerca al objetivo
+	const FVector Here = Grid->GridToWorld(X, Y);
+	FIntPoint Side = GridSearch::Dir4[(Incoming.Dir + 1) & 3];
+	if (FVector::DotProduct(Grid->GridToWorld(X + Side.X, Y + Side.Y) - Here, Ctx.TargetWorld - Here) < 0.f) Side = FIntPoint(-Side.X, -Side.Y);
+
+	const FIntPoint Options[2] = { Side, FIntPoint(-Side.X, -Side.Y) };
+	for (const FIntPoint& D : Options)
+	{
+		const FIntPoint N = Cell + D;
+		if (!Grid->IsPassableCell(N, CostLut)) continue;
+		// Libre tambin mientras dura el paso lateral
+		if (Lanes->IsCellInFireLane(N, ReactSeconds + CommitSeconds, EProjectileTeam::Player)) continue;
+
+		S->DodgeInput = ToCardinal(Grid->GridToWorld(N.X, N.Y) - Here);
+		S->DodgeUntil = Now + CommitSeconds;
+		ApplyDodge(CommitSeconds);
+		return;
+	}
+
+	// Sin hueco: si viene de frente, bala contra bala
+	if (bShootIncoming && Ctx.bFireReady)
+	{
+		const FIntPoint Back = GridSearch::Dir4[(Incoming.Dir + 2) & 3];
+		const FVector2D ToBullet = ToCardinal(Grid->GridToWorld(X + Back.X, Y + Back.Y) - Here);
+		if (ToBullet.Equals(ToCardinal(FVector(Ctx.FacingDir, 0.f))))
+		{
+			Out.bRequestFrontShot = true;
+			Out.Debug.Add(EMoveDebugTag::DodgeShoot);
+		}
+	}
+}
@@ -3,20 +3,20 @@
 
 void UEnemyMovePolicy_GridAxisLock::ComputeMove(const FMoveContext& Ctx, FMoveDecision& Out)
 {
-    Out = FMoveDecision{};
+    Out.ResetMove();
     const float Tile = Ctx.TileSize;
 
     // 0) Stop & Shoot si hay Brick inmediato al frente
-    if (Owner.IsValid() && Owner->bPreferShootWhenFrontBrick)
+    if (Ctx.bPreferShootWhenFrontBrick)
     {
         const uint8 Front = Ctx.FrontObstacle(Tile * FMath::Max(1, Ctx.LookAheadTiles), nullptr);
         if (Front == 1 /*Brick*/)
         {
             Out.RawMoveInput = FVector2D::ZeroVector;
             Out.LockAxis = (FMath::Abs(Ctx.FacingDir.X) >= FMath::Abs(Ctx.FacingDir.Y)) ? EMoveLockAxis::X : EMoveLockAxis::Y;
-            Out.LockTime = Owner->MinLockTime;
+            Out.LockTime = Ctx.MinLockTime;
             Out.bRequestFrontShot = Ctx.bFireReady; // disparamos en este tick si listo
-            Out.DebugText = TEXT("Stop&Shoot Front Brick");
+            Out.Debug.Add(EMoveDebugTag::StopShootFrontBrick);
             return;
         }
     }
@@ -28,12 +28,12 @@ void UEnemyMovePolicy_GridAxisLock::ComputeMove(const FMoveContext& Ctx, FMoveDe
 
     auto TryAxis = [&](bool bAxisX, int Dir)->bool
         {
-            if (!Ctx.IsAheadBlocked) return false;
+            if (!Ctx.HasQueries()) return false;
             if (!Ctx.IsAheadBlocked(bAxisX, Dir, Tile * Ctx.LookAheadTiles))
             {
                 Out.RawMoveInput = bAxisX ? FVector2D(Dir, 0) : FVector2D(0, Dir);
                 Out.LockAxis = bAxisX ? EMoveLockAxis::X : EMoveLockAxis::Y;
-                Out.LockTime = Owner.IsValid() ? Owner->MinLockTime : 0.25f;
+                Out.LockTime = Ctx.MinLockTime;
                 return true;
             }
             return false;
@@ -43,19 +43,19 @@ void UEnemyMovePolicy_GridAxisLock::ComputeMove(const FMoveContext& Ctx, FMoveDe
     if (!AlignedX)
     {
         const int DirX = FMath::Sign(To.X);
-        if (TryAxis(true, DirX)) { Out.DebugText = TEXT("Go X"); return; }
+        if (TryAxis(true, DirX)) { Out.Debug.Add(EMoveDebugTag::GoX); return; }
         if (!AlignedY)
         {
             const int DirY = FMath::Sign(To.Y);
-            if (TryAxis(false, DirY)) { Out.DebugText = TEXT("Fallback Y"); return; }
+            if (TryAxis(false, DirY)) { Out.Debug.Add(EMoveDebugTag::FallbackY); return; }
         }
     }
     else if (!AlignedY)
     {
         const int DirY = FMath::Sign(To.Y);
-        if (TryAxis(false, DirY)) { Out.DebugText = TEXT("Go Y"); return; }
+        if (TryAxis(false, DirY)) { Out.Debug.Add(EMoveDebugTag::GoY); return; }
         const int DirX = FMath::Sign(To.X);
-        if (TryAxis(true, DirX)) { Out.DebugText = TEXT("Fallback X"); return; }
+        if (TryAxis(true, DirX)) { Out.Debug.Add(EMoveDebugTag::FallbackX); return; }
     }
     else
     {
@@ -67,23 +67,23 @@ void UEnemyMovePolicy_GridAxisLock::ComputeMove(const FMoveContext& Ctx, FMoveDe
             if (FMath::Abs(Ctx.FacingDir.X) >= FMath::Abs(Ctx.FacingDir.Y))
             {
                 const int DirX = (Ctx.FacingDir.X >= 0.f) ? +1 : -1;
-                if (TryAxis(true, DirX)) { Out.DebugText = TEXT("Keep X"); return; }
+                if (TryAxis(true, DirX)) { Out.Debug.Add(EMoveDebugTag::KeepX); return; }
             }
             else
             {
                 const int DirY = (Ctx.FacingDir.Y >= 0.f) ? +1 : -1;
-                if (TryAxis(false, DirY)) { Out.DebugText = TEXT("Keep Y"); return; }
+                if (TryAxis(false, DirY)) { Out.Debug.Add(EMoveDebugTag::KeepY); return; }
             }
         }
         else if (FMath::Abs(To.X) > FMath::Abs(To.Y))
         {
             const int DirX = FMath::Sign(To.X);
-            if (TryAxis(true, DirX)) { Out.DebugText = TEXT("Major X"); return; }
+            if (TryAxis(true, DirX)) { Out.Debug.Add(EMoveDebugTag::MajorX); return; }
         }
         else
         {
             const int DirY = FMath::Sign(To.Y);
-            if (TryAxis(false, DirY)) { Out.DebugText = TEXT("Major Y"); return; }
+            if (TryAxis(false, DirY)) { Out.Debug.Add(EMoveDebugTag::MajorY); return; }
         }
     }
 
@@ -93,12 +93,12 @@ void UEnemyMovePolicy_GridAxisLock::ComputeMove(const FMoveContext& Ctx, FMoveDe
     Out.LockTime = 0.f;
 
     // 4) Si est cardinal con la meta y claro/brick, sugiere disparo (policy no fuerza, solo sugiere)
-    if (Owner.IsValid())
+    if (Ctx.HasQueries())
     {
         const uint8 LOS = Ctx.CardinalLineToTarget(Ctx.Location, Ctx.TargetWorld, nullptr);
         if (LOS == 1 /*Clear*/ || LOS == 2 /*Brick*/)
             Out.bRequestFrontShot = Ctx.bFireReady;
     }
 
-    Out.DebugText = TEXT("Blocked/Wait");
+    Out.Debug.Add(EMoveDebugTag::BlockedWait);
 }
@@ -1,56 +1,40 @@
 #include "Components/EnemyMovement/EnemyMovePolicies/EnemyMovePolicy_PathFollow.h"
-#include "Components/GridPathFollow/GridPathFollowComponent.h"
 #include "Components/GridPathFollow/GridPathManager.h"
+#include "Components/GridPathFollow/GridSearch.h"
 #include "Map/MapGridSubsystem.h"
 
 #include "Engine/World.h"
 #include "Engine/GameInstance.h"
-#include "Components/ActorComponent.h"
-#include "GameFramework/Actor.h"
-#include "Kismet/GameplayStatics.h"
 #include "Components/EnemyMovement/EnemyMovementComponent.h"
+#include "Enemies/EnemyPawn.h"
+#include "Common/BattleTankPawn.h"
+#include "Spawner/EnemySquad.h"
 
-void UEnemyMovePolicy_PathFollow::Initialize(UEnemyMovementComponent* InOwner)
+void UEnemyMovePolicy_PathFollow::Initialize(UWorld* World)
 {
-	Super::Initialize(InOwner);
-	EnemyMoveOwner = MakeWeakObjectPtr(InOwner);
+	UGameInstance* GI = World ? World->GetGameInstance() : nullptr;
+	Grid = GI ? GI->GetSubsystem<UMapGridSubsystem>() : nullptr;
+	PathMgr = GI ? GI->GetSubsystem<UGridPathManager>() : nullptr;
 }
 
-void UEnemyMovePolicy_PathFollow::EnsureDeps(const FMoveContext& Ctx)
+void UEnemyMovePolicy_PathFollow::DestroyState(FEnemyMoveAgent& Agent) const
 {
-	// Grid desde el MovementComponent
-	if (!Grid && EnemyMoveOwner.IsValid())
+	FEnemyPathFollowState& S = StateOf<FEnemyPathFollowState>(Agent);
+	if (S.CoopAgent != 0 && IsValid(PathMgr))
 	{
-		Grid = EnemyMoveOwner->GetGrid();
-	}
-
-	// PathMgr
-	if (!PathMgr && EnemyMoveOwner.IsValid())
-	{
-		if (UWorld* W = EnemyMoveOwner->GetWorld())
-		{
-			if (UGameInstance* GI = W->GetGameInstance())
-			{
-				PathMgr = GI->GetSubsystem<UGridPathManager>();
-			}
-		}
-	}
-
-	// Follower en el Owner actor
-	if (!Follower && EnemyMoveOwner.IsValid())
-	{
-		if (AActor* OwnerActor = EnemyMoveOwner->GetOwner())
-		{
-			Follower = OwnerActor->FindComponentByClass<UGridPathFollowComponent>();
-			if (!Follower)
-			{
-				Follower = NewObject<UGridPathFollowComponent>(OwnerActor, UGridPathFollowComponent::StaticClass(), NAME_None, RF_Transactional);
-				Follower->RegisterComponent();
-			}
-		}
+		PathMgr->UnregisterCooperativeAgent(S.CoopAgent);
 	}
+	DestroyStateAs<FEnemyPathFollowState>(Agent);
 }
 
+void UEnemyMovePolicy_PathFollow::SetSquad(FEnemyMoveAgent& Agent, const TSharedPtr<FEnemySquad>& InSquad) const
+{
+	if (!Agent.State) return;
+	FEnemyPathFollowState& S = StateOf<FEnemyPathFollowState>(Agent);
+	S.Squad = InSquad;
+	S.SquadRouteVersion = 0;
+	S.bFollowingSquad = false;
+}
 
 bool UEnemyMovePolicy_PathFollow::TryWorldToGrid(const FVector& World, FIntPoint& OutCell) const
 {
@@ -61,17 +45,18 @@ bool UEnemyMovePolicy_PathFollow::TryWorldToGrid(const FVector& World, FIntPoint
 	return true;
 }
 
-void UEnemyMovePolicy_PathFollow::MaybeReplan(const FMoveContext& Ctx, const FIntPoint& StartCell, const FIntPoint& GoalCell)
+void UEnemyMovePolicy_PathFollow::MaybeReplan(FEnemyPathFollowState& S, const FMoveContext& Ctx, const FIntPoint& StartCell, const FIntPoint& GoalCell) const
 {
 	if (!PathMgr || !Grid) return;
 
-	const float Now = (EnemyMoveOwner.IsValid() && EnemyMoveOwner->GetWorld())
-		? EnemyMoveOwner->GetWorld()->GetTimeSeconds() : 0.f;
+	const float Now = (float)Ctx.Now;
+	const EEnemyAILOD LODTier = Ctx.Agent->LODTier;
 
-	const bool bGoalMoved = (FMath::Abs(GoalCell.X - LastGoalCell.X) + FMath::Abs(GoalCell.Y - LastGoalCell.Y)) >= ReplanDistCells;
-	const bool bTime = (Now - LastReplanTime) >= ReplanInterval;
+	const bool bGoalMoved = (FMath::Abs(GoalCell.X - S.LastGoalCell.X) + FMath::Abs(GoalCell.Y - S.LastGoalCell.Y)) >= ReplanDistCells;
+	const float Scale = LODTier == EEnemyAILOD::Low ? LowReplanScale : (LODTier == EEnemyAILOD::Medium ? MediumReplanScale : 1.f);
+	const bool bTime = (Now - S.LastReplanTime) >= ReplanInterval * Scale;
 
-	if (!Follower || !Follower->HasPath() || bGoalMoved || bTime)
+	if (!S.Follower.HasPath() || bGoalMoved || bTime)
 	{
 		FGridPathRequest Req;
 		Req.Grid = Grid;
@@ -80,17 +65,197 @@ void UEnemyMovePolicy_PathFollow::MaybeReplan(const FMoveContext& Ctx, const FIn
 		Req.Cost = Cost;
 		Req.MaxSteps = bTargetIsPlayer ? FMath::Max(0, HorizonSteps) : 0;
 		Req.bAllowPartial = true;
+		ApplyTurnModel(Ctx, Req);
 
-		FGridPathResult Res;
-		if (PathMgr->ComputePath(Req, Res) && Res.bValid)
+		// Ruta compartida: enemigos con el mismo origen/destino reutilizan la de la cach
+		if (FGridPathRef Res = PathMgr->ComputePathShared(Req))
 		{
-			Follower->SetPath(Grid, Res);
-			LastGoalCell = GoalCell;
-			LastReplanTime = Now;
+			S.Follower.SetSharedPath(Res);
+			S.LastGoalCell = GoalCell;
+			// Primera ruta: desfase aleatorio para que una tanda no replanifique siempre a la vez
+			S.LastReplanTime = S.bHasPlanned ? Now : Now - FMath::FRand() * ReplanInterval;
+			S.bHasPlanned = true;
+			PublishToSquad(S, Ctx, Res, GoalCell);
 		}
 	}
 }
 
+void UEnemyMovePolicy_PathFollow::ApplyTurnModel(const FMoveContext& Ctx, FGridPathRequest& Req) const
+{
+	if (!bTurnAware || Ctx.Agent->LODTier != EEnemyAILOD::High || !Grid) return;
+	const ABattleTankPawn* Tank = Ctx.Agent->Pawn;
+	if (!Tank) return;
+
+	Req.Cost.TurnCost = Tank->GetTurnPathCost(Grid->GetTileSize(), Cost.FreeCost) * TurnCostScale;
+
+	// Direccin de Dir4 (ejes del grid en mundo) ms parecida a la del tanque
+	const FVector Origin = Grid->GridToWorld(0, 0);
+	const FVector AxisX = (Grid->GridToWorld(1, 0) - Origin).GetSafeNormal2D();
+	const FVector AxisY = (Grid->GridToWorld(0, 1) - Origin).GetSafeNormal2D();
+	const FVector Facing(Ctx.FacingDir, 0.f);
+	float BestDot = -2.f;
+	for (int32 D = 0; D < 4; ++D)
+	{
+		const FIntPoint& G = GridSearch::Dir4[D];
+		const float Dot = FVector::DotProduct(AxisX * G.X + AxisY * G.Y, Facing);
+		if (Dot > BestDot) { BestDot = Dot; Req.StartDir = D; }
+	}
+}
+
+void UEnemyMovePolicy_PathFollow::MaybeRefineNextSegment(FEnemyPathFollowState& S, const FMoveContext& Ctx, const FIntPoint& GoalCell) const
+{
+	// HPA*: el tramo actual se acaba -> refinar el siguiente sin replanificar entero
+	if (!S.Follower.IsAtLastCell() || !S.Follower.HasPendingSegments()) return;
+
+	const FGridPath& Current = *S.Follower.GetPath();
+
+	FGridPathRequest Req;
+	Req.Grid = Grid;
+	Req.Start = Current.GetEndCell();
+	Req.Goal = GoalCell;
+	Req.Cost = Cost;
+
+	if (FGridPathRef Next = PathMgr->RefineNextSegmentShared(Req, Current))
+	{
+		S.Follower.ContinueWith(Next);
+		PublishToSquad(S, Ctx, Next, GoalCell);
+	}
+	else
+	{
+		// El tramo ya no es transitable (mapa cambi): fuerza replan en el prximo tick
+		S.LastReplanTime = -1000.f;
+	}
+}
+
+bool UEnemyMovePolicy_PathFollow::UpdateCooperativePlan(FEnemyPathFollowState& S, const FMoveContext& Ctx, const FIntPoint& StartCell, const FIntPoint& GoalCell) const
+{
+	const int64 Tick = PathMgr->GetCooperativeTick(Ctx.Now);
+
+	if (S.CoopAgent == 0) S.CoopAgent = PathMgr->RegisterCooperativeAgent();
+	if (S.CoopAgent == 0) return false;
+
+	// Fuera de plan si la celda actual no coincide con la prevista (1 tick de holgura)
+	const int32 Offset = (int32)(Tick - S.CoopPlanTick);
+	auto PlanHas = [&S, &StartCell](int32 i) { return S.CoopPlan.IsValidIndex(i) && S.CoopPlan[i] == StartCell; };
+	const bool bOnPlan = PlanHas(Offset) || PlanHas(Offset - 1) || PlanHas(Offset + 1);
+	const bool bGoalMoved = (FMath::Abs(GoalCell.X - S.LastGoalCell.X) + FMath::Abs(GoalCell.Y - S.LastGoalCell.Y)) >= ReplanDistCells;
+
+	// Plan recortado (sin reserva para el siguiente tick): replan antes de quedarse sin l
+	const bool bPlanEnding = Offset + 1 >= S.CoopPlan.Num();
+
+	if (!bOnPlan || bGoalMoved || bPlanEnding || Tick >= S.CoopNextReplanTick || !S.Follower.HasPath())
+	{
+		FGridPathRequest Req;
+		Req.Grid = Grid;
+		Req.Start = StartCell;
+		Req.Goal = GoalCell;
+		Req.Cost = Cost;
+		Req.bAllowPartial = true;
+
+		PathMgr->ComputeCooperativePath(Req, S.CoopAgent, Tick, S.CoopPlan);
+		S.CoopPlanTick = Tick;
+		S.CoopNextReplanTick = PathMgr->GetNextCooperativeReplanTick(S.CoopAgent, Tick);
+		S.LastGoalCell = GoalCell;
+
+		// El seguidor recorre las celdas; las esperas se fusionan y se aplican abajo
+		S.Follower.SetSharedPath(FGridPath::Make(S.CoopPlan, Grid));
+	}
+
+	// Esperar: el plan sigue en la celda actual en el siguiente tick
+	const int32 PlanOffset = (int32)(Tick - S.CoopPlanTick);
+	return S.CoopPlan.IsValidIndex(PlanOffset + 1) && S.CoopPlan[PlanOffset] == StartCell && S.CoopPlan[PlanOffset + 1] == StartCell
+		&& StartCell != GoalCell;
+}
+
+void UEnemyMovePolicy_PathFollow::PublishToSquad(const FEnemyPathFollowState& S, const FMoveContext& Ctx, const FGridPathRef& Path, const FIntPoint& GoalCell) const
+{
+	if (!S.Squad.IsValid()) return;
+	if (S.Squad->GetSlot(Ctx.Agent->Pawn) == 0) S.Squad->PublishLeaderPath(Path, GoalCell);
+}
+
+bool UEnemyMovePolicy_PathFollow::UpdateSquad(FEnemyPathFollowState& S, const FMoveContext& Ctx, const FIntPoint& StartCell, const FIntPoint& GoalCell) const
+{
+	if (!S.Squad.IsValid()) return false;
+	FEnemySquad* Squad = S.Squad.Get();
+
+	Squad->Prune();
+	const int32 Slot = Squad->GetSlot(Ctx.Agent->Pawn);
+	if (Slot == INDEX_NONE) { S.Squad.Reset(); return false; }
+
+	// El lder planifica como siempre (MaybeReplan publica) y deja rastro para los rezagados
+	if (Slot == 0)
+	{
+		Squad->RecordLeaderCell(StartCell);
+		S.bFollowingSquad = false;
+		return false;
+	}
+
+	// Otra meta que la del lder (la poltica de objetivos la cambi): por su cuenta
+	const FIntPoint LeaderGoal = Squad->GetGoalCell();
+	const bool bSameGoal = (FMath::Abs(GoalCell.X - LeaderGoal.X) + FMath::Abs(GoalCell.Y - LeaderGoal.Y)) <= SquadDivergeCells;
+	if (!Squad->GetLeaderPath().IsValid() || !bSameGoal)
+	{
+		S.bFollowingSquad = false;
+		return false;
+	}
+
+	// Recorrido nuevo si el lder public otra ruta; divergencia slo cada ReplanInterval
+	const float Now = (float)Ctx.Now;
+	const bool bStale = S.bFollowingSquad && (S.SquadRouteVersion != Squad->GetVersion() || !S.Follower.HasPath());
+	if (!bStale && (Now - S.LastSquadCheckTime) < ReplanInterval) return S.bFollowingSquad;
+	S.LastSquadCheckTime = Now;
+
+	if (!Squad->BuildFollowerRoute(StartCell, SquadDivergeCells, S.SquadRoute) || !BridgeToSquadRoute(S, StartCell))
+	{
+		// Se alej del rastro: replan individual inmediato hasta volver a acercarse
+		if (S.bFollowingSquad) S.LastReplanTime = -1000.f;
+		S.bFollowingSquad = false;
+		return false;
+	}
+
+	S.Follower.SetSharedPath(FGridPath::Make(S.SquadRoute, Grid));
+	S.SquadRouteVersion = Squad->GetVersion();
+	S.LastGoalCell = GoalCell;
+	S.bFollowingSquad = true;
+	return true;
+}
+
+bool UEnemyMovePolicy_PathFollow::BridgeToSquadRoute(FEnemyPathFollowState& S, const FIntPoint& StartCell) const
+{
+	if (S.SquadRoute[0] == StartCell) return true;
+	if (!PathMgr) return false;
+
+	// Hueco hasta la celda de unin: A* corto con el mismo coste; si da mucha vuelta, por su cuenta
+	FGridPathRequest Req;
+	Req.Grid = Grid;
+	Req.Start = StartCell;
+	Req.Goal = S.SquadRoute[0];
+	Req.Cost = Cost;
+	Req.MaxExpansions = FMath::Square(SquadDivergeCells * 2 + 1); // el entorno del hueco
+	Req.bAllowPartial = false;
+	Req.Planner = EGridPathPlanner::AStar;
+
+	FGridPathResult Bridge;
+	if (!PathMgr->ComputePath(Req, Bridge) || !Bridge.bReachedGoal || Bridge.Cells.Num() < 2) return false;
+	S.SquadRoute.Insert(Bridge.Cells.GetData(), Bridge.Cells.Num() - 1, 0);
+	return true;
+}
+
+bool UEnemyMovePolicy_PathFollow::IsBlockedBySquadmate(const FEnemyPathFollowState& S, const FMoveContext& Ctx) const
+{
+	if (!S.Squad.IsValid()) return false;
+
+	const int32 Slot = S.Squad->GetSlot(Ctx.Agent->Pawn);
+	const AEnemyPawn* Ahead = Slot > 0 ? S.Squad->GetMember(Slot - 1) : nullptr;
+	if (!Ahead) return false;
+
+	const FVector ToAhead = Ahead->GetActorLocation() - Ctx.Location;
+	if (ToAhead.SizeSquared2D() > FMath::Square(SquadSpacingCells * Ctx.TileSize)) return false;
+
+	// Slo frena si avanzar lo acerca ms (si el de delante vuelve, se aparta)
+	return FVector::DotProduct(S.Follower.GetDesiredDirWorld(Ctx.Location), ToAhead) > 0.f;
+}
+
 FVector2D UEnemyMovePolicy_PathFollow::ToCardinalInput(const FVector& DirWorld)
 {
 	// DirWorld cardinal (1,0,0) o (0,1,0) segn eje dominante
@@ -102,22 +267,47 @@ FVector2D UEnemyMovePolicy_PathFollow::ToCardinalInput(const FVector& DirWorld)
 
 void UEnemyMovePolicy_PathFollow::ComputeMove(const FMoveContext& Ctx, FMoveDecision& Out)
 {
-	Out.DebugText = TEXT("PathFollow");
-	EnsureDeps(Ctx);
+	Out.Debug.Add(EMoveDebugTag::PathFollow);
 
-	if (!Grid || !PathMgr || !Follower) return;
+	FEnemyPathFollowState* S = GetState<FEnemyPathFollowState>(Ctx);
+	if (!Grid || !PathMgr || !S) return;
+	FGridPathFollower& Follower = S->Follower;
 
 	// Celdas start/goal desde world
 	FIntPoint StartCell, GoalCell;
 	if (!TryWorldToGrid(Ctx.Location, StartCell)) return;
 	if (!TryWorldToGrid(Ctx.TargetWorld, GoalCell)) return;
 
-	// Replanificacin (parcial si objetivo mvil)
-	MaybeReplan(Ctx, StartCell, GoalCell);
+	bool bWait = false;
+	if (bCooperative)
+	{
+		bWait = UpdateCooperativePlan(*S, Ctx, StartCell, GoalCell);
+		Follower.AdvanceIfReached(Ctx.Location, Ctx.AlignEpsilon);
+	}
+	else if (UpdateSquad(*S, Ctx, StartCell, GoalCell))
+	{
+		// Seguidor de escuadra: ruta del lder, sin bsqueda propia
+		Follower.AdvanceIfReached(Ctx.Location, Ctx.AlignEpsilon);
+		bWait = IsBlockedBySquadmate(*S, Ctx);
+	}
+	else
+	{
+		// Replanificacin (parcial si objetivo mvil)
+		MaybeReplan(*S, Ctx, StartCell, GoalCell);
+
+		// Avance y direccin cardinal
+		Follower.AdvanceIfReached(Ctx.Location, Ctx.AlignEpsilon);
+		MaybeRefineNextSegment(*S, Ctx, GoalCell);
+	}
 
-	// Avance y direccin cardinal
-	Follower->AdvanceIfReached(Ctx.Location, Ctx.TileSize, Ctx.AlignEpsilon);
-	const FVector DesiredDirWorld = Follower->GetDesiredDirWorld(Ctx.Location, Ctx.TileSize);
+	if (bWait)
+	{
+		// Cediendo el paso: otro enemigo tiene reservada la celda siguiente (o el de delante est muy cerca)
+		Out.Debug.Add(S->bFollowingSquad ? EMoveDebugTag::PathFollowSquadWait : EMoveDebugTag::PathFollowWait);
+		Out.RawMoveInput = FVector2D::ZeroVector;
+		return;
+	}
+	const FVector DesiredDirWorld = Follower.GetDesiredDirWorld(Ctx.Location);
 
 	Out.RawMoveInput = ToCardinalInput(DesiredDirWorld);
 	// LockAxis opcional (podemos dejar None; lo ajustaremos si quieres conservar axis-lock)
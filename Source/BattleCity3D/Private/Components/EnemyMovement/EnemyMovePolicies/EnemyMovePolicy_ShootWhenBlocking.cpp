@@ -1,8 +1,19 @@
 #include "Components/EnemyMovement/EnemyMovePolicies/EnemyMovePolicy_ShootWhenBlocking.h"
+#include "Map/MapGridSubsystem.h"
+#include "Map/MapTopologySubsystem.h"
+#include "Engine/World.h"
+#include "Engine/GameInstance.h"
+
+void UEnemyMovePolicy_ShootWhenBlocking::Initialize(UWorld* World)
+{
+	UGameInstance* GI = World ? World->GetGameInstance() : nullptr;
+	Grid = GI ? GI->GetSubsystem<UMapGridSubsystem>() : nullptr;
+	Topo = GI ? GI->GetSubsystem<UMapTopologySubsystem>() : nullptr;
+}
 
 void UEnemyMovePolicy_ShootWhenBlocking::ComputeMove(const FMoveContext& Ctx, FMoveDecision& Out)
 {
-	Out.DebugText += TEXT(" +ShootCheck");
+	Out.Debug.Add(EMoveDebugTag::ShootCheck);
 
 	if (!Ctx.bFireReady) return;
 	if (!IsFrontBrick(Ctx)) return;
@@ -11,17 +22,37 @@ void UEnemyMovePolicy_ShootWhenBlocking::ComputeMove(const FMoveContext& Ctx, FM
 	Out.RawMoveInput = FVector2D::ZeroVector;
 }
 
+void UEnemyMovePolicy_ShootWhenBlocking::PrepareParallel()
+{
+	// La topologa se pone al da al consultarla: que no lo haga un hilo del ParallelFor
+	if (bOnlyBreachBricks && Topo) Topo->GetTopology();
+}
+
 bool UEnemyMovePolicy_ShootWhenBlocking::IsFrontBrick(const FMoveContext& Ctx) const
 {
-	if (!Ctx.FrontObstacle) return false;
+	if (!Ctx.HasQueries()) return false;
 
 	FVector Hit;
 	const uint8 Type = Ctx.FrontObstacle(Ctx.TileSize * 0.51f, &Hit);
 	// Convencin dada: 0=None, 1=Brick, 2=Steel
-	if (Type == 1) return true;
+	if (Type == 1) return !bOnlyBreachBricks || IsBreachTarget(Ctx, Hit);
 
 	// Si tu FrontObstacle no usa distancias, puedes ajustar a:
 	// const uint8 Type = Ctx.FrontObstacle(0.f, &Hit);
 
 	return false;
 }
+
+bool UEnemyMovePolicy_ShootWhenBlocking::IsBreachTarget(const FMoveContext& Ctx, const FVector& HitWorld) const
+{
+	if (!Topo || !Grid) return true;
+
+	// Con ruta abierta a la base no hay brecha que respetar
+	int32 X, Y;
+	if (!Grid->WorldToGrid(Ctx.Location, X, Y) || Topo->GetBricksToBase(FIntPoint(X, Y)) == 0) return true;
+
+	// El impacto cae en el borde del ladrillo: un poco hacia dentro
+	const FVector Inside = HitWorld + FVector(Ctx.FacingDir, 0.f) * (Ctx.TileSize * 0.25f);
+	if (!Grid->WorldToGrid(Inside, X, Y)) return false;
+	return Topo->IsBreachBrick(FIntPoint(X, Y));
+}
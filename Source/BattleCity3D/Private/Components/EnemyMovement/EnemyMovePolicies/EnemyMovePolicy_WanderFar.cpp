@@ -2,39 +2,37 @@
 #include "Components/EnemyMovement/EnemyMovementComponent.h"
 #include "Map/MapGridSubsystem.h"
 #include "Enemies/EnemyPawn.h"
-#include "Kismet/GameplayStatics.h"
+#include "Engine/World.h"
+#include "Engine/GameInstance.h"
 
-void UEnemyMovePolicy_WanderFar::Initialize(UEnemyMovementComponent* InOwner)
+void UEnemyMovePolicy_WanderFar::Initialize(UWorld* World)
 {
-	Super::Initialize(InOwner);
-	MoveOwner = MakeWeakObjectPtr(InOwner);
-	if (InOwner) { 
-		Pawn = MakeWeakObjectPtr(InOwner->GetPawn()); 
-		Grid = MakeWeakObjectPtr(InOwner->GetGrid()); 
-	}
+	UGameInstance* GI = World ? World->GetGameInstance() : nullptr;
+	Grid = GI ? GI->GetSubsystem<UMapGridSubsystem>() : nullptr;
+	CostLut = FGridCostLUT(Cost);
 }
 
-bool UEnemyMovePolicy_WanderFar::IsHuntPlayer() const
+void UEnemyMovePolicy_WanderFar::ConstructState(FEnemyMoveAgent& Agent) const
 {
-	if (!Pawn.IsValid()) return true; // por seguridad, tratamos como player
-	return (Pawn->Goal == EEnemyGoal::HuntPlayer);
+	ConstructStateAs<FEnemyWanderState>(Agent);
+	StateOf<FEnemyWanderState>(Agent).Rng.Initialize(FMath::Rand());
 }
 
 bool UEnemyMovePolicy_WanderFar::IsPassableAhead(const FIntPoint& From, const FVector2D& Dir) const
 {
-	if (!Grid.IsValid()) return false;
+	if (!Grid) return false;
 	const FIntPoint N(From.X + Sign01(Dir.X), From.Y + Sign01(Dir.Y));
-	return Grid->IsPassableCell(N, Cost);
+	return Grid->IsPassableCell(N, CostLut);
 }
 
-int UEnemyMovePolicy_WanderFar::ScoreDir(const FIntPoint& From, const FVector2D& Dir, const FIntPoint& GoalCell) const
+int UEnemyMovePolicy_WanderFar::ScoreDir(FEnemyWanderState& S, const FIntPoint& From, const FVector2D& Dir, const FIntPoint& GoalCell) const
 {
-	if (!Grid.IsValid()) return -1000000;
+	if (!Grid) return -1000000;
 	const FIntPoint N(From.X + Sign01(Dir.X), From.Y + Sign01(Dir.Y));
-	if (!Grid->IsPassableCell(N, Cost)) return -1000000;
+	if (!Grid->IsPassableCell(N, CostLut)) return -1000000;
 
 	// Base: aleatorio ligero
-	int Score = FMath::RandRange(0, 10);
+	int Score = S.Rng.RandRange(0, 10);
 
 	// Sesgo: reducir distancia Manhattan al objetivo
 	if (bBiasTowardTarget)
@@ -46,30 +44,31 @@ int UEnemyMovePolicy_WanderFar::ScoreDir(const FIntPoint& From, const FVector2D&
 	return Score;
 }
 
-void UEnemyMovePolicy_WanderFar::ChooseNewDir(const FMoveContext& Ctx, const FIntPoint& FromCell, const FIntPoint& GoalCell)
+void UEnemyMovePolicy_WanderFar::ChooseNewDir(FEnemyWanderState& S, const FMoveContext& Ctx, const FIntPoint& FromCell, const FIntPoint& GoalCell) const
 {
-	TArray<FVector2D> Dirs = { FVector2D(1,0), FVector2D(-1,0), FVector2D(0,1), FVector2D(0,-1) };
+	static const FVector2D Dirs[4] = { FVector2D(1,0), FVector2D(-1,0), FVector2D(0,1), FVector2D(0,-1) };
 	int BestScore = -1000000; FVector2D Best = FVector2D::ZeroVector;
 
 	// Valora cada direccin
 	for (const FVector2D& D : Dirs)
 	{
-		const int S = ScoreDir(FromCell, D, GoalCell);
-		if (S > BestScore) { BestScore = S; Best = D; }
+		const int Score = ScoreDir(S, FromCell, D, GoalCell);
+		if (Score > BestScore) { BestScore = Score; Best = D; }
 	}
 
 	// Si todo invlido (encerrado), dejamos cero y policy no emitir input
-	CurrentDir = Best;
-	StepsLeft = (BestScore <= -1000000) ? 0 : FMath::RandRange(MinStrideCells, MaxStrideCells);
-	NextRechooseTime = UGameplayStatics::GetTimeSeconds(this) + 0.5; // cooldown ligero
+	S.CurrentDir = Best;
+	S.StepsLeft = (BestScore <= -1000000) ? 0 : S.Rng.RandRange(MinStrideCells, MaxStrideCells);
+	S.NextRechooseTime = Ctx.Now + 0.5; // cooldown ligero
 }
 
 void UEnemyMovePolicy_WanderFar::ComputeMove(const FMoveContext& Ctx, FMoveDecision& Out)
 {
-	if (!Grid.IsValid() || !MoveOwner.IsValid()) return;
+	FEnemyWanderState* S = GetState<FEnemyWanderState>(Ctx);
+	if (!Grid || !S) return;
 
-	// Slo aplica para perseguir jugador
-	if (!IsHuntPlayer()) return;
+	// Slo aplica para perseguir jugador (sin pawn, por seguridad, como si lo fuera)
+	if (Ctx.Agent->Pawn && Ctx.Agent->Pawn->Goal != EEnemyGoal::HuntPlayer) return;
 
 	// Distancia en celdas al objetivo
 	int32 SX, SY, GX, GY;
@@ -80,18 +79,17 @@ void UEnemyMovePolicy_WanderFar::ComputeMove(const FMoveContext& Ctx, FMoveDecis
 	if (Manh <= FMath::TruncToInt(ActivateBeyondCells)) return; // cerca: deja que PathFollow mande
 
 	// Elegir/continuar tramo
-	const double Now = UGameplayStatics::GetTimeSeconds(this);
-	if (StepsLeft <= 0 || Now >= NextRechooseTime || !IsPassableAhead(FIntPoint(SX, SY), CurrentDir))
+	if (S->StepsLeft <= 0 || Ctx.Now >= S->NextRechooseTime || !IsPassableAhead(FIntPoint(SX, SY), S->CurrentDir))
 	{
-		ChooseNewDir(Ctx, FIntPoint(SX, SY), FIntPoint(GX, GY));
+		ChooseNewDir(*S, Ctx, FIntPoint(SX, SY), FIntPoint(GX, GY));
 	}
 
-	if (StepsLeft > 0 && !CurrentDir.IsNearlyZero())
+	if (S->StepsLeft > 0 && !S->CurrentDir.IsNearlyZero())
 	{
-		Out.RawMoveInput = FVector2D((float)Sign01(CurrentDir.X), (float)Sign01(CurrentDir.Y));
+		Out.RawMoveInput = FVector2D((float)Sign01(S->CurrentDir.X), (float)Sign01(S->CurrentDir.Y));
 		Out.LockAxis = (FMath::Abs(Out.RawMoveInput.X) > 0.5f) ? EMoveLockAxis::X : EMoveLockAxis::Y;
 		Out.LockTime = 0.25f; // pequea ventana para evitar zig-zag
-		Out.DebugText.Append(TEXT(" +WanderFar"));
-		StepsLeft--;
+		Out.Debug.Add(EMoveDebugTag::WanderFar);
+		S->StepsLeft--;
 	}
 }
@@ -1,5 +1,6 @@
 #include "Components/EnemyMovement/EnemyMovementComponent.h"
 #include "Components/EnemyMovement/EnemyMovePolicies/EnemyMovePolicy.h"
+#include "Components/EnemyMovement/EnemyAIManager.h"
 #include "Enemies/EnemyPawn.h"
 #include "Map/MapGridSubsystem.h"
 #include "Kismet/GameplayStatics.h"
@@ -20,13 +21,14 @@ void UEnemyMovementComponent::BeginPlay()
     CachedGrid = (GetWorld() && GetWorld()->GetGameInstance())
         ? GetWorld()->GetGameInstance()->GetSubsystem<UMapGridSubsystem>()
         : nullptr;
+    MoveAgent.Component = this;
+    MoveAgent.Pawn = CachedPawn.Get();
     EnsurePolicy();
 
-    // Inicializa facing local desde el Pawn si existe, si no, (1,0)
-    if (CachedPawn.IsValid())
+    // Alta en el manager (facing inicial desde el Pawn); con bc.ai.batched nos apaga el tick
+    if (UEnemyAIManager* Mgr = GetWorld() ? GetWorld()->GetSubsystem<UEnemyAIManager>() : nullptr)
     {
-        const FVector2D PawnFacing = CachedPawn->GetFacingDir();
-        if (!PawnFacing.IsNearlyZero()) LastFacingDir = FVector2D(Sign01(PawnFacing.X), Sign01(PawnFacing.Y));
+        Mgr->RegisterAgent(this);
     }
 
     if (UMapGridSubsystem* G = GetGrid())
@@ -37,20 +39,63 @@ void UEnemyMovementComponent::BeginPlay()
     }
 }
 
+void UEnemyMovementComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    if (AIManager) AIManager->UnregisterAgent(this);
+    ReleasePolicyState();
+    Super::EndPlay(EndPlayReason);
+}
+
+UEnemyMovePolicy* UEnemyMovementComponent::GetPolicyConfig() const
+{
+    if (MovePolicy) return MovePolicy;
+    TSubclassOf<UEnemyMovePolicy> Cls =
+        MovePolicyClass ? MovePolicyClass : (TSubclassOf<UEnemyMovePolicy>)(UEnemyMovePolicy_GridAxisLock::StaticClass());
+    return Cls->GetDefaultObject<UEnemyMovePolicy>();
+}
+
 void UEnemyMovementComponent::EnsurePolicy()
 {
-    if (!MovePolicy && MovePolicyClass)
-        MovePolicy = NewObject<UEnemyMovePolicy>(this, MovePolicyClass, NAME_None, RF_Transactional);
+    BindPolicy(ConfigOverride ? ConfigOverride.Get() : GetPolicyConfig());
+}
+
+void UEnemyMovementComponent::SetPolicyConfig(UEnemyMovePolicy* Config)
+{
+    ConfigOverride = Config;
+    if (HasBegunPlay()) EnsurePolicy();
+}
 
-    if (!MovePolicy)
+void UEnemyMovementComponent::BindPolicy(UEnemyMovePolicy* Config)
+{
+    ReleasePolicyState();
+
+    UWorld* W = GetWorld();
+    UEnemyAIManager* Mgr = W ? W->GetSubsystem<UEnemyAIManager>() : nullptr;
+    UEnemyMovePolicy* Policy = Mgr ? Mgr->GetSharedPolicy(Config) : nullptr;
+    if (!Policy)
     {
-        TSubclassOf<UEnemyMovePolicy> Cls =
-            MovePolicyClass ? MovePolicyClass : (TSubclassOf<UEnemyMovePolicy>)(UEnemyMovePolicy_GridAxisLock::StaticClass());
-        MovePolicy = NewObject<UEnemyMovePolicy>(this, Cls, NAME_None, RF_Transactional);
+        // Sin compartir (bc.ai.sharedpolicies 0): instancia propia; ni el CDO ni una configuracin
+        // ajena (la del spawner) se usan tal cual
+        Policy = Config->GetOuter() == this
+            ? Config
+            : NewObject<UEnemyMovePolicy>(this, Config->GetClass(), NAME_None, RF_Transactional, Config);
+        Policy->Initialize(W);
     }
 
-    if (MovePolicy) 
-        MovePolicy->Initialize(this);
+    MovePolicy = Policy;
+    MovePolicy->AcquireAgentState(MoveAgent);
+
+    if (AIManager) AIManager->RefreshAgentPolicy(this);
+}
+
+void UEnemyMovementComponent::ReleasePolicyState()
+{
+    if (MovePolicy) MovePolicy->ReleaseAgentState(MoveAgent);
+}
+
+FVector2D UEnemyMovementComponent::GetLastFacingDir() const
+{
+    return (AIManager && AIAgentIndex != INDEX_NONE) ? AIManager->GetAgents().Facing[AIAgentIndex] : FVector2D(1.f, 0.f);
 }
 
 float UEnemyMovementComponent::GetTileSizeSafe() const
@@ -84,14 +129,11 @@ bool UEnemyMovementComponent::IsAheadBlocked(bool bAxisX, int Dir, float DistWor
     int32 SX, SY;
     if (!CachedGrid->WorldToGrid(Start, SX, SY)) return false;
 
-    for (int s = 1; s <= Steps; ++s)
-    {
-        const int X = bAxisX ? (SX + Dir * s) : SX;
-        const int Y = bAxisX ? SY : (SY + Dir * s);
-        const EObstacleType O = CachedGrid->GetObstacleAtGrid(X, Y);
-        if (O == EObstacleType::Brick || O == EObstacleType::Steel) return true;
-    }
-    return false;
+    // Tabla de siguiente obstculo de la fila/columna: O(1) sea cual sea la distancia
+    const FIntPoint From(SX, SY);
+    FIntPoint Hit;
+    if (!CachedGrid->FindNextObstacle(From, bAxisX ? FIntPoint(Dir, 0) : FIntPoint(0, Dir), Hit)) return false;
+    return FMath::Abs(Hit.X - SX) + FMath::Abs(Hit.Y - SY) <= Steps;
 }
 
 uint8 UEnemyMovementComponent::QueryFrontObstacle(float MaxDistanceWorld, FVector* OutHitWorld) const
@@ -100,7 +142,7 @@ uint8 UEnemyMovementComponent::QueryFrontObstacle(float MaxDistanceWorld, FVecto
     const float Tile = GetTileSizeSafe();
 
     // === NUEVO: usar facing local del componente
-    const FVector2D Facing = LastFacingDir;
+    const FVector2D Facing = GetLastFacingDir();
     const bool bAxisX = (FMath::Abs(Facing.X) >= FMath::Abs(Facing.Y));
     const int  Dir = bAxisX ? ((Facing.X >= 0.f) ? +1 : -1)
         : ((Facing.Y >= 0.f) ? +1 : -1);
@@ -109,18 +151,12 @@ uint8 UEnemyMovementComponent::QueryFrontObstacle(float MaxDistanceWorld, FVecto
     int32 SX, SY; if (!CachedGrid->WorldToGrid(Start, SX, SY)) return 0;
 
     const int Steps = FMath::Max(1, FMath::FloorToInt(MaxDistanceWorld / Tile));
-    for (int s = 1; s <= Steps; ++s)
-    {
-        const int X = bAxisX ? (SX + Dir * s) : SX;
-        const int Y = bAxisX ? SY : (SY + Dir * s);
-        const EObstacleType O = CachedGrid->GetObstacleAtGrid(X, Y);
-        if (O == EObstacleType::Brick || O == EObstacleType::Steel)
-        {
-            if (OutHitWorld) *OutHitWorld = CachedGrid->GridToWorld(X, Y, Tile * 0.5f);
-            return (O == EObstacleType::Brick) ? 1 : 2;
-        }
-    }
-    return 0;
+    FIntPoint Hit;
+    if (!CachedGrid->FindNextObstacle(FIntPoint(SX, SY), bAxisX ? FIntPoint(Dir, 0) : FIntPoint(0, Dir), Hit)) return 0;
+    if (FMath::Abs(Hit.X - SX) + FMath::Abs(Hit.Y - SY) > Steps) return 0;
+
+    if (OutHitWorld) *OutHitWorld = CachedGrid->GridToWorld(Hit.X, Hit.Y, Tile * 0.5f);
+    return (CachedGrid->GetObstacleAtGrid(Hit.X, Hit.Y) == EObstacleType::Brick) ? 1 : 2;
 }
 
 uint8 UEnemyMovementComponent::CheckCardinalLineToTarget(const FVector& From, const FVector& To, FVector* OutFirstHitWorld) const
@@ -137,31 +173,15 @@ uint8 UEnemyMovementComponent::CheckCardinalLineToTarget(const FVector& From, co
     if (!CachedGrid->WorldToGrid(From, SX, SY) || !CachedGrid->WorldToGrid(To, EX, EY))
         return 0;
 
-    if (CardinalX)
+    // Primer obstculo de la fila/columna hacia el objetivo; bloquea si est antes o en su celda
+    const FIntPoint Step = CardinalX ? FIntPoint((EX >= SX) ? 1 : -1, 0) : FIntPoint(0, (EY >= SY) ? 1 : -1);
+    const int32 Span = CardinalX ? FMath::Abs(EX - SX) : FMath::Abs(EY - SY);
+    FIntPoint Hit;
+    if (Span > 0 && CachedGrid->FindNextObstacle(FIntPoint(SX, SY), Step, Hit)
+        && FMath::Abs(Hit.X - SX) + FMath::Abs(Hit.Y - SY) <= Span)
     {
-        const int Dir = (EX >= SX) ? 1 : -1;
-        for (int x = SX + Dir; x != EX + Dir; x += Dir)
-        {
-            const EObstacleType O = CachedGrid->GetObstacleAtGrid(x, SY);
-            if (O == EObstacleType::Brick || O == EObstacleType::Steel)
-            {
-                if (OutFirstHitWorld) *OutFirstHitWorld = CachedGrid->GridToWorld(x, SY, Tile * 0.5f);
-                return (O == EObstacleType::Brick) ? 2 : 3; // Brick / Steel
-            }
-        }
-    }
-    else
-    {
-        const int Dir = (EY >= SY) ? 1 : -1;
-        for (int y = SY + Dir; y != EY + Dir; y += Dir)
-        {
-            const EObstacleType O = CachedGrid->GetObstacleAtGrid(SX, y);
-            if (O == EObstacleType::Brick || O == EObstacleType::Steel)
-            {
-                if (OutFirstHitWorld) *OutFirstHitWorld = CachedGrid->GridToWorld(SX, y, Tile * 0.5f);
-                return (O == EObstacleType::Brick) ? 2 : 3;
-            }
-        }
+        if (OutFirstHitWorld) *OutFirstHitWorld = CachedGrid->GridToWorld(Hit.X, Hit.Y, Tile * 0.5f);
+        return (CachedGrid->GetObstacleAtGrid(Hit.X, Hit.Y) == EObstacleType::Brick) ? 2 : 3; // Brick / Steel
     }
     return 1; // Clear
 }
@@ -177,17 +197,22 @@ void UEnemyMovementComponent::ApplyDecision(const FMoveDecision& D)
 {
     if (!CachedPawn.IsValid()) return;
 
-    // Lock
-    if (D.LockAxis != EMoveLockAxis::None && D.LockTime > 0.f)
+    if (AIManager && AIAgentIndex != INDEX_NONE)
     {
-        AxisLock = D.LockAxis;
-        LockUntilTime = UGameplayStatics::GetTimeSeconds(this) + D.LockTime;
-    }
+        FEnemyAIAgents& A = AIManager->GetAgents();
 
-    // === NUEVO: actualizar facing local con la ltima orden de movimiento cardinal
-    if (!D.RawMoveInput.IsNearlyZero())
-    {
-        LastFacingDir = FVector2D((float)Sign01(D.RawMoveInput.X), (float)Sign01(D.RawMoveInput.Y));
+        // Lock
+        if (D.LockAxis != EMoveLockAxis::None && D.LockTime > 0.f)
+        {
+            A.LockAxis[AIAgentIndex] = D.LockAxis;
+            A.LockUntil[AIAgentIndex] = UGameplayStatics::GetTimeSeconds(this) + D.LockTime;
+        }
+
+        // === NUEVO: actualizar facing local con la ltima orden de movimiento cardinal
+        if (!D.RawMoveInput.IsNearlyZero())
+        {
+            A.Facing[AIAgentIndex] = FVector2D((float)Sign01(D.RawMoveInput.X), (float)Sign01(D.RawMoveInput.Y));
+        }
     }
 
     // Movimiento
@@ -200,18 +225,12 @@ void UEnemyMovementComponent::ApplyDecision(const FMoveDecision& D)
     }
 }
 
-void UEnemyMovementComponent::TickComponent(float DT, ELevelTick levelTick, FActorComponentTickFunction* tickFunction)
+void UEnemyMovementComponent::BuildMoveContext(FMoveContext& Ctx) const
 {
-    Super::TickComponent(DT, levelTick, tickFunction);
-
-    if (!MovePolicy || !CachedPawn.IsValid()) return;
-
-    // Construir contexto
-    FMoveContext Ctx;
     Ctx.Location = CachedPawn->GetActorLocation();
 
     // === NUEVO: usar facing local (no dependemos de que el Pawn lo actualice)
-    Ctx.FacingDir = LastFacingDir;
+    Ctx.FacingDir = GetLastFacingDir();
 
     Ctx.TargetWorld = CachedPawn->GetAITargetWorld();
 
@@ -220,25 +239,31 @@ void UEnemyMovementComponent::TickComponent(float DT, ELevelTick levelTick, FAct
     Ctx.AlignEpsilon = AlignEpsilonFactor * Tile;
     Ctx.TieDeadband = TieDeadbandFactor * Tile;
     Ctx.LookAheadTiles = LookAheadTiles;
+    Ctx.MinLockTime = MinLockTime;
+    Ctx.bPreferShootWhenFrontBrick = bPreferShootWhenFrontBrick;
 
     Ctx.bFireReady = IsFireReady();
+    Ctx.Now = UGameplayStatics::GetTimeSeconds(this);
 
-    Ctx.IsAheadBlocked = [this, Tile](bool bAxisX, int Dir, float DistWorld) { return IsAheadBlocked(bAxisX, Dir, DistWorld); };
-    Ctx.FrontObstacle = [this](float D, FVector* Out) { return QueryFrontObstacle(D, Out); };
-    Ctx.CardinalLineToTarget = [this](const FVector& A, const FVector& B, FVector* Out) { return CheckCardinalLineToTarget(A, B, Out); };
+    Ctx.Queries = this;
+    Ctx.Agent = const_cast<FEnemyMoveAgent*>(&MoveAgent);
+}
 
-    // Pedir decisin a la policy
-    FMoveDecision Dec;
-    MovePolicy->ComputeMove(Ctx, Dec);
+void UEnemyMovementComponent::ApplyAxisLock(FMoveDecision& Dec, double Now)
+{
+    if (!AIManager || AIAgentIndex == INDEX_NONE) return;
+    FEnemyAIAgents& A = AIManager->GetAgents();
+    EMoveLockAxis& AxisLock = A.LockAxis[AIAgentIndex];
+    const double LockUntilTime = A.LockUntil[AIAgentIndex];
+    const FVector2D LastFacingDir = A.Facing[AIAgentIndex];
 
     // Lock activo: mantener eje si no hay bloqueo real
-    const double Now = UGameplayStatics::GetTimeSeconds(this);
     if (AxisLock != EMoveLockAxis::None && Now < LockUntilTime)
     {
         const bool bAxisX = (AxisLock == EMoveLockAxis::X);
         const int Dir = bAxisX ? ((LastFacingDir.X >= 0) ? +1 : -1)
             : ((LastFacingDir.Y >= 0) ? +1 : -1);
-        if (!IsAheadBlocked(bAxisX, Dir, Tile * LookAheadTiles))
+        if (!IsAheadBlocked(bAxisX, Dir, GetTileSizeSafe() * LookAheadTiles))
         {
             Dec.RawMoveInput = bAxisX ? FVector2D(Dir, 0) : FVector2D(0, Dir);
             Dec.LockAxis = AxisLock;
@@ -249,8 +274,22 @@ void UEnemyMovementComponent::TickComponent(float DT, ELevelTick levelTick, FAct
             AxisLock = EMoveLockAxis::None;
         }
     }
+}
+
+void UEnemyMovementComponent::OnGameplayTimer(uint32 Payload)
+{
+    if (AIManager && AIAgentIndex != INDEX_NONE) AIManager->MarkDecisionDue(AIAgentIndex);
+}
 
-    ApplyDecision(Dec);
+void UEnemyMovementComponent::TickComponent(float DT, ELevelTick levelTick, FActorComponentTickFunction* tickFunction)
+{
+    Super::TickComponent(DT, levelTick, tickFunction);
+
+    // Slo con bc.ai.batched 0: si no, el manager actualiza a todos en su tick
+    if (AIManager && AIAgentIndex != INDEX_NONE)
+    {
+        AIManager->UpdateAgent(AIAgentIndex, UGameplayStatics::GetTimeSeconds(this));
+    }
 }
 
 #if WITH_EDITOR
@@ -260,7 +299,10 @@ void UEnemyMovementComponent::PostEditChangeProperty(FPropertyChangedEvent& E)
     static const FName NAME_MovePolicyClass(TEXT("MovePolicyClass"));
     if (E.Property && E.Property->GetFName() == NAME_MovePolicyClass)
     {
-        EnsurePolicy();
+        // Editor: instancia inline para editarla; en juego se vuelve a enlazar
+        if (!MovePolicy && MovePolicyClass)
+            MovePolicy = NewObject<UEnemyMovePolicy>(this, MovePolicyClass, NAME_None, RF_Transactional);
+        if (HasBegunPlay()) EnsurePolicy();
     }
 }
 #endif
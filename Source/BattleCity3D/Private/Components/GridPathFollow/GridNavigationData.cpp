@@ -0,0 +1,505 @@
+#include "Components/GridPathFollow/GridNavigationData.h"
+#include "Components/GridPathFollow/GridPathManager.h"
+#include "Map/MapGridSubsystem.h"
+#include "NavigationSystem.h"
+#include "Engine/World.h"
+#include "Engine/GameInstance.h"
+#include "EngineUtils.h"
+
+AGridNavigationData::AGridNavigationData(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+	if (!HasAnyFlags(RF_ClassDefaultObject))
+	{
+		FindPathImplementation = FindPath;
+		FindHierarchicalPathImplementation = FindPath;
+		TestPathImplementation = TestPath;
+		TestHierarchicalPathImplementation = TestPath;
+		RaycastImplementation = Raycast;
+	}
+
+	CostProfile.BrickCost = CostProfile.ImpassableCost;
+}
+
+AGridNavigationData* AGridNavigationData::EnsureForWorld(UWorld* World)
+{
+	if (!World) return nullptr;
+	for (TActorIterator<AGridNavigationData> It(World); It; ++It) return *It;
+
+	UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(World);
+	if (!NavSys)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[GridNav] El mundo no tiene NavigationSystem; MoveTo/EQS no tendrn datos de navegacin"));
+		return nullptr;
+	}
+
+	AGridNavigationData* Nav = World->SpawnActor<AGridNavigationData>();
+	if (Nav)
+	{
+		NavSys->RequestRegistrationDeferred(*Nav);
+	}
+	return Nav;
+}
+
+void AGridNavigationData::BeginPlay()
+{
+	Super::BeginPlay();
+
+	if (UMapGridSubsystem* Grid = GetGrid())
+	{
+		CellChangedHandle = Grid->OnGridCellChanged.AddUObject(this, &AGridNavigationData::HandleGridCellChanged);
+	}
+}
+
+void AGridNavigationData::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UMapGridSubsystem* Grid = GetGrid())
+	{
+		Grid->OnGridCellChanged.Remove(CellChangedHandle);
+	}
+	CellChangedHandle.Reset();
+
+	Super::EndPlay(EndPlayReason);
+}
+
+UMapGridSubsystem* AGridNavigationData::GetGrid() const
+{
+	const UGameInstance* GI = GetWorld() ? GetWorld()->GetGameInstance() : nullptr;
+	return GI ? GI->GetSubsystem<UMapGridSubsystem>() : nullptr;
+}
+
+UGridPathManager* AGridNavigationData::GetPathManager() const
+{
+	const UGameInstance* GI = GetWorld() ? GetWorld()->GetGameInstance() : nullptr;
+	return GI ? GI->GetSubsystem<UGridPathManager>() : nullptr;
+}
+
+bool AGridNavigationData::IsNavigableCell(const UMapGridSubsystem& Grid, const FGridCostLUT& Lut, const FIntPoint& Cell) const
+{
+	return Grid.IsPassableCell(Cell, Lut);
+}
+
+FVector AGridNavigationData::CellToWorld(const UMapGridSubsystem& Grid, const FIntPoint& Cell, float Z) const
+{
+	FVector P = Grid.GridToWorld(Cell.X, Cell.Y);
+	P.Z = Z;
+	return P;
+}
+
+FBox AGridNavigationData::GetBounds() const
+{
+	const UMapGridSubsystem* Grid = GetGrid();
+	if (!Grid || Grid->GetWidth() <= 0 || Grid->GetHeight() <= 0) return FBox(ForceInit);
+
+	const float Half = Grid->GetTileSize() * 0.5f;
+	FBox Box(ForceInit);
+	Box += Grid->GridToWorld(0, 0);
+	Box += Grid->GridToWorld(Grid->GetWidth() - 1, Grid->GetHeight() - 1);
+	return Box.ExpandBy(FVector(Half, Half, Grid->GetTileSize()));
+}
+
+bool AGridNavigationData::ProjectToCell(const UMapGridSubsystem& Grid, const FGridCostLUT& Lut, const FVector& Point, const FVector& Extent, FIntPoint& OutCell) const
+{
+	int32 X = 0, Y = 0;
+	if (!Grid.WorldToGrid(Point, X, Y)) return false; // fuera del mapa no hay navegacin
+	const FIntPoint Center(X, Y);
+	if (IsNavigableCell(Grid, Lut, Center)) { OutCell = Center; return true; }
+
+	// Anillos crecientes hasta cubrir Extent; la ms cercana en mundo gana
+	const int32 MaxRing = FMath::Max(0, FMath::CeilToInt(FMath::Max(Extent.X, Extent.Y) / Grid.GetTileSize()));
+	for (int32 Ring = 1; Ring <= MaxRing; ++Ring)
+	{
+		double BestDistSq = TNumericLimits<double>::Max();
+		bool bFound = false;
+		for (int32 DY = -Ring; DY <= Ring; ++DY)
+		{
+			for (int32 DX = -Ring; DX <= Ring; ++DX)
+			{
+				if (FMath::Max(FMath::Abs(DX), FMath::Abs(DY)) != Ring) continue;
+				const FIntPoint C(Center.X + DX, Center.Y + DY);
+				if (!IsNavigableCell(Grid, Lut, C)) continue;
+
+				const FVector W = Grid.GridToWorld(C.X, C.Y);
+				if (FMath::Abs(W.X - Point.X) > Extent.X + Grid.GetTileSize() * 0.5f
+					|| FMath::Abs(W.Y - Point.Y) > Extent.Y + Grid.GetTileSize() * 0.5f) continue;
+
+				const double D = FVector::DistSquared2D(W, Point);
+				if (D < BestDistSq) { BestDistSq = D; OutCell = C; bFound = true; }
+			}
+		}
+		if (bFound) return true;
+	}
+	return false;
+}
+
+bool AGridNavigationData::ProjectPoint(const FVector& Point, FNavLocation& OutLocation, const FVector& Extent, FSharedConstNavQueryFilter Filter, const UObject* Querier) const
+{
+	const UMapGridSubsystem* Grid = GetGrid();
+	const FGridCostLUT Lut(CostProfile);
+	FIntPoint Cell;
+	if (!Grid || !ProjectToCell(*Grid, Lut, Point, Extent, Cell)) return false;
+
+	int32 X = INDEX_NONE, Y = INDEX_NONE;
+	Grid->WorldToGrid(Point, X, Y);
+	// Dentro de una celda navegable el punto se queda donde est
+	const FVector Loc = (Cell == FIntPoint(X, Y)) ? Point : CellToWorld(*Grid, Cell, Point.Z);
+	OutLocation = FNavLocation(Loc, CellToNodeRef(*Grid, Cell));
+	return true;
+}
+
+void AGridNavigationData::BatchProjectPoints(TArray<FNavigationProjectionWork>& Workload, const FVector& Extent, FSharedConstNavQueryFilter Filter, const UObject* Querier) const
+{
+	for (FNavigationProjectionWork& Work : Workload)
+	{
+		Work.bResult = ProjectPoint(Work.Point, Work.OutLocation, Extent, Filter, Querier);
+	}
+}
+
+void AGridNavigationData::BatchProjectPoints(TArray<FNavigationProjectionWork>& Workload, FSharedConstNavQueryFilter Filter, const UObject* Querier) const
+{
+	for (FNavigationProjectionWork& Work : Workload)
+	{
+		const FVector Extent = Work.ProjectionLimit.IsValid ? Work.ProjectionLimit.GetExtent() : FVector::ZeroVector;
+		Work.bResult = ProjectPoint(Work.Point, Work.OutLocation, Extent, Filter, Querier);
+	}
+}
+
+FNavLocation AGridNavigationData::GetRandomPoint(FSharedConstNavQueryFilter Filter, const UObject* Querier) const
+{
+	const UMapGridSubsystem* Grid = GetGrid();
+	if (!Grid || Grid->GetWidth() <= 0 || Grid->GetHeight() <= 0) return FNavLocation();
+	const FGridCostLUT Lut(CostProfile);
+
+	// Unos cuantos intentos al azar y, si el mapa es casi todo muro, barrido desde una celda al azar
+	const int32 N = Grid->GetWidth() * Grid->GetHeight();
+	const float Z = Grid->GridToWorld(0, 0).Z;
+	for (int32 Try = 0; Try < 16; ++Try)
+	{
+		const int32 I = FMath::RandRange(0, N - 1);
+		const FIntPoint C(I % Grid->GetWidth(), I / Grid->GetWidth());
+		if (IsNavigableCell(*Grid, Lut, C)) return FNavLocation(CellToWorld(*Grid, C, Z), CellToNodeRef(*Grid, C));
+	}
+	const int32 First = FMath::RandRange(0, N - 1);
+	for (int32 k = 0; k < N; ++k)
+	{
+		const int32 I = (First + k) % N;
+		const FIntPoint C(I % Grid->GetWidth(), I / Grid->GetWidth());
+		if (IsNavigableCell(*Grid, Lut, C)) return FNavLocation(CellToWorld(*Grid, C, Z), CellToNodeRef(*Grid, C));
+	}
+	return FNavLocation();
+}
+
+bool AGridNavigationData::GetRandomPointInNavigableRadius(const FVector& Origin, float Radius, FNavLocation& OutResult, FSharedConstNavQueryFilter Filter, const UObject* Querier) const
+{
+	const UMapGridSubsystem* Grid = GetGrid();
+
+	int32 X = 0, Y = 0;
+	if (!Grid || !Grid->WorldToGrid(Origin, X, Y)) return false;
+	const int32 R = FMath::CeilToInt(Radius / Grid->GetTileSize());
+	const FGridCostLUT Lut(CostProfile);
+
+	// Reservoir sampling sobre las celdas navegables del crculo (sin array de candidatos)
+	int32 Seen = 0;
+	FIntPoint Pick;
+	for (int32 DY = -R; DY <= R; ++DY)
+	{
+		for (int32 DX = -R; DX <= R; ++DX)
+		{
+			const FIntPoint C(X + DX, Y + DY);
+			if (!IsNavigableCell(*Grid, Lut, C) || FVector::DistSquared2D(Grid->GridToWorld(C.X, C.Y), Origin) > FMath::Square(Radius)) continue;
+			if (FMath::RandRange(0, Seen++) == 0) Pick = C;
+		}
+	}
+	if (Seen == 0) return false;
+
+	OutResult = FNavLocation(CellToWorld(*Grid, Pick, Origin.Z), CellToNodeRef(*Grid, Pick));
+	return true;
+}
+
+bool AGridNavigationData::GetRandomReachablePointInRadius(const FVector& Origin, float Radius, FNavLocation& OutResult, FSharedConstNavQueryFilter Filter, const UObject* Querier) const
+{
+	const UMapGridSubsystem* Grid = GetGrid();
+	const FGridCostLUT Lut(CostProfile);
+	FIntPoint Start;
+	if (!Grid || !ProjectToCell(*Grid, Lut, Origin, FVector(Grid->GetTileSize()), Start)) return false;
+
+	// BFS local sobre la caja del radio: slo celdas conectadas con Origin
+	const int32 R = FMath::CeilToInt(Radius / Grid->GetTileSize());
+	const int32 Side = 2 * R + 1;
+	TArray<bool> Visited;
+	Visited.SetNumZeroed(Side * Side);
+	TArray<FIntPoint> Queue;
+	Queue.Reserve(Side * Side);
+
+	auto Local = [&](const FIntPoint& C) { return (C.X - Start.X + R) + (C.Y - Start.Y + R) * Side; };
+	Visited[Local(Start)] = true;
+	Queue.Add(Start);
+
+	int32 Seen = 0;
+	FIntPoint Pick = Start;
+	for (int32 Head = 0; Head < Queue.Num(); ++Head)
+	{
+		const FIntPoint U = Queue[Head];
+		if (FVector::DistSquared2D(Grid->GridToWorld(U.X, U.Y), Origin) <= FMath::Square(Radius) && FMath::RandRange(0, Seen++) == 0) Pick = U;
+
+		for (const FIntPoint& D : GridSearch::Dir4)
+		{
+			const FIntPoint V = U + D;
+			if (FMath::Abs(V.X - Start.X) > R || FMath::Abs(V.Y - Start.Y) > R) continue;
+			if (Visited[Local(V)] || !IsNavigableCell(*Grid, Lut, V)) continue;
+			Visited[Local(V)] = true;
+			Queue.Add(V);
+		}
+	}
+
+	OutResult = FNavLocation(CellToWorld(*Grid, Pick, Origin.Z), CellToNodeRef(*Grid, Pick));
+	return true;
+}
+
+bool AGridNavigationData::Raycast(const ANavigationData* NavData, const FVector& RayStart, const FVector& RayEnd, FVector& HitLocation,
+	FNavigationRaycastAdditionalResults* AdditionalResults, FSharedConstNavQueryFilter QueryFilter, const UObject* Querier)
+{
+	const AGridNavigationData* Self = Cast<const AGridNavigationData>(NavData);
+	const UMapGridSubsystem* Grid = Self ? Self->GetGrid() : nullptr;
+	HitLocation = RayEnd;
+	if (!Grid) return false;
+	const FGridCostLUT Lut(Self->CostProfile);
+
+	// Muestreo a cuarto de celda: no se salta esquinas de un tile
+	const float Step = Grid->GetTileSize() * 0.25f;
+	const int32 NumSteps = FMath::Max(1, FMath::CeilToInt(FVector::Dist2D(RayStart, RayEnd) / Step));
+	FVector Last = RayStart;
+	for (int32 i = 0; i <= NumSteps; ++i)
+	{
+		const FVector P = FMath::Lerp(RayStart, RayEnd, (float)i / NumSteps);
+		int32 X = 0, Y = 0;
+		if (!Grid->WorldToGrid(P, X, Y) || !Self->IsNavigableCell(*Grid, Lut, FIntPoint(X, Y)))
+		{
+			HitLocation = Last;
+			return true;
+		}
+		Last = P;
+	}
+	return false;
+}
+
+void AGridNavigationData::BatchRaycast(TArray<FNavigationRaycastWork>& Workload, FSharedConstNavQueryFilter QueryFilter, const UObject* Querier) const
+{
+	const UMapGridSubsystem* Grid = GetGrid();
+	for (FNavigationRaycastWork& Work : Workload)
+	{
+		FVector Hit;
+		Work.bDidHit = Raycast(this, Work.RayStart, Work.RayEnd, Hit, nullptr, QueryFilter, Querier);
+		Work.HitLocation = FNavLocation(Hit);
+		if (Grid)
+		{
+			int32 X = 0, Y = 0;
+			if (Grid->WorldToGrid(Hit, X, Y)) Work.HitLocation.NodeRef = CellToNodeRef(*Grid, FIntPoint(X, Y));
+		}
+	}
+}
+
+bool AGridNavigationData::ComputeGridPath(const FVector& From, const FVector& To, bool bAllowPartial, TArray<FIntPoint>& OutCorners, float& OutCost, bool& bOutReachedGoal) const
+{
+	OutCorners.Reset();
+	OutCost = 0.f;
+	bOutReachedGoal = false;
+
+	if (!IsInGameThread())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[GridNav] Consulta de ruta fuera del game thread ignorada (usa consultas sncronas)"));
+		return false;
+	}
+
+	UMapGridSubsystem* Grid = GetGrid();
+	UGridPathManager* Mgr = GetPathManager();
+	if (!Grid || !Mgr || Grid->GetWidth() <= 0) return false;
+
+	FGridPathRequest Req;
+	Req.Grid = Grid;
+	Req.Cost = CostProfile;
+	Req.bAllowPartial = bAllowPartial;
+	const FVector Extent(Grid->GetTileSize());
+	const FGridCostLUT Lut(CostProfile);
+	if (!ProjectToCell(*Grid, Lut, From, Extent, Req.Start) || !ProjectToCell(*Grid, Lut, To, Extent, Req.Goal)) return false;
+
+	FGridPathRef Path = Mgr->ComputePathShared(Req);
+	if (!Path.IsValid() || Path->GetNumCells() == 0) return false;
+
+	OutCost = Path->TotalCost;
+	bOutReachedGoal = Path->bReachedGoal;
+	OutCorners.Append(Path->GetCornerCells());
+
+	// HPA* entrega la ruta por tramos; la navegacin de UE quiere la ruta entera
+	while (Path->PendingWaypoints.Num() > 0)
+	{
+		FGridPathRef Next = Mgr->RefineNextSegmentShared(Req, *Path);
+		if (!Next.IsValid())
+		{
+			bOutReachedGoal = false;
+			if (!bAllowPartial) return false;
+			break;
+		}
+		const TArray<FIntPoint>& Corners = Next->GetCornerCells();
+		OutCorners.Append(Corners.GetData() + 1, Corners.Num() - 1); // la primera es la ltima del tramo anterior
+		Path = Next;
+	}
+	return true;
+}
+
+void AGridNavigationData::BuildPathPoints(const UMapGridSubsystem& Grid, const TArray<FIntPoint>& Corners, const FVector& Start, const FVector& End, bool bReachedGoal, TArray<FNavPathPoint>& OutPoints) const
+{
+	OutPoints.Reset(Corners.Num() + 1);
+	OutPoints.Add(FNavPathPoint(Start, CellToNodeRef(Grid, Corners[0])));
+	for (int32 i = 1; i < Corners.Num(); ++i)
+	{
+		OutPoints.Add(FNavPathPoint(CellToWorld(Grid, Corners[i], Start.Z), CellToNodeRef(Grid, Corners[i])));
+	}
+	if (bReachedGoal)
+	{
+		// El ltimo punto es el destino pedido, no el centro de su celda
+		if (OutPoints.Num() > 1) OutPoints.Last().Location = FVector(End.X, End.Y, Start.Z);
+		else OutPoints.Add(FNavPathPoint(FVector(End.X, End.Y, Start.Z), CellToNodeRef(Grid, Corners.Last())));
+	}
+}
+
+FPathFindingResult AGridNavigationData::FindPath(const FNavAgentProperties& AgentProperties, const FPathFindingQuery& Query)
+{
+	FPathFindingResult Result(ENavigationQueryResult::Error);
+	const AGridNavigationData* Self = Cast<const AGridNavigationData>(Query.NavData.Get());
+	const UMapGridSubsystem* Grid = Self ? Self->GetGrid() : nullptr;
+	if (!Grid) return Result;
+
+	FNavigationPath* NavPath = Query.PathInstanceToFill.Get();
+	if (NavPath)
+	{
+		Result.Path = Query.PathInstanceToFill;
+		NavPath->ResetForRepath();
+	}
+	else
+	{
+		Result.Path = Self->CreatePathInstance<FNavigationPath>(Query);
+		NavPath = Result.Path.Get();
+	}
+	if (!NavPath) return Result;
+
+	TArray<FIntPoint> Corners;
+	float Cost = 0.f;
+	bool bReachedGoal = false;
+	if (!Self->ComputeGridPath(Query.StartLocation, Query.EndLocation, Query.bAllowPartialPaths, Corners, Cost, bReachedGoal))
+	{
+		Result.Result = ENavigationQueryResult::Fail;
+		return Result;
+	}
+
+	Self->BuildPathPoints(*Grid, Corners, Query.StartLocation, Query.EndLocation, bReachedGoal, NavPath->GetPathPoints());
+	NavPath->SetIsPartial(!bReachedGoal);
+	NavPath->MarkReady();
+	Result.Result = ENavigationQueryResult::Success;
+	return Result;
+}
+
+bool AGridNavigationData::TestPath(const FNavAgentProperties& AgentProperties, const FPathFindingQuery& Query, int32* NumVisitedNodes)
+{
+	const AGridNavigationData* Self = Cast<const AGridNavigationData>(Query.NavData.Get());
+	if (!Self) return false;
+
+	TArray<FIntPoint> Corners;
+	float Cost = 0.f;
+	bool bReachedGoal = false;
+	const bool bOk = Self->ComputeGridPath(Query.StartLocation, Query.EndLocation, Query.bAllowPartialPaths, Corners, Cost, bReachedGoal);
+	if (NumVisitedNodes)
+	{
+		const UGridPathManager* Mgr = Self->GetPathManager();
+		*NumVisitedNodes = Mgr ? Mgr->GetLastNodesExpanded() : 0;
+	}
+	return bOk && (bReachedGoal || Query.bAllowPartialPaths);
+}
+
+ENavigationQueryResult::Type AGridNavigationData::CalcLengthAndCost(const FVector& PathStart, const FVector& PathEnd, FVector::FReal* OutLength, FVector::FReal* OutCost) const
+{
+	const UMapGridSubsystem* Grid = GetGrid();
+	if (!Grid) return ENavigationQueryResult::Error;
+
+	TArray<FIntPoint> Corners;
+	float Cost = 0.f;
+	bool bReachedGoal = false;
+	if (!ComputeGridPath(PathStart, PathEnd, false, Corners, Cost, bReachedGoal) || !bReachedGoal) return ENavigationQueryResult::Fail;
+
+	if (OutCost) *OutCost = Cost;
+	if (OutLength)
+	{
+		TArray<FNavPathPoint> Points;
+		BuildPathPoints(*Grid, Corners, PathStart, PathEnd, true, Points);
+		FVector::FReal Length = 0.;
+		for (int32 i = 1; i < Points.Num(); ++i) Length += FVector::Dist(Points[i - 1].Location, Points[i].Location);
+		*OutLength = Length;
+	}
+	return ENavigationQueryResult::Success;
+}
+
+ENavigationQueryResult::Type AGridNavigationData::CalcPathCost(const FVector& PathStart, const FVector& PathEnd, FVector::FReal& OutPathCost, FSharedConstNavQueryFilter QueryFilter, const UObject* Querier) const
+{
+	return CalcLengthAndCost(PathStart, PathEnd, nullptr, &OutPathCost);
+}
+
+ENavigationQueryResult::Type AGridNavigationData::CalcPathLength(const FVector& PathStart, const FVector& PathEnd, FVector::FReal& OutPathLength, FSharedConstNavQueryFilter QueryFilter, const UObject* Querier) const
+{
+	return CalcLengthAndCost(PathStart, PathEnd, &OutPathLength, nullptr);
+}
+
+ENavigationQueryResult::Type AGridNavigationData::CalcPathLengthAndCost(const FVector& PathStart, const FVector& PathEnd, FVector::FReal& OutPathLength, FVector::FReal& OutPathCost, FSharedConstNavQueryFilter QueryFilter, const UObject* Querier) const
+{
+	return CalcLengthAndCost(PathStart, PathEnd, &OutPathLength, &OutPathCost);
+}
+
+bool AGridNavigationData::DoesNodeContainLocation(NavNodeRef NodeRef, const FVector& WorldSpaceLocation) const
+{
+	const UMapGridSubsystem* Grid = GetGrid();
+	int32 X = 0, Y = 0;
+	if (!Grid || !Grid->WorldToGrid(WorldSpaceLocation, X, Y)) return false;
+	return CellToNodeRef(*Grid, FIntPoint(X, Y)) == NodeRef;
+}
+
+void AGridNavigationData::HandleGridCellChanged(FIntPoint Cell)
+{
+	const UMapGridSubsystem* Grid = GetGrid();
+	if (!Grid || Grid->GetWidth() <= 0) return;
+
+	// "Dirty area" barata: el grid ya est al da, slo hay que repedir las rutas afectadas.
+	// Los puntos son esquinas, as que cada tramo es un rectngulo de celdas entre dos NodeRef.
+	const int32 W = Grid->GetWidth();
+	const int32 R = InvalidationRadiusCells;
+	int32 NumInvalidated = 0;
+
+	FScopeLock PathLock(&ActivePathsLock);
+	for (int32 i = ActivePaths.Num() - 1; i >= 0; --i)
+	{
+		FNavPathSharedPtr Path = ActivePaths[i].Pin();
+		if (!Path.IsValid())
+		{
+			ActivePaths.RemoveAtSwap(i, 1, EAllowShrinking::No);
+			continue;
+		}
+		if (!Path->IsReady() || !Path->IsUpToDate() || Path->GetIgnoreInvalidation()) continue;
+
+		const TArray<FNavPathPoint>& Points = Path->GetPathPoints();
+		for (int32 k = 1; k < Points.Num(); ++k)
+		{
+			const int32 A = (int32)Points[k - 1].NodeRef, B = (int32)Points[k].NodeRef;
+			const FIntPoint Min(FMath::Min(A % W, B % W) - R, FMath::Min(A / W, B / W) - R);
+			const FIntPoint Max(FMath::Max(A % W, B % W) + R, FMath::Max(A / W, B / W) + R);
+			if (Cell.X >= Min.X && Cell.X <= Max.X && Cell.Y >= Min.Y && Cell.Y <= Max.Y)
+			{
+				Path->Invalidate();
+				++NumInvalidated;
+				break;
+			}
+		}
+	}
+
+	if (NumInvalidated > 0)
+	{
+		UE_LOG(LogTemp, Verbose, TEXT("[GridNav] Celda (%d,%d) cambiada: %d rutas invalidadas"), Cell.X, Cell.Y, NumInvalidated);
+	}
+}
@@ -0,0 +1,102 @@
+#include "Components/GridPathFollow/GridPath.h"
+#include "Components/GridPathFollow/GridSearch.h"
+#include "Map/MapGridSubsystem.h"
+
+FIntPoint FGridPath::RunDir(uint8 Run)
+{
+	return GridSearch::Dir4[Run >> 6];
+}
+
+void FGridPath::AppendStep(int32 Dir)
+{
+	// Extiende el ltimo run si va en la misma direccin y cabe (64 pasos mx.)
+	if (Runs.Num() > 0)
+	{
+		uint8& Last = Runs.Last();
+		if ((Last >> 6) == Dir && (Last & 0x3F) < 0x3F)
+		{
+			++Last;
+			++NumCells;
+			return;
+		}
+	}
+	Runs.Add((uint8)(Dir << 6));
+	++NumCells;
+}
+
+TSharedRef<FGridPath, ESPMode::ThreadSafe> FGridPath::Make(TConstArrayView<FIntPoint> Cells, const UMapGridSubsystem* Grid)
+{
+	TSharedRef<FGridPath, ESPMode::ThreadSafe> P = MakeShared<FGridPath, ESPMode::ThreadSafe>();
+	if (Cells.Num() == 0 || !ensureMsgf(Grid, TEXT("FGridPath::Make sin grid"))) return P;
+
+	// Un salto no se puede rellenar sin mirar muros: entrada invlida, ruta vaca
+	for (int32 i = 0; i < Cells.Num(); ++i)
+	{
+		if (!ensureMsgf(Grid->IsInside(Cells[i]), TEXT("FGridPath::Make: (%d,%d) fuera del grid"), Cells[i].X, Cells[i].Y))
+		{
+			return P;
+		}
+		if (i == 0) continue;
+		const FIntPoint D = Cells[i] - Cells[i - 1];
+		if (!ensureMsgf(FMath::Abs(D.X) + FMath::Abs(D.Y) <= 1, TEXT("FGridPath::Make: (%d,%d)->(%d,%d) no es adyacente"),
+			Cells[i - 1].X, Cells[i - 1].Y, Cells[i].X, Cells[i].Y))
+		{
+			return P;
+		}
+	}
+
+	P->StartCell = Cells[0];
+	P->NumCells = 1;
+	P->CornerCells.Add(Cells[0]);
+
+	int32 PrevDir = INDEX_NONE;
+	FIntPoint Cur = Cells[0];
+	for (int32 i = 1; i < Cells.Num(); ++i)
+	{
+		const FIntPoint Delta = Cells[i] - Cur;
+		if (Delta == FIntPoint::ZeroValue) continue; // espera en la misma celda
+		const int32 Dir = (Delta.X != 0) ? (Delta.X > 0 ? 1 : 3) : (Delta.Y > 0 ? 2 : 0);
+
+		// Esquina = celda donde se gira
+		if (PrevDir != INDEX_NONE && Dir != PrevDir) P->CornerCells.Add(Cur);
+		PrevDir = Dir;
+
+		P->AppendStep(Dir);
+		Cur = Cells[i];
+	}
+	if (P->CornerCells.Last() != Cur) P->CornerCells.Add(Cur);
+
+	P->Runs.Shrink();
+	P->CornerCells.Shrink();
+
+	P->CornersWorld.Reserve(P->CornerCells.Num());
+	for (const FIntPoint& C : P->CornerCells)
+	{
+		P->CornersWorld.Add(Grid->GridToWorld(C.X, C.Y));
+	}
+	return P;
+}
+
+TSharedRef<FGridPath, ESPMode::ThreadSafe> FGridPath::FromResult(const FGridPathResult& R, const UMapGridSubsystem* Grid)
+{
+	TSharedRef<FGridPath, ESPMode::ThreadSafe> P = Make(R.Cells, Grid);
+	P->PendingWaypoints = R.PendingWaypoints;
+	P->TotalCost = R.TotalCost;
+	P->bReachedGoal = R.bReachedGoal;
+	return P;
+}
+
+void FGridPath::Decode(TArray<FIntPoint>& OutCells) const
+{
+	OutCells.Reset(NumCells);
+	ForEachCell([&OutCells](const FIntPoint& C) { OutCells.Add(C); });
+}
+
+void FGridPath::ToResult(FGridPathResult& Out) const
+{
+	Decode(Out.Cells);
+	Out.PendingWaypoints = PendingWaypoints;
+	Out.TotalCost = TotalCost;
+	Out.bReachedGoal = bReachedGoal;
+	Out.bValid = IsValid();
+}
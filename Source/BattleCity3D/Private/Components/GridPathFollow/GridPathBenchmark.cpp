@@ -0,0 +1,333 @@
+#include "Components/GridPathFollow/GridPathManager.h"
+#include "Components/GridPathFollow/GridPath.h"
+#include "Components/EnemyMovement/EnemyAIManager.h"
+#include "Map/MapGridSubsystem.h"
+#include "Utils/JsonMapUtils.h"
+
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/DateTime.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonWriter.h"
+#include "Serialization/JsonSerializer.h"
+#include "JsonObjectConverter.h"
+#include "UObject/Package.h"
+
+// Benchmark de UGridPathManager sobre los mapas de JsonMaps y mapas procedurales.
+// Headless: UnrealEditor-Cmd BattleCity3D.uproject -game -nullrhi -unattended -ExecCmds="bc.path.bench; quit"
+
+namespace GridPathBench
+{
+	struct FMapCase
+	{
+		FString Name;
+		float BrickDensity = -1.f; // -1 = mapa del proyecto
+		FMapConfig Config;
+	};
+
+	struct FQuery
+	{
+		FIntPoint Start;
+		FIntPoint Goal;
+	};
+
+	static const FGridCostProfile BenchCost = { 1.f, 10.f, 1e9f };
+
+	static FMapConfig MakeProceduralMap(int32 Size, float BrickDensity, int32 Seed)
+	{
+		FMapConfig Map;
+		Map.width = Size;
+		Map.height = Size;
+		Map.tileSize = 100.f;
+		Map.legend.Add(TEXT("."), FLegendEntry{});
+		Map.legend.FindOrAdd(TEXT("B")).obstacle = TEXT("Brick");
+		Map.legend.FindOrAdd(TEXT("S")).obstacle = TEXT("Steel");
+		Map.legend.FindOrAdd(TEXT("W")).terrain = TEXT("Water");
+
+		FRandomStream Rng(Seed);
+		Map.rows.Reserve(Size);
+		for (int32 Y = 0; Y < Size; ++Y)
+		{
+			FString Row;
+			Row.Reserve(Size);
+			for (int32 X = 0; X < Size; ++X)
+			{
+				const float R = Rng.FRand();
+				// 4% acero + 4% agua fijos; la densidad de ladrillo es el parmetro
+				if (R < 0.04f)                     Row.AppendChar(TEXT('S'));
+				else if (R < 0.08f)                Row.AppendChar(TEXT('W'));
+				else if (R < 0.08f + BrickDensity) Row.AppendChar(TEXT('B'));
+				else                               Row.AppendChar(TEXT('.'));
+			}
+			Map.rows.Add(MoveTemp(Row));
+		}
+		return Map;
+	}
+
+	static void LoadShippedMaps(TArray<FMapCase>& Out)
+	{
+		TArray<FString> Files;
+		const FString Dir = FPaths::ProjectDir() / TEXT("JsonMaps");
+		IFileManager::Get().FindFiles(Files, *(Dir / TEXT("*.json")), true, false);
+		Files.Sort();
+
+		for (const FString& File : Files)
+		{
+			FString Text;
+			if (!FFileHelper::LoadFileToString(Text, *(Dir / File))) continue;
+
+			FMapCase Case;
+			Case.Name = FPaths::GetBaseFilename(File);
+			if (!FJsonObjectConverter::JsonObjectStringToUStruct(Text, &Case.Config, 0, 0))
+			{
+				UE_LOG(LogTemp, Warning, TEXT("[PathBench] No se pudo leer %s"), *File);
+				continue;
+			}
+			Out.Add(MoveTemp(Case));
+		}
+	}
+
+	static void MakeQueries(const UMapGridSubsystem* Grid, int32 Num, int32 Seed, TArray<FQuery>& Out)
+	{
+		FRandomStream Rng(Seed);
+		const FGridCostLUT Lut(BenchCost);
+		auto RandomOpenCell = [&]() -> FIntPoint
+			{
+				for (int32 Try = 0; Try < 256; ++Try)
+				{
+					const FIntPoint C(Rng.RandHelper(Grid->GetWidth()), Rng.RandHelper(Grid->GetHeight()));
+					if (Grid->IsPassableCell(C, Lut)) return C;
+				}
+				return FIntPoint::ZeroValue;
+			};
+
+		Out.Reset(Num);
+		for (int32 i = 0; i < Num; ++i)
+		{
+			Out.Add(FQuery{ RandomOpenCell(), RandomOpenCell() });
+		}
+	}
+
+	static double Percentile(const TArray<double>& Sorted, double P)
+	{
+		if (Sorted.Num() == 0) return 0.0;
+		const int32 Idx = FMath::Clamp(FMath::CeilToInt(P * Sorted.Num()) - 1, 0, Sorted.Num() - 1);
+		return Sorted[Idx];
+	}
+
+	static TSharedRef<FJsonObject> RunBatch(UGridPathManager* Mgr, UMapGridSubsystem* Grid, const FMapCase& Case,
+		const TArray<FQuery>& Queries, EGridPathPlanner Planner, bool bCache, int32 Passes)
+	{
+		Mgr->PathCacheCapacity = bCache ? 256 : 0;
+		Mgr->ResetCache();
+
+		FGridPathRequest Req;
+		Req.Grid = Grid;
+		Req.Cost = BenchCost;
+		Req.Planner = Planner;
+
+		// Primera consulta aparte: incluye construir estructuras precalculadas (jerarqua, etc.)
+		Req.Start = Queries[0].Start;
+		Req.Goal = Queries[0].Goal;
+		const uint64 FirstStart = FPlatformTime::Cycles64();
+		Mgr->ComputePathShared(Req);
+		const double FirstUs = FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - FirstStart) * 1e6;
+		Mgr->ResetCache();
+
+		TArray<double> LatUs;
+		TArray<double> Expanded;
+		LatUs.Reserve(Queries.Num() * Passes);
+		Expanded.Reserve(Queries.Num() * Passes);
+		// Reservas por consulta con el contador de -bcaialloccount (incluye la ruta devuelta y lo que
+		// crezca el scratch); PathBytes = tamao de la ruta devuelta
+		int64 Allocs = 0;
+		int64 AllocBytes = 0;
+		int64 PathBytes = 0;
+		int32 Reached = 0;
+
+		for (int32 Pass = 0; Pass < Passes; ++Pass)
+		{
+			for (const FQuery& Q : Queries)
+			{
+				Req.Start = Q.Start;
+				Req.Goal = Q.Goal;
+
+				FGridPathRef Path;
+				{
+#if BC_AI_ALLOC_COUNT
+					FBCAllocCountScope AllocScope;
+#endif
+					const uint64 T0 = FPlatformTime::Cycles64();
+					Path = Mgr->ComputePathShared(Req);
+					LatUs.Add(FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - T0) * 1e6);
+#if BC_AI_ALLOC_COUNT
+					Allocs += AllocScope.GetAllocs();
+					AllocBytes += AllocScope.GetBytes();
+#endif
+				}
+				Expanded.Add(Mgr->GetLastNodesExpanded());
+
+				if (Path.IsValid())
+				{
+					PathBytes += Path->GetAllocatedSize();
+					if (Path->bReachedGoal) ++Reached;
+				}
+			}
+		}
+
+		double SumUs = 0.0, SumExp = 0.0;
+		for (double V : LatUs) SumUs += V;
+		for (double V : Expanded) SumExp += V;
+		LatUs.Sort();
+		Expanded.Sort();
+		const int32 N = FMath::Max(1, LatUs.Num());
+
+		const UEnum* PlannerEnum = StaticEnum<EGridPathPlanner>();
+		TSharedRef<FJsonObject> J = MakeShared<FJsonObject>();
+		J->SetStringField(TEXT("map"), Case.Name);
+		J->SetNumberField(TEXT("width"), Grid->GetWidth());
+		J->SetNumberField(TEXT("height"), Grid->GetHeight());
+		J->SetNumberField(TEXT("brickDensity"), Case.BrickDensity);
+		J->SetStringField(TEXT("planner"), PlannerEnum->GetNameStringByValue((int64)Planner));
+		J->SetBoolField(TEXT("cache"), bCache);
+		J->SetNumberField(TEXT("queries"), LatUs.Num());
+		J->SetNumberField(TEXT("reachedGoal"), Reached);
+		J->SetNumberField(TEXT("firstQueryUs"), FirstUs);
+		J->SetNumberField(TEXT("meanUs"), SumUs / N);
+		J->SetNumberField(TEXT("p50Us"), Percentile(LatUs, 0.50));
+		J->SetNumberField(TEXT("p99Us"), Percentile(LatUs, 0.99));
+		J->SetNumberField(TEXT("nodesExpandedMean"), SumExp / N);
+		J->SetNumberField(TEXT("nodesExpandedP99"), Percentile(Expanded, 0.99));
+#if BC_AI_ALLOC_COUNT
+		if (FBCAllocCountScope::IsInstalled())
+		{
+			J->SetNumberField(TEXT("allocsPerQuery"), (double)Allocs / N);
+			J->SetNumberField(TEXT("allocBytesPerQuery"), (double)AllocBytes / N);
+		}
+#endif
+		J->SetNumberField(TEXT("pathBytesPerQuery"), (double)PathBytes / N);
+		J->SetNumberField(TEXT("scratchBytes"), (double)Mgr->GetScratchAllocatedSize());
+		if (bCache)
+		{
+			const FGridPathCacheStats S = Mgr->GetCacheStats();
+			J->SetNumberField(TEXT("cacheHitRate"), S.GetHitRate());
+			J->SetNumberField(TEXT("cacheBytes"), (double)S.Bytes);
+		}
+
+		UE_LOG(LogTemp, Display, TEXT("[PathBench] %-14s %4dx%-4d %-12s%s q=%4d p50=%9.1fus p99=%9.1fus exp=%9.0f first=%9.1fus allocs=%.1f (%.0f B)"),
+			*Case.Name, Grid->GetWidth(), Grid->GetHeight(), *PlannerEnum->GetNameStringByValue((int64)Planner),
+			bCache ? TEXT("+cache") : TEXT("      "), LatUs.Num(),
+			Percentile(LatUs, 0.50), Percentile(LatUs, 0.99), SumExp / N, FirstUs, (double)Allocs / N, (double)AllocBytes / N);
+		return J;
+	}
+
+	static void Run(const TArray<FString>& Args)
+	{
+		const FString Line = FString::Join(Args, TEXT(" "));
+
+		int32 Seed = 1337;
+		int32 BaseQueries = 200;
+		FString SizesStr = TEXT("64,128,256,512,1024,2048");
+		FString DensStr = TEXT("0.1,0.3");
+		FString OutPath;
+		FParse::Value(*Line, TEXT("seed="), Seed);
+		FParse::Value(*Line, TEXT("queries="), BaseQueries);
+		FParse::Value(*Line, TEXT("sizes="), SizesStr, false);
+		FParse::Value(*Line, TEXT("density="), DensStr, false);
+		FParse::Value(*Line, TEXT("out="), OutPath);
+		if (Line.Contains(TEXT("quick"))) SizesStr = TEXT("64,128,256");
+
+#if BC_AI_ALLOC_COUNT
+		if (!FBCAllocCountScope::IsInstalled())
+#endif
+		{
+			UE_LOG(LogTemp, Warning, TEXT("[PathBench] Sin contador de reservas: arranca con -bcaialloccount (no Shipping) para allocsPerQuery/allocBytesPerQuery"));
+		}
+
+		TArray<FMapCase> Cases;
+		LoadShippedMaps(Cases);
+
+		TArray<FString> Sizes, Densities;
+		SizesStr.ParseIntoArray(Sizes, TEXT(","));
+		DensStr.ParseIntoArray(Densities, TEXT(","));
+		for (const FString& SizeS : Sizes)
+		{
+			for (const FString& DensS : Densities)
+			{
+				const int32 Size = FCString::Atoi(*SizeS);
+				const float Dens = FCString::Atof(*DensS);
+				if (Size <= 0) continue;
+
+				FMapCase Case;
+				Case.Name = FString::Printf(TEXT("Gen%d_b%02d"), Size, FMath::RoundToInt(Dens * 100.f));
+				Case.BrickDensity = Dens;
+				Case.Config = MakeProceduralMap(Size, Dens, Seed + Size);
+				Cases.Add(MoveTemp(Case));
+			}
+		}
+
+		// Objetos sueltos: no tocan el grid/manager de la partida en curso
+		UMapGridSubsystem* Grid = NewObject<UMapGridSubsystem>(GetTransientPackage());
+		UGridPathManager* Mgr = NewObject<UGridPathManager>(GetTransientPackage());
+		Grid->AddToRoot();
+		Mgr->AddToRoot();
+
+		const UEnum* PlannerEnum = StaticEnum<EGridPathPlanner>();
+		TArray<TSharedPtr<FJsonValue>> Results;
+
+		for (const FMapCase& Case : Cases)
+		{
+			if (!Grid->InitializeFromConfig(Case.Config, FTransform::Identity)) continue;
+
+			// Menos consultas en mapas enormes (A* plano completo es O(celdas))
+			const int32 Cells = Grid->GetWidth() * Grid->GetHeight();
+			const int32 NumQueries = FMath::Clamp((int32)((int64)BaseQueries * 256 * 256 / FMath::Max(1, Cells)), 16, BaseQueries);
+
+			TArray<FQuery> Queries;
+			MakeQueries(Grid, NumQueries, Seed, Queries);
+			if (Queries.Num() == 0) continue;
+
+			// Todos los planificadores que expone el manager (sin cach), y Auto con cach (2 pasadas)
+			for (int32 i = 0; i < PlannerEnum->NumEnums() - 1; ++i)
+			{
+				const EGridPathPlanner Planner = (EGridPathPlanner)PlannerEnum->GetValueByIndex(i);
+				Results.Add(MakeShared<FJsonValueObject>(RunBatch(Mgr, Grid, Case, Queries, Planner, false, 1)));
+			}
+			Results.Add(MakeShared<FJsonValueObject>(RunBatch(Mgr, Grid, Case, Queries, EGridPathPlanner::Auto, true, 2)));
+		}
+
+		Mgr->RemoveFromRoot();
+		Grid->RemoveFromRoot();
+
+		TSharedRef<FJsonObject> Root = MakeShared<FJsonObject>();
+		Root->SetStringField(TEXT("timestamp"), FDateTime::UtcNow().ToIso8601());
+		Root->SetNumberField(TEXT("seed"), Seed);
+		Root->SetArrayField(TEXT("results"), Results);
+
+		FString Json;
+		const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Json);
+		FJsonSerializer::Serialize(Root, Writer);
+
+		if (OutPath.IsEmpty())
+		{
+			OutPath = FPaths::ProjectSavedDir() / TEXT("Benchmarks") / FString::Printf(TEXT("PathBench-%s.json"), *FDateTime::Now().ToString());
+		}
+		if (FFileHelper::SaveStringToFile(Json, *OutPath))
+		{
+			UE_LOG(LogTemp, Display, TEXT("[PathBench] Resultados: %s"), *OutPath);
+		}
+		else
+		{
+			UE_LOG(LogTemp, Error, TEXT("[PathBench] No se pudo escribir %s"), *OutPath);
+		}
+	}
+}
+
+// Uso en consola: bc.path.bench [quick] [sizes=64,256] [density=0.1,0.3] [queries=200] [seed=1337] [out=Ruta.json]
+static FAutoConsoleCommand GBcPathBenchCmd(
+	TEXT("bc.path.bench"),
+	TEXT("Benchmark de pathfinding (todos los planificadores) sobre JsonMaps y mapas procedurales; escribe JSON en Saved/Benchmarks."),
+	FConsoleCommandWithArgsDelegate::CreateStatic(&GridPathBench::Run));
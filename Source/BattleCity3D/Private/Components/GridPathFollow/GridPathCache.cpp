@@ -0,0 +1,150 @@
+#include "Components/GridPathFollow/GridPathCache.h"
+
+void FGridPathCache::Configure(int32 InCapacity, int32 InRegionSize)
+{
+	Capacity = FMath::Max(1, InCapacity);
+	RegionSize = FMath::Max(1, InRegionSize);
+	Reset();
+}
+
+void FGridPathCache::Reset()
+{
+	Entries.Reset();
+	FreeSlots.Reset();
+	SlotByKey.Reset();
+	SlotsByRegion.Reset();
+	Head = Tail = INDEX_NONE;
+	Stats.Entries = 0;
+	Stats.Bytes = 0;
+}
+
+void FGridPathCache::ResetStats()
+{
+	// Entries/Bytes reflejan el contenido actual, no se reinician
+	FGridPathCacheStats Fresh;
+	Fresh.Entries = Stats.Entries;
+	Fresh.Bytes = Stats.Bytes;
+	Stats = Fresh;
+}
+
+void FGridPathCache::Unlink(int32 Slot)
+{
+	FEntry& E = Entries[Slot];
+	if (E.Prev != INDEX_NONE) Entries[E.Prev].Next = E.Next; else Head = E.Next;
+	if (E.Next != INDEX_NONE) Entries[E.Next].Prev = E.Prev; else Tail = E.Prev;
+	E.Prev = E.Next = INDEX_NONE;
+}
+
+void FGridPathCache::LinkFront(int32 Slot)
+{
+	FEntry& E = Entries[Slot];
+	E.Prev = INDEX_NONE;
+	E.Next = Head;
+	if (Head != INDEX_NONE) Entries[Head].Prev = Slot;
+	Head = Slot;
+	if (Tail == INDEX_NONE) Tail = Slot;
+}
+
+void FGridPathCache::RemoveSlot(int32 Slot)
+{
+	FEntry& E = Entries[Slot];
+	Unlink(Slot);
+
+	for (uint32 Region : E.Regions)
+	{
+		if (TArray<int32>* List = SlotsByRegion.Find(Region))
+		{
+			List->RemoveSingleSwap(Slot, EAllowShrinking::No);
+			if (List->Num() == 0) SlotsByRegion.Remove(Region);
+		}
+	}
+
+	SlotByKey.Remove(E.Key);
+	Stats.Bytes -= E.Bytes;
+	--Stats.Entries;
+
+	E.Path.Reset(); // los seguidores que an la usan conservan su referencia
+	E.Regions.Reset();
+	FreeSlots.Add(Slot);
+}
+
+FGridPathRef FGridPathCache::Find(const FGridPathCacheKey& Key)
+{
+	const int32* Slot = SlotByKey.Find(Key);
+	if (!Slot)
+	{
+		++Stats.Misses;
+		return nullptr;
+	}
+
+	++Stats.Hits;
+	if (Head != *Slot)
+	{
+		Unlink(*Slot);
+		LinkFront(*Slot);
+	}
+	return Entries[*Slot].Path;
+}
+
+void FGridPathCache::Add(const FGridPathCacheKey& Key, const FGridPathRef& Path)
+{
+	// Parciales fuera: su resultado depende de celdas que no recorren (ver cabecera)
+	if (!Path.IsValid() || !Path->bReachedGoal) return;
+
+	if (const int32* Existing = SlotByKey.Find(Key))
+	{
+		RemoveSlot(*Existing);
+	}
+	while (Stats.Entries >= Capacity && Tail != INDEX_NONE)
+	{
+		RemoveSlot(Tail);
+		++Stats.Evictions;
+	}
+
+	const int32 Slot = FreeSlots.Num() > 0 ? FreeSlots.Pop(EAllowShrinking::No) : Entries.AddDefaulted();
+	FEntry& E = Entries[Slot];
+	E.Key = Key;
+	E.Path = Path;
+	E.Regions.Reset();
+
+	// Regiones recorridas; los tramos HPA* an sin refinar cubren su rectngulo
+	Path->ForEachCell([this, &E](const FIntPoint& C) { E.Regions.AddUnique(RegionOf(C)); });
+	FIntPoint Prev = Path->GetNumCells() > 0 ? Path->GetEndCell() : Key.Start;
+	for (const FIntPoint& W : Path->PendingWaypoints)
+	{
+		for (int32 RY = FMath::Min(Prev.Y, W.Y) / RegionSize; RY <= FMath::Max(Prev.Y, W.Y) / RegionSize; ++RY)
+		{
+			for (int32 RX = FMath::Min(Prev.X, W.X) / RegionSize; RX <= FMath::Max(Prev.X, W.X) / RegionSize; ++RX)
+			{
+				E.Regions.AddUnique(PackRegion(RX, RY));
+			}
+		}
+		Prev = W;
+	}
+
+	for (uint32 Region : E.Regions)
+	{
+		SlotsByRegion.FindOrAdd(Region).Add(Slot);
+	}
+
+	E.Bytes = (int64)Path->GetAllocatedSize() + E.Regions.GetAllocatedSize();
+	Stats.Bytes += E.Bytes;
+	++Stats.Entries;
+
+	SlotByKey.Add(Key, Slot);
+	LinkFront(Slot);
+}
+
+void FGridPathCache::InvalidateCell(const FIntPoint& Cell)
+{
+	const TArray<int32>* List = SlotsByRegion.Find(RegionOf(Cell));
+	if (!List) return;
+
+	// Copia: RemoveSlot modifica la lista de la regin
+	const TArray<int32> Slots = *List;
+	for (int32 Slot : Slots)
+	{
+		RemoveSlot(Slot);
+		++Stats.Invalidations;
+	}
+}
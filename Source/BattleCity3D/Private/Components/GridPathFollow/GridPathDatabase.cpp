@@ -0,0 +1,88 @@
+#include "Components/GridPathFollow/GridPathDatabase.h"
+#include "Components/GridPathFollow/GridSearch.h"
+#include "Map/MapGridSubsystem.h"
+#include "Algo/BinarySearch.h"
+
+void FGridPathDatabase::Reset()
+{
+	Width = Height = 0;
+	RowStart.Reset();
+	Runs.Reset();
+}
+
+void FGridPathDatabase::Build(const UMapGridSubsystem* Grid)
+{
+	Reset();
+	if (!Grid || Grid->GetWidth() <= 0 || Grid->GetHeight() <= 0) return;
+
+	const FGridBitboard& Walkable = Grid->GetWalkableBits();
+	if (Walkable.IsEmpty()) return;
+
+	const double T0 = FPlatformTime::Seconds();
+	Width = Grid->GetWidth();
+	Height = Grid->GetHeight();
+	const int32 N = Width * Height;
+
+	TArray<uint8> First;
+	TArray<int32> Queue;
+	First.SetNumUninitialized(N);
+	Queue.SetNumUninitialized(N);
+	RowStart.SetNumUninitialized(N + 1);
+
+	for (int32 S = 0; S < N; ++S)
+	{
+		RowStart[S] = Runs.Num();
+		const FIntPoint SC(S % Width, S / Width);
+		if (!Walkable.Get(SC.X, SC.Y)) continue; // ningn tanque arranca en acero/agua
+
+		// BFS de coste unitario: el primer movimiento se hereda del padre
+		FMemory::Memset(First.GetData(), NoMove, N);
+		int32 Head = 0, Tail = 0;
+		Queue[Tail++] = S;
+		while (Head < Tail)
+		{
+			const int32 U = Queue[Head++];
+			const FIntPoint UC(U % Width, U / Width);
+			for (int32 Dir = 0; Dir < 4; ++Dir)
+			{
+				const FIntPoint V = UC + GridSearch::Dir4[Dir];
+				if (!Walkable.Get(V.X, V.Y)) continue;
+				const int32 VI = V.X + V.Y * Width;
+				if (VI == S || First[VI] != NoMove) continue;
+				First[VI] = (U == S) ? (uint8)Dir : First[U];
+				Queue[Tail++] = VI;
+			}
+		}
+
+		// RLE sobre destinos; NoMove es comodn y alarga el run actual
+		uint8 Current = NoMove;
+		for (int32 T = 0; T < N; ++T)
+		{
+			const uint8 M = First[T];
+			if (M == NoMove || M == Current) continue;
+			Runs.Add(((uint32)(Runs.Num() == RowStart[S] ? 0 : T) << 3) | M);
+			Current = M;
+		}
+	}
+	RowStart[N] = Runs.Num();
+	Runs.Shrink();
+
+	UE_LOG(LogTemp, Log, TEXT("[PathDB] %dx%d: %d runs (%.2f por celda), %lld bytes, %.1f ms"),
+		Width, Height, Runs.Num(), (float)Runs.Num() / N, (int64)GetAllocatedSize(), (FPlatformTime::Seconds() - T0) * 1000.0);
+}
+
+uint8 FGridPathDatabase::GetFirstMove(const FIntPoint& From, const FIntPoint& To) const
+{
+	if (!IsBuilt() || From.X < 0 || From.Y < 0 || From.X >= Width || From.Y >= Height
+		|| To.X < 0 || To.Y < 0 || To.X >= Width || To.Y >= Height) return NoMove;
+
+	const int32 S = From.X + From.Y * Width;
+	const int32 Begin = RowStart[S];
+	const int32 Num = RowStart[S + 1] - Begin;
+	if (Num == 0) return NoMove;
+
+	// ltimo run cuyo destino inicial <= To
+	const uint32 Key = ((uint32)(To.X + To.Y * Width) << 3) | 7u;
+	const int32 Pos = Algo::UpperBound(TConstArrayView<uint32>(Runs.GetData() + Begin, Num), Key) - 1;
+	return Pos >= 0 ? (uint8)(Runs[Begin + Pos] & 7u) : NoMove;
+}
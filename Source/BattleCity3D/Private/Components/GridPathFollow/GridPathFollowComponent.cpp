@@ -4,9 +4,10 @@
 #include "Components/GridPathFollow/GridPathFollowComponent.h"
 #include "Map/MapGridSubsystem.h"
 
-FVector UGridPathFollowComponent::GridToWorld(const FIntPoint& C, float TileSize) const
+void UGridPathFollowComponent::SetPath(UMapGridSubsystem* InGrid, const FGridPathResult& InPath)
 {
-	if (Grid)
-		return Grid->GridToWorld(C.X, C.Y); // usa tu conversin precisa
-	return FVector(C.X * 200.f, C.Y * 200.f, 0.f); // fallback
+	// Entrada Blueprint: se codifica una vez y las esquinas quedan en mundo
+	FGridPathRef Shared;
+	if (InPath.bValid) Shared = FGridPath::FromResult(InPath, InGrid);
+	SetSharedPath(InGrid, Shared);
 }
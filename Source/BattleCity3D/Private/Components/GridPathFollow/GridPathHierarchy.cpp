@@ -0,0 +1,362 @@
+#include "Components/GridPathFollow/GridPathHierarchy.h"
+#include "Map/MapGridSubsystem.h"
+#include "Misc/ScopeExit.h"
+
+// Tramos de frontera ms cortos que esto -> 1 entrada (centro); si no, 2 (extremos).
+static constexpr int32 HPA_LongEntranceLen = 6;
+
+void FGridPathHierarchy::Build(const UMapGridSubsystem* InGrid, const FGridCostProfile& InCost, int32 InClusterSize)
+{
+	Grid = InGrid;
+	Cost = InCost;
+	Lut = FGridCostLUT(InCost);
+	ClusterSize = FMath::Max(4, InClusterSize);
+
+	Nodes.Reset();
+	FreeNodes.Reset();
+	NodeByCell.Reset();
+	ClusterNodes.Reset();
+
+	if (!Grid || Grid->GetWidth() <= 0 || Grid->GetHeight() <= 0)
+	{
+		Grid = nullptr;
+		return;
+	}
+
+	ClustersX = FMath::DivideAndRoundUp(Grid->GetWidth(), ClusterSize);
+	ClustersY = FMath::DivideAndRoundUp(Grid->GetHeight(), ClusterSize);
+	ClusterNodes.SetNum(ClustersX * ClustersY);
+
+	for (int32 CY = 0; CY < ClustersY; ++CY)
+	{
+		for (int32 CX = 0; CX < ClustersX; ++CX)
+		{
+			const int32 K = CX + CY * ClustersX;
+			if (CX + 1 < ClustersX) BuildBorder(K, /*bVertical*/true);
+			if (CY + 1 < ClustersY) BuildBorder(K, /*bVertical*/false);
+		}
+	}
+
+	for (int32 K = 0; K < ClusterNodes.Num(); ++K)
+	{
+		RebuildIntra(K);
+	}
+}
+
+SIZE_T FGridPathHierarchy::GetAllocatedSize() const
+{
+	SIZE_T Bytes = Nodes.GetAllocatedSize() + FreeNodes.GetAllocatedSize() + ClusterNodes.GetAllocatedSize()
+		+ NodeByCell.GetAllocatedSize() + Scratch.GetAllocatedSize() + AbstractScratch.GetAllocatedSize();
+	for (const FNode& N : Nodes) Bytes += N.Edges.GetAllocatedSize();
+	for (const TArray<int32>& L : ClusterNodes) Bytes += L.GetAllocatedSize();
+	return Bytes;
+}
+
+float FGridPathHierarchy::CellCost(const FIntPoint& C) const
+{
+	return Grid ? Grid->GetTileCost(C, Lut) : Cost.ImpassableCost;
+}
+
+int32 FGridPathHierarchy::GetClusterOf(const FIntPoint& Cell) const
+{
+	return (Cell.X / ClusterSize) + (Cell.Y / ClusterSize) * ClustersX;
+}
+
+FGridSearchBounds FGridPathHierarchy::GetClusterBounds(int32 Cluster) const
+{
+	const int32 CX = Cluster % ClustersX;
+	const int32 CY = Cluster / ClustersX;
+	const int32 MinX = CX * ClusterSize;
+	const int32 MinY = CY * ClusterSize;
+	return FGridSearchBounds(MinX, MinY,
+		FMath::Min(MinX + ClusterSize, Grid->GetWidth()) - 1,
+		FMath::Min(MinY + ClusterSize, Grid->GetHeight()) - 1);
+}
+
+FGridSearchBounds FGridPathHierarchy::GetSegmentBounds(const FIntPoint& A, const FIntPoint& B) const
+{
+	return GetClusterBounds(GetClusterOf(A)).Union(GetClusterBounds(GetClusterOf(B)));
+}
+
+int32 FGridPathHierarchy::FindOrAddNode(const FIntPoint& Cell)
+{
+	if (const int32* Found = NodeByCell.Find(Cell)) return *Found;
+
+	const int32 Idx = FreeNodes.Num() > 0 ? FreeNodes.Pop(EAllowShrinking::No) : Nodes.AddDefaulted();
+	FNode& N = Nodes[Idx];
+	N.Cell = Cell;
+	N.Cluster = GetClusterOf(Cell);
+	N.bAlive = true;
+	N.Edges.Reset();
+
+	NodeByCell.Add(Cell, Idx);
+	ClusterNodes[N.Cluster].Add(Idx);
+	return Idx;
+}
+
+void FGridPathHierarchy::RemoveNode(int32 NodeIdx)
+{
+	FNode& N = Nodes[NodeIdx];
+	if (!N.bAlive) return;
+
+	// Aristas entrantes intra-cluster (las inter ya se quitaron en ClearBorder)
+	for (int32 Other : ClusterNodes[N.Cluster])
+	{
+		if (Other == NodeIdx) continue;
+		Nodes[Other].Edges.RemoveAllSwap([NodeIdx](const FEdge& E) { return E.To == NodeIdx; }, EAllowShrinking::No);
+	}
+
+	ClusterNodes[N.Cluster].RemoveSingleSwap(NodeIdx, EAllowShrinking::No);
+	NodeByCell.Remove(N.Cell);
+	N.Edges.Reset();
+	N.bAlive = false;
+	FreeNodes.Add(NodeIdx);
+}
+
+void FGridPathHierarchy::AddEntrance(const FIntPoint& A, const FIntPoint& B)
+{
+	const int32 NA = FindOrAddNode(A);
+	const int32 NB = FindOrAddNode(B);
+	// Coste de ENTRAR en la celda destino (igual que en el A* plano)
+	Nodes[NA].Edges.Add(FEdge{ NB, CellCost(B) });
+	Nodes[NB].Edges.Add(FEdge{ NA, CellCost(A) });
+}
+
+void FGridPathHierarchy::BuildBorder(int32 ClusterA, bool bVertical)
+{
+	const FGridSearchBounds BA = GetClusterBounds(ClusterA);
+	const FIntPoint Step = bVertical ? FIntPoint(1, 0) : FIntPoint(0, 1);
+	const FIntPoint Along = bVertical ? FIntPoint(0, 1) : FIntPoint(1, 0);
+	const FIntPoint First = bVertical ? FIntPoint(BA.MaxX, BA.MinY) : FIntPoint(BA.MinX, BA.MaxY);
+	const int32 Len = bVertical ? BA.Height() : BA.Width();
+
+	auto EmitRun = [&](int32 RunStart, int32 RunLen)
+		{
+			if (RunLen <= 0) return;
+			if (RunLen < HPA_LongEntranceLen)
+			{
+				const FIntPoint A = First + Along * (RunStart + RunLen / 2);
+				AddEntrance(A, A + Step);
+			}
+			else
+			{
+				const FIntPoint A0 = First + Along * RunStart;
+				const FIntPoint A1 = First + Along * (RunStart + RunLen - 1);
+				AddEntrance(A0, A0 + Step);
+				AddEntrance(A1, A1 + Step);
+			}
+		};
+
+	int32 RunStart = INDEX_NONE;
+	for (int32 i = 0; i < Len; ++i)
+	{
+		const FIntPoint A = First + Along * i;
+		const bool bOpen = IsOpenCell(A) && IsOpenCell(A + Step);
+		if (bOpen && RunStart == INDEX_NONE) RunStart = i;
+		if (!bOpen && RunStart != INDEX_NONE)
+		{
+			EmitRun(RunStart, i - RunStart);
+			RunStart = INDEX_NONE;
+		}
+	}
+	if (RunStart != INDEX_NONE) EmitRun(RunStart, Len - RunStart);
+}
+
+void FGridPathHierarchy::ClearBorder(int32 ClusterA, bool bVertical)
+{
+	const FGridSearchBounds BA = GetClusterBounds(ClusterA);
+	const FIntPoint Step = bVertical ? FIntPoint(1, 0) : FIntPoint(0, 1);
+	const FIntPoint Along = bVertical ? FIntPoint(0, 1) : FIntPoint(1, 0);
+	const FIntPoint First = bVertical ? FIntPoint(BA.MaxX, BA.MinY) : FIntPoint(BA.MinX, BA.MaxY);
+	const int32 Len = bVertical ? BA.Height() : BA.Width();
+
+	auto DropCrossing = [this](const FIntPoint& Cell, const FIntPoint& Across)
+		{
+			const int32* Idx = NodeByCell.Find(Cell);
+			if (!Idx) return;
+			const int32 NodeIdx = *Idx;
+			FNode& N = Nodes[NodeIdx];
+			N.Edges.RemoveAllSwap([this, Across](const FEdge& E) { return Nodes[E.To].Cell == Across; }, EAllowShrinking::No);
+
+			// Sin aristas hacia otros clusters -> ya no es entrada (puede serlo de otra frontera en esquinas)
+			const bool bStillEntrance = N.Edges.ContainsByPredicate([this, &N](const FEdge& E) { return Nodes[E.To].Cluster != N.Cluster; });
+			if (!bStillEntrance) RemoveNode(NodeIdx);
+		};
+
+	for (int32 i = 0; i < Len; ++i)
+	{
+		const FIntPoint A = First + Along * i;
+		DropCrossing(A, A + Step);
+		DropCrossing(A + Step, A);
+	}
+}
+
+FGridSearchBounds FGridPathHierarchy::RunClusterDijkstra(const FIntPoint& Cell, int32* InOutExpanded)
+{
+	const FGridSearchBounds B = GetClusterBounds(GetClusterOf(Cell));
+	const int32 Expanded = GridSearch::RunDijkstra(Scratch, B, Cell, Cost.ImpassableCost,
+		[this](const FIntPoint& C) { return CellCost(C); });
+	if (InOutExpanded) *InOutExpanded += Expanded;
+	return B;
+}
+
+float FGridPathHierarchy::ScratchCost(const FGridSearchBounds& B, const FIntPoint& Cell) const
+{
+	return B.Contains(Cell) ? Scratch.GetClosedCost(B.ToIndex(Cell)) : TNumericLimits<float>::Max();
+}
+
+void FGridPathHierarchy::RebuildIntra(int32 Cluster)
+{
+	const TArray<int32>& Members = ClusterNodes[Cluster];
+
+	for (int32 NodeIdx : Members)
+	{
+		FNode& N = Nodes[NodeIdx];
+		N.Edges.RemoveAllSwap([this, &N](const FEdge& E) { return Nodes[E.To].Cluster == N.Cluster; }, EAllowShrinking::No);
+	}
+
+	for (int32 NodeIdx : Members)
+	{
+		const FGridSearchBounds B = RunClusterDijkstra(Nodes[NodeIdx].Cell);
+		for (int32 Other : Members)
+		{
+			if (Other == NodeIdx) continue;
+			const float D = ScratchCost(B, Nodes[Other].Cell);
+			if (D < TNumericLimits<float>::Max())
+			{
+				Nodes[NodeIdx].Edges.Add(FEdge{ Other, D });
+			}
+		}
+	}
+}
+
+void FGridPathHierarchy::OnCellChanged(const FIntPoint& Cell)
+{
+	if (!Grid || Cell.X < 0 || Cell.Y < 0 || Cell.X >= Grid->GetWidth() || Cell.Y >= Grid->GetHeight()) return;
+
+	const int32 K = GetClusterOf(Cell);
+	const int32 CX = K % ClustersX;
+	const int32 CY = K / ClustersX;
+	const FGridSearchBounds B = GetClusterBounds(K);
+
+	// Fronteras tocadas: (cluster "A", vertical?)
+	TArray<TPair<int32, bool>, TInlineAllocator<4>> Borders;
+	if (Cell.X == B.MinX && CX > 0)             Borders.Add({ K - 1, true });
+	if (Cell.X == B.MaxX && CX + 1 < ClustersX) Borders.Add({ K, true });
+	if (Cell.Y == B.MinY && CY > 0)             Borders.Add({ K - ClustersX, false });
+	if (Cell.Y == B.MaxY && CY + 1 < ClustersY) Borders.Add({ K, false });
+
+	TArray<int32, TInlineAllocator<5>> Dirty;
+	Dirty.Add(K);
+
+	for (const TPair<int32, bool>& Border : Borders) ClearBorder(Border.Key, Border.Value);
+	for (const TPair<int32, bool>& Border : Borders)
+	{
+		BuildBorder(Border.Key, Border.Value);
+		Dirty.AddUnique(Border.Key);
+		Dirty.AddUnique(Border.Value ? Border.Key + 1 : Border.Key + ClustersX);
+	}
+
+	for (int32 D : Dirty) RebuildIntra(D);
+}
+
+bool FGridPathHierarchy::FindAbstractPath(const FIntPoint& Start, const FIntPoint& Goal, TArray<FIntPoint>& OutWaypoints, float* OutCost, int32* OutNodesExpanded)
+{
+	OutWaypoints.Reset();
+	int32 Expanded = 0;
+	ON_SCOPE_EXIT{ if (OutNodesExpanded) *OutNodesExpanded = Expanded; };
+
+	if (!Grid || !IsOpenCell(Goal)) return false;
+
+	const int32 KS = GetClusterOf(Start);
+	const int32 KG = GetClusterOf(Goal);
+
+	// Start -> entradas de su cluster (y directo a Goal si comparten cluster)
+	TArray<FEdge, TInlineAllocator<32>> StartEdges;
+	float DirectCost = TNumericLimits<float>::Max();
+	{
+		const FGridSearchBounds B = RunClusterDijkstra(Start, &Expanded);
+		for (int32 NodeIdx : ClusterNodes[KS])
+		{
+			const float D = ScratchCost(B, Nodes[NodeIdx].Cell);
+			if (D < TNumericLimits<float>::Max()) StartEdges.Add(FEdge{ NodeIdx, D });
+		}
+		if (KS == KG) DirectCost = ScratchCost(B, Goal);
+	}
+
+	// Entradas del cluster de Goal -> Goal. d(n->g) = d(g->n) - c(n) + c(g)
+	TArray<FEdge, TInlineAllocator<32>> GoalEdges;
+	{
+		const float GoalCellCost = CellCost(Goal);
+		const FGridSearchBounds B = RunClusterDijkstra(Goal, &Expanded);
+		for (int32 NodeIdx : ClusterNodes[KG])
+		{
+			const float D = ScratchCost(B, Nodes[NodeIdx].Cell);
+			if (D < TNumericLimits<float>::Max())
+			{
+				GoalEdges.Add(FEdge{ NodeIdx, D - CellCost(Nodes[NodeIdx].Cell) + GoalCellCost });
+			}
+		}
+	}
+
+	// A* abstracto: [0, N) nodos, N = Start, N+1 = Goal
+	const int32 N = Nodes.Num();
+	const int32 SIdx = N;
+	const int32 GIdx = N + 1;
+	const float MinStep = MinStepCost();
+
+	auto CellOf = [&](int32 Idx) -> FIntPoint { return Idx == SIdx ? Start : (Idx == GIdx ? Goal : Nodes[Idx].Cell); };
+	auto H = [&](int32 Idx) -> float
+		{
+			const FIntPoint C = CellOf(Idx);
+			return (FMath::Abs(C.X - Goal.X) + FMath::Abs(C.Y - Goal.Y)) * MinStep;
+		};
+
+	FGridSearchScratch& S = AbstractScratch;
+	S.Begin(N + 2);
+	S.Relax(SIdx, 0.f, INDEX_NONE, H(SIdx));
+
+	auto Visit = [&](int32 From, float FromG, const FEdge& E)
+		{
+			if (S.IsClosed(E.To)) return;
+			const float TentG = FromG + E.Cost;
+			if (!S.IsSeen(E.To) || TentG < S.G[E.To]) S.Relax(E.To, TentG, From, H(E.To));
+		};
+
+	bool bFound = false;
+	FGridSearchScratch::FEntry Cur;
+	while (S.PopOpen(Cur))
+	{
+		if (Cur.Idx == GIdx) { bFound = true; break; }
+		S.Close(Cur.Idx);
+		++Expanded;
+
+		if (Cur.Idx == SIdx)
+		{
+			for (const FEdge& E : StartEdges) Visit(SIdx, Cur.G, E);
+			if (DirectCost < TNumericLimits<float>::Max()) Visit(SIdx, Cur.G, FEdge{ GIdx, DirectCost });
+			continue;
+		}
+
+		const FNode& Node = Nodes[Cur.Idx];
+		for (const FEdge& E : Node.Edges) Visit(Cur.Idx, Cur.G, E);
+		if (Node.Cluster == KG)
+		{
+			for (const FEdge& E : GoalEdges)
+			{
+				if (E.To == Cur.Idx) { Visit(Cur.Idx, Cur.G, FEdge{ GIdx, E.Cost }); break; }
+			}
+		}
+	}
+
+	if (!bFound) return false;
+	if (OutCost) *OutCost = S.G[GIdx];
+
+	for (int32 Idx = GIdx; Idx != INDEX_NONE; Idx = S.Parent[Idx])
+	{
+		const FIntPoint C = CellOf(Idx);
+		if (OutWaypoints.Num() == 0 || OutWaypoints.Last() != C) OutWaypoints.Add(C);
+	}
+	Algo::Reverse(OutWaypoints);
+	return true;
+}
@@ -0,0 +1,238 @@
+#include "Components/GridPathFollow/GridPathLandmarks.h"
+#include "Components/GridPathFollow/GridSearch.h"
+#include "Map/MapGridSubsystem.h"
+
+static constexpr float LM_Inf = TNumericLimits<float>::Max();
+
+struct FLandmarkHeapLess
+{
+	bool operator()(const TPair<float, int32>& A, const TPair<float, int32>& B) const { return A.Key < B.Key; }
+};
+
+template<typename TDist>
+static float DistToFloat(TDist D, TDist Inf) { return D == Inf ? LM_Inf : (float)D; }
+
+void FGridPathLandmarks::Build(const UMapGridSubsystem* InGrid, const FGridCostProfile& InCost, int32 InNumLandmarks, int32 InExactMaxCells)
+{
+	Grid = InGrid;
+	Cost = InCost;
+	Lut = FGridCostLUT(InCost);
+	bNeedsRebuild = false;
+	Landmarks.Reset();
+	FromLandmark.Reset();
+	Exact.Reset();
+
+	if (!Grid || Grid->GetWidth() <= 0 || Grid->GetHeight() <= 0)
+	{
+		Grid = nullptr;
+		return;
+	}
+
+	Width = Grid->GetWidth();
+	Height = Grid->GetHeight();
+	const int32 N = NumCells();
+
+	CellCosts.SetNumUninitialized(N);
+	for (int32 Idx = 0; Idx < N; ++Idx)
+	{
+		const float C = Grid->GetTileCost(FIntPoint(Idx % Width, Idx / Width), Lut);
+		CellCosts[Idx] = (C >= Cost.ImpassableCost) ? LM_Inf : C;
+	}
+
+	// Tabla exacta: mapa pequeo, costes enteros y la ruta ms larga posible (paso ms caro) cabe en uint16
+	float WorstStep = 0.f;
+	for (int32 Code = 0; Code < 16; ++Code)
+	{
+		if (Lut.IsPassable((uint8)Code)) WorstStep = FMath::Max(WorstStep, Lut[(uint8)Code]);
+	}
+	if (N <= InExactMaxCells && Lut.bIntegral && (double)N * WorstStep < ExactUnreached)
+	{
+		Exact.SetNumUninitialized(N * N);
+		for (int32 S = 0; S < N; ++S)
+		{
+			FillRow<uint16>(Exact.GetData() + S * N, S, ExactUnreached);
+		}
+		return;
+	}
+
+	ChooseLandmarks(InNumLandmarks);
+}
+
+void FGridPathLandmarks::ChooseLandmarks(int32 NumLandmarks)
+{
+	const int32 N = NumCells();
+	NumLandmarks = FMath::Clamp(NumLandmarks, 0, N);
+	if (NumLandmarks == 0) return;
+
+	// Semilla: primera celda transitable; el primer landmark es la ms lejana a ella
+	int32 Seed = INDEX_NONE;
+	for (int32 Idx = 0; Idx < N && Seed == INDEX_NONE; ++Idx)
+	{
+		if (CellCosts[Idx] != LM_Inf) Seed = Idx;
+	}
+	if (Seed == INDEX_NONE) return;
+
+	FromLandmark.SetNumUninitialized(N * NumLandmarks);
+	FillRow<float>(FromLandmark.GetData(), Seed, LM_Inf);
+	TArray<float> MinDist(FromLandmark.GetData(), N);
+
+	// Farthest-point: cada landmark nuevo maximiza la distancia al ms cercano ya elegido
+	for (int32 L = 0; L < NumLandmarks; ++L)
+	{
+		int32 Best = INDEX_NONE;
+		float BestD = -1.f;
+		for (int32 Idx = 0; Idx < N; ++Idx)
+		{
+			if (MinDist[Idx] != LM_Inf && MinDist[Idx] > BestD && CellCosts[Idx] != LM_Inf)
+			{
+				BestD = MinDist[Idx];
+				Best = Idx;
+			}
+		}
+		if (Best == INDEX_NONE || (L > 0 && BestD <= 0.f)) break;
+
+		Landmarks.Add(Best);
+		float* Row = FromLandmark.GetData() + L * N;
+		FillRow<float>(Row, Best, LM_Inf);
+		for (int32 Idx = 0; Idx < N; ++Idx)
+		{
+			MinDist[Idx] = FMath::Min(MinDist[Idx], Row[Idx]);
+		}
+	}
+	FromLandmark.SetNum(Landmarks.Num() * N);
+}
+
+float FGridPathLandmarks::GetCellCost(const FIntPoint& C) const
+{
+	if (C.X < 0 || C.Y < 0 || C.X >= Width || C.Y >= Height) return Cost.ImpassableCost;
+	const float V = CellCosts[C.X + C.Y * Width];
+	return V == LM_Inf ? Cost.ImpassableCost : V;
+}
+
+float FGridPathLandmarks::Heuristic(const FIntPoint& Cell, const FIntPoint& Goal) const
+{
+	if (!Grid || Goal.X < 0 || Goal.Y < 0 || Goal.X >= Width || Goal.Y >= Height) return 0.f;
+	const int32 N = NumCells();
+	const int32 NI = Cell.X + Cell.Y * Width;
+	const int32 GI = Goal.X + Goal.Y * Width;
+
+	if (HasExactTable())
+	{
+		const uint16 D = Exact[NI * N + GI];
+		return D == ExactUnreached ? 0.f : (float)D;
+	}
+
+	const float CN = CellCosts[NI];
+	const float CG = CellCosts[GI];
+	float H = 0.f;
+	for (int32 L = 0; L < Landmarks.Num(); ++L)
+	{
+		const float* Row = FromLandmark.GetData() + L * N;
+		const float DLn = Row[NI];
+		const float DLg = Row[GI];
+		if (DLn == LM_Inf || DLg == LM_Inf) continue;
+
+		// d(n,g) >= d(L,g) - d(L,n)   y   d(n,g) >= d(n,L) - d(g,L), con d(v,L) = d(L,v) - c(v) + c(L)
+		H = FMath::Max(H, DLg - DLn);
+		if (CN != LM_Inf && CG != LM_Inf) H = FMath::Max(H, (DLn - CN) - (DLg - CG));
+	}
+	return H;
+}
+
+bool FGridPathLandmarks::GetExactDistance(const FIntPoint& From, const FIntPoint& To, int32& OutCost) const
+{
+	if (!HasExactTable()) return false;
+	const uint16 D = Exact[(From.X + From.Y * Width) * NumCells() + (To.X + To.Y * Width)];
+	if (D == ExactUnreached) return false;
+	OutCost = D;
+	return true;
+}
+
+void FGridPathLandmarks::OnCellChanged(const FIntPoint& Cell)
+{
+	if (!Grid || bNeedsRebuild || Cell.X < 0 || Cell.Y < 0 || Cell.X >= Width || Cell.Y >= Height) return;
+
+	const int32 Idx = Cell.X + Cell.Y * Width;
+	const float Raw = Grid->GetTileCost(Cell, Lut);
+	const float NewCost = (Raw >= Cost.ImpassableCost) ? LM_Inf : Raw;
+	const float OldCost = CellCosts[Idx];
+	if (NewCost == OldCost) return;
+
+	// Un aumento (no ocurre al romper ladrillos) invalida distancias en cualquier parte: reconstruir
+	if (NewCost > OldCost)
+	{
+		bNeedsRebuild = true;
+		return;
+	}
+
+	CellCosts[Idx] = NewCost;
+	const int32 N = NumCells();
+	if (HasExactTable())
+	{
+		for (int32 S = 0; S < N; ++S) RepairRow<uint16>(Exact.GetData() + S * N, S, Idx, ExactUnreached);
+	}
+	for (int32 L = 0; L < Landmarks.Num(); ++L)
+	{
+		RepairRow<float>(FromLandmark.GetData() + L * N, Landmarks[L], Idx, LM_Inf);
+	}
+}
+
+template<typename TDist>
+void FGridPathLandmarks::FillRow(TDist* Row, int32 Source, TDist Inf)
+{
+	for (int32 Idx = 0; Idx < NumCells(); ++Idx) Row[Idx] = Inf;
+	Row[Source] = 0;
+	Heap.Reset();
+	Heap.HeapPush(TPair<float, int32>(0.f, Source), FLandmarkHeapLess());
+	Propagate<TDist>(Row, Source, Inf);
+}
+
+template<typename TDist>
+void FGridPathLandmarks::RepairRow(TDist* Row, int32 Source, int32 Changed, TDist Inf)
+{
+	if (Changed == Source) return;
+
+	// Nueva distancia de la celda cambiada = mejor vecino + su nuevo coste
+	const FIntPoint C(Changed % Width, Changed / Width);
+	float Best = DistToFloat(Row[Changed], Inf);
+	for (const FIntPoint& D : GridSearch::Dir4)
+	{
+		const FIntPoint Nb = C + D;
+		if (Nb.X < 0 || Nb.Y < 0 || Nb.X >= Width || Nb.Y >= Height) continue;
+		const float DNb = DistToFloat(Row[Nb.X + Nb.Y * Width], Inf);
+		if (DNb != LM_Inf) Best = FMath::Min(Best, DNb + CellCosts[Changed]);
+	}
+	if (Best >= DistToFloat(Row[Changed], Inf)) return;
+
+	Row[Changed] = (TDist)Best;
+	Heap.Reset();
+	Heap.HeapPush(TPair<float, int32>(Best, Changed), FLandmarkHeapLess());
+	Propagate<TDist>(Row, Source, Inf);
+}
+
+template<typename TDist>
+void FGridPathLandmarks::Propagate(TDist* Row, int32 Source, TDist Inf)
+{
+	TPair<float, int32> Cur;
+	while (Heap.Num() > 0)
+	{
+		Heap.HeapPop(Cur, FLandmarkHeapLess(), EAllowShrinking::No);
+		if (Cur.Key > DistToFloat(Row[Cur.Value], Inf)) continue; // obsoleta
+
+		const FIntPoint C(Cur.Value % Width, Cur.Value / Width);
+		for (const FIntPoint& D : GridSearch::Dir4)
+		{
+			const FIntPoint Nb = C + D;
+			if (Nb.X < 0 || Nb.Y < 0 || Nb.X >= Width || Nb.Y >= Height) continue;
+			const int32 NIdx = Nb.X + Nb.Y * Width;
+			if (NIdx == Source || CellCosts[NIdx] == LM_Inf) continue;
+
+			const float Tent = Cur.Key + CellCosts[NIdx];
+			if (Tent < DistToFloat(Row[NIdx], Inf))
+			{
+				Row[NIdx] = (TDist)Tent;
+				Heap.HeapPush(TPair<float, int32>(Tent, NIdx), FLandmarkHeapLess());
+			}
+		}
+	}
+}
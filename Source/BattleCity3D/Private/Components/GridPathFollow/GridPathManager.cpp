@@ -1,183 +1,870 @@
 #include "Components/GridPathFollow/GridPathManager.h"
-#include "Containers/Map.h"
-#include "Containers/Queue.h"
-#include "Algo/Reverse.h"
 #include "Map/MapGridSubsystem.h"
+#include "Projectiles/ProjectileLaneIndex.h"
+#include "Engine/World.h"
+#include "Engine/GameInstance.h"
+#include "Algo/Reverse.h"
+
+DECLARE_STATS_GROUP(TEXT("BattleCity Path"), STATGROUP_BCPath, STATCAT_Advanced);
+DECLARE_CYCLE_STAT(TEXT("ComputePath"), STAT_BCPath_ComputePath, STATGROUP_BCPath);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Cache hits"), STAT_BCPath_CacheHits, STATGROUP_BCPath);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Cache misses"), STAT_BCPath_CacheMisses, STATGROUP_BCPath);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Cache entries"), STAT_BCPath_CacheEntries, STATGROUP_BCPath);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Cache evictions (total)"), STAT_BCPath_CacheEvictions, STATGROUP_BCPath);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Cache invalidations (total)"), STAT_BCPath_CacheInvalidations, STATGROUP_BCPath);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Cache hit rate %"), STAT_BCPath_CacheHitRate, STATGROUP_BCPath);
+DECLARE_MEMORY_STAT(TEXT("Cache memory"), STAT_BCPath_CacheMemory, STATGROUP_BCPath);
+
+// Uso en consola: bc.path.cachestats  /  bc.path.cachestats reset
+static FAutoConsoleCommandWithWorldAndArgs GBcPathCacheStatsCmd(
+	TEXT("bc.path.cachestats"),
+	TEXT("Muestra hits/misses/expulsiones/memoria de la cache de rutas. 'reset' la vacia."),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+		{
+			UGameInstance* GI = World ? World->GetGameInstance() : nullptr;
+			UGridPathManager* Mgr = GI ? GI->GetSubsystem<UGridPathManager>() : nullptr;
+			if (!Mgr) return;
+
+			if (Args.Num() > 0 && Args[0].Equals(TEXT("reset"), ESearchCase::IgnoreCase))
+			{
+				Mgr->ResetCache();
+				return;
+			}
+
+			const FGridPathCacheStats S = Mgr->GetCacheStats();
+			UE_LOG(LogTemp, Log, TEXT("[PathCache] hits=%d misses=%d hitrate=%.1f%% entries=%d/%d bytes=%lld evictions=%d invalidations=%d"),
+				S.Hits, S.Misses, S.GetHitRate() * 100.f, S.Entries, Mgr->PathCacheCapacity, S.Bytes, S.Evictions, S.Invalidations);
+		}));
 
-struct FAStarNode
+static float TileCost(const UMapGridSubsystem* Grid, const FIntPoint& C, const FGridCostLUT& Lut)
 {
-	FIntPoint Cell;
-	float G = 0.f; // coste desde Start
-	float F = 0.f; // G + H
-};
+	return Grid ? Grid->GetTileCost(C, Lut) : Lut.ImpassableCost;
+}
+
+// MaxSteps es el mismo horizonte en todos los planificadores: pasos de ruta (la tabla exacta y el
+// BFS ya paran ah). Las bsquedas devuelven la ruta entera y aqu se corta, con el coste del tramo.
+template<typename FCellCost>
+static bool ClipToMaxSteps(const FGridPathRequest& Req, FGridPathResult& R, FCellCost&& CellCost, float TurnCost = 0.f)
+{
+	if (Req.MaxSteps <= 0 || R.Cells.Num() <= Req.MaxSteps + 1) return true;
+	if (!Req.bAllowPartial) return false;
+
+	R.Cells.SetNum(Req.MaxSteps + 1, EAllowShrinking::No);
+	R.bReachedGoal = false;
+	R.TotalCost = 0.f;
+	int32 PrevDir = (Req.StartDir >= 0 && Req.StartDir < 4) ? Req.StartDir : INDEX_NONE;
+	for (int32 i = 1; i < R.Cells.Num(); ++i)
+	{
+		const FIntPoint Delta = R.Cells[i] - R.Cells[i - 1];
+		if (Delta == FIntPoint::ZeroValue) continue;
+		const int32 Dir = (Delta.X != 0) ? (Delta.X > 0 ? 1 : 3) : (Delta.Y > 0 ? 2 : 0);
+		if (TurnCost > 0.f && PrevDir != INDEX_NONE && Dir != PrevDir) R.TotalCost += TurnCost;
+		PrevDir = Dir;
+		R.TotalCost += CellCost(R.Cells[i]);
+	}
+	return true;
+}
 
-static float TileCost(const UMapGridSubsystem* Grid, const FIntPoint& C, const FGridCostProfile& Cost)
+void UGridPathManager::Initialize(FSubsystemCollectionBase& Collection)
 {
-	return Grid ? Grid->GetTileCost(C, Cost) : Cost.ImpassableCost;
+	Super::Initialize(Collection);
+	Cache.Configure(PathCacheCapacity, PathCacheRegionSize);
+	Reservations.Configure(CooperativeWindow + 2, CooperativeMaxAgents);
+	Traces.Configure(TraceCapacity, TraceMaxSamples);
 }
 
-bool UGridPathManager::ComputePath(const FGridPathRequest& Req, FGridPathResult& OutResult) const
+void UGridPathManager::Deinitialize()
+{
+	if (UMapGridSubsystem* Old = BoundGrid.Get())
+	{
+		Old->OnGridCellChanged.Remove(CellChangedHandle);
+	}
+	CellChangedHandle.Reset();
+	BoundGrid.Reset();
+	Hierarchies.Reset();
+	LandmarkSets.Reset();
+	PathDatabase.Reset();
+	Cache.Reset();
+	Super::Deinitialize();
+}
+
+bool UGridPathManager::ComputePath(const FGridPathRequest& Req, FGridPathResult& OutResult)
 {
 	OutResult = FGridPathResult{};
-	if (!Req.Grid) return false;
-	return AStar_Internal(Req, OutResult);
+	const FGridPathRef Path = ComputePathShared(Req);
+	if (!Path.IsValid()) return false;
+	Path->ToResult(OutResult);
+	return OutResult.bValid;
 }
 
-bool UGridPathManager::AStar_Internal(const FGridPathRequest& Req, FGridPathResult& OutResult) const
+FGridPathRef UGridPathManager::ComputePathShared(const FGridPathRequest& Req)
 {
-	UMapGridSubsystem* Grid = Req.Grid;
-	if (!Grid) return false;
+	SCOPE_CYCLE_COUNTER(STAT_BCPath_ComputePath);
+	LastNodesExpanded = 0;
+	if (!Req.Grid) return nullptr;
+	EnsureBoundTo(Req.Grid);
 
-	const float StartCost = TileCost(Grid, Req.Start, Req.Cost);
-	const float GoalCost = TileCost(Grid, Req.Goal, Req.Cost);
-	const bool bGoalBlocked = GoalCost >= Req.Cost.ImpassableCost;
+	// Distinta regin de WalkableBits: ni rompiendo ladrillos hay ruta, no merece buscar
+	if (!Req.bAllowPartial)
+	{
+		const int32 RegionA = Req.Grid->GetWalkableRegion(Req.Start);
+		const int32 RegionB = Req.Grid->GetWalkableRegion(Req.Goal);
+		if (RegionA != INDEX_NONE && RegionB != INDEX_NONE && RegionA != RegionB) return nullptr;
+	}
 
-	TMap<FIntPoint, float> GScore;
-	TMap<FIntPoint, float> FScore;
-	TMap<FIntPoint, FIntPoint> CameFrom;
-	TSet<FIntPoint> Closed;
+	const EGridPathPlanner Planner = ResolvePlanner(Req);
+	const bool bUseCache = PathCacheCapacity > 0 && !UsesThreat(Req);
 
-	TArray<FIntPoint> Open;
-	auto PushOpen = [&](const FIntPoint& C) { Open.Add(C); };
-	auto PopBest = [&]() -> FIntPoint {
-		int32 BestIdx = 0; float BestF = TNumericLimits<float>::Max();
-		for (int32 i = 0; i < Open.Num(); ++i)
+	FGridPathCacheKey Key;
+	if (bUseCache)
+	{
+		Key = MakeCacheKey(Req, Planner);
+		if (FGridPathRef Hit = Cache.Find(Key))
 		{
-			const float* FPtr = FScore.Find(Open[i]);
-			const float Fv = FPtr ? *FPtr : TNumericLimits<float>::Max();
-			if (Fv < BestF) { BestF = Fv; BestIdx = i; }
+			INC_DWORD_STAT(STAT_BCPath_CacheHits);
+			PublishCacheStats();
+			return Hit;
 		}
-		const FIntPoint Best = Open[BestIdx];
-		Open.RemoveAtSwap(BestIdx, 1, false);
-		return Best;
-		};
+		INC_DWORD_STAT(STAT_BCPath_CacheMisses);
+	}
 
-	auto H = [&](const FIntPoint& C) { return (float)Heuristic_Manhattan(C, Req.Goal); };
+	// Traza: todas con bc.path.trace 1; si no, slo se repiten con traza las que superan slowms
+	FGridSearchTrace* Trace = GridPathTrace::IsCaptureEnabled() ? &Traces.BeginTrace() : nullptr;
+	ActiveTrace = Trace;
 
-	GScore.Add(Req.Start, 0.f);
-	FScore.Add(Req.Start, H(Req.Start));
-	PushOpen(Req.Start);
+	// Lo perezoso (jerarqua, landmarks, base de datos) fuera del cronmetro: si no, la primera
+	// consulta de cada perfil siempre saldra lenta
+	PreparePlanner(Planner, Req);
+	const double T0 = FPlatformTime::Seconds();
+	FGridPathResult R;
+	const bool bOk = RunPlanner(Planner, Req, R);
+	const float Millis = (float)((FPlatformTime::Seconds() - T0) * 1000.0);
+	ActiveTrace = nullptr;
 
-	int32 StepsEmitted = 0;
-	bool bReached = false;
-	FIntPoint ReachedCell = Req.Start;
+	const float SlowMs = GridPathTrace::GetSlowQueryMs();
+	if (Trace)
+	{
+		FinishTrace(*Trace, Planner, Req, R, bOk, Millis);
+		Trace->bSlow = SlowMs > 0.f && Millis >= SlowMs;
+		Traces.Commit();
+	}
+	else if (SlowMs > 0.f && Millis >= SlowMs)
+	{
+		const int32 Nodes = LastNodesExpanded;
+		FGridSearchTrace& Slow = Traces.BeginTrace();
+		ActiveTrace = &Slow;
+		FGridPathResult Replay;
+		const bool bReplayOk = RunPlanner(Planner, Req, Replay);
+		ActiveTrace = nullptr;
+		LastNodesExpanded = Nodes;
 
-	while (Open.Num() > 0)
+		FinishTrace(Slow, Planner, Req, Replay, bReplayOk, Millis);
+		Slow.bSlow = true;
+		Traces.Commit();
+		UE_LOG(LogTemp, Warning, TEXT("[PathTrace] Consulta lenta (%d,%d)->(%d,%d): %.2f ms, %d nodos (traza guardada, bc.path.trace.draw)"),
+			Req.Start.X, Req.Start.Y, Req.Goal.X, Req.Goal.Y, Millis, Nodes);
+	}
+
+	if (!bOk || !R.bValid) return nullptr; // los fallos no se cachean
+
+	const FGridPathRef Path = FGridPath::FromResult(R, Req.Grid);
+	if (!Path->IsValid()) return nullptr;
+
+	if (bUseCache)
+	{
+		Cache.Add(Key, Path); // descarta las parciales
+		PublishCacheStats();
+	}
+	return Path;
+}
+
+void UGridPathManager::PreparePlanner(EGridPathPlanner Planner, const FGridPathRequest& Req)
+{
+	switch (Planner)
+	{
+	case EGridPathPlanner::Hierarchical: GetHierarchy(Req.Grid, Req.Cost); break;
+	case EGridPathPlanner::Landmarks:    GetLandmarks(Req.Grid, Req.Cost); break;
+	case EGridPathPlanner::PathDatabase:
+		if (!PathDatabase.IsBuilt() && Req.Grid->GetWidth() * Req.Grid->GetHeight() <= PathDatabaseMaxMapCells) PathDatabase.Build(Req.Grid);
+		break;
+	default: break;
+	}
+}
+
+bool UGridPathManager::RunPlanner(EGridPathPlanner Planner, const FGridPathRequest& Req, FGridPathResult& OutResult)
+{
+	switch (Planner)
+	{
+	case EGridPathPlanner::Hierarchical: return Hierarchical_Internal(Req, OutResult);
+	case EGridPathPlanner::Landmarks:    return Landmarks_Internal(Req, OutResult);
+	case EGridPathPlanner::PathDatabase: return PathDatabase_Internal(Req, OutResult);
+	case EGridPathPlanner::BitBFS:       return BitBFS_Internal(Req, OutResult);
+	case EGridPathPlanner::TurnAware:    return TurnAware_Internal(Req, OutResult);
+	default:                             return AStar_Internal(Req, OutResult);
+	}
+}
+
+void UGridPathManager::FinishTrace(FGridSearchTrace& Trace, EGridPathPlanner Planner, const FGridPathRequest& Req, const FGridPathResult& R, bool bOk, float Millis)
+{
+	Trace.Start = Req.Start;
+	Trace.Goal = Req.Goal;
+	Trace.Planner = (uint8)Planner;
+	Trace.bReachedGoal = bOk && R.bReachedGoal;
+	Trace.Millis = Millis;
+	Trace.NodesExpanded = LastNodesExpanded;
+	Trace.CaptureTime = FPlatformTime::Seconds();
+	if (bOk) Trace.Path = R.Cells;
+}
+
+FGridPathCacheKey UGridPathManager::MakeCacheKey(const FGridPathRequest& Req, EGridPathPlanner Planner) const
+{
+	FGridPathCacheKey Key;
+	Key.Start = Req.Start;
+	Key.Goal = Req.Goal;
+	Key.CostHash = GetTypeHash(Req.Cost);
+	Key.LayoutVersion = Req.Grid->GetLayoutVersion();
+	Key.MaxSteps = FMath::Max(0, Req.MaxSteps);
+	Key.MaxExpansions = FMath::Max(0, Req.MaxExpansions);
+	Key.Planner = (uint8)Planner;
+	Key.bAllowPartial = Req.bAllowPartial;
+	// El giro no entra en el hash del perfil: con TurnAware la ruta depende tambin de l y de la orientacin
+	if (Planner == EGridPathPlanner::TurnAware)
 	{
-		const FIntPoint Current = PopBest();
-		if (Current == Req.Goal && !bGoalBlocked)
+		Key.CostHash = HashCombine(Key.CostHash, HashCombine(GetTypeHash(Req.Cost.TurnCost), GetTypeHash(Req.StartDir)));
+	}
+	return Key;
+}
+
+void UGridPathManager::PublishCacheStats() const
+{
+	const FGridPathCacheStats& S = Cache.GetStats();
+	SET_DWORD_STAT(STAT_BCPath_CacheEntries, S.Entries);
+	SET_DWORD_STAT(STAT_BCPath_CacheEvictions, S.Evictions);
+	SET_DWORD_STAT(STAT_BCPath_CacheInvalidations, S.Invalidations);
+	SET_FLOAT_STAT(STAT_BCPath_CacheHitRate, S.GetHitRate() * 100.f);
+	SET_MEMORY_STAT(STAT_BCPath_CacheMemory, S.Bytes);
+}
+
+void UGridPathManager::ResetCache()
+{
+	Cache.Configure(PathCacheCapacity, PathCacheRegionSize);
+	Cache.ResetStats();
+	PublishCacheStats();
+}
+
+EGridPathPlanner UGridPathManager::ResolvePlanner(const FGridPathRequest& Req) const
+{
+	if (Req.Planner != EGridPathPlanner::Auto) return Req.Planner;
+	if (Req.Cost.TurnCost > 0.f) return EGridPathPlanner::TurnAware;
+	if (UsesThreat(Req)) return EGridPathPlanner::AStar;
+
+	// HPA* y la base de datos slo dan rutas completas y no cuentan expansiones: con horizonte o
+	// presupuesto, A*/landmarks
+	const int32 Cells = Req.Grid->GetWidth() * Req.Grid->GetHeight();
+	const bool bBounded = Req.MaxSteps > 0 || Req.MaxExpansions > 0;
+	if (!bBounded && Cells >= HierarchicalMinMapCells) return EGridPathPlanner::Hierarchical;
+	if (!bBounded && Cells > ExactTableMaxCells && Cells <= PathDatabaseMaxMapCells) return EGridPathPlanner::PathDatabase;
+	return (Cells <= LandmarkMaxMapCells && (LandmarkCount > 0 || Cells <= ExactTableMaxCells)) ? EGridPathPlanner::Landmarks : EGridPathPlanner::AStar;
+}
+
+bool UGridPathManager::AStar_Internal(const FGridPathRequest& Req, FGridPathResult& OutResult)
+{
+	UMapGridSubsystem* Grid = Req.Grid;
+	if (!Grid) return false;
+
+	FGridSearchQuery Q;
+	Q.Start = Req.Start;
+	Q.Goal = Req.Goal;
+	Q.Bounds = FGridSearchBounds::FromSize(Grid->GetWidth(), Grid->GetHeight());
+	Q.ImpassableCost = Req.Cost.ImpassableCost;
+	Q.MaxExpansions = FMath::Max(0, Req.MaxExpansions);
+	Q.bAllowPartial = Req.bAllowPartial;
+	Q.Trace = ActiveTrace;
+
+	const FGridCostLUT Lut(Req.Cost);
+	const float MinStep = Lut.MinStep; // escala Manhattan sin romper la admisibilidad
+
+	// Amenaza: suplemento en celdas que cruzar una bala del jugador (una lectura del ndice de carriles)
+	const FProjectileLaneIndex* Lanes = UsesThreat(Req) ? ThreatLanes : nullptr;
+	const float ThreatCost = Req.Cost.ThreatCost;
+	const float ThreatHorizon = Req.Cost.ThreatHorizon;
+	auto CellCost = [Grid, &Lut, Lanes, ThreatCost, ThreatHorizon](const FIntPoint& C)
 		{
-			bReached = true;
-			ReachedCell = Current;
-			break;
-		}
+			const float Cost = TileCost(Grid, C, Lut);
+			if (Lanes && Cost < Lut.ImpassableCost && Lanes->IsThreatened(C, EProjectileTeam::Player, ThreatHorizon)) return Cost + ThreatCost;
+			return Cost;
+		};
+
+	FGridSearchResult R;
+	const bool bOk = GridSearch::RunAStar(Scratch, Q, CellCost,
+		[&Req, MinStep](const FIntPoint& C) { return Heuristic_Manhattan(C, Req.Goal) * MinStep; },
+		R);
+	LastNodesExpanded += R.NodesExpanded;
+
+	// Vlida slo si hay al menos un paso real, salvo que Start==Goal
+	if (!bOk || R.Cells.Num() == 0) return false;
+
+	OutResult.Cells = MoveTemp(R.Cells);
+	OutResult.TotalCost = R.TotalCost;
+	OutResult.bReachedGoal = R.bReachedGoal;
+	OutResult.bValid = true;
+	if (!ClipToMaxSteps(Req, OutResult, CellCost)) { OutResult = FGridPathResult{}; return false; }
+	return true;
+}
 
-		Closed.Add(Current);
+bool UGridPathManager::TurnAware_Internal(const FGridPathRequest& Req, FGridPathResult& OutResult)
+{
+	UMapGridSubsystem* Grid = Req.Grid;
+	if (!Grid) return false;
 
-		TArray<FIntPoint> Neigh;
-		Grid->GetNeighbors4(Current, Neigh);
+	FGridSearchQuery Q;
+	Q.Start = Req.Start;
+	Q.Goal = Req.Goal;
+	Q.Bounds = FGridSearchBounds::FromSize(Grid->GetWidth(), Grid->GetHeight());
+	Q.ImpassableCost = Req.Cost.ImpassableCost;
+	Q.MaxExpansions = FMath::Max(0, Req.MaxExpansions); // aqu cuenta estados celda x orientacin
+	Q.bAllowPartial = Req.bAllowPartial;
+	Q.Trace = ActiveTrace;
 
-		for (const FIntPoint& N : Neigh)
+	const FGridCostLUT Lut(Req.Cost);
+	const float MinStep = Lut.MinStep;
+	const FProjectileLaneIndex* Lanes = UsesThreat(Req) ? ThreatLanes : nullptr;
+	const float ThreatCost = Req.Cost.ThreatCost;
+	const float ThreatHorizon = Req.Cost.ThreatHorizon;
+	const int32 StartDir = (Req.StartDir >= 0 && Req.StartDir < 4) ? Req.StartDir : INDEX_NONE;
+	const float TurnCost = FMath::Max(0.f, Req.Cost.TurnCost);
+	auto CellCost = [Grid, &Lut, Lanes, ThreatCost, ThreatHorizon](const FIntPoint& C)
 		{
-			if (Closed.Contains(N)) continue;
+			const float Cost = TileCost(Grid, C, Lut);
+			if (Lanes && Cost < Lut.ImpassableCost && Lanes->IsThreatened(C, EProjectileTeam::Player, ThreatHorizon)) return Cost + ThreatCost;
+			return Cost;
+		};
 
-			const float MoveCost = TileCost(Grid, N, Req.Cost);
-			if (MoveCost >= Req.Cost.ImpassableCost) continue;
+	FGridSearchResult R;
+	const bool bOk = GridSearch::RunTurnAwareAStar(Scratch, Q, StartDir, TurnCost, CellCost,
+		[&Req, MinStep](const FIntPoint& C) { return Heuristic_Manhattan(C, Req.Goal) * MinStep; },
+		R);
+	LastNodesExpanded += R.NodesExpanded;
 
-			const float* GCurPtr = GScore.Find(Current);
-			if (!GCurPtr) continue; // seguridad
-			const float TentG = *GCurPtr + MoveCost;
+	if (!bOk || R.Cells.Num() == 0) return false;
 
-			const float* PrevG = GScore.Find(N);
-			if (!PrevG || TentG < *PrevG)
-			{
-				CameFrom.Add(N, Current);
-				GScore.Add(N, TentG);
-				FScore.Add(N, TentG + H(N));
-				if (!Open.Contains(N)) PushOpen(N);
-			}
-		}
+	OutResult.Cells = MoveTemp(R.Cells);
+	OutResult.TotalCost = R.TotalCost;
+	OutResult.bReachedGoal = R.bReachedGoal;
+	OutResult.bValid = true;
+	if (!ClipToMaxSteps(Req, OutResult, CellCost, TurnCost)) { OutResult = FGridPathResult{}; return false; }
+	return true;
+}
 
-		// Horizonte parcial
-		if (Req.MaxSteps > 0)
+bool UGridPathManager::Landmarks_Internal(const FGridPathRequest& Req, FGridPathResult& OutResult)
+{
+	FGridPathLandmarks* L = GetLandmarks(Req.Grid, Req.Cost);
+	if (!L) return AStar_Internal(Req, OutResult);
+
+	// Tabla exacta: bajar por la tabla (vecino N con c(N) + d(N,Goal) == d(C,Goal)), sin expandir nodos.
+	// Con horizonte se corta a MaxSteps pasos, como el resto de planificadores.
+	int32 Remaining = 0;
+	if (L->GetExactDistance(Req.Start, Req.Goal, Remaining))
+	{
+		const int32 Total = Remaining;
+		const int32 MaxSteps = FMath::Max(0, Req.MaxSteps);
+		OutResult.Cells.Reset();
+		OutResult.Cells.Add(Req.Start);
+		FIntPoint C = Req.Start;
+		while (C != Req.Goal && (MaxSteps == 0 || OutResult.Cells.Num() <= MaxSteps))
 		{
-			StepsEmitted++;
-			if (StepsEmitted >= Req.MaxSteps)
+			bool bStepped = false;
+			for (const FIntPoint& D : GridSearch::Dir4)
 			{
-				float BestF = TNumericLimits<float>::Max();
-				FIntPoint BestCell = Current;
-				for (const auto& KVP : FScore)
+				const FIntPoint N = C + D;
+				const float StepCost = L->GetCellCost(N);
+				int32 Rest = 0;
+				if (StepCost >= Req.Cost.ImpassableCost) continue;
+				if (N == Req.Goal) Rest = 0;
+				else if (!L->GetExactDistance(N, Req.Goal, Rest)) continue;
+				if ((int32)StepCost + Rest == Remaining)
 				{
-					const FIntPoint& Cell = KVP.Key;
-					if (!Closed.Contains(Cell)) continue;
-					// Asegura que hay cadena hacia Start
-					if (Cell != Req.Start && !CameFrom.Contains(Cell)) continue;
-					if (KVP.Value < BestF) { BestF = KVP.Value; BestCell = Cell; }
+					C = N;
+					Remaining = Rest;
+					bStepped = true;
+					break;
 				}
-				ReachedCell = BestCell;
-				bReached = (BestCell == Req.Goal);
-				break;
 			}
+			if (!bStepped) break; // tabla desfasada: que lo resuelva el A*
+			OutResult.Cells.Add(C);
+		}
+
+		if (C == Req.Goal)
+		{
+			OutResult.TotalCost = (float)Total;
+			OutResult.bReachedGoal = true;
+			OutResult.bValid = true;
+			return true;
+		}
+		if (MaxSteps > 0 && OutResult.Cells.Num() > MaxSteps)
+		{
+			// Horizonte agotado en una tabla vlida: parcial (o fallo) sin pasar por el A*
+			if (!Req.bAllowPartial) { OutResult = FGridPathResult{}; return false; }
+			OutResult.TotalCost = (float)(Total - Remaining);
+			OutResult.bReachedGoal = false;
+			OutResult.bValid = true;
+			return true;
 		}
+		OutResult = FGridPathResult{};
+	}
+
+	UMapGridSubsystem* Grid = Req.Grid;
+	FGridSearchQuery Q;
+	Q.Start = Req.Start;
+	Q.Goal = Req.Goal;
+	Q.Bounds = FGridSearchBounds::FromSize(Grid->GetWidth(), Grid->GetHeight());
+	Q.ImpassableCost = Req.Cost.ImpassableCost;
+	Q.MaxExpansions = FMath::Max(0, Req.MaxExpansions);
+	Q.bAllowPartial = Req.bAllowPartial;
+	Q.Trace = ActiveTrace;
+
+	const FGridCostLUT Lut(Req.Cost);
+	const float MinStep = Lut.MinStep; // escala Manhattan sin romper la admisibilidad
+	auto CellCost = [L](const FIntPoint& C) { return L->GetCellCost(C); };
+	FGridSearchResult R;
+	const bool bOk = GridSearch::RunAStar(Scratch, Q, CellCost,
+		[L, &Req, MinStep](const FIntPoint& C) { return FMath::Max(Heuristic_Manhattan(C, Req.Goal) * MinStep, L->Heuristic(C, Req.Goal)); },
+		R);
+	LastNodesExpanded += R.NodesExpanded;
+	if (!bOk || R.Cells.Num() == 0) return false;
+
+	OutResult.Cells = MoveTemp(R.Cells);
+	OutResult.TotalCost = R.TotalCost;
+	OutResult.bReachedGoal = R.bReachedGoal;
+	OutResult.bValid = true;
+	if (!ClipToMaxSteps(Req, OutResult, CellCost)) { OutResult = FGridPathResult{}; return false; }
+	return true;
+}
+
+bool UGridPathManager::PathDatabase_Internal(const FGridPathRequest& Req, FGridPathResult& OutResult)
+{
+	UMapGridSubsystem* Grid = Req.Grid;
+	const int32 Cells = Grid->GetWidth() * Grid->GetHeight();
+	auto Fallback = [&]()
+		{
+			OutResult = FGridPathResult{};
+			return (Cells <= LandmarkMaxMapCells) ? Landmarks_Internal(Req, OutResult) : AStar_Internal(Req, OutResult);
+		};
+
+	// La ruta esttica slo es ptima si ninguna celda (ladrillo, hielo, bosque) sale ms barata que el suelo libre
+	const FGridCostLUT Lut(Req.Cost);
+	if (Cells > PathDatabaseMaxMapCells || Lut.MinStep < Req.Cost.FreeCost) return Fallback();
+	if (!PathDatabase.IsBuilt()) PathDatabase.Build(Grid);
+
+	// Destinos en otra regin no tienen datos (parciales y similares los resuelve la bsqueda)
+	const int32 Region = Grid->GetWalkableRegion(Req.Start);
+	if (Region == INDEX_NONE || Region != Grid->GetWalkableRegion(Req.Goal)) return Fallback();
+
+	OutResult.Cells.Reset();
+	OutResult.Cells.Add(Req.Start);
+	float Total = 0.f;
+	FIntPoint C = Req.Start;
+	for (int32 Guard = Cells; C != Req.Goal && Guard > 0; --Guard)
+	{
+		const uint8 Move = PathDatabase.GetFirstMove(C, Req.Goal);
+		if (Move == FGridPathDatabase::NoMove) break;
+		C += GridSearch::Dir4[Move];
+
+		// Overlay dinmico: un ladrillo (o terreno con suplemento) encima invalida la ruta esttica
+		const float StepCost = TileCost(Grid, C, Lut);
+		if (StepCost != Req.Cost.FreeCost) break;
+		Total += StepCost;
+		OutResult.Cells.Add(C);
 	}
+	if (C != Req.Goal) return Fallback();
+
+	// Slo suelo libre y ptima con ladrillos como libres => tambin ptima con su coste real
+	OutResult.TotalCost = Total;
+	OutResult.bReachedGoal = true;
+	OutResult.bValid = true;
+	return true;
+}
+
+bool UGridPathManager::BitBFS_Internal(const FGridPathRequest& Req, FGridPathResult& OutResult)
+{
+	UMapGridSubsystem* Grid = Req.Grid;
+	const FGridBitboard& Open = Grid->GetOpenBits();
+	const int32 W = Grid->GetWidth();
+	const int32 H = Grid->GetHeight();
+	auto Inside = [W, H](const FIntPoint& C) { return C.X >= 0 && C.Y >= 0 && C.X < W && C.Y < H; };
+	if (Open.IsEmpty() || !Inside(Req.Start) || !Inside(Req.Goal)) return false;
+
+	const int32 Layers = Bfs.DistanceField(Open, MakeArrayView(&Req.Start, 1), BfsDist, FMath::Max(0, Req.MaxSteps));
+	LastNodesExpanded += Layers; // aqu "nodos" = capas del frente
 
-	// === NUEVO: fallback parcial cuando NO se alcanz Goal y NO hubo corte por horizonte ===
+	// Destino alcanzado o, en parcial, la celda alcanzada ms cercana (Manhattan) al destino
+	FIntPoint End = Req.Goal;
+	bool bReached = BfsDist[Req.Goal.X + Req.Goal.Y * W] != FGridBitBFS::Unreached;
 	if (!bReached)
 	{
-		if (!Req.bAllowPartial)
+		if (!Req.bAllowPartial) return false;
+		int32 BestH = MAX_int32;
+		for (int32 Idx = 0; Idx < BfsDist.Num(); ++Idx)
 		{
-			OutResult = FGridPathResult{};
-			return false;
+			if (BfsDist[Idx] == FGridBitBFS::Unreached) continue;
+			const FIntPoint C(Idx % W, Idx / W);
+			const int32 Dist = Heuristic_Manhattan(C, Req.Goal);
+			if (Dist < BestH) { BestH = Dist; End = C; }
 		}
+	}
 
-		float BestF = TNumericLimits<float>::Max();
-		FIntPoint BestCell = Req.Start;
+	// Reconstruccin: bajar por el campo de distancias (d -> d-1) hasta Start
+	OutResult.Cells.Reset();
+	FIntPoint C = End;
+	int32 D = BfsDist[C.X + C.Y * W];
+	OutResult.Cells.Add(C);
+	while (D > 0)
+	{
+		for (const FIntPoint& Dir : GridSearch::Dir4)
+		{
+			const FIntPoint N = C + Dir;
+			if (Inside(N) && BfsDist[N.X + N.Y * W] == D - 1) { C = N; break; }
+		}
+		--D;
+		OutResult.Cells.Add(C);
+	}
+	Algo::Reverse(OutResult.Cells);
+
+	OutResult.TotalCost = (OutResult.Cells.Num() - 1) * Req.Cost.FreeCost;
+	OutResult.bReachedGoal = bReached;
+	OutResult.bValid = true;
+	return true;
+}
+
+bool UGridPathManager::SearchBounded(const FGridPathRequest& Req, const FIntPoint& From, const FIntPoint& To,
+	const FGridSearchBounds& Bounds, bool bAllowPartial, FGridSearchResult& Out)
+{
+	UMapGridSubsystem* Grid = Req.Grid;
+	FGridSearchQuery Q;
+	Q.Start = From;
+	Q.Goal = To;
+	Q.Bounds = Bounds;
+	Q.ImpassableCost = Req.Cost.ImpassableCost;
+	Q.bAllowPartial = bAllowPartial;
+	Q.Trace = ActiveTrace;
+
+	const FGridCostLUT Lut(Req.Cost);
+	const float MinStep = Lut.MinStep; // escala Manhattan sin romper la admisibilidad
+	const bool bOk = GridSearch::RunAStar(Scratch, Q,
+		[Grid, &Lut](const FIntPoint& C) { return TileCost(Grid, C, Lut); },
+		[To, MinStep](const FIntPoint& C) { return Heuristic_Manhattan(C, To) * MinStep; },
+		Out);
+	LastNodesExpanded += Out.NodesExpanded;
+	return bOk;
+}
+
+bool UGridPathManager::Hierarchical_Internal(const FGridPathRequest& Req, FGridPathResult& OutResult)
+{
+	FGridPathHierarchy* H = GetHierarchy(Req.Grid, Req.Cost);
+	if (!H || Req.Start == Req.Goal) return AStar_Internal(Req, OutResult);
 
-		for (const auto& KVP : FScore)
+	TArray<FIntPoint> Waypoints;
+	float AbstractCost = 0.f;
+	int32 AbstractExpanded = 0;
+	const bool bFound = H->FindAbstractPath(Req.Start, Req.Goal, Waypoints, &AbstractCost, &AbstractExpanded);
+	LastNodesExpanded += AbstractExpanded;
+	if (!bFound || Waypoints.Num() < 2)
+	{
+		// Sin conexin abstracta: el A* plano resuelve el parcial (mejor celda alcanzable)
+		return AStar_Internal(Req, OutResult);
+	}
+
+	OutResult.Cells.Reset();
+	OutResult.Cells.Add(Req.Start);
+
+	const int32 NumAhead = FMath::Clamp(HierarchicalRefineAhead, 1, Waypoints.Num() - 1);
+	for (int32 i = 1; i <= NumAhead; ++i)
+	{
+		FGridSearchResult Seg;
+		if (!SearchBounded(Req, OutResult.Cells.Last(), Waypoints[i], H->GetSegmentBounds(OutResult.Cells.Last(), Waypoints[i]), false, Seg))
 		{
-			const FIntPoint& Cell = KVP.Key;
-			if (!Closed.Contains(Cell)) continue;
-			// necesita cadena vlida hasta Start
-			if (Cell != Req.Start && !CameFrom.Contains(Cell)) continue;
-			if (KVP.Value < BestF) { BestF = KVP.Value; BestCell = Cell; }
+			OutResult = FGridPathResult{};
+			return AStar_Internal(Req, OutResult);
 		}
-		ReachedCell = BestCell;
+		OutResult.Cells.Append(Seg.Cells.GetData() + 1, Seg.Cells.Num() - 1);
 	}
 
-	// Reconstruccin
-	auto Reconstruct = [&](const FIntPoint& End, TArray<FIntPoint>& OutPath, float& OutCost)
+	OutResult.PendingWaypoints.Append(Waypoints.GetData() + NumAhead + 1, Waypoints.Num() - NumAhead - 1);
+	// Coste abstracto = coste de la ruta completa (los tramos pendientes ya estn conectados)
+	OutResult.TotalCost = AbstractCost;
+	OutResult.bReachedGoal = true;
+	OutResult.bValid = true;
+	return true;
+}
+
+bool UGridPathManager::RefineNextSegment(const FGridPathRequest& Req, FGridPathResult& InOutResult)
+{
+	const FGridPathRef Next = RefineNextSegmentShared(Req, *FGridPath::FromResult(InOutResult, Req.Grid));
+	if (!Next.IsValid()) return false;
+	Next->ToResult(InOutResult);
+	return true;
+}
+
+FGridPathRef UGridPathManager::RefineNextSegmentShared(const FGridPathRequest& Req, const FGridPath& Current)
+{
+	if (!Req.Grid || Current.GetNumCells() == 0 || Current.PendingWaypoints.Num() == 0) return nullptr;
+
+	FGridPathHierarchy* H = GetHierarchy(Req.Grid, Req.Cost);
+	if (!H) return nullptr;
+
+	const FIntPoint From = Current.GetEndCell();
+	const FIntPoint To = Current.PendingWaypoints[0];
+
+	FGridSearchResult Seg;
+	if (!SearchBounded(Req, From, To, H->GetSegmentBounds(From, To), false, Seg)) return nullptr;
+
+	TSharedRef<FGridPath, ESPMode::ThreadSafe> Next = FGridPath::Make(Seg.Cells, Req.Grid);
+	if (!Next->IsValid()) return nullptr;
+	Next->PendingWaypoints.Append(Current.PendingWaypoints.GetData() + 1, Current.PendingWaypoints.Num() - 1);
+	Next->TotalCost = Current.TotalCost;
+	Next->bReachedGoal = Current.bReachedGoal;
+	return Next;
+}
+
+uint16 UGridPathManager::RegisterCooperativeAgent()
+{
+	if (FreeAgentIds.Num() > 0) return FreeAgentIds.Pop(EAllowShrinking::No);
+	return (NextAgentId < MAX_uint16) ? NextAgentId++ : FGridReservationTable::NoAgent;
+}
+
+void UGridPathManager::UnregisterCooperativeAgent(uint16 Agent)
+{
+	if (Agent == FGridReservationTable::NoAgent) return;
+	Reservations.ReleaseAgent(Agent);
+	FreeAgentIds.Add(Agent);
+}
+
+int64 UGridPathManager::GetCooperativeTick(double WorldSeconds) const
+{
+	return (int64)FMath::FloorToDouble(WorldSeconds / FMath::Max(0.01f, CooperativeStepSeconds));
+}
+
+int64 UGridPathManager::GetNextCooperativeReplanTick(uint16 Agent, int64 Tick) const
+{
+	const int32 Half = FMath::Max(1, CooperativeWindow / 2);
+	return ((Tick / Half) + 1) * Half + (Agent % Half);
+}
+
+bool UGridPathManager::ComputeCooperativePath(const FGridPathRequest& Req, uint16 Agent, int64 StartTick, TArray<FIntPoint>& OutTimedCells)
+{
+	OutTimedCells.Reset();
+	UMapGridSubsystem* Grid = Req.Grid;
+	if (!Grid || Agent == FGridReservationTable::NoAgent) return false;
+	EnsureBoundTo(Grid);
+
+	Reservations.AdvanceTo(StartTick);
+	Reservations.ReleaseAgent(Agent);
+
+	const int32 Window = FMath::Clamp(CooperativeWindow, 1, Reservations.GetDepth() - 1);
+	const int32 GridW = Grid->GetWidth();
+	const int32 Cells = GridW * Grid->GetHeight();
+	auto CellId = [GridW](const FIntPoint& C) { return C.X + C.Y * GridW; };
+
+	// Estados (celda, t) dentro del rectngulo alcanzable en Window pasos
+	const FGridSearchBounds B(
+		FMath::Max(0, Req.Start.X - Window), FMath::Max(0, Req.Start.Y - Window),
+		FMath::Min(GridW - 1, Req.Start.X + Window), FMath::Min(Grid->GetHeight() - 1, Req.Start.Y + Window));
+	if (!B.Contains(Req.Start)) return false;
+	const int32 NumCells = B.Num();
+	CoopScratch.Begin(NumCells * (Window + 1));
+
+	// Ms all de la ventana se ignoran las reservas: h = mejor estimacin disponible de la distancia real
+	FGridPathLandmarks* L = (Cells <= LandmarkMaxMapCells) ? GetLandmarks(Grid, Req.Cost) : nullptr;
+	const FGridCostLUT Lut(Req.Cost);
+	const float MinStep = Lut.MinStep; // escala Manhattan sin romper la admisibilidad
+	auto H = [&](const FIntPoint& C)
 		{
-			OutPath.Reset();
-			OutPath.Add(End);
-			float CostAcc = 0.f;
+			const float Manhattan = Heuristic_Manhattan(C, Req.Goal) * MinStep;
+			return L ? FMath::Max(Manhattan, L->Heuristic(C, Req.Goal)) : Manhattan;
+		};
 
-			FIntPoint Cur = End;
-			while (Cur != Req.Start)
+	// La meta slo cierra la bsqueda si puede quedarse en ella hasta el final de la ventana; si otro
+	// la tiene reservada despus, se sigue buscando (esperar en otra celda y llegar ms tarde)
+	auto CanHoldGoal = [&](int32 T)
+		{
+			for (int32 t = T + 1; t <= Window; ++t)
 			{
-				const FIntPoint* Prev = CameFrom.Find(Cur);
-				if (!Prev) break;
-				CostAcc += TileCost(Grid, Cur, Req.Cost);
-				Cur = *Prev;
-				OutPath.Add(Cur);
+				if (Reservations.IsReservedByOther(CellId(Req.Goal), StartTick + t, Agent)) return false;
 			}
-			Algo::Reverse(OutPath);
-			OutCost = CostAcc;
+			return true;
 		};
 
-	TArray<FIntPoint> Path;
-	float CostSum = 0.f;
-	Reconstruct(ReachedCell, Path, CostSum);
+	CoopScratch.Relax(B.ToIndex(Req.Start), 0.f, INDEX_NONE, H(Req.Start));
 
-	// Vlida slo si hay al menos un paso real, salvo que Start==Goal
-	if (Path.Num() <= 1 && Req.Start != ReachedCell)
+	int32 Found = INDEX_NONE;
+	int32 Expanded = 0;
+	FGridSearchScratch::FEntry Cur;
+	while (CoopScratch.PopOpen(Cur))
 	{
-		OutResult = FGridPathResult{};
+		const int32 T = Cur.Idx / NumCells;
+		const FIntPoint C = B.ToCell(Cur.Idx % NumCells);
+		if ((C == Req.Goal && CanHoldGoal(T)) || T == Window) { Found = Cur.Idx; break; }
+
+		CoopScratch.Close(Cur.Idx);
+		++Expanded;
+		const int64 AbsT = StartTick + T;
+
+		// 4 movimientos + esperar
+		for (int32 Action = 0; Action < 5; ++Action)
+		{
+			const bool bWait = (Action == 4);
+			const FIntPoint N = bWait ? C : C + GridSearch::Dir4[Action];
+			if (!B.Contains(N)) continue;
+
+			const float StepCost = bWait ? CooperativeWaitCost : TileCost(Grid, N, Lut);
+			if (StepCost >= Req.Cost.ImpassableCost) continue;
+
+			// Celda ocupada en t+1, o intercambio de celdas con otro agente entre t y t+1
+			if (Reservations.IsReservedByOther(CellId(N), AbsT + 1, Agent)) continue;
+			if (!bWait)
+			{
+				const uint16 Other = Reservations.GetReserver(CellId(N), AbsT);
+				if (Other != FGridReservationTable::NoAgent && Other != Agent && Reservations.GetReserver(CellId(C), AbsT + 1) == Other) continue;
+			}
+
+			const int32 NIdx = (T + 1) * NumCells + B.ToIndex(N);
+			if (CoopScratch.IsClosed(NIdx)) continue;
+			const float TentG = Cur.G + StepCost;
+			if (!CoopScratch.IsSeen(NIdx) || TentG < CoopScratch.G[NIdx])
+			{
+				CoopScratch.Relax(NIdx, TentG, Cur.Idx, H(N));
+			}
+		}
+	}
+	LastNodesExpanded = Expanded;
+
+	if (Found == INDEX_NONE)
+	{
+		// Encerrado: esperar en el sitio (y que nadie cuente con esta celda)
+		OutTimedCells.Add(Req.Start);
+		Reservations.Reserve(CellId(Req.Start), StartTick, Agent);
 		return false;
 	}
 
-	OutResult.Cells = MoveTemp(Path);
-	OutResult.TotalCost = CostSum;
-	OutResult.bReachedGoal = (ReachedCell == Req.Goal);
-	OutResult.bValid = true;
-	return true;
+	for (int32 Idx = Found; Idx != INDEX_NONE; Idx = CoopScratch.Parent[Idx])
+	{
+		OutTimedCells.Add(B.ToCell(Idx % NumCells));
+	}
+	Algo::Reverse(OutTimedCells);
+
+	// Meta alcanzada antes del final de la ventana: se queda en ella
+	while (OutTimedCells.Num() < Window + 1) OutTimedCells.Add(OutTimedCells.Last());
+
+	for (int32 i = 0; i < OutTimedCells.Num(); ++i)
+	{
+		// Tick lleno: el plan acaba antes de ese tick y PathFollow replanifica al agotarlo
+		if (!Reservations.Reserve(CellId(OutTimedCells[i]), StartTick + i, Agent))
+		{
+			OutTimedCells.SetNum(i, EAllowShrinking::No);
+			break;
+		}
+	}
+	return OutTimedCells.Num() > 0;
+}
+
+FGridPathHierarchy* UGridPathManager::GetHierarchy(UMapGridSubsystem* Grid, const FGridCostProfile& InCost)
+{
+	if (!Grid || Grid->GetWidth() <= 0 || Grid->GetHeight() <= 0) return nullptr;
+	EnsureBoundTo(Grid);
+
+	// Amenaza y giro fuera: si no, el slot (indexado sin ellos) se reconstruira en cada consulta
+	const FGridCostProfile Cost = InCost.GetBaseCosts();
+	TUniquePtr<FGridPathHierarchy>& Slot = Hierarchies.FindOrAdd(GetTypeHash(Cost));
+	if (!Slot.IsValid())
+	{
+		Slot = MakeUnique<FGridPathHierarchy>();
+	}
+
+	if (!Slot->IsBuilt() || Slot->GetCostProfile() != Cost)
+	{
+		Slot->Build(Grid, Cost, HierarchicalClusterSize);
+	}
+	return Slot->IsBuilt() ? Slot.Get() : nullptr;
+}
+
+FGridPathLandmarks* UGridPathManager::GetLandmarks(UMapGridSubsystem* Grid, const FGridCostProfile& InCost)
+{
+	if (!Grid || Grid->GetWidth() <= 0 || Grid->GetHeight() <= 0) return nullptr;
+	EnsureBoundTo(Grid);
+
+	const FGridCostProfile Cost = InCost.GetBaseCosts();
+	TUniquePtr<FGridPathLandmarks>& Slot = LandmarkSets.FindOrAdd(GetTypeHash(Cost));
+	if (!Slot.IsValid())
+	{
+		Slot = MakeUnique<FGridPathLandmarks>();
+	}
+
+	if (!Slot->IsBuilt() || Slot->GetCostProfile() != Cost)
+	{
+		Slot->Build(Grid, Cost, LandmarkCount, ExactTableMaxCells);
+	}
+	return Slot->IsBuilt() ? Slot.Get() : nullptr;
+}
+
+void UGridPathManager::EnsureBoundTo(UMapGridSubsystem* Grid)
+{
+	if (BoundGrid.Get() != Grid)
+	{
+		if (UMapGridSubsystem* Old = BoundGrid.Get())
+		{
+			Old->OnGridCellChanged.Remove(CellChangedHandle);
+		}
+		BoundGrid = Grid;
+		CellChangedHandle = Grid->OnGridCellChanged.AddUObject(this, &UGridPathManager::HandleGridCellChanged);
+		BoundLayoutVersion = Grid->GetLayoutVersion();
+		Hierarchies.Reset();
+		LandmarkSets.Reset();
+		PathDatabase.Reset();
+		Reservations.Reset();
+		Cache.Reset();
+	}
+	else if (BoundLayoutVersion != Grid->GetLayoutVersion())
+	{
+		// Mapa recargado: todo lo precalculado es invlido
+		BoundLayoutVersion = Grid->GetLayoutVersion();
+		Hierarchies.Reset();
+		LandmarkSets.Reset();
+		PathDatabase.Reset();
+		Reservations.Reset();
+		Cache.Reset();
+	}
+}
+
+SIZE_T UGridPathManager::GetScratchAllocatedSize() const
+{
+	SIZE_T Bytes = Scratch.GetAllocatedSize() + Bfs.GetAllocatedSize() + BfsDist.GetAllocatedSize();
+	for (const TPair<uint32, TUniquePtr<FGridPathHierarchy>>& KVP : Hierarchies)
+	{
+		if (KVP.Value.IsValid()) Bytes += KVP.Value->GetAllocatedSize();
+	}
+	for (const TPair<uint32, TUniquePtr<FGridPathLandmarks>>& KVP : LandmarkSets)
+	{
+		if (KVP.Value.IsValid()) Bytes += KVP.Value->GetAllocatedSize();
+	}
+	Bytes += PathDatabase.GetAllocatedSize() + Reservations.GetAllocatedSize() + CoopScratch.GetAllocatedSize();
+	Bytes += Traces.GetAllocatedSize();
+	return Bytes;
+}
+
+void UGridPathManager::HandleGridCellChanged(FIntPoint Cell)
+{
+	Cache.InvalidateCell(Cell);
+	PublishCacheStats();
+
+	for (TPair<uint32, TUniquePtr<FGridPathHierarchy>>& KVP : Hierarchies)
+	{
+		if (KVP.Value.IsValid() && KVP.Value->IsBuilt())
+		{
+			KVP.Value->OnCellChanged(Cell);
+		}
+	}
+	for (TPair<uint32, TUniquePtr<FGridPathLandmarks>>& KVP : LandmarkSets)
+	{
+		if (KVP.Value.IsValid()) KVP.Value->OnCellChanged(Cell);
+	}
 }
@@ -0,0 +1,208 @@
+#include "Components/GridPathFollow/GridPathTrace.h"
+#include "Components/GridPathFollow/GridPathManager.h"
+#include "Map/MapGridSubsystem.h"
+#include "Engine/World.h"
+#include "Engine/GameInstance.h"
+#include "DrawDebugHelpers.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryWriter.h"
+
+// Uso en consola: bc.path.trace 1
+static TAutoConsoleVariable<int32> CVarBcPathTrace(
+	TEXT("bc.path.trace"),
+	0,
+	TEXT("1: Guarda la traza (expansiones, open set, ruta) de cada consulta de ruta. 0: Solo las lentas."),
+	ECVF_Cheat);
+
+#if !UE_BUILD_SHIPPING
+// Uso en consola: bc.path.trace.slowms 2.5
+static TAutoConsoleVariable<float> CVarBcPathTraceSlowMs(
+	TEXT("bc.path.trace.slowms"),
+	0.f,
+	TEXT("Consultas de ruta mas lentas que esto (ms, sin contar la construccion perezosa de datos) se repiten con traza y se guardan. 0: Desactivado."),
+	ECVF_Default);
+#endif
+
+bool GridPathTrace::IsCaptureEnabled()
+{
+	return CVarBcPathTrace.GetValueOnGameThread() != 0;
+}
+
+float GridPathTrace::GetSlowQueryMs()
+{
+#if UE_BUILD_SHIPPING
+	return 0.f; // sin auto-captura en Shipping
+#else
+	return CVarBcPathTraceSlowMs.GetValueOnGameThread();
+#endif
+}
+
+static UGridPathManager* GetPathManager(UWorld* World)
+{
+	UGameInstance* GI = World ? World->GetGameInstance() : nullptr;
+	return GI ? GI->GetSubsystem<UGridPathManager>() : nullptr;
+}
+
+// Uso en consola: bc.path.trace.draw [N=1] [segundos=5]
+static FAutoConsoleCommandWithWorldAndArgs GBcPathTraceDrawCmd(
+	TEXT("bc.path.trace.draw"),
+	TEXT("Dibuja sobre el grid las ultimas N trazas de ruta (expansiones azul->rojo por orden, ruta en amarillo)."),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+		{
+			UGridPathManager* Mgr = GetPathManager(World);
+			UGameInstance* GI = World ? World->GetGameInstance() : nullptr;
+			UMapGridSubsystem* Grid = GI ? GI->GetSubsystem<UMapGridSubsystem>() : nullptr;
+			if (!Mgr || !Grid) return;
+
+			const int32 N = Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 1;
+			const float Seconds = Args.Num() > 1 ? FCString::Atof(*Args[1]) : 5.f;
+			Mgr->GetTraces().Draw(World, Grid, FMath::Max(1, N), Seconds);
+		}));
+
+// Uso en consola: bc.path.trace.export [fichero]
+static FAutoConsoleCommandWithWorldAndArgs GBcPathTraceExportCmd(
+	TEXT("bc.path.trace.export"),
+	TEXT("Exporta las trazas de ruta guardadas a un .bctr binario (por defecto en Saved/PathTraces)."),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+		{
+			UGridPathManager* Mgr = GetPathManager(World);
+			if (!Mgr) return;
+
+			const FString Path = Args.Num() > 0 ? Args[0]
+				: FPaths::ProjectSavedDir() / TEXT("PathTraces") / FString::Printf(TEXT("PathTrace-%s.bctr"), *FDateTime::Now().ToString());
+			if (Mgr->GetTraces().ExportBinary(Path))
+			{
+				UE_LOG(LogTemp, Log, TEXT("[PathTrace] %d trazas exportadas a %s"), Mgr->GetTraces().Num(), *Path);
+			}
+			else
+			{
+				UE_LOG(LogTemp, Warning, TEXT("[PathTrace] No se pudo escribir %s"), *Path);
+			}
+		}));
+
+void FGridPathTraceRing::Configure(int32 InCapacity, int32 InMaxSamples)
+{
+	Slots.SetNum(FMath::Max(1, InCapacity));
+	MaxSamples = FMath::Max(0, InMaxSamples);
+	Reset();
+}
+
+void FGridPathTraceRing::Reset()
+{
+	Head = 0;
+	Count = 0;
+}
+
+FGridSearchTrace& FGridPathTraceRing::BeginTrace()
+{
+	if (Slots.Num() == 0) Slots.SetNum(1);
+
+	FGridSearchTrace& T = Slots[Head];
+	T.Expanded.Reset();
+	T.OpenSize.Reset();
+	T.Path.Reset();
+	T.bTruncated = false;
+	T.bSlow = false;
+	T.bReachedGoal = false;
+	T.Millis = 0.f;
+	T.NodesExpanded = 0;
+	T.MaxSamples = MaxSamples;
+	return T;
+}
+
+void FGridPathTraceRing::Commit()
+{
+	Head = (Head + 1) % Slots.Num();
+	Count = FMath::Min(Count + 1, Slots.Num());
+}
+
+const FGridSearchTrace& FGridPathTraceRing::GetRecent(int32 Index) const
+{
+	check(Index >= 0 && Index < Count);
+	return Slots[(Head - 1 - Index + Slots.Num() * 2) % Slots.Num()];
+}
+
+SIZE_T FGridPathTraceRing::GetAllocatedSize() const
+{
+	SIZE_T Bytes = Slots.GetAllocatedSize();
+	for (const FGridSearchTrace& T : Slots)
+	{
+		Bytes += T.Expanded.GetAllocatedSize() + T.OpenSize.GetAllocatedSize() + T.Path.GetAllocatedSize();
+	}
+	return Bytes;
+}
+
+bool FGridPathTraceRing::ExportBinary(const FString& FilePath) const
+{
+	TArray<uint8> Bytes;
+	FMemoryWriter Ar(Bytes);
+
+	uint32 Magic = 0x52544342; // "BCTR"
+	uint32 Version = 1;
+	int32 Num = Count;
+	Ar << Magic << Version << Num;
+
+	auto WriteCell = [&Ar](const FIntPoint& C)
+		{
+			uint16 X = (uint16)C.X, Y = (uint16)C.Y;
+			Ar << X << Y;
+		};
+
+	// De la ms antigua a la ms reciente
+	for (int32 i = Count - 1; i >= 0; --i)
+	{
+		const FGridSearchTrace& T = GetRecent(i);
+		WriteCell(T.Start);
+		WriteCell(T.Goal);
+		uint8 Planner = T.Planner;
+		uint8 Flags = (uint8)((T.bReachedGoal ? 1 : 0) | (T.bSlow ? 2 : 0) | (T.bTruncated ? 4 : 0));
+		float Millis = T.Millis;
+		int32 Nodes = T.NodesExpanded;
+		int32 NumExpanded = T.Expanded.Num();
+		Ar << Planner << Flags << Millis << Nodes << NumExpanded;
+		for (int32 k = 0; k < NumExpanded; ++k)
+		{
+			WriteCell(T.Expanded[k]);
+			uint16 Open = (uint16)FMath::Min(T.OpenSize[k], (int32)MAX_uint16);
+			Ar << Open;
+		}
+		int32 NumPath = T.Path.Num();
+		Ar << NumPath;
+		for (const FIntPoint& C : T.Path) WriteCell(C);
+	}
+
+	return FFileHelper::SaveArrayToFile(Bytes, *FilePath);
+}
+
+void FGridPathTraceRing::Draw(UWorld* World, const UMapGridSubsystem* Grid, int32 NumTraces, float Seconds) const
+{
+	if (!World || !Grid) return;
+	const float Tile = Grid->GetTileSize();
+
+	for (int32 i = 0; i < FMath::Min(NumTraces, Count); ++i)
+	{
+		const FGridSearchTrace& T = GetRecent(i);
+		const float Z = Tile * (0.2f + 0.1f * i); // cada traza un poco ms alta para distinguirlas
+
+		const int32 NumExp = T.Expanded.Num();
+		for (int32 k = 0; k < NumExp; ++k)
+		{
+			const float Alpha = NumExp > 1 ? (float)k / (NumExp - 1) : 0.f;
+			const FColor Col = FLinearColor::LerpUsingHSV(FLinearColor::Blue, FLinearColor::Red, Alpha).ToFColor(true);
+			DrawDebugPoint(World, Grid->GridToWorld(T.Expanded[k].X, T.Expanded[k].Y, Z), 8.f, Col, false, Seconds);
+		}
+
+		for (int32 k = 1; k < T.Path.Num(); ++k)
+		{
+			DrawDebugLine(World, Grid->GridToWorld(T.Path[k - 1].X, T.Path[k - 1].Y, Z), Grid->GridToWorld(T.Path[k].X, T.Path[k].Y, Z),
+				FColor::Yellow, false, Seconds, 0, 6.f);
+		}
+		DrawDebugSphere(World, Grid->GridToWorld(T.Start.X, T.Start.Y, Z), Tile * 0.2f, 8, FColor::Green, false, Seconds);
+		DrawDebugSphere(World, Grid->GridToWorld(T.Goal.X, T.Goal.Y, Z), Tile * 0.2f, 8, T.bReachedGoal ? FColor::Red : FColor::Orange, false, Seconds);
+
+		UE_LOG(LogTemp, Log, TEXT("[PathTrace] #%d (%d,%d)->(%d,%d) planner=%d %.3f ms nodes=%d path=%d%s%s"),
+			i, T.Start.X, T.Start.Y, T.Goal.X, T.Goal.Y, T.Planner, T.Millis, T.NodesExpanded, T.Path.Num(),
+			T.bSlow ? TEXT(" [lenta]") : TEXT(""), T.bTruncated ? TEXT(" [truncada]") : TEXT(""));
+	}
+}
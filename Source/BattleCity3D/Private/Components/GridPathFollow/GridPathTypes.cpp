@@ -1,4 +1,32 @@
+#include "Components/GridPathFollow/GridPathTypes.h"
+#include "Map/MapGridSubsystem.h"
 
+FGridCostLUT::FGridCostLUT(const FGridCostProfile& P)
+{
+	ImpassableCost = P.ImpassableCost;
+	MinStep = TNumericLimits<float>::Max();
 
+	for (int32 Code = 0; Code < 16; ++Code)
+	{
+		const ETerrainType T = (ETerrainType)(Code & 3);
+		const int32 O = Code >> 2;
 
-#include "Components/GridPathFollow/GridPathTypes.h"
+		// Agua y acero (y cdigos sin uso): impasables
+		float C = P.ImpassableCost;
+		if (T != ETerrainType::Water && O <= (int32)EObstacleType::Brick)
+		{
+			C = (O == (int32)EObstacleType::Brick) ? P.BrickCost : P.FreeCost;
+			if (T == ETerrainType::Ice)    C += P.IceExtraCost;
+			if (T == ETerrainType::Forest) C += P.ForestExtraCost;
+			C = FMath::Min(FMath::Max(C, KINDA_SMALL_NUMBER), P.ImpassableCost);
+		}
+		Costs[Code] = C;
+
+		if (C < P.ImpassableCost)
+		{
+			MinStep = FMath::Min(MinStep, C);
+			bIntegral &= (C == FMath::FloorToFloat(C));
+		}
+	}
+	if (MinStep == TNumericLimits<float>::Max()) MinStep = FMath::Max(KINDA_SMALL_NUMBER, P.FreeCost);
+}
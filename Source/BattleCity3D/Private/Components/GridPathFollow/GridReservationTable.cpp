@@ -0,0 +1,114 @@
+#include "Components/GridPathFollow/GridReservationTable.h"
+
+void FGridReservationTable::Configure(int32 InDepth, int32 InMaxAgents)
+{
+	Depth = FMath::Max(1, InDepth);
+	SlotsPerTick = (int32)FMath::RoundUpToPowerOfTwo((uint32)FMath::Max(8, InMaxAgents * 2));
+	Slots.SetNum(Depth * SlotsPerTick);
+	BucketTick.SetNum(Depth);
+	Reset();
+}
+
+void FGridReservationTable::Reset()
+{
+	for (FSlot& S : Slots) S = FSlot{};
+	for (int64& T : BucketTick) T = INDEX_NONE;
+	for (TArray<TPair<int32, int64>>& L : ByAgent) L.Reset();
+	CurrentTick = 0;
+}
+
+void FGridReservationTable::AdvanceTo(int64 Tick)
+{
+	if (Depth == 0 || Tick <= CurrentTick) return;
+	CurrentTick = Tick;
+
+	// Los buckets de ticks ya pasados quedan libres para reciclarse en Reserve
+	for (TArray<TPair<int32, int64>>& L : ByAgent)
+	{
+		L.RemoveAll([Tick](const TPair<int32, int64>& R) { return R.Value < Tick; });
+	}
+}
+
+const FGridReservationTable::FSlot* FGridReservationTable::FindSlot(int32 Cell, int64 Tick) const
+{
+	const int32 Bucket = BucketOf(Tick);
+	if (BucketTick[Bucket] != Tick) return nullptr;
+
+	const FSlot* Base = Slots.GetData() + Bucket * SlotsPerTick;
+	const uint32 Mask = (uint32)SlotsPerTick - 1;
+	for (uint32 i = 0, H = HashCell(Cell) & Mask; i < (uint32)SlotsPerTick; ++i, H = (H + 1) & Mask)
+	{
+		const FSlot& S = Base[H];
+		if (S.Cell == MAX_uint32) return nullptr;
+		if (S.Cell == (uint32)Cell && S.Agent != NoAgent) return &S;
+	}
+	return nullptr;
+}
+
+uint16 FGridReservationTable::GetReserver(int32 Cell, int64 Tick) const
+{
+	if (Depth == 0 || !IsInWindow(Tick)) return NoAgent;
+	const FSlot* S = FindSlot(Cell, Tick);
+	return S ? S->Agent : NoAgent;
+}
+
+bool FGridReservationTable::Reserve(int32 Cell, int64 Tick, uint16 Agent)
+{
+	if (Depth == 0 || Agent == NoAgent || !IsInWindow(Tick)) return false;
+
+	const int32 Bucket = BucketOf(Tick);
+	FSlot* Base = Slots.GetData() + Bucket * SlotsPerTick;
+	if (BucketTick[Bucket] != Tick)
+	{
+		// Reciclar el bucket de un tick vencido
+		for (int32 i = 0; i < SlotsPerTick; ++i) Base[i] = FSlot{};
+		BucketTick[Bucket] = Tick;
+	}
+
+	const uint32 Mask = (uint32)SlotsPerTick - 1;
+	FSlot* Free = nullptr;
+	for (uint32 i = 0, H = HashCell(Cell) & Mask; i < (uint32)SlotsPerTick; ++i, H = (H + 1) & Mask)
+	{
+		FSlot& S = Base[H];
+		if (S.Cell == (uint32)Cell && S.Agent != NoAgent) return S.Agent == Agent;
+		if (S.Agent == NoAgent && !Free) Free = &S;
+		if (S.Cell == MAX_uint32) break;
+	}
+	if (!Free) return false; // tick lleno
+
+	Free->Cell = (uint32)Cell;
+	Free->Agent = Agent;
+
+	if (ByAgent.Num() <= Agent) ByAgent.SetNum(Agent + 1);
+	ByAgent[Agent].Add(TPair<int32, int64>(Cell, Tick));
+	return true;
+}
+
+void FGridReservationTable::ReleaseAgent(uint16 Agent)
+{
+	if (!ByAgent.IsValidIndex(Agent)) return;
+
+	for (const TPair<int32, int64>& R : ByAgent[Agent])
+	{
+		if (!IsInWindow(R.Value)) continue;
+		if (FSlot* S = const_cast<FSlot*>(FindSlot(R.Key, R.Value)))
+		{
+			if (S->Agent == Agent) S->Agent = NoAgent; // borrado: la celda se queda para no cortar el sondeo
+		}
+	}
+	ByAgent[Agent].Reset();
+}
+
+int32 FGridReservationTable::GetNumReservations() const
+{
+	int32 Num = 0;
+	for (const TArray<TPair<int32, int64>>& L : ByAgent) Num += L.Num();
+	return Num;
+}
+
+SIZE_T FGridReservationTable::GetAllocatedSize() const
+{
+	SIZE_T Bytes = Slots.GetAllocatedSize() + BucketTick.GetAllocatedSize() + ByAgent.GetAllocatedSize();
+	for (const TArray<TPair<int32, int64>>& L : ByAgent) Bytes += L.GetAllocatedSize();
+	return Bytes;
+}
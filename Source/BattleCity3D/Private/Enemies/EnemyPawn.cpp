@@ -7,6 +7,8 @@
 #include "Map/MapGridSubsystem.h"
 #include "GameClasses/BattleGameMode.h"
 #include "Spawner/EnemySpawner.h"
+#include "Common/BattleTargetRegistry.h"
+#include "Common/GameplayTimerSubsystem.h"
 
 // Nota: No necesitamos DrawDebugHelpers aqu para el movimiento fsico, 
 // eso ya lo hace ABattleTankPawn.
@@ -25,6 +27,9 @@ void AEnemyPawn::BeginPlay()
     // Llama a la base para inicializar Grid y hacer el Snap inicial
     Super::BeginPlay();
 
+    Targets = GetWorld()->GetSubsystem<UBattleTargetRegistry>();
+    if (Targets) Targets->Register(this, EBattleTargetKind::Enemy, EBattleTeam::Enemy);
+
     // Configuracin inicial de Stats segn el tipo
     if (bAcceptTypeFromSpawner)
     {
@@ -32,11 +37,39 @@ void AEnemyPawn::BeginPlay()
         SetTypeFromSpawner(EnemyType);
     }
 
+    // Sin MovementComp (UpdateAI): primera decisin desfasada por actor para no pensar todos en el mismo frame
+    if (!MovementComp)
+    {
+        ScheduleAIDecision(AIReplanInterval * (float)(GetUniqueID() % 8) / 8.f);
+    }
+
     // Iniciar disparo automtico si hay clase de proyectil
     if (ProjectileClass)
     {
-        GetWorld()->GetTimerManager().SetTimer(FireTimer, this, &AEnemyPawn::Fire, FireInterval, true, FMath::RandRange(0.5f, 1.5f));
+        // Rueda de timers del mundo; FTimerManager slo si no existe (mundos sin el subsistema)
+        const float FirstDelay = FMath::RandRange(0.5f, 1.5f);
+        if (UGameplayTimerSubsystem* Timers = GetWorld()->GetSubsystem<UGameplayTimerSubsystem>())
+        {
+            FireTimer = Timers->SetTimer(FTimerDelegate::CreateUObject(this, &AEnemyPawn::Fire), FireInterval, true, FirstDelay);
+        }
+        else
+        {
+            GetWorldTimerManager().SetTimer(FireTimerFallback, this, &AEnemyPawn::Fire, FireInterval, true, FirstDelay);
+        }
+    }
+}
+
+void AEnemyPawn::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    if (Targets) Targets->Unregister(this);
+    if (UGameplayTimerSubsystem* Timers = GetWorld()->GetSubsystem<UGameplayTimerSubsystem>())
+    {
+        Timers->ClearTimer(FireTimer);
+        Timers->ClearTimer(AIDecisionTimer);
     }
+    GetWorldTimerManager().ClearTimer(FireTimerFallback);
+    GetWorldTimerManager().ClearTimer(AIDecisionTimerFallback);
+    Super::EndPlay(EndPlayReason);
 }
 
 void AEnemyPawn::Tick(float DeltaSeconds)
@@ -55,6 +88,30 @@ void AEnemyPawn::Tick(float DeltaSeconds)
     Super::Tick(DeltaSeconds);
 }
 
+void AEnemyPawn::OnGameplayTimer(uint32 Payload)
+{
+    MarkAIDecisionDue();
+}
+
+void AEnemyPawn::ScheduleAIDecision(float Delay)
+{
+    // Igual que el disparo: rueda de timers del mundo y FTimerManager slo si no existe
+    bAIDecisionDue = false;
+    if (UGameplayTimerSubsystem* Timers = GetWorld()->GetSubsystem<UGameplayTimerSubsystem>())
+    {
+        Timers->ClearTimer(AIDecisionTimer);
+        AIDecisionTimer = Timers->SetTimer(this, 0, FMath::Max(Delay, 0.f));
+    }
+    else if (Delay > 0.f)
+    {
+        GetWorldTimerManager().SetTimer(AIDecisionTimerFallback, this, &AEnemyPawn::MarkAIDecisionDue, Delay, false);
+    }
+    else
+    {
+        bAIDecisionDue = true;
+    }
+}
+
 void AEnemyPawn::UpdateAI(float DT)
 {
     const double Now = UGameplayStatics::GetTimeSeconds(this);
@@ -81,7 +138,7 @@ void AEnemyPawn::UpdateAI(float DT)
     // Solo recalculamos ruta si:
     // A) Ya pas el tiempo de espera (Timer vencido)
     // B) O estamos bloqueados AHORA MISMO (Emergencia)
-    if (Now < NextAIDecisionTime && !bIsBlockedNow)
+    if (!bAIDecisionDue && !bIsBlockedNow)
     {
         return; // Mantenemos la decisin anterior y seguimos movindonos
     }
@@ -99,7 +156,7 @@ void AEnemyPawn::UpdateAI(float DT)
     // B. Persecucin del Objetivo
 
     // Reseteamos el timer para pensamiento normal
-    NextAIDecisionTime = Now + AIReplanInterval;
+    ScheduleAIDecision(AIReplanInterval);
 
     const FVector Target = GetAITargetWorld();
     const FVector To = Target - GetActorLocation();
@@ -212,7 +269,7 @@ void AEnemyPawn::ChooseTurn()
 
             // COMPROMISO: Forzamos a mantener esta direccin por un tiempo
             // para evitar que la IA intente volver inmediatamente a la ruta bloqueada.
-            NextAIDecisionTime = UGameplayStatics::GetTimeSeconds(this) + AICommitmentTimeAfterTurn;
+            ScheduleAIDecision(AICommitmentTimeAfterTurn);
 
             return;
         }
@@ -225,29 +282,21 @@ void AEnemyPawn::ChooseTurn()
 
 FVector AEnemyPawn::GetAITargetWorld() const
 {
-    // 1. Si tenemos objetivo prioritario (Base)
+    // Foto del frame en UBattleTargetRegistry: sin buscar actores por tick
+    if (!Targets) return FVector::ZeroVector;
+
+    // 1. Si tenemos objetivo prioritario: la base del jugador
     if (Goal == EEnemyGoal::HuntBase)
     {
-        // Buscar actor base
-        TArray<AActor*> Bases;
-        UGameplayStatics::GetAllActorsOfClass(this, ABattleBase::StaticClass(), Bases); // Optimizar cach en prod
-
-        // Filtrar bases aliadas (Bando del jugador = azul, nosotros = rojo/enemigo)
-        // Buscamos la base del jugador para destruirla
-        for (AActor* B : Bases)
-        {
-            if (ABattleBase* BaseParams = Cast<ABattleBase>(B))
-            {
-                if (!BaseParams->bIsEnemyBase) // Es base aliada (objetivo)
-                    return B->GetActorLocation();
-            }
-        }
+        if (const FBattleTargetEntry* Base = Targets->GetBase(EBattleTeam::Player))
+            return Base->Location;
     }
 
     // 2. Fallback: Ir al jugador
-    if (APawn* Player = UGameplayStatics::GetPlayerPawn(this, 0))
+    FVector PlayerLoc;
+    if (Targets->GetPlayerLocation(PlayerLoc))
     {
-        return Player->GetActorLocation();
+        return PlayerLoc;
     }
 
     return FVector::ZeroVector;
@@ -0,0 +1,350 @@
+#include "Enemies/Horde/HordeProcessors.h"
+#include "Enemies/Horde/HordeFragments.h"
+#include "Enemies/Horde/HordeSubsystem.h"
+#include "Components/GridPathFollow/GridSearch.h"
+#include "Map/GridBitboard.h"
+#include "Map/MapGridSubsystem.h"
+#include "MassExecutionContext.h"
+#include "MassEntityManager.h"
+
+DECLARE_CYCLE_STAT(TEXT("Horde decide"), STAT_BCHorde_Decide, STATGROUP_BCHorde);
+DECLARE_CYCLE_STAT(TEXT("Horde move"), STAT_BCHorde_Move, STATGROUP_BCHorde);
+DECLARE_CYCLE_STAT(TEXT("Horde fire"), STAT_BCHorde_Fire, STATGROUP_BCHorde);
+DECLARE_CYCLE_STAT(TEXT("Horde render"), STAT_BCHorde_Render, STATGROUP_BCHorde);
+
+static constexpr float HordeCenterEps = 1e-3f;
+
+// Centro de celda hacia el que va (la celda actual si an no pas su centro) y distancia hasta l
+static FIntPoint UpcomingCenter(const FHordeGridFragment& G, uint8 Dir, float& OutToCenter)
+{
+	const FIntPoint& D = GridSearch::Dir4[Dir];
+	const float Along = (G.Pos.X - G.Cell.X) * D.X + (G.Pos.Y - G.Cell.Y) * D.Y;
+	if (Along > HordeCenterEps)
+	{
+		OutToCenter = 1.f - Along;
+		return G.Cell + D;
+	}
+	OutToCenter = FMath::Max(0.f, -Along);
+	return G.Cell;
+}
+
+UHordeProcessorBase::UHordeProcessorBase()
+{
+	// Los ejecuta UHordeSubsystem en su orden; sin MassSimulation no hay fases que los lancen
+	bAutoRegisterWithProcessingPhases = false;
+	ExecutionFlags = (int32)EProcessorExecutionFlags::All;
+}
+
+// ================= Decisin =================
+
+UHordeDecisionProcessor::UHordeDecisionProcessor()
+	: EntityQuery(*this)
+{
+}
+
+void UHordeDecisionProcessor::ConfigureQueries(const TSharedRef<FMassEntityManager>& EntityManager)
+{
+	EntityQuery.AddRequirement<FHordeGridFragment>(EMassFragmentAccess::ReadOnly);
+	EntityQuery.AddRequirement<FHordeFacingFragment>(EMassFragmentAccess::ReadOnly);
+	EntityQuery.AddRequirement<FHordeTankFragment>(EMassFragmentAccess::ReadOnly);
+	EntityQuery.AddRequirement<FHordeGoalFragment>(EMassFragmentAccess::ReadWrite);
+	EntityQuery.AddTagRequirement<FHordeTag>(EMassFragmentPresence::All);
+}
+
+void UHordeDecisionProcessor::Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context)
+{
+	SCOPE_CYCLE_COUNTER(STAT_BCHorde_Decide);
+	const UHordeSubsystem* H = Horde;
+	if (!H || !H->GetGrid()) return;
+	const FGridBitboard& Walkable = H->GetGrid()->GetWalkableBits();
+
+	// Slo lee el grid y los campos: chunks en paralelo
+	EntityQuery.ParallelForEachEntityChunk(Context, [H, &Walkable](FMassExecutionContext& Ctx)
+		{
+			const TConstArrayView<FHordeGridFragment> Grids = Ctx.GetFragmentView<FHordeGridFragment>();
+			const TConstArrayView<FHordeFacingFragment> Facings = Ctx.GetFragmentView<FHordeFacingFragment>();
+			const TConstArrayView<FHordeTankFragment> Tanks = Ctx.GetFragmentView<FHordeTankFragment>();
+			const TArrayView<FHordeGoalFragment> Goals = Ctx.GetMutableFragmentView<FHordeGoalFragment>();
+
+			for (int32 i = 0; i < Ctx.GetNumEntities(); ++i)
+			{
+				const uint8 Facing = Facings[i].Dir;
+				const uint32 Seed = Tanks[i].Seed;
+				FHordeGoalFragment& Goal = Goals[i];
+
+				float ToCenter = 0.f;
+				const FIntPoint Center = UpcomingCenter(Grids[i], Facing, ToCenter);
+				const uint16 Here = H->GetGoalDistance(Goal.Goal, Center);
+
+				// Primero la orientacin actual (empates = no girar), luego el resto en un orden propio de la entidad
+				uint8 Order[4] = { Facing, 0, 0, 0 };
+				for (int32 k = 0, n = 1; k < 4; ++k)
+				{
+					const uint8 D = (uint8)((Seed + k) & 3);
+					if (D != Facing) Order[n++] = D;
+				}
+
+				// Encerrado o sin campo: deambula siguiendo el pasillo
+				if (Here == FGridBitBFS::Unreached)
+				{
+					Goal.WantDir = HordeNoDir;
+					for (const uint8 D : Order)
+					{
+						const FIntPoint N = Center + GridSearch::Dir4[D];
+						if (Walkable.Get(N.X, N.Y)) { Goal.WantDir = D; break; }
+					}
+					continue;
+				}
+
+				// Baja por el campo de distancia (los ladrillos cuentan como paso: se rompen a tiros)
+				uint8 Best = HordeNoDir;
+				uint16 BestDist = Here;
+				for (const uint8 D : Order)
+				{
+					const uint16 Dist = H->GetGoalDistance(Goal.Goal, Center + GridSearch::Dir4[D]);
+					if (Dist < BestDist) { BestDist = Dist; Best = D; }
+				}
+				Goal.WantDir = Best;
+			}
+		});
+}
+
+// ================= Movimiento =================
+
+UHordeMovementProcessor::UHordeMovementProcessor()
+	: EntityQuery(*this)
+{
+	ExecutionOrder.ExecuteAfter.Add(UHordeDecisionProcessor::StaticClass()->GetFName());
+}
+
+void UHordeMovementProcessor::ConfigureQueries(const TSharedRef<FMassEntityManager>& EntityManager)
+{
+	EntityQuery.AddRequirement<FHordeGridFragment>(EMassFragmentAccess::ReadWrite);
+	EntityQuery.AddRequirement<FHordeFacingFragment>(EMassFragmentAccess::ReadWrite);
+	EntityQuery.AddRequirement<FHordeVelocityFragment>(EMassFragmentAccess::ReadWrite);
+	EntityQuery.AddRequirement<FHordeGoalFragment>(EMassFragmentAccess::ReadOnly);
+	EntityQuery.AddRequirement<FHordeTankFragment>(EMassFragmentAccess::ReadOnly);
+	EntityQuery.AddTagRequirement<FHordeTag>(EMassFragmentPresence::All);
+}
+
+void UHordeMovementProcessor::Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context)
+{
+	SCOPE_CYCLE_COUNTER(STAT_BCHorde_Move);
+	UHordeSubsystem* H = Horde;
+	if (!H || !H->GetGrid()) return;
+
+	// Cada entidad reserva la celda que ocupa y la que entra (CAS en UHordeSubsystem::CellClaims);
+	// no entra donde hay otra entidad o un pawn. Fuera de las reservas slo toca sus fragmentos.
+	EntityQuery.ParallelForEachEntityChunk(Context, [H](FMassExecutionContext& Ctx)
+		{
+			const float DT = Ctx.GetDeltaTimeSeconds();
+			const TArrayView<FHordeGridFragment> Grids = Ctx.GetMutableFragmentView<FHordeGridFragment>();
+			const TArrayView<FHordeFacingFragment> Facings = Ctx.GetMutableFragmentView<FHordeFacingFragment>();
+			const TArrayView<FHordeVelocityFragment> Velocities = Ctx.GetMutableFragmentView<FHordeVelocityFragment>();
+			const TConstArrayView<FHordeGoalFragment> Goals = Ctx.GetFragmentView<FHordeGoalFragment>();
+			const TConstArrayView<FHordeTankFragment> Tanks = Ctx.GetFragmentView<FHordeTankFragment>();
+
+			for (int32 i = 0; i < Ctx.GetNumEntities(); ++i)
+			{
+				FHordeGridFragment& G = Grids[i];
+				FHordeFacingFragment& F = Facings[i];
+				FHordeVelocityFragment& V = Velocities[i];
+				const uint8 Want = Goals[i].WantDir;
+				const FHordeTypeParams& P = H->GetParams(Tanks[i].Type);
+
+				// Parn de giro (TurnDelay), como ABattleTankPawn
+				if (V.TurnDelayLeft > 0.f)
+				{
+					V.TurnDelayLeft -= DT;
+					continue;
+				}
+
+				float ToCenter = 0.f;
+				FIntPoint Center = UpcomingCenter(G, F.Dir, ToCenter);
+
+				// En el centro: girar, parar o seguir hacia el siguiente
+				if (ToCenter <= HordeCenterEps)
+				{
+					G.Pos = FVector2f((float)Center.X, (float)Center.Y);
+					G.Cell = Center;
+					// Lleg a la que estaba entrando: suelta la anterior
+					if (G.Ahead == Center)
+					{
+						if (G.Held != Center) H->ReleaseCell(G.Held, G.ClaimId);
+						G.Ahead = FIntPoint(INDEX_NONE, INDEX_NONE);
+					}
+					// Sin su celda (recin creada en un spawn ocupado): espera a que quede libre
+					if (!H->ClaimCell(Center, G.ClaimId))
+					{
+						V.Speed = 0.f;
+						continue;
+					}
+					G.Held = Center;
+					if (Want != HordeNoDir && Want != F.Dir)
+					{
+						F.Dir = Want;
+						V.Speed = 0.f;
+						V.TurnDelayLeft = P.TurnDelay;
+						continue;
+					}
+					const FIntPoint Next = Center + GridSearch::Dir4[F.Dir];
+					if (Want == HordeNoDir || !H->CanEnterCell(Next) || !H->ClaimCell(Next, G.ClaimId))
+					{
+						V.Speed = 0.f;
+						continue;
+					}
+					G.Ahead = Next;
+					Center = Next;
+					ToCenter = 1.f;
+				}
+
+				const FIntPoint& D = GridSearch::Dir4[F.Dir];
+				V.Speed = FMath::FInterpTo(V.Speed, P.Speed, DT, P.AccelRate);
+				float Step = V.Speed * DT;
+
+				// Al cruzar un centro slo sigue de largo si no gira y reserva la siguiente
+				if (Step >= ToCenter)
+				{
+					const FIntPoint Next = Center + D;
+					if (Want == F.Dir && H->CanEnterCell(Next) && H->ClaimCell(Next, G.ClaimId))
+					{
+						if (G.Held != Center) H->ReleaseCell(G.Held, G.ClaimId);
+						G.Held = Center;
+						G.Ahead = Next;
+					}
+					else
+					{
+						Step = ToCenter;
+					}
+				}
+
+				G.Pos.X += D.X * Step;
+				G.Pos.Y += D.Y * Step;
+				G.Cell = FIntPoint(FMath::RoundToInt(G.Pos.X), FMath::RoundToInt(G.Pos.Y));
+			}
+		});
+}
+
+// ================= Disparo =================
+
+UHordeFireProcessor::UHordeFireProcessor()
+	: EntityQuery(*this)
+{
+	ExecutionOrder.ExecuteAfter.Add(UHordeMovementProcessor::StaticClass()->GetFName());
+	bRequiresGameThreadExecution = true;
+}
+
+void UHordeFireProcessor::ConfigureQueries(const TSharedRef<FMassEntityManager>& EntityManager)
+{
+	EntityQuery.AddRequirement<FHordeGridFragment>(EMassFragmentAccess::ReadOnly);
+	EntityQuery.AddRequirement<FHordeFacingFragment>(EMassFragmentAccess::ReadOnly);
+	EntityQuery.AddRequirement<FHordeGoalFragment>(EMassFragmentAccess::ReadOnly);
+	EntityQuery.AddRequirement<FHordeTankFragment>(EMassFragmentAccess::ReadWrite);
+	EntityQuery.AddTagRequirement<FHordeTag>(EMassFragmentPresence::All);
+}
+
+void UHordeFireProcessor::Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context)
+{
+	SCOPE_CYCLE_COUNTER(STAT_BCHorde_Fire);
+	UHordeSubsystem* H = Horde;
+	if (!H || !H->GetGrid()) return;
+
+	// En serie: escribe la cola de disparos del subsistema
+	EntityQuery.ForEachEntityChunk(Context, [H](FMassExecutionContext& Ctx)
+		{
+			const float DT = Ctx.GetDeltaTimeSeconds();
+			const TConstArrayView<FHordeGridFragment> Grids = Ctx.GetFragmentView<FHordeGridFragment>();
+			const TConstArrayView<FHordeFacingFragment> Facings = Ctx.GetFragmentView<FHordeFacingFragment>();
+			const TConstArrayView<FHordeGoalFragment> Goals = Ctx.GetFragmentView<FHordeGoalFragment>();
+			const TArrayView<FHordeTankFragment> Tanks = Ctx.GetMutableFragmentView<FHordeTankFragment>();
+
+			for (int32 i = 0; i < Ctx.GetNumEntities(); ++i)
+			{
+				FHordeTankFragment& T = Tanks[i];
+				if (T.HitPoints <= 0) continue;
+				T.FireCooldown -= DT;
+				if (T.FireCooldown > 0.f || H->Shots.Num() >= H->MaxShotsPerFrame) continue;
+
+				const FHordeGridFragment& G = Grids[i];
+				const uint8 Dir = Facings[i].Dir;
+				const FIntPoint& D = GridSearch::Dir4[Dir];
+
+				// De frente: ladrillo en su camino (pegado), o base / jugador en lnea antes de un muro
+				bool bFire = false;
+				FIntPoint C = G.Cell + D;
+				for (int32 Step = 0; Step < H->FireRangeCells; ++Step, C += D)
+				{
+					if (H->IsBaseCell(C) || (H->HasPlayer() && C == H->GetPlayerCell())) { bFire = true; break; }
+					if (H->IsBrickCell(C)) { bFire = Step == 0 && Goals[i].WantDir == Dir; break; }
+					if (!H->IsOpenCell(C)) break;
+				}
+				if (!bFire) continue;
+
+				H->Shots.Add({ G.Pos, Dir });
+				// Cadencia del tipo con un desfase propio, para que una tanda no dispare a la vez
+				const FHordeTypeParams& P = H->GetParams(T.Type);
+				T.FireCooldown = P.FireInterval * (0.8f + 0.4f * (float)((T.Seed >> 8) & 255) / 255.f);
+			}
+		});
+}
+
+// ================= Render + ocupacin =================
+
+UHordeRenderProcessor::UHordeRenderProcessor()
+	: EntityQuery(*this)
+{
+	ExecutionOrder.ExecuteAfter.Add(UHordeFireProcessor::StaticClass()->GetFName());
+	bRequiresGameThreadExecution = true;
+}
+
+void UHordeRenderProcessor::ConfigureQueries(const TSharedRef<FMassEntityManager>& EntityManager)
+{
+	EntityQuery.AddRequirement<FHordeGridFragment>(EMassFragmentAccess::ReadOnly);
+	EntityQuery.AddRequirement<FHordeFacingFragment>(EMassFragmentAccess::ReadOnly);
+	EntityQuery.AddRequirement<FHordeTankFragment>(EMassFragmentAccess::ReadOnly);
+	EntityQuery.AddTagRequirement<FHordeTag>(EMassFragmentPresence::All);
+}
+
+void UHordeRenderProcessor::Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context)
+{
+	SCOPE_CYCLE_COUNTER(STAT_BCHorde_Render);
+	UHordeSubsystem* H = Horde;
+	if (!H || !H->GetGrid()) return;
+
+	const int32 W = H->GetGrid()->GetWidth();
+	const int32 Hgt = H->GetGrid()->GetHeight();
+	H->CellHead.Init(INDEX_NONE, W * Hgt);
+	H->NextInCell.Reset();
+	H->Occupants.Reset();
+	H->OccupantPos.Reset();
+	H->InstanceTransforms.Reset();
+
+	const FTransform& MeshRel = H->GetMeshRelative();
+	const float Z = H->GetTankZ();
+
+	EntityQuery.ForEachEntityChunk(Context, [H, W, Hgt, &MeshRel, Z](FMassExecutionContext& Ctx)
+		{
+			const TConstArrayView<FHordeGridFragment> Grids = Ctx.GetFragmentView<FHordeGridFragment>();
+			const TConstArrayView<FHordeFacingFragment> Facings = Ctx.GetFragmentView<FHordeFacingFragment>();
+			const TConstArrayView<FHordeTankFragment> Tanks = Ctx.GetFragmentView<FHordeTankFragment>();
+
+			for (int32 i = 0; i < Ctx.GetNumEntities(); ++i)
+			{
+				// Muertas este frame: se destruyen al principio del siguiente
+				if (Tanks[i].HitPoints <= 0) continue;
+				const FHordeGridFragment& G = Grids[i];
+
+				const FTransform Actor(H->DirToRotation(Facings[i].Dir), H->CellToWorld(G.Pos, Z));
+				H->InstanceTransforms.Add(MeshRel * Actor);
+
+				if (G.Cell.X < 0 || G.Cell.Y < 0 || G.Cell.X >= W || G.Cell.Y >= Hgt) continue;
+				const int32 Idx = H->Occupants.Add(Ctx.GetEntity(i));
+				H->OccupantPos.Add(G.Pos);
+				int32& Head = H->CellHead[G.Cell.X + G.Cell.Y * W];
+				H->NextInCell.Add(Head);
+				Head = Idx;
+			}
+		});
+
+	H->NumEntities = H->InstanceTransforms.Num();
+}
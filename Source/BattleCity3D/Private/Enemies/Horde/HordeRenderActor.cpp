@@ -0,0 +1,47 @@
+#include "Enemies/Horde/HordeRenderActor.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "Engine/StaticMesh.h"
+#include "Materials/MaterialInterface.h"
+
+AHordeRenderActor::AHordeRenderActor()
+{
+	PrimaryActorTick.bCanEverTick = false;
+
+	TanksISM = CreateDefaultSubobject<UInstancedStaticMeshComponent>(TEXT("TanksISM"));
+	TanksISM->SetMobility(EComponentMobility::Movable);
+	// Los impactos van por la ocupacin del subsistema, no por fsica
+	TanksISM->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	TanksISM->SetGenerateOverlapEvents(false);
+	RootComponent = TanksISM;
+}
+
+void AHordeRenderActor::SetupMesh(UStaticMesh* Mesh, UMaterialInterface* Material)
+{
+	TanksISM->SetStaticMesh(Mesh);
+	if (Material) TanksISM->SetMaterial(0, Material);
+}
+
+void AHordeRenderActor::UpdateInstances(const TArray<FTransform>& Transforms)
+{
+	const int32 Have = TanksISM->GetInstanceCount();
+	const int32 Want = Transforms.Num();
+
+	// Las instancias no tienen identidad: se reescriben todas, slo cambia la cola
+	if (Want < Have)
+	{
+		RemoveScratch.Reset(Have - Want);
+		for (int32 i = Have - 1; i >= Want; --i) RemoveScratch.Add(i);
+		TanksISM->RemoveInstances(RemoveScratch);
+	}
+	else if (Want > Have)
+	{
+		AddScratch.Reset(Want - Have);
+		AddScratch.Append(Transforms.GetData() + Have, Want - Have);
+		TanksISM->AddInstances(AddScratch, false, true);
+	}
+
+	if (Want > 0)
+	{
+		TanksISM->BatchUpdateInstancesTransforms(0, Transforms, true, true, true);
+	}
+}
@@ -0,0 +1,485 @@
+#include "Enemies/Horde/HordeSubsystem.h"
+#include "Enemies/Horde/HordeFragments.h"
+#include "Enemies/Horde/HordeProcessors.h"
+#include "Enemies/Horde/HordeRenderActor.h"
+#include "Enemies/EnemyPawn.h"
+#include "Projectiles/Projectile.h"
+#include "Spawner/EnemySpawner.h"
+#include "Map/MapGridSubsystem.h"
+#include "Common/BattleTargetRegistry.h"
+#include "Components/GridPathFollow/GridSearch.h"
+#include "Components/StaticMeshComponent.h"
+#include "MassEntitySubsystem.h"
+#include "MassEntityManager.h"
+#include "MassExecutor.h"
+#include "MassProcessingTypes.h"
+#include "EngineUtils.h"
+#include "Engine/World.h"
+#include "Engine/GameInstance.h"
+
+DECLARE_CYCLE_STAT(TEXT("Horde tick"), STAT_BCHorde_Tick, STATGROUP_BCHorde);
+DECLARE_CYCLE_STAT(TEXT("Horde fields"), STAT_BCHorde_Fields, STATGROUP_BCHorde);
+DECLARE_CYCLE_STAT(TEXT("Horde ISM upload"), STAT_BCHorde_Upload, STATGROUP_BCHorde);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Entities"), STAT_BCHorde_Entities, STATGROUP_BCHorde);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Shots this frame"), STAT_BCHorde_Shots, STATGROUP_BCHorde);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Promoted actors"), STAT_BCHorde_Promoted, STATGROUP_BCHorde);
+
+// Uso en consola: bc.horde.promote 0/1
+static TAutoConsoleVariable<int32> CVarHordePromote(
+	TEXT("bc.horde.promote"),
+	1,
+	TEXT("1 = las entidades de la horda cerca del jugador pasan a ser AEnemyPawn completos (hasta MaxPromotedActors)."),
+	ECVF_Default);
+
+// Uso en consola: bc.horde.spawn [N=1000] [tipo=-1]
+static FAutoConsoleCommandWithWorldAndArgs GBcHordeSpawnCmd(
+	TEXT("bc.horde.spawn"),
+	TEXT("Crea N tanques de la horda (MassEntity) repartidos entre los spawns. tipo: 0=Basic 1=Fast 2=Power 3=Armored, -1 = mezclados."),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+		{
+			UHordeSubsystem* Horde = World ? World->GetSubsystem<UHordeSubsystem>() : nullptr;
+			if (!Horde) return;
+			const int32 Count = Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 1000;
+			const int32 Type = Args.Num() > 1 ? FCString::Atoi(*Args[1]) : -1;
+			const int32 Created = Horde->SpawnHorde(Count, Type);
+			UE_LOG(LogTemp, Log, TEXT("[Horde] +%d entidades (total %d)"), Created, Horde->GetNumEntities());
+		}));
+
+// Uso en consola: bc.horde.clear
+static FAutoConsoleCommandWithWorldAndArgs GBcHordeClearCmd(
+	TEXT("bc.horde.clear"),
+	TEXT("Destruye todas las entidades de la horda."),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+		{
+			if (UHordeSubsystem* Horde = World ? World->GetSubsystem<UHordeSubsystem>() : nullptr) Horde->ClearHorde();
+		}));
+
+UHordeSubsystem::UHordeSubsystem()
+{
+	EnemyClass = AEnemyPawn::StaticClass();
+	ProjectileClass = AProjectile::StaticClass();
+}
+
+bool UHordeSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId UHordeSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UHordeSubsystem, STATGROUP_Tickables);
+}
+
+void UHordeSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	// Si no se configur otra, la clase por defecto del spawner del nivel
+	if (EnemyClass == AEnemyPawn::StaticClass())
+	{
+		for (TActorIterator<AEnemySpawner> It(&InWorld); It; ++It)
+		{
+			if (It->EnemyClassDefault) { EnemyClass = It->EnemyClassDefault; break; }
+		}
+	}
+}
+
+void UHordeSubsystem::Deinitialize()
+{
+	// El mundo se va: Mass destruye sus entidades con l
+	Processors.Reset();
+	EntityManager.Reset();
+	RenderActor = nullptr;
+	Grid = nullptr;
+	Super::Deinitialize();
+}
+
+bool UHordeSubsystem::EnsureSetup()
+{
+	if (EntityManager.IsValid()) return Grid != nullptr;
+
+	UWorld* World = GetWorld();
+	UGameInstance* GI = World ? World->GetGameInstance() : nullptr;
+	Grid = GI ? GI->GetSubsystem<UMapGridSubsystem>() : nullptr;
+	UMassEntitySubsystem* Mass = World ? World->GetSubsystem<UMassEntitySubsystem>() : nullptr;
+	if (!Grid || !Mass || Grid->GetWidth() <= 0 || Grid->GetHeight() <= 0) return false;
+
+	EntityManager = Mass->GetMutableEntityManager().AsShared();
+	Archetype = EntityManager->CreateArchetype({
+		FHordeGridFragment::StaticStruct(),
+		FHordeFacingFragment::StaticStruct(),
+		FHordeVelocityFragment::StaticStruct(),
+		FHordeGoalFragment::StaticStruct(),
+		FHordeTankFragment::StaticStruct(),
+		FHordeTag::StaticStruct() });
+
+	// Orden fijo: decidir -> mover -> disparar -> render/ocupacin
+	const TSharedRef<FMassEntityManager> Manager = EntityManager.ToSharedRef();
+	for (UClass* Class : { UHordeDecisionProcessor::StaticClass(), UHordeMovementProcessor::StaticClass(),
+		UHordeFireProcessor::StaticClass(), UHordeRenderProcessor::StaticClass() })
+	{
+		UHordeProcessorBase* Processor = NewObject<UHordeProcessorBase>(this, Class);
+		Processor->Horde = this;
+		Processor->CallInitialize(this, Manager);
+		Processors.Add(Processor);
+	}
+
+	LoadTypeParams();
+
+	// Misma malla que el pawn de referencia
+	FActorSpawnParameters Params;
+	Params.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+	RenderActor = World->SpawnActor<AHordeRenderActor>(AHordeRenderActor::StaticClass(), FTransform::Identity, Params);
+	const AEnemyPawn* CDO = EnemyClass ? EnemyClass->GetDefaultObject<AEnemyPawn>() : nullptr;
+	if (RenderActor && CDO && CDO->Body)
+	{
+		RenderActor->SetupMesh(CDO->Body->GetStaticMesh(), CDO->Body->GetMaterial(0));
+		MeshRelative = CDO->Body->GetRelativeTransform();
+	}
+	return true;
+}
+
+void UHordeSubsystem::LoadTypeParams()
+{
+	const AEnemyPawn* CDO = EnemyClass ? EnemyClass->GetDefaultObject<AEnemyPawn>() : GetDefault<AEnemyPawn>();
+	const float Tile = FMath::Max(1.f, Grid->GetTileSize());
+	TankZ = Tile * 0.5f;
+
+	// EnemyPawn an no distingue stats por tipo: todos salen del mismo CDO
+	for (FHordeTypeParams& P : TypeParams)
+	{
+		P.Speed = CDO->MoveSpeed / Tile;
+		P.AccelRate = CDO->AccelRate;
+		P.TurnDelay = CDO->TurnDelay;
+		P.FireInterval = CDO->FireInterval;
+		P.HitPoints = FMath::Max(1, CDO->HitPoints);
+	}
+}
+
+void UHordeSubsystem::RefreshFields()
+{
+	SCOPE_CYCLE_COUNTER(STAT_BCHorde_Fields);
+	const int32 W = Grid->GetWidth();
+	const int32 N = W * Grid->GetHeight();
+
+	// Mapa nuevo: ejes y campo de la base (sobre WalkableBits no cambia al romper ladrillos)
+	if (FieldsLayoutVersion != Grid->GetLayoutVersion() || BaseField.Num() != N)
+	{
+		FieldsLayoutVersion = Grid->GetLayoutVersion();
+		GridOrigin = Grid->GridToWorld(0, 0);
+		GridAxisX = Grid->GridToWorld(1, 0) - GridOrigin;
+		GridAxisY = Grid->GridToWorld(0, 1) - GridOrigin;
+		Bfs.DistanceField(Grid->GetWalkableBits(), Grid->GetBaseCells(), BaseField);
+		PlayerCell = FIntPoint(INDEX_NONE, INDEX_NONE);
+		PlayerField.Reset();
+		// Reservas de otro mapa: cada entidad vuelve a reclamar la suya en su prximo centro
+		CellClaims.Init(0, N);
+	}
+
+	// Campo del jugador: slo cuando cambia de celda
+	FIntPoint Cell;
+	const UBattleTargetRegistry* Targets = GetWorld()->GetSubsystem<UBattleTargetRegistry>();
+	bHasPlayer = Targets && Targets->GetPlayerCell(Cell);
+	if (bHasPlayer && (Cell != PlayerCell || PlayerField.Num() != N))
+	{
+		PlayerCell = Cell;
+		const FIntPoint Seeds[1] = { PlayerCell };
+		Bfs.DistanceField(Grid->GetWalkableBits(), Seeds, PlayerField);
+	}
+
+	RefreshPawnCells();
+}
+
+void UHordeSubsystem::RefreshPawnCells()
+{
+	PawnCells.Init(Grid->GetWidth(), Grid->GetHeight());
+	if (!PawnCells.IsEmpty())
+	{
+		FMemory::Memzero(PawnCells.GetRow(0), sizeof(uint64) * PawnCells.GetWordsPerRow() * PawnCells.GetHeight());
+	}
+
+	const UBattleTargetRegistry* Targets = GetWorld()->GetSubsystem<UBattleTargetRegistry>();
+	if (!Targets) return;
+	for (const FBattleTargetEntry& E : Targets->GetEntries())
+	{
+		if (E.Kind == EBattleTargetKind::Base || !E.bHasCell) continue;
+		PawnCells.Set(E.Cell.X, E.Cell.Y, true);
+	}
+}
+
+uint16 UHordeSubsystem::GetGoalDistance(EEnemyGoal Goal, const FIntPoint& Cell) const
+{
+	const int32 W = Grid->GetWidth();
+	if (Cell.X < 0 || Cell.Y < 0 || Cell.X >= W || Cell.Y >= Grid->GetHeight()) return FGridBitBFS::Unreached;
+	// Sin jugador los cazadores van a la base
+	const TArray<uint16>& Field = (Goal == EEnemyGoal::HuntPlayer && bHasPlayer) ? PlayerField : BaseField;
+	return Field.Num() > 0 ? Field[Cell.X + Cell.Y * W] : FGridBitBFS::Unreached;
+}
+
+bool UHordeSubsystem::IsOpenCell(const FIntPoint& Cell) const
+{
+	return Grid->GetOpenBits().Get(Cell.X, Cell.Y);
+}
+
+bool UHordeSubsystem::IsBrickCell(const FIntPoint& Cell) const
+{
+	return Grid->GetObstacleAtGrid(Cell.X, Cell.Y) == EObstacleType::Brick;
+}
+
+bool UHordeSubsystem::IsBaseCell(const FIntPoint& Cell) const
+{
+	return Grid->GetBaseCells().Contains(Cell);
+}
+
+bool UHordeSubsystem::CanEnterCell(const FIntPoint& Cell) const
+{
+	return IsOpenCell(Cell) && !IsBaseCell(Cell) && !(bHasPlayer && Cell == PlayerCell) && !PawnCells.Get(Cell.X, Cell.Y);
+}
+
+bool UHordeSubsystem::ClaimCell(const FIntPoint& Cell, int32 ClaimId)
+{
+	const int32 W = Grid->GetWidth();
+	if (Cell.X < 0 || Cell.Y < 0 || Cell.X >= W || Cell.Y >= Grid->GetHeight() || CellClaims.Num() != W * Grid->GetHeight()) return false;
+	const int32 Prev = FPlatformAtomics::InterlockedCompareExchange(&CellClaims[Cell.X + Cell.Y * W], ClaimId, 0);
+	return Prev == 0 || Prev == ClaimId;
+}
+
+void UHordeSubsystem::ReleaseCell(const FIntPoint& Cell, int32 ClaimId)
+{
+	const int32 W = Grid->GetWidth();
+	if (Cell.X < 0 || Cell.Y < 0 || Cell.X >= W || Cell.Y >= Grid->GetHeight() || CellClaims.Num() != W * Grid->GetHeight()) return;
+	FPlatformAtomics::InterlockedCompareExchange(&CellClaims[Cell.X + Cell.Y * W], 0, ClaimId);
+}
+
+FVector UHordeSubsystem::CellToWorld(const FVector2f& Pos, float Z) const
+{
+	return GridOrigin + GridAxisX * Pos.X + GridAxisY * Pos.Y + FVector(0.f, 0.f, Z);
+}
+
+FVector2f UHordeSubsystem::WorldToCellPos(const FVector& WorldPos) const
+{
+	const FVector Local = WorldPos - GridOrigin;
+	return FVector2f(
+		(float)(FVector::DotProduct(Local, GridAxisX) / FMath::Max(GridAxisX.SizeSquared(), UE_KINDA_SMALL_NUMBER)),
+		(float)(FVector::DotProduct(Local, GridAxisY) / FMath::Max(GridAxisY.SizeSquared(), UE_KINDA_SMALL_NUMBER)));
+}
+
+FRotator UHordeSubsystem::DirToRotation(uint8 Dir) const
+{
+	const FIntPoint& D = GridSearch::Dir4[Dir & 3];
+	return (GridAxisX * D.X + GridAxisY * D.Y).Rotation();
+}
+
+int32 UHordeSubsystem::SpawnHorde(int32 Count, int32 Type)
+{
+	if (Count <= 0 || !EnsureSetup()) return 0;
+	RefreshFields();
+
+	TArray<FIntPoint> SpawnCells;
+	Grid->GetAllEnemySpawnCells(SpawnCells);
+	if (SpawnCells.Num() == 0)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[Horde] El mapa no tiene spawns de enemigos"));
+		return 0;
+	}
+
+	FRandomStream Rng((int32)(SpawnSerial * 7919u + 17u));
+	TArray<FMassEntityHandle> Created;
+	{
+		// Las entidades se crean en bloque en su chunk; se rellenan antes de soltar el contexto
+		TSharedRef<FMassEntityManager::FEntityCreationContext> Creation = EntityManager->BatchCreateEntities(Archetype, Count, Created);
+		for (int32 i = 0; i < Created.Num(); ++i)
+		{
+			const FMassEntityHandle Entity = Created[i];
+			const FIntPoint Cell = SpawnCells[(SpawnSerial + i) % SpawnCells.Num()];
+
+			// Sin reservas: las que comparten spawn esperan en cola a que quede libre
+			FHordeGridFragment& G = EntityManager->GetFragmentDataChecked<FHordeGridFragment>(Entity);
+			G.Pos = FVector2f((float)Cell.X, (float)Cell.Y);
+			G.Cell = Cell;
+			G.ClaimId = (int32)((SpawnSerial + i) & 0x7FFFFFFF) + 1;
+
+			FHordeTankFragment& T = EntityManager->GetFragmentDataChecked<FHordeTankFragment>(Entity);
+			T.Type = (EEnemyType)(Type >= 0 ? (Type & 3) : Rng.RandRange(0, 3));
+			T.HitPoints = GetParams(T.Type).HitPoints;
+			T.FireCooldown = Rng.FRandRange(0.f, GetParams(T.Type).FireInterval);
+			T.Seed = HashCombineFast(GetTypeHash(SpawnSerial + i), 0x9E3779B9u);
+
+			FHordeGoalFragment& Goal = EntityManager->GetFragmentDataChecked<FHordeGoalFragment>(Entity);
+			Goal.Goal = Rng.FRand() < HuntPlayerChance ? EEnemyGoal::HuntPlayer : EEnemyGoal::HuntBase;
+		}
+	}
+	SpawnSerial += Created.Num();
+	NumEntities += Created.Num();
+	return Created.Num();
+}
+
+void UHordeSubsystem::ClearHorde()
+{
+	// Todas las entidades de la horda estn en su arquetipo, hayan pasado ya por el render o no
+	if (EntityManager.IsValid() && Archetype.IsValid())
+	{
+		EntityManager->BatchDestroyEntityChunks(FMassArchetypeEntityCollection(Archetype));
+	}
+	NumEntities = 0;
+	for (int32& Claim : CellClaims) Claim = 0;
+	PendingKills.Reset();
+	Occupants.Reset();
+	OccupantPos.Reset();
+	NextInCell.Reset();
+	CellHead.Reset();
+	Shots.Reset();
+	InstanceTransforms.Reset();
+	if (RenderActor) RenderActor->UpdateInstances(InstanceTransforms);
+}
+
+bool UHordeSubsystem::HitAt(const FVector& WorldPos, float Radius)
+{
+	if (NumEntities == 0 || !Grid || CellHead.Num() == 0) return false;
+
+	const int32 W = Grid->GetWidth();
+	const int32 H = Grid->GetHeight();
+	const FVector2f P = WorldToCellPos(WorldPos);
+	const float Reach = HitRadiusCells + Radius / FMath::Max(1.f, Grid->GetTileSize());
+	const int32 CX = FMath::RoundToInt(P.X);
+	const int32 CY = FMath::RoundToInt(P.Y);
+
+	// Su celda y las vecinas: una entidad a medio camino puede estar en la de al lado
+	for (int32 Y = CY - 1; Y <= CY + 1; ++Y)
+	{
+		for (int32 X = CX - 1; X <= CX + 1; ++X)
+		{
+			if (X < 0 || Y < 0 || X >= W || Y >= H) continue;
+			for (int32 i = CellHead[X + Y * W]; i != INDEX_NONE; i = NextInCell[i])
+			{
+				const FVector2f& E = OccupantPos[i];
+				if (FMath::Abs(E.X - P.X) > Reach || FMath::Abs(E.Y - P.Y) > Reach) continue;
+				if (!EntityManager->IsEntityValid(Occupants[i])) continue;
+
+				FHordeTankFragment* T = EntityManager->GetFragmentDataPtr<FHordeTankFragment>(Occupants[i]);
+				if (!T || T->HitPoints <= 0) continue;
+				if (--T->HitPoints <= 0) PendingKills.Add(Occupants[i]);
+				return true;
+			}
+		}
+	}
+	return false;
+}
+
+void UHordeSubsystem::FlushKills()
+{
+	if (PendingKills.Num() == 0) return;
+	PendingKills.RemoveAll([this](const FMassEntityHandle& E) { return !EntityManager->IsEntityValid(E); });
+	for (const FMassEntityHandle& E : PendingKills)
+	{
+		// Muertas o promocionadas: sus celdas quedan libres
+		const FHordeGridFragment& G = EntityManager->GetFragmentDataChecked<FHordeGridFragment>(E);
+		ReleaseCell(G.Held, G.ClaimId);
+		ReleaseCell(G.Ahead, G.ClaimId);
+	}
+	EntityManager->BatchDestroyEntities(PendingKills);
+	NumEntities = FMath::Max(0, NumEntities - PendingKills.Num());
+	PendingKills.Reset();
+}
+
+void UHordeSubsystem::RunPipeline(float DeltaTime)
+{
+	TArray<UMassProcessor*, TInlineAllocator<4>> View;
+	for (UMassProcessor* Processor : Processors) View.Add(Processor);
+
+	FMassProcessingContext Context(EntityManager.ToSharedRef(), DeltaTime);
+	UE::Mass::Executor::RunProcessorsView(View, Context);
+}
+
+void UHordeSubsystem::SpawnShots()
+{
+	SET_DWORD_STAT(STAT_BCHorde_Shots, Shots.Num());
+	if (Shots.Num() == 0 || !ProjectileClass) { Shots.Reset(); return; }
+
+	UWorld* World = GetWorld();
+	FActorSpawnParameters Params;
+	Params.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+	const float Muzzle = 0.6f;
+	for (const FHordeShot& Shot : Shots)
+	{
+		const FIntPoint& D = GridSearch::Dir4[Shot.Dir & 3];
+		const FVector2f From(Shot.Pos.X + D.X * Muzzle, Shot.Pos.Y + D.Y * Muzzle);
+		if (AProjectile* Proj = World->SpawnActor<AProjectile>(ProjectileClass, CellToWorld(From, TankZ), DirToRotation(Shot.Dir), Params))
+		{
+			Proj->Team = EProjectileTeam::Enemy;
+		}
+	}
+	Shots.Reset();
+}
+
+void UHordeSubsystem::PromoteNearPlayer(float DeltaTime)
+{
+	Promoted.RemoveAll([](const TWeakObjectPtr<AEnemyPawn>& P) { return !P.IsValid(); });
+	SET_DWORD_STAT(STAT_BCHorde_Promoted, Promoted.Num());
+	if (CVarHordePromote.GetValueOnGameThread() == 0 || !bHasPlayer || !EnemyClass) return;
+
+	PromoteAccum += DeltaTime;
+	if (PromoteAccum < PromoteIntervalSeconds) return;
+	PromoteAccum = 0.f;
+	if (Promoted.Num() >= MaxPromotedActors) return;
+
+	const int32 W = Grid->GetWidth();
+	const int32 H = Grid->GetHeight();
+	const int32 R = FMath::CeilToInt(PromoteRadiusCells);
+	const FVector2f Center((float)PlayerCell.X, (float)PlayerCell.Y);
+
+	for (int32 Y = PlayerCell.Y - R; Y <= PlayerCell.Y + R; ++Y)
+	{
+		for (int32 X = PlayerCell.X - R; X <= PlayerCell.X + R; ++X)
+		{
+			if (X < 0 || Y < 0 || X >= W || Y >= H) continue;
+			for (int32 i = CellHead[X + Y * W]; i != INDEX_NONE; i = NextInCell[i])
+			{
+				if (Promoted.Num() >= MaxPromotedActors) return;
+				if (FVector2f::Distance(OccupantPos[i], Center) > PromoteRadiusCells) continue;
+
+				const FMassEntityHandle Entity = Occupants[i];
+				if (!EntityManager->IsEntityValid(Entity)) continue;
+				FHordeTankFragment& T = EntityManager->GetFragmentDataChecked<FHordeTankFragment>(Entity);
+				if (T.HitPoints <= 0) continue;
+				const FHordeGoalFragment& Goal = EntityManager->GetFragmentDataChecked<FHordeGoalFragment>(Entity);
+				const FHordeFacingFragment& F = EntityManager->GetFragmentDataChecked<FHordeFacingFragment>(Entity);
+
+				// Pawn completo en el mismo sitio, con su tipo, vida y objetivo
+				const FTransform Xform(DirToRotation(F.Dir), CellToWorld(OccupantPos[i], TankZ));
+				AEnemyPawn* Pawn = GetWorld()->SpawnActorDeferred<AEnemyPawn>(EnemyClass, Xform, nullptr, nullptr,
+					ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn);
+				if (!Pawn) continue;
+				Pawn->EnemyType = T.Type;
+				Pawn->HitPoints = T.HitPoints;
+				Pawn->Goal = Goal.Goal;
+				Pawn->FinishSpawning(Xform);
+
+				T.HitPoints = 0;
+				PendingKills.Add(Entity);
+				Promoted.Add(Pawn);
+			}
+		}
+	}
+}
+
+void UHordeSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+	if (!EntityManager.IsValid() || !Grid) return;
+	if (NumEntities == 0 && PendingKills.Num() == 0 && InstanceTransforms.Num() == 0) return;
+
+	SCOPE_CYCLE_COUNTER(STAT_BCHorde_Tick);
+	FlushKills();
+	RefreshFields();
+	RunPipeline(DeltaTime);
+
+	{
+		SCOPE_CYCLE_COUNTER(STAT_BCHorde_Upload);
+		if (RenderActor) RenderActor->UpdateInstances(InstanceTransforms);
+	}
+
+	SpawnShots();
+	PromoteNearPlayer(DeltaTime);
+	SET_DWORD_STAT(STAT_BCHorde_Entities, NumEntities);
+}
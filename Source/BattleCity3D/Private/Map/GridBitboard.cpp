@@ -0,0 +1,151 @@
+#include "Map/GridBitboard.h"
+
+void FGridBitboard::Init(int32 InWidth, int32 InHeight)
+{
+	Width = FMath::Max(0, InWidth);
+	Height = FMath::Max(0, InHeight);
+	WordsPerRow = (Width + 63) >> 6;
+	Words.SetNumZeroed(WordsPerRow * Height);
+}
+
+int32 FGridBitboard::CountSet() const
+{
+	int32 Count = 0;
+	for (uint64 W : Words) Count += (int32)FMath::CountBits(W);
+	return Count;
+}
+
+void FGridBitBFS::Begin(const FGridBitboard& Passable, TConstArrayView<FIntPoint> Seeds)
+{
+	const int32 NumWords = Passable.Words.Num();
+	Frontier.SetNumUninitialized(NumWords, EAllowShrinking::No);
+	Next.SetNumUninitialized(NumWords, EAllowShrinking::No);
+	Visited.SetNumUninitialized(NumWords, EAllowShrinking::No);
+	FMemory::Memzero(Frontier.GetData(), NumWords * sizeof(uint64));
+	FMemory::Memzero(Visited.GetData(), NumWords * sizeof(uint64));
+
+	RowMin = MAX_int32;
+	RowMax = -1;
+
+	const int32 WPR = Passable.GetWordsPerRow();
+	for (const FIntPoint& S : Seeds)
+	{
+		if (S.X < 0 || S.Y < 0 || S.X >= Passable.GetWidth() || S.Y >= Passable.GetHeight()) continue;
+		// La semilla cuenta como alcanzada aunque su celda no sea pasable (p.ej. tanque encima)
+		const int32 Idx = S.Y * WPR + (S.X >> 6);
+		const uint64 Bit = 1ull << (S.X & 63);
+		Frontier[Idx] |= Bit;
+		Visited[Idx] |= Bit;
+		RowMin = FMath::Min(RowMin, S.Y);
+		RowMax = FMath::Max(RowMax, S.Y);
+	}
+}
+
+bool FGridBitBFS::Step(const FGridBitboard& Passable)
+{
+	if (RowMax < RowMin) return false;
+
+	const int32 WPR = Passable.GetWordsPerRow();
+	const int32 Lo = FMath::Max(0, RowMin - 1);
+	const int32 Hi = FMath::Min(Passable.GetHeight() - 1, RowMax + 1);
+
+	// Filas del frente fuera de [RowMin, RowMax] pueden tener basura de capas anteriores: se tratan como 0
+	auto FrontierRow = [&](int32 Y) -> const uint64*
+		{
+			return (Y >= RowMin && Y <= RowMax) ? Frontier.GetData() + Y * WPR : nullptr;
+		};
+
+	int32 NewMin = MAX_int32, NewMax = -1;
+	for (int32 Y = Lo; Y <= Hi; ++Y)
+	{
+		const uint64* RESTRICT Up = FrontierRow(Y - 1);
+		const uint64* RESTRICT Cur = FrontierRow(Y);
+		const uint64* RESTRICT Down = FrontierRow(Y + 1);
+		const uint64* RESTRICT Pass = Passable.GetRow(Y);
+		uint64* RESTRICT Vis = Visited.GetData() + Y * WPR;
+		uint64* RESTRICT Out = Next.GetData() + Y * WPR;
+
+		// N/S: la fila vecina tal cual
+		for (int32 W = 0; W < WPR; ++W) Out[W] = (Up ? Up[W] : 0ull) | (Down ? Down[W] : 0ull);
+
+		// E/O: desplazar dentro de la palabra y acarrear el bit del borde a la palabra vecina
+		if (Cur)
+		{
+			for (int32 W = 0; W < WPR; ++W) Out[W] |= (Cur[W] << 1) | (Cur[W] >> 1);
+			for (int32 W = 1; W < WPR; ++W)
+			{
+				Out[W] |= Cur[W - 1] >> 63;
+				Out[W - 1] |= Cur[W] << 63;
+			}
+		}
+
+		uint64 Any = 0;
+		for (int32 W = 0; W < WPR; ++W)
+		{
+			const uint64 N = Out[W] & Pass[W] & ~Vis[W];
+			Out[W] = N;
+			Vis[W] |= N;
+			Any |= N;
+		}
+
+		if (Any)
+		{
+			NewMin = FMath::Min(NewMin, Y);
+			NewMax = Y;
+		}
+	}
+
+	Swap(Frontier, Next);
+	RowMin = NewMin;
+	RowMax = NewMax;
+	return RowMax >= RowMin;
+}
+
+int32 FGridBitBFS::Flood(const FGridBitboard& Passable, TConstArrayView<FIntPoint> Seeds, FGridBitboard& OutReached, int32 MaxLayers)
+{
+	Begin(Passable, Seeds);
+
+	int32 Layers = 0;
+	while ((MaxLayers <= 0 || Layers < MaxLayers) && Step(Passable)) ++Layers;
+
+	OutReached.Init(Passable.GetWidth(), Passable.GetHeight());
+	FMemory::Memcpy(OutReached.Words.GetData(), Visited.GetData(), Visited.Num() * sizeof(uint64));
+	return Layers;
+}
+
+int32 FGridBitBFS::DistanceField(const FGridBitboard& Passable, TConstArrayView<FIntPoint> Seeds, TArray<uint16>& OutDist, int32 MaxLayers)
+{
+	const int32 W = Passable.GetWidth();
+	OutDist.Init(Unreached, W * Passable.GetHeight());
+
+	Begin(Passable, Seeds);
+	const int32 WPR = Passable.GetWordsPerRow();
+	ForEachFrontierCell(WPR, [&](int32 X, int32 Y) { OutDist[X + Y * W] = 0; });
+
+	int32 Layers = 0;
+	while ((MaxLayers <= 0 || Layers < MaxLayers) && Layers < Unreached - 1 && Step(Passable))
+	{
+		++Layers;
+		const uint16 D = (uint16)Layers;
+		ForEachFrontierCell(WPR, [&](int32 X, int32 Y) { OutDist[X + Y * W] = D; });
+	}
+	return Layers;
+}
+
+int32 FGridBitBFS::LayerDistance(const FGridBitboard& Passable, const FIntPoint& Start, const FIntPoint& Goal, int32 MaxLayers)
+{
+	if (Goal.X < 0 || Goal.Y < 0 || Goal.X >= Passable.GetWidth() || Goal.Y >= Passable.GetHeight()) return INDEX_NONE;
+	if (Start == Goal) return 0;
+
+	Begin(Passable, MakeArrayView(&Start, 1));
+	const int32 GoalIdx = Goal.Y * Passable.GetWordsPerRow() + (Goal.X >> 6);
+	const uint64 GoalBit = 1ull << (Goal.X & 63);
+
+	int32 Layers = 0;
+	while ((MaxLayers <= 0 || Layers < MaxLayers) && Step(Passable))
+	{
+		++Layers;
+		if (Visited[GoalIdx] & GoalBit) return Layers;
+	}
+	return INDEX_NONE;
+}
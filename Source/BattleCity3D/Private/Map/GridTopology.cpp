@@ -0,0 +1,435 @@
+#include "Map/GridTopology.h"
+#include "Map/MapGridSubsystem.h"
+#include "Components/GridPathFollow/GridSearch.h"
+
+int32 FGridTopology::Neighbor(int32 Idx, int32 Dir) const
+{
+	const FIntPoint N = IndexToCell(Idx) + GridSearch::Dir4[Dir];
+	return CellIndex(N);
+}
+
+int32 FGridTopology::CellCapacity(const UMapGridSubsystem& Grid, int32 Idx) const
+{
+	if (IsSource[Idx] || IsSink[Idx]) return InfCap;
+
+	const FIntPoint C = IndexToCell(Idx);
+	if (Grid.GetTerrainAtGrid(C.X, C.Y) == ETerrainType::Water) return 0;
+	switch (Grid.GetObstacleAtGrid(C.X, C.Y))
+	{
+	case EObstacleType::Steel: return 0;
+	case EObstacleType::Brick: return 1;
+	default:                   return InfCap;
+	}
+}
+
+void FGridTopology::Reset()
+{
+	Width = Height = 0;
+	Cap.Reset();
+	Sources.Reset();
+	Sinks.Reset();
+	IsSource.Reset();
+	IsSink.Reset();
+	BrickDist.Reset();
+	BrickParent.Reset();
+	NodeFlow.Reset();
+	ArcFlow.Reset();
+	StateParent.Reset();
+	StateVisit.Reset();
+	ArticulationCells.Reset();
+	Chokepoints.Reset();
+	ChokepointSet.Reset();
+	BreachBricks.Reset();
+	MinCut.Reset();
+	bFlowEnabled = bFlowDirty = bBaseOpen = false;
+	bArticulationDirty = bBreachDirty = true;
+}
+
+void FGridTopology::Build(const UMapGridSubsystem& Grid, int32 MaxFlowCells)
+{
+	Reset();
+	Width = Grid.GetWidth();
+	Height = Grid.GetHeight();
+	const int32 N = Width * Height;
+	if (N <= 0)
+	{
+		Width = Height = 0;
+		return;
+	}
+
+	IsSource.Init(false, N);
+	IsSink.Init(false, N);
+
+	TArray<FIntPoint> Cells;
+	Grid.GetAllEnemySpawnCells(Cells);
+	for (const FIntPoint& C : Cells)
+	{
+		const int32 Idx = CellIndex(C);
+		if (Idx != INDEX_NONE && !IsSource[Idx]) { IsSource[Idx] = true; Sources.Add(Idx); }
+	}
+
+	Cells = Grid.GetBaseCells();
+	int32 BX, BY;
+	if (Cells.Num() == 0 && Grid.HasBase() && Grid.WorldToGrid(Grid.GetBaseWorldLocation(), BX, BY)) Cells.Add(FIntPoint(BX, BY));
+	for (const FIntPoint& C : Cells)
+	{
+		const int32 Idx = CellIndex(C);
+		if (Idx != INDEX_NONE && !IsSink[Idx] && !IsSource[Idx]) { IsSink[Idx] = true; Sinks.Add(Idx); }
+	}
+
+	Cap.SetNumUninitialized(N);
+	for (int32 i = 0; i < N; ++i) Cap[i] = CellCapacity(Grid, i);
+
+	BuildBrickDistances();
+
+	bFlowEnabled = Sources.Num() > 0 && Sinks.Num() > 0 && N <= MaxFlowCells;
+	if (bFlowEnabled)
+	{
+		NodeFlow.Init(0, N);
+		ArcFlow.Init(0, N * 4);
+		StateParent.SetNumUninitialized(N * 2);
+		StateVisit.Init(0, N * 2);
+		VisitEpoch = 0;
+		bFlowDirty = true;
+	}
+
+	++FullBuilds;
+}
+
+bool FGridTopology::OnCellChanged(const UMapGridSubsystem& Grid, const FIntPoint& Cell)
+{
+	const int32 Idx = CellIndex(Cell);
+	if (!IsBuilt() || Grid.GetWidth() != Width || Grid.GetHeight() != Height) return false;
+	if (Idx == INDEX_NONE) return true;
+
+	const int32 OldCap = Cap[Idx];
+	const int32 NewCap = CellCapacity(Grid, Idx);
+	if (NewCap == OldCap) return true;
+	// Empeorar (celda que se cierra) invalida distancias y quiz el flujo: mejor reconstruir
+	if (NewCap < OldCap) return false;
+
+	Cap[Idx] = NewCap;
+	bArticulationDirty = true;
+	bBreachDirty = true;
+	if (bFlowEnabled) bFlowDirty = true; // el flujo actual sigue siendo vlido, slo falta aumentar
+
+	// La celda puede acortar camino a la base: nueva distancia desde sus vecinos y propagar la mejora
+	uint16 Best = IsSink[Idx] ? 0 : Unreached;
+	uint8 BestDir = 0;
+	const uint16 Self = IsOpen(Idx) ? 0 : 1;
+	for (int32 D = 0; D < 4; ++D)
+	{
+		const int32 U = Neighbor(Idx, D);
+		if (U == INDEX_NONE || Cap[U] == 0 || BrickDist[U] == Unreached) continue;
+		if (BrickDist[U] + Self < Best) { Best = (uint16)(BrickDist[U] + Self); BestDir = (uint8)D; }
+	}
+	if (Best < BrickDist[Idx])
+	{
+		BrickDist[Idx] = Best;
+		BrickParent[Idx] = BestDir;
+		BfsCur.Reset();
+		BfsCur.Add(Idx);
+		PropagateBrickDistance(Best);
+	}
+
+	++IncrementalUpdates;
+	return true;
+}
+
+void FGridTopology::Refresh()
+{
+	if (!IsBuilt()) return;
+	if (bArticulationDirty) BuildArticulations();
+	if (bBreachDirty) BuildBreach();
+	// Abierta una vez, sigue abierta: los ladrillos slo caen
+	if (bFlowEnabled && bFlowDirty)
+	{
+		if (bBaseOpen) bFlowDirty = false;
+		else Augment();
+	}
+}
+
+void FGridTopology::BuildBrickDistances()
+{
+	const int32 N = Width * Height;
+	BrickDist.Init(Unreached, N);
+	BrickParent.Init(0, N);
+
+	BfsCur.Reset();
+	for (const int32 S : Sinks)
+	{
+		BrickDist[S] = 0;
+		BfsCur.Add(S);
+	}
+	PropagateBrickDistance(0);
+}
+
+void FGridTopology::PropagateBrickDistance(uint16 FromDist)
+{
+	// 0-1 BFS por capas: entrar en suelo cuesta 0 (misma capa), en ladrillo 1 (capa siguiente)
+	uint16 D = FromDist;
+	while (BfsCur.Num() > 0)
+	{
+		BfsNext.Reset();
+		for (int32 i = 0; i < BfsCur.Num(); ++i)
+		{
+			const int32 V = BfsCur[i];
+			if (BrickDist[V] != D) continue;
+
+			for (int32 Dir = 0; Dir < 4; ++Dir)
+			{
+				const int32 U = Neighbor(V, Dir);
+				if (U == INDEX_NONE || Cap[U] == 0) continue;
+
+				const bool bOpen = IsOpen(U);
+				const uint16 Nd = (uint16)(D + (bOpen ? 0 : 1));
+				if (Nd >= BrickDist[U]) continue;
+
+				BrickDist[U] = Nd;
+				BrickParent[U] = (uint8)((Dir + 2) & 3);
+				(bOpen ? BfsCur : BfsNext).Add(U);
+			}
+		}
+		Swap(BfsCur, BfsNext);
+		++D;
+	}
+}
+
+void FGridTopology::BuildArticulations()
+{
+	bArticulationDirty = false;
+	ArticulationCells.Reset();
+	Chokepoints.Reset();
+	ChokepointSet.Reset();
+
+	const int32 N = Width * Height;
+	Disc.Init(-1, N);
+	Low.SetNumUninitialized(N);
+	Fin.SetNumUninitialized(N);
+	TBitArray<> IsArticulation(false, N);
+
+	struct FFrame { int32 V; int32 Parent; int32 NextDir; };
+	TArray<FFrame> Stack;
+	int32 Timer = 0;
+
+	// Tarjan iterativo; desde la base adems se miran los spawns que quedan aislados bajo cada corte
+	auto RunFrom = [&](int32 Root, bool bBaseRoot)
+		{
+			int32 RootChildren = 0;
+			Disc[Root] = Low[Root] = Timer++;
+			Stack.Add({ Root, INDEX_NONE, 0 });
+
+			while (Stack.Num() > 0)
+			{
+				FFrame& F = Stack.Last();
+				if (F.NextDir < 4)
+				{
+					const int32 V = F.V;
+					const int32 Parent = F.Parent;
+					const int32 U = Neighbor(V, F.NextDir++);
+					if (U == INDEX_NONE || !IsOpen(U)) continue;
+
+					if (Disc[U] < 0)
+					{
+						Disc[U] = Low[U] = Timer++;
+						Stack.Add({ U, V, 0 });
+					}
+					else if (U != Parent)
+					{
+						Low[V] = FMath::Min(Low[V], Disc[U]);
+					}
+					continue;
+				}
+
+				const FFrame Done = Stack.Pop(EAllowShrinking::No);
+				Fin[Done.V] = Timer - 1;
+				const int32 P = Done.Parent;
+				if (P == INDEX_NONE) continue;
+
+				Low[P] = FMath::Min(Low[P], Low[Done.V]);
+				if (P == Root) { ++RootChildren; continue; }
+				if (Low[Done.V] < Disc[P]) continue;
+
+				if (!IsArticulation[P])
+				{
+					IsArticulation[P] = true;
+					ArticulationCells.Add(IndexToCell(P));
+				}
+				if (!bBaseRoot || IsSink[P]) continue;
+
+				// Subrbol de Done.V = [Disc, Fin]: si contiene un spawn, P lo separa de la base
+				for (const int32 S : Sources)
+				{
+					if (Disc[S] >= Disc[Done.V] && Disc[S] <= Fin[Done.V])
+					{
+						bool bAlready = false;
+						ChokepointSet.Add(IndexToCell(P), &bAlready);
+						if (!bAlready) Chokepoints.Add(IndexToCell(P));
+						break;
+					}
+				}
+			}
+
+			if (RootChildren > 1 && !IsArticulation[Root])
+			{
+				IsArticulation[Root] = true;
+				ArticulationCells.Add(IndexToCell(Root));
+			}
+		};
+
+	if (Sinks.Num() > 0) RunFrom(Sinks[0], true);
+	for (int32 i = 0; i < N; ++i)
+	{
+		if (Disc[i] < 0 && IsOpen(i)) RunFrom(i, false);
+	}
+}
+
+void FGridTopology::BuildBreach()
+{
+	bBreachDirty = false;
+	BreachBricks.Reset();
+
+	const int32 N = Width * Height;
+	TBitArray<> Marked(false, N);
+	for (const int32 S : Sources)
+	{
+		if (BrickDist[S] == Unreached) continue;
+
+		// Bajar por los padres del 0-1 BFS hasta que no quede ladrillo por delante
+		int32 V = S;
+		for (int32 Guard = 0; Guard < N && BrickDist[V] > 0 && !IsSink[V]; ++Guard)
+		{
+			if (!IsOpen(V) && !Marked[V])
+			{
+				Marked[V] = true;
+				BreachBricks.Add(IndexToCell(V));
+			}
+			V = Neighbor(V, BrickParent[V]);
+			if (V == INDEX_NONE) break;
+		}
+	}
+}
+
+bool FGridTopology::VisitState(int32 State, int32 From)
+{
+	if (StateVisit[State] == VisitEpoch) return false;
+	StateVisit[State] = VisitEpoch;
+	StateParent[State] = From;
+	StateQueue.Add(State);
+	return true;
+}
+
+bool FGridTopology::FindAugmentingPath(int32& OutSinkState)
+{
+	if (++VisitEpoch == 0)
+	{
+		StateVisit.Init(0, StateVisit.Num());
+		VisitEpoch = 1;
+	}
+	StateQueue.Reset();
+	for (const int32 S : Sources) VisitState(S * 2, INDEX_NONE);
+
+	for (int32 Head = 0; Head < StateQueue.Num(); ++Head)
+	{
+		const int32 St = StateQueue[Head];
+		const int32 V = St >> 1;
+
+		if ((St & 1) == 0)
+		{
+			if (IsSink[V]) { OutSinkState = St; return true; }
+
+			// entrada -> salida (capacidad de la celda)
+			if (NodeFlow[V] < Cap[V]) VisitState(V * 2 + 1, St);
+			// arco inverso: deshacer flujo que entr desde el vecino W
+			for (int32 D = 0; D < 4; ++D)
+			{
+				const int32 W = Neighbor(V, D);
+				if (W != INDEX_NONE && ArcFlow[W * 4 + ((D + 2) & 3)] > 0) VisitState(W * 2 + 1, St);
+			}
+		}
+		else
+		{
+			if (NodeFlow[V] > 0) VisitState(V * 2, St);
+			for (int32 D = 0; D < 4; ++D)
+			{
+				const int32 W = Neighbor(V, D);
+				if (W != INDEX_NONE && Cap[W] > 0) VisitState(W * 2, St);
+			}
+		}
+	}
+	return false;
+}
+
+void FGridTopology::Augment()
+{
+	bFlowDirty = false;
+	bBaseOpen = false;
+	MinCut.Reset();
+
+	// Direccin del arco A->B entre celdas vecinas
+	auto DirBetween = [this](int32 A, int32 B)
+		{
+			const FIntPoint Delta = IndexToCell(B) - IndexToCell(A);
+			for (int32 D = 0; D < 4; ++D) if (GridSearch::Dir4[D] == Delta) return D;
+			return 0;
+		};
+
+	int32 SinkState = INDEX_NONE;
+	while (FindAugmentingPath(SinkState))
+	{
+		// Cuello de botella del camino
+		int32 Bottleneck = InfCap;
+		for (int32 St = SinkState; StateParent[St] != INDEX_NONE; St = StateParent[St])
+		{
+			const int32 Prev = StateParent[St];
+			const int32 A = Prev >> 1, B = St >> 1;
+			int32 Res;
+			if (A == B) Res = (St & 1) ? Cap[A] - NodeFlow[A] : NodeFlow[A];
+			else        Res = (Prev & 1) ? InfCap - ArcFlow[A * 4 + DirBetween(A, B)] : ArcFlow[B * 4 + DirBetween(B, A)];
+			Bottleneck = FMath::Min(Bottleneck, Res);
+		}
+
+		// Slo suelo: un spawn ya llega a la base, no hay corte de ladrillos
+		if (Bottleneck >= InfCap / 2)
+		{
+			bBaseOpen = true;
+			return;
+		}
+
+		for (int32 St = SinkState; StateParent[St] != INDEX_NONE; St = StateParent[St])
+		{
+			const int32 Prev = StateParent[St];
+			const int32 A = Prev >> 1, B = St >> 1;
+			if (A == B) NodeFlow[A] += (St & 1) ? Bottleneck : -Bottleneck;
+			else if (Prev & 1) ArcFlow[A * 4 + DirBetween(A, B)] += Bottleneck;
+			else               ArcFlow[B * 4 + DirBetween(B, A)] -= Bottleneck;
+		}
+		++Augmentations;
+	}
+
+	BuildCutFromReachable();
+}
+
+void FGridTopology::BuildCutFromReachable()
+{
+	// Corte = ladrillos con la entrada alcanzable en el residual y la salida no
+	const int32 N = Width * Height;
+	for (int32 V = 0; V < N; ++V)
+	{
+		if (Cap[V] == 1 && StateVisit[V * 2] == VisitEpoch && StateVisit[V * 2 + 1] != VisitEpoch)
+		{
+			MinCut.Add(IndexToCell(V));
+		}
+	}
+}
+
+SIZE_T FGridTopology::GetAllocatedSize() const
+{
+	return Cap.GetAllocatedSize() + Sources.GetAllocatedSize() + Sinks.GetAllocatedSize()
+		+ IsSource.GetAllocatedSize() + IsSink.GetAllocatedSize()
+		+ BrickDist.GetAllocatedSize() + BrickParent.GetAllocatedSize() + BfsCur.GetAllocatedSize() + BfsNext.GetAllocatedSize()
+		+ NodeFlow.GetAllocatedSize() + ArcFlow.GetAllocatedSize() + StateParent.GetAllocatedSize() + StateVisit.GetAllocatedSize() + StateQueue.GetAllocatedSize()
+		+ Disc.GetAllocatedSize() + Low.GetAllocatedSize() + Fin.GetAllocatedSize()
+		+ ArticulationCells.GetAllocatedSize() + Chokepoints.GetAllocatedSize() + ChokepointSet.GetAllocatedSize()
+		+ BreachBricks.GetAllocatedSize() + MinCut.GetAllocatedSize();
+}
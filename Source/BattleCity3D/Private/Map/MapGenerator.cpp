@@ -7,6 +7,7 @@
 #include "Camera/CameraActor.h"
 #include "Map/MapConfigAsset.h"
 #include "Map/MapGridSubsystem.h"
+#include "Components/GridPathFollow/GridNavigationData.h"
 #include "Player/TankPawn.h"
 #include "Utils/JsonMapUtils.h"
 #include "DrawDebugHelpers.h"
@@ -205,6 +206,11 @@ void AMapGenerator::BeginPlay()
 			PlayerWorldStart = PlayerSpawns[0]; //TODO: Randomizar donde aparece el jugador.
 	}
 
+	if (bSpawnGridNavigationData)
+	{
+		AGridNavigationData::EnsureForWorld(GetWorld());
+	}
+
 	SpawnAndPossessPlayer();
 }
 
@@ -26,10 +26,25 @@ bool UMapGridSubsystem::InitializeFromAsset(UMapConfigAsset* Asset,
 	return BuildFromAsset(Map, Map.legend);
 }
 
+bool UMapGridSubsystem::InitializeFromConfig(const FMapConfig& Map, const FTransform& MapTransform)
+{
+	MapXform = MapTransform;
+	TileSize = Map.tileSize;
+	MapWidth = Map.width;
+	MapHeight = Map.height;
+	Visual = nullptr;
+
+	SubStep = TileSize / (float)SubdivisionsPerTile;
+
+	return BuildFromAsset(Map, Map.legend);
+}
+
 bool UMapGridSubsystem::BuildFromAsset(const FMapConfig& Map, const TMap<FString, FLegendEntry>& Legend)
 {
 	if (MapWidth <= 0 || MapHeight <= 0 || TileSize <= 0.f) return false;
 
+	++LayoutVersion;
+
 	const int32 N = MapWidth * MapHeight;
 	TerrainGrid.SetNum(N);
 	ObstacleGrid.SetNum(N);
@@ -126,6 +141,7 @@ bool UMapGridSubsystem::BuildFromAsset(const FMapConfig& Map, const TMap<FString
 	if (PlayerSpawnCells.Num() > 0)
 		PlayerWorldStart = GridToWorld(PlayerSpawnCells[0].X, PlayerSpawnCells[0].Y, TileSize * 0.5f);
 
+	RebuildDerivedLayers();
 
 	return true;
 }
@@ -216,26 +232,8 @@ void UMapGridSubsystem::GetNeighbors4(const FIntPoint& Cell, TArray<FIntPoint>&
 
 float UMapGridSubsystem::GetTileCost(const FIntPoint& Cell, const FGridCostProfile& Profile) const
 {
-	if (!IsInside(Cell)) return Profile.ImpassableCost;
-
-	const int32 Idx = XYToIndex(Cell.X, Cell.Y);
-
-	// Terreno base: terreno (ice/water/forest/ground)
-	const ETerrainType T = (TerrainGrid.IsValidIndex(Idx)) ? TerrainGrid[Idx] : ETerrainType::Ground;
-	// Obstculo en la celda
-	const EObstacleType O = (ObstacleGrid.IsValidIndex(Idx)) ? ObstacleGrid[Idx] : EObstacleType::None;
-
-	// Agua: impasable (en tu juego actual)
-	if (T == ETerrainType::Water) return Profile.ImpassableCost;
-
-	// Acero: impasable
-	if (O == EObstacleType::Steel) return Profile.ImpassableCost;
-
-	// Ladrillo: pasable "caro" (atravesable si compensa romper)
-	if (O == EObstacleType::Brick) return Profile.BrickCost;
-
-	// Resto: libre
-	return Profile.FreeCost;
+	// Agua/acero impasables, ladrillo caro, suplementos por terreno: todo en la tabla compilada
+	return GetTileCost(Cell, FGridCostLUT(Profile));
 }
 
 void UMapGridSubsystem::GetAllEnemySpawnCells(TArray<FIntPoint>& Out) const
@@ -295,7 +293,7 @@ bool UMapGridSubsystem::TryHitObstacleAtWorld(const FVector& WorldPos, bool& bWa
 		}
 
 		// NUEVO: notificar cambio de celda para invalidar rutas
-		OnGridCellChanged.Broadcast(FIntPoint(X, Y));
+		NotifyCellChanged(X, Y);
 		return true;
 	}
 	else if (O == EObstacleType::Steel)
@@ -394,11 +392,117 @@ bool UMapGridSubsystem::ProcessProjectileHit(const FVector& Location, float Radi
 						ObstacleGrid[Idx] = EObstacleType::None;
 						// Actualizar visuales
 						if (Visual.IsValid()) Visual->RemoveBrickInstanceAt(x, y);
-						OnGridCellChanged.Broadcast(FIntPoint(x, y));
+						NotifyCellChanged(x, y);
 					}
 				}
 			}
 		}
 	}
 	return bHitSomething;
-}
\ No newline at end of file
+}
+void UMapGridSubsystem::RebuildDerivedLayers()
+{
+	CellCodes.SetNumUninitialized(MapWidth * MapHeight);
+	OpenBits.Init(MapWidth, MapHeight);
+	WalkableBits.Init(MapWidth, MapHeight);
+
+	for (int32 Y = 0; Y < MapHeight; ++Y)
+	{
+		for (int32 X = 0; X < MapWidth; ++X)
+		{
+			const int32 Idx = XYToIndex(X, Y);
+			const bool bWater = TerrainGrid[Idx] == ETerrainType::Water;
+			const EObstacleType O = ObstacleGrid[Idx];
+			CellCodes[Idx] = PackGridCellCode((uint8)TerrainGrid[Idx], (uint8)O);
+			if (!bWater && O != EObstacleType::Steel) WalkableBits.Set(X, Y, true);
+			if (!bWater && O == EObstacleType::None)  OpenBits.Set(X, Y, true);
+		}
+	}
+
+	RebuildObstacleTables();
+
+	// Regiones conexas de WalkableBits (flood lineal, una vez por carga de mapa)
+	WalkableRegion.Init(INDEX_NONE, MapWidth * MapHeight);
+	TArray<FIntPoint> Stack;
+	int32 NextRegion = 0;
+	for (int32 Y = 0; Y < MapHeight; ++Y)
+	{
+		for (int32 X = 0; X < MapWidth; ++X)
+		{
+			if (!WalkableBits.Get(X, Y) || WalkableRegion[XYToIndex(X, Y)] != INDEX_NONE) continue;
+
+			const int32 Region = NextRegion++;
+			WalkableRegion[XYToIndex(X, Y)] = Region;
+			Stack.Reset();
+			Stack.Add(FIntPoint(X, Y));
+			while (Stack.Num() > 0)
+			{
+				const FIntPoint C = Stack.Pop(EAllowShrinking::No);
+				const FIntPoint Nbs[4] = { {C.X, C.Y - 1}, {C.X + 1, C.Y}, {C.X, C.Y + 1}, {C.X - 1, C.Y} };
+				for (const FIntPoint& N : Nbs)
+				{
+					if (!WalkableBits.Get(N.X, N.Y)) continue;
+					int32& R = WalkableRegion[XYToIndex(N.X, N.Y)];
+					if (R != INDEX_NONE) continue;
+					R = Region;
+					Stack.Add(N);
+				}
+			}
+		}
+	}
+}
+
+void UMapGridSubsystem::RebuildObstacleTables()
+{
+	const int32 N = MapWidth * MapHeight;
+	NextObstacleE.SetNumUninitialized(N);
+	NextObstacleW.SetNumUninitialized(N);
+	NextObstacleS.SetNumUninitialized(N);
+	NextObstacleN.SetNumUninitialized(N);
+	auto IsObstacle = [this](int32 X, int32 Y) { return ObstacleGrid[XYToIndex(X, Y)] != EObstacleType::None; };
+
+	// Un barrido por sentido: cada celda guarda el ltimo obstculo visto
+	for (int32 Y = 0; Y < MapHeight; ++Y)
+	{
+		uint16 Next = NoObstacle;
+		for (int32 X = MapWidth - 1; X >= 0; --X) { NextObstacleE[XYToIndex(X, Y)] = Next; if (IsObstacle(X, Y)) Next = (uint16)X; }
+		Next = NoObstacle;
+		for (int32 X = 0; X < MapWidth; ++X) { NextObstacleW[XYToIndex(X, Y)] = Next; if (IsObstacle(X, Y)) Next = (uint16)X; }
+	}
+	for (int32 X = 0; X < MapWidth; ++X)
+	{
+		uint16 Next = NoObstacle;
+		for (int32 Y = MapHeight - 1; Y >= 0; --Y) { NextObstacleS[XYToIndex(X, Y)] = Next; if (IsObstacle(X, Y)) Next = (uint16)Y; }
+		Next = NoObstacle;
+		for (int32 Y = 0; Y < MapHeight; ++Y) { NextObstacleN[XYToIndex(X, Y)] = Next; if (IsObstacle(X, Y)) Next = (uint16)Y; }
+	}
+}
+
+void UMapGridSubsystem::PatchObstacleTables(int32 X, int32 Y)
+{
+	if (NextObstacleE.Num() != MapWidth * MapHeight) return;
+	auto IsObstacle = [this](int32 CX, int32 CY) { return ObstacleGrid[XYToIndex(CX, CY)] != EObstacleType::None; };
+	const int32 Idx = XYToIndex(X, Y);
+	const bool bObstacle = IsObstacle(X, Y);
+
+	// Las celdas hasta el obstculo anterior (incluido) miraban a (X, Y) o ms all: ahora ven
+	// (X, Y) si es obstculo, o lo que (X, Y) ve detrs si ya no lo es
+	const uint16 E = bObstacle ? (uint16)X : NextObstacleE[Idx];
+	for (int32 CX = X - 1; CX >= 0; --CX) { NextObstacleE[XYToIndex(CX, Y)] = E; if (IsObstacle(CX, Y)) break; }
+	const uint16 W = bObstacle ? (uint16)X : NextObstacleW[Idx];
+	for (int32 CX = X + 1; CX < MapWidth; ++CX) { NextObstacleW[XYToIndex(CX, Y)] = W; if (IsObstacle(CX, Y)) break; }
+	const uint16 S = bObstacle ? (uint16)Y : NextObstacleS[Idx];
+	for (int32 CY = Y - 1; CY >= 0; --CY) { NextObstacleS[XYToIndex(X, CY)] = S; if (IsObstacle(X, CY)) break; }
+	const uint16 N = bObstacle ? (uint16)Y : NextObstacleN[Idx];
+	for (int32 CY = Y + 1; CY < MapHeight; ++CY) { NextObstacleN[XYToIndex(X, CY)] = N; if (IsObstacle(X, CY)) break; }
+}
+
+void UMapGridSubsystem::NotifyCellChanged(int32 X, int32 Y)
+{
+	const int32 Idx = XYToIndex(X, Y);
+	CellCodes[Idx] = PackGridCellCode((uint8)TerrainGrid[Idx], (uint8)ObstacleGrid[Idx]);
+	OpenBits.Set(X, Y, TerrainGrid[Idx] != ETerrainType::Water && ObstacleGrid[Idx] == EObstacleType::None);
+	PatchObstacleTables(X, Y);
+
+	OnGridCellChanged.Broadcast(FIntPoint(X, Y));
+}
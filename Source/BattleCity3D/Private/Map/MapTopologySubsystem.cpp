@@ -0,0 +1,146 @@
+#include "Map/MapTopologySubsystem.h"
+#include "Map/MapGridSubsystem.h"
+#include "Engine/World.h"
+#include "Engine/GameInstance.h"
+#include "DrawDebugHelpers.h"
+
+// Uso en consola: bc.map.topology [segundos=5]
+static FAutoConsoleCommandWithWorldAndArgs GBcMapTopologyCmd(
+	TEXT("bc.map.topology"),
+	TEXT("Dibuja la topologia del mapa: articulaciones (amarillo), chokepoints spawn->base (naranja), brecha (rojo) y corte minimo de ladrillos (magenta)."),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+		{
+			UGameInstance* GI = World ? World->GetGameInstance() : nullptr;
+			UMapTopologySubsystem* Topo = GI ? GI->GetSubsystem<UMapTopologySubsystem>() : nullptr;
+			UMapGridSubsystem* Grid = GI ? GI->GetSubsystem<UMapGridSubsystem>() : nullptr;
+			const FGridTopology* T = Topo ? Topo->GetTopology() : nullptr;
+			if (!T || !Grid) return;
+
+			const float Seconds = Args.Num() > 0 ? FCString::Atof(*Args[0]) : 5.f;
+			const float Tile = Grid->GetTileSize();
+			auto DrawCells = [&](const TArray<FIntPoint>& Cells, const FColor& Col, float Z, float Scale)
+				{
+					for (const FIntPoint& C : Cells)
+					{
+						DrawDebugBox(World, Grid->GridToWorld(C.X, C.Y, Z), FVector(Tile * Scale, Tile * Scale, 4.f), Col, false, Seconds, 0, 4.f);
+					}
+				};
+			DrawCells(T->GetArticulationCells(), FColor::Yellow, Tile * 0.1f, 0.3f);
+			DrawCells(T->GetChokepoints(), FColor::Orange, Tile * 0.15f, 0.4f);
+			DrawCells(T->GetBreachBricks(), FColor::Red, Tile * 0.6f, 0.45f);
+			DrawCells(T->GetMinBrickCut(), FColor::Magenta, Tile * 0.7f, 0.35f);
+
+			UE_LOG(LogTemp, Log, TEXT("[Topology] articulaciones=%d chokepoints=%d brecha=%d corte=%d%s builds=%d incrementales=%d aumentos=%d bytes=%llu"),
+				T->GetArticulationCells().Num(), T->GetChokepoints().Num(), T->GetBreachBricks().Num(), T->GetMinBrickCut().Num(),
+				T->IsBaseOpen() ? TEXT(" (base abierta)") : (T->HasFlow() ? TEXT("") : TEXT(" (sin flujo)")),
+				T->GetFullBuilds(), T->GetIncrementalUpdates(), T->GetAugmentations(), (uint64)T->GetAllocatedSize());
+		}));
+
+void UMapTopologySubsystem::Deinitialize()
+{
+	if (UMapGridSubsystem* Old = BoundGrid.Get())
+	{
+		Old->OnGridCellChanged.Remove(CellChangedHandle);
+	}
+	CellChangedHandle.Reset();
+	BoundGrid.Reset();
+	Topology.Reset();
+	Super::Deinitialize();
+}
+
+bool UMapTopologySubsystem::EnsureUpToDate()
+{
+	UMapGridSubsystem* Grid = BoundGrid.Get();
+	if (!Grid)
+	{
+		Grid = GetGameInstance()->GetSubsystem<UMapGridSubsystem>();
+		if (!Grid) return false;
+		BoundGrid = Grid;
+		CellChangedHandle = Grid->OnGridCellChanged.AddUObject(this, &UMapTopologySubsystem::HandleGridCellChanged);
+		bNeedsBuild = true;
+	}
+	if (Grid->GetWidth() <= 0 || Grid->GetHeight() <= 0) return false;
+
+	// Mapa recargado: todo lo calculado es invlido
+	if (bNeedsBuild || BoundLayoutVersion != Grid->GetLayoutVersion())
+	{
+		BoundLayoutVersion = Grid->GetLayoutVersion();
+		Topology.Build(*Grid, MaxFlowCells);
+		bNeedsBuild = false;
+	}
+	Topology.Refresh();
+	return Topology.IsBuilt();
+}
+
+void UMapTopologySubsystem::HandleGridCellChanged(FIntPoint Cell)
+{
+	UMapGridSubsystem* Grid = BoundGrid.Get();
+	if (!Grid || bNeedsBuild || !Topology.IsBuilt()) return;
+	if (BoundLayoutVersion != Grid->GetLayoutVersion() || !Topology.OnCellChanged(*Grid, Cell)) bNeedsBuild = true;
+}
+
+const FGridTopology* UMapTopologySubsystem::GetTopology()
+{
+	return EnsureUpToDate() ? &Topology : nullptr;
+}
+
+static const TArray<FIntPoint> GNoCells;
+
+const TArray<FIntPoint>& UMapTopologySubsystem::GetArticulationCells()
+{
+	return EnsureUpToDate() ? Topology.GetArticulationCells() : GNoCells;
+}
+
+const TArray<FIntPoint>& UMapTopologySubsystem::GetChokepoints()
+{
+	return EnsureUpToDate() ? Topology.GetChokepoints() : GNoCells;
+}
+
+bool UMapTopologySubsystem::IsChokepoint(const FIntPoint& Cell)
+{
+	return EnsureUpToDate() && Topology.IsChokepoint(Cell);
+}
+
+int32 UMapTopologySubsystem::GetBricksToBase(const FIntPoint& Cell)
+{
+	return EnsureUpToDate() ? Topology.GetBricksToBase(Cell) : FGridTopology::Unreached;
+}
+
+const TArray<FIntPoint>& UMapTopologySubsystem::GetBreachBricks()
+{
+	return EnsureUpToDate() ? Topology.GetBreachBricks() : GNoCells;
+}
+
+const TArray<FIntPoint>& UMapTopologySubsystem::GetMinBrickCut()
+{
+	return EnsureUpToDate() ? Topology.GetMinBrickCut() : GNoCells;
+}
+
+bool UMapTopologySubsystem::IsBaseOpen()
+{
+	return EnsureUpToDate() && Topology.IsBaseOpen();
+}
+
+bool UMapTopologySubsystem::IsBreachBrick(const FIntPoint& Cell)
+{
+	if (!EnsureUpToDate()) return false;
+	return Topology.GetBreachBricks().Contains(Cell) || Topology.GetMinBrickCut().Contains(Cell);
+}
+
+bool UMapTopologySubsystem::FindNearestBreachBrick(const FIntPoint& From, FIntPoint& OutCell)
+{
+	if (!EnsureUpToDate()) return false;
+
+	int32 BestDist = MAX_int32;
+	auto Consider = [&](const TArray<FIntPoint>& Cells)
+		{
+			for (const FIntPoint& C : Cells)
+			{
+				const int32 D = FMath::Abs(C.X - From.X) + FMath::Abs(C.Y - From.Y);
+				if (D < BestDist) { BestDist = D; OutCell = C; }
+			}
+		};
+	Consider(Topology.GetBreachBricks());
+	Consider(Topology.GetMinBrickCut());
+	return BestDist != MAX_int32;
+}
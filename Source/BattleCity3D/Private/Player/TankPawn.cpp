@@ -3,6 +3,7 @@
 #include "Kismet/GameplayStatics.h"
 #include "EnhancedInputComponent.h"
 #include "Projectiles/Projectile.h"
+#include "Common/BattleTargetRegistry.h"
 // Nota: Ya no necesitamos headers de Grid o Debug aqu, la base se encarga.
 
 ATankPawn::ATankPawn()
@@ -15,6 +16,20 @@ void ATankPawn::BeginPlay()
 {
     Super::BeginPlay();
     // El Snap inicial ya lo hace Super::BeginPlay
+
+    if (UBattleTargetRegistry* Targets = GetWorld()->GetSubsystem<UBattleTargetRegistry>())
+    {
+        Targets->Register(this, EBattleTargetKind::Player, EBattleTeam::Player);
+    }
+}
+
+void ATankPawn::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    if (UBattleTargetRegistry* Targets = GetWorld()->GetSubsystem<UBattleTargetRegistry>())
+    {
+        Targets->Unregister(this);
+    }
+    Super::EndPlay(EndPlayReason);
 }
 
 void ATankPawn::Tick(float DeltaSeconds)
@@ -6,6 +6,8 @@
 #include "Engine/StaticMesh.h"
 #include "EngineUtils.h"
 #include "Map/MapGridSubsystem.h"
+#include "Projectiles/ProjectileLaneSubsystem.h"
+#include "Enemies/Horde/HordeSubsystem.h"
 
 #include "Player/TankPawn.h"
 #include "Enemies/EnemyPawn.h"
@@ -67,6 +69,22 @@ void AProjectile::BeginPlay()
 		Collision->IgnoreActorWhenMoving(Inst, true);
 	}
 	Grid = GetGameInstance()->GetSubsystem<UMapGridSubsystem>();
+	Horde = GetWorld()->GetSubsystem<UHordeSubsystem>();
+
+	// ndice de lneas de fuego (esquiva y costes de amenaza de la IA)
+	if (UProjectileLaneSubsystem* Lanes = GetWorld()->GetSubsystem<UProjectileLaneSubsystem>())
+	{
+		Lanes->RegisterProjectile(this);
+	}
+}
+
+void AProjectile::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UProjectileLaneSubsystem* Lanes = GetWorld()->GetSubsystem<UProjectileLaneSubsystem>())
+	{
+		Lanes->UnregisterProjectile(this);
+	}
+	Super::EndPlay(EndPlayReason);
 }
 
 void AProjectile::Tick(float DeltaSeconds)
@@ -87,6 +105,13 @@ void AProjectile::Tick(float DeltaSeconds)
 		return;
 	}
 
+	// Tanques de la horda (MassEntity): no tienen colisin, se consulta su ocupacin por celda
+	if (Team == EProjectileTeam::Player && Horde && Horde->HitAt(GetActorLocation(), ProjRadius))
+	{
+		Destroy();
+		return;
+	}
+
 	// 2. Colisin con Actores Dinmicos (Tanques, Base, otras Balas)
 	// Mantenemos tu barrido manual original para esto
 	DoManualSweep(DeltaSeconds);
@@ -0,0 +1,144 @@
+#include "Projectiles/ProjectileLaneIndex.h"
+#include "Components/GridPathFollow/GridSearch.h"
+#include "Map/MapGridSubsystem.h"
+#include "Algo/Sort.h"
+
+void FProjectileLaneIndex::Reset()
+{
+	for (int32 T = 0; T < 2; ++T)
+	{
+		for (const int32 Idx : Touched[T]) Arrival[T][Idx] = MAX_flt;
+		Touched[T].Reset();
+	}
+	Entries.Reset();
+	LaneStart.Reset();
+}
+
+void FProjectileLaneIndex::Build(const UMapGridSubsystem& Grid, TConstArrayView<FProjectileLaneSample> Samples, float LookaheadSeconds)
+{
+	const int32 W = Grid.GetWidth();
+	const int32 H = Grid.GetHeight();
+	const float Tile = Grid.GetTileSize();
+
+	if (W != Width || H != Height)
+	{
+		Width = W;
+		Height = H;
+		for (int32 T = 0; T < 2; ++T)
+		{
+			Arrival[T].Init(MAX_flt, FMath::Max(0, W * H));
+			Touched[T].Reset();
+		}
+		Entries.Reset();
+		LaneStart.Reset();
+	}
+	else
+	{
+		Reset();
+	}
+
+	Pending.Reset();
+	PendingLane.Reset();
+	if (W <= 0 || H <= 0 || Tile <= KINDA_SMALL_NUMBER) return;
+
+	// Ejes del grid en mundo (el mapa puede estar girado)
+	const FVector Origin = Grid.GridToWorld(0, 0);
+	const FVector AxisX = (Grid.GridToWorld(1, 0) - Origin) / Tile;
+	const FVector AxisY = (Grid.GridToWorld(0, 1) - Origin) / Tile;
+
+	for (const FProjectileLaneSample& S : Samples)
+	{
+		int32 X, Y;
+		if (!Grid.WorldToGrid(S.Location, X, Y)) continue;
+
+		// Velocidad en celdas/s; las balas van en cardinal, nos quedamos con el eje dominante
+		const float Vx = FVector::DotProduct(S.Velocity, AxisX) / Tile;
+		const float Vy = FVector::DotProduct(S.Velocity, AxisY) / Tile;
+		const bool bAlongX = FMath::Abs(Vx) >= FMath::Abs(Vy);
+		const float Speed = bAlongX ? FMath::Abs(Vx) : FMath::Abs(Vy);
+		if (Speed < 0.01f) continue;
+
+		FProjectileLaneEntry E;
+		E.Cell = FIntPoint(X, Y);
+		E.Dir = bAlongX ? (Vx > 0.f ? 1 : 3) : (Vy > 0.f ? 2 : 0);
+		E.Team = S.Team;
+		E.CellsPerSecond = Speed;
+
+		const float Along = FVector::DotProduct(S.Location - Grid.GridToWorld(X, Y), bAlongX ? AxisX : AxisY) / Tile;
+		const float Sign = (bAlongX ? Vx : Vy) > 0.f ? 1.f : -1.f;
+		E.Offset = FMath::Clamp(Along * Sign, -0.5f, 0.5f);
+		E.EntryTime = (0.5f - E.Offset) / Speed;
+
+		// Capa de llegada: la celda actual y las de delante hasta chocar o agotar el horizonte
+		const int32 MaxCells = FMath::FloorToInt(LookaheadSeconds * Speed + 0.5f + E.Offset);
+		const FIntPoint Step = GridSearch::Dir4[E.Dir];
+		TArray<float>& Layer = Arrival[(int32)S.Team];
+		TArray<int32>& Touch = Touched[(int32)S.Team];
+
+		int32 K = 0;
+		for (FIntPoint C = E.Cell; K <= MaxCells; ++K, C += Step)
+		{
+			const int32 Idx = CellIndex(C);
+			if (Idx == INDEX_NONE) break;
+			if (K > 0 && Grid.GetObstacleAtGrid(C.X, C.Y) != EObstacleType::None) break;
+
+			if (Layer[Idx] == MAX_flt) Touch.Add(Idx);
+			Layer[Idx] = FMath::Min(Layer[Idx], E.GetArrivalTime(K));
+		}
+		E.RangeCells = K - 1;
+
+		Pending.Add(E);
+		PendingLane.Add(bAlongX ? Y : H + X);
+	}
+
+	// Reparto por carril (counting sort) y orden por EntryTime dentro de cada uno
+	const int32 NumLanes = H + W;
+	LaneStart.Reset();
+	LaneStart.SetNumZeroed(NumLanes + 1);
+	for (const int32 Lane : PendingLane) ++LaneStart[Lane + 1];
+	for (int32 L = 0; L < NumLanes; ++L) LaneStart[L + 1] += LaneStart[L];
+
+	Entries.SetNumUninitialized(Pending.Num(), EAllowShrinking::No);
+	LaneFill.Reset();
+	LaneFill.Append(LaneStart.GetData(), NumLanes);
+	for (int32 i = 0; i < Pending.Num(); ++i)
+	{
+		Entries[LaneFill[PendingLane[i]]++] = Pending[i];
+	}
+
+	for (int32 L = 0; L < NumLanes; ++L)
+	{
+		const int32 Count = LaneStart[L + 1] - LaneStart[L];
+		if (Count < 2) continue;
+		Algo::SortBy(TArrayView<FProjectileLaneEntry>(Entries.GetData() + LaneStart[L], Count), &FProjectileLaneEntry::EntryTime);
+	}
+}
+
+bool FProjectileLaneIndex::FindIncoming(const FIntPoint& Cell, EProjectileTeam Team, float WithinSeconds, FProjectileLaneEntry& OutEntry, float& OutArrival) const
+{
+	OutArrival = MAX_flt;
+	if (!IsThreatened(Cell, Team, WithinSeconds)) return false;
+
+	auto Scan = [&](TConstArrayView<FProjectileLaneEntry> Lane)
+		{
+			for (const FProjectileLaneEntry& E : Lane)
+			{
+				if (E.Team != Team) continue;
+				const FIntPoint D = GridSearch::Dir4[E.Dir];
+				const int32 K = (Cell.X - E.Cell.X) * D.X + (Cell.Y - E.Cell.Y) * D.Y;
+				if (K < 0 || K > E.RangeCells) continue;
+
+				const float T = E.GetArrivalTime(K);
+				if (T < OutArrival) { OutArrival = T; OutEntry = E; }
+			}
+		};
+	Scan(GetRowLane(Cell.Y));
+	Scan(GetColumnLane(Cell.X));
+	return OutArrival <= WithinSeconds;
+}
+
+SIZE_T FProjectileLaneIndex::GetAllocatedSize() const
+{
+	return Entries.GetAllocatedSize() + LaneStart.GetAllocatedSize() + Pending.GetAllocatedSize() + PendingLane.GetAllocatedSize() + LaneFill.GetAllocatedSize()
+		+ Arrival[0].GetAllocatedSize() + Arrival[1].GetAllocatedSize() + Touched[0].GetAllocatedSize() + Touched[1].GetAllocatedSize();
+}
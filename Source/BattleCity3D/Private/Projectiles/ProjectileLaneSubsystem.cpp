@@ -0,0 +1,117 @@
+#include "Projectiles/ProjectileLaneSubsystem.h"
+#include "Projectiles/Projectile.h"
+#include "Components/GridPathFollow/GridPathManager.h"
+#include "Map/MapGridSubsystem.h"
+#include "Engine/World.h"
+#include "Engine/GameInstance.h"
+#include "DrawDebugHelpers.h"
+
+// Uso en consola: bc.ai.lanes.draw 1
+static TAutoConsoleVariable<int32> CVarBcLanesDraw(
+	TEXT("bc.ai.lanes.draw"),
+	0,
+	TEXT("1: Dibuja las lineas de fuego de las balas en vuelo hasta donde chocan o acaba el horizonte (rojo = jugador, azul = enemigas)."),
+	ECVF_Cheat);
+
+bool UProjectileLaneSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UProjectileLaneSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	if (UGameInstance* GI = InWorld.GetGameInstance())
+	{
+		if (UGridPathManager* Mgr = GI->GetSubsystem<UGridPathManager>())
+		{
+			Mgr->SetThreatLanes(&Index);
+			PathMgr = Mgr;
+		}
+	}
+}
+
+void UProjectileLaneSubsystem::Deinitialize()
+{
+	if (UGridPathManager* Mgr = PathMgr.Get())
+	{
+		if (Mgr->GetThreatLanes() == &Index) Mgr->SetThreatLanes(nullptr);
+	}
+	PathMgr.Reset();
+	Projectiles.Reset();
+	Index.Reset();
+	Super::Deinitialize();
+}
+
+TStatId UProjectileLaneSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UProjectileLaneSubsystem, STATGROUP_Tickables);
+}
+
+void UProjectileLaneSubsystem::RegisterProjectile(AProjectile* Projectile)
+{
+	if (Projectile) Projectiles.AddUnique(Projectile);
+}
+
+void UProjectileLaneSubsystem::UnregisterProjectile(AProjectile* Projectile)
+{
+	Projectiles.RemoveSingleSwap(Projectile, EAllowShrinking::No);
+}
+
+void UProjectileLaneSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	UGameInstance* GI = GetWorld()->GetGameInstance();
+	const UMapGridSubsystem* Grid = GI ? GI->GetSubsystem<UMapGridSubsystem>() : nullptr;
+	if (!Grid) return;
+
+	Samples.Reset();
+	for (int32 i = Projectiles.Num() - 1; i >= 0; --i)
+	{
+		const AProjectile* P = Projectiles[i].Get();
+		if (!P)
+		{
+			Projectiles.RemoveAtSwap(i, 1, EAllowShrinking::No);
+			continue;
+		}
+		FProjectileLaneSample& S = Samples.AddDefaulted_GetRef();
+		S.Location = P->GetActorLocation();
+		S.Velocity = P->GetVelocity();
+		S.Team = P->Team;
+	}
+	Index.Build(*Grid, Samples, LookaheadSeconds);
+
+	if (CVarBcLanesDraw.GetValueOnGameThread() != 0) DrawDebug();
+}
+
+void UProjectileLaneSubsystem::DrawDebug() const
+{
+	UWorld* World = GetWorld();
+	UGameInstance* GI = World ? World->GetGameInstance() : nullptr;
+	const UMapGridSubsystem* Grid = GI ? GI->GetSubsystem<UMapGridSubsystem>() : nullptr;
+	if (!Grid) return;
+
+	const float Tile = Grid->GetTileSize();
+	for (int32 Y = 0; Y < Grid->GetHeight(); ++Y)
+	{
+		for (const FProjectileLaneEntry& E : Index.GetRowLane(Y))
+		{
+			const FIntPoint Step(E.Dir == 1 ? 1 : -1, 0);
+			const FIntPoint Last = E.Cell + Step * E.RangeCells;
+			DrawDebugLine(World, Grid->GridToWorld(E.Cell.X, E.Cell.Y, Tile * 0.3f), Grid->GridToWorld(Last.X, Last.Y, Tile * 0.3f),
+				E.Team == EProjectileTeam::Player ? FColor::Red : FColor::Blue, false, 0.f, 0, 8.f);
+		}
+	}
+	for (int32 X = 0; X < Grid->GetWidth(); ++X)
+	{
+		for (const FProjectileLaneEntry& E : Index.GetColumnLane(X))
+		{
+			const FIntPoint Step(0, E.Dir == 2 ? 1 : -1);
+			const FIntPoint Last = E.Cell + Step * E.RangeCells;
+			DrawDebugLine(World, Grid->GridToWorld(E.Cell.X, E.Cell.Y, Tile * 0.3f), Grid->GridToWorld(Last.X, Last.Y, Tile * 0.3f),
+				E.Team == EProjectileTeam::Player ? FColor::Red : FColor::Blue, false, 0.f, 0, 8.f);
+		}
+	}
+}
@@ -1,6 +1,8 @@
 #include "Spawner/EnemySpawner.h"
 #include "Enemies/EnemyPawn.h"
 #include "Map/MapGridSubsystem.h"
+#include "Common/BattleTargetRegistry.h"
+#include "Common/GameplayTimerSubsystem.h"
 #include "TimerManager.h"
 #include "Kismet/GameplayStatics.h"
 #include "GameClasses/BattleGameMode.h"
@@ -16,7 +18,10 @@
 #include "Components/EnemyMovement/EnemyMovePolicies/EnemyMovePolicy.h"
 #include "Components/EnemyMovement/EnemyMovePolicies/EnemyMovePolicy_PathFollow.h"
 #include "Components/EnemyMovement/EnemyMovePolicies/EnemyMovePolicy_Composite.h"
+#include "Components/EnemyMovement/EnemyMovePolicies/EnemyMovePolicy_AxisPathShoot.h"
 #include "Components/EnemyMovement/EnemyMovementComponent.h"
+#include "Components/EnemyMovement/EnemyAIManager.h"
+#include "Spawner/EnemySquad.h"
 
 #include "Spawner/SpawnPointPolicies/EnemySpawnPointPolicy_RandomAny.h"
 #include "Spawner/SpawnPointPolicies/EnemySpawnPointPolicy_FarFromPlayer.h"
@@ -114,9 +119,7 @@ void AEnemySpawner::ScheduleWaves()
 		Pending.Add(PW);
 		EnemiesPlanned += PW.Count;
 
-		FTimerHandle H;
-		FTimerDelegate D = FTimerDelegate::CreateUObject(this, &AEnemySpawner::OnWaveDue, PW);
-		GetWorldTimerManager().SetTimer(H, D, PW.Time, false);
+		SetSpawnTimer(FTimerDelegate::CreateUObject(this, &AEnemySpawner::OnWaveDue, PW), PW.Time);
 	}
 
 	// Precache spawn points por smbolo (mundo)
@@ -144,6 +147,18 @@ void AEnemySpawner::ScheduleWaves()
 	UE_LOG(LogTemp, Log, TEXT("EnemySpawner: %d spawn cells unificadas."), AllSpawnCells.Num());
 }
 
+void AEnemySpawner::SetSpawnTimer(FTimerDelegate&& Delegate, float Delay)
+{
+	// Rueda de timers del mundo; FTimerManager slo si no existe (mundos sin el subsistema)
+	if (UGameplayTimerSubsystem* Timers = GetWorld()->GetSubsystem<UGameplayTimerSubsystem>())
+	{
+		Timers->SetTimer(MoveTemp(Delegate), Delay);
+		return;
+	}
+	FTimerHandle H;
+	GetWorldTimerManager().SetTimer(H, Delegate, Delay, false);
+}
+
 void AEnemySpawner::OnWaveDue(FPendingWave Wave)
 {
 	if (!Grid) return;
@@ -152,17 +167,17 @@ void AEnemySpawner::OnWaveDue(FPendingWave Wave)
 	const int32 FreeSlots = MaxAlive - AliveCount;
 	if (FreeSlots <= 0)
 	{
-		FTimerHandle H;
-		FTimerDelegate D = FTimerDelegate::CreateUObject(this, &AEnemySpawner::OnWaveDue, Wave);
-		GetWorldTimerManager().SetTimer(H, D, 0.5f, false);
+		SetSpawnTimer(FTimerDelegate::CreateUObject(this, &AEnemySpawner::OnWaveDue, Wave), 0.5f);
 		return;
 	}
 
 	const int32 ToSpawnNow = FMath::Clamp(Wave.Count, 0, FreeSlots);
+	TArray<AEnemyPawn*> Batch;
 	for (int32 i = 0; i < ToSpawnNow; ++i)
 	{
-		SpawnOne(Wave.Type, Wave.Symbol);
+		if (AEnemyPawn* E = SpawnOne(Wave.Type, Wave.Symbol)) Batch.Add(E);
 	}
+	if (bFormSquads) FormSquads(Batch);
 
 	const int32 Remaining = Wave.Count - ToSpawnNow;
 	if (Remaining > 0)
@@ -170,9 +185,7 @@ void AEnemySpawner::OnWaveDue(FPendingWave Wave)
 		FPendingWave Rest = Wave;
 		Rest.Count = Remaining;
 
-		FTimerHandle H;
-		FTimerDelegate D = FTimerDelegate::CreateUObject(this, &AEnemySpawner::OnWaveDue, Rest);
-		GetWorldTimerManager().SetTimer(H, D, 0.5f, false);
+		SetSpawnTimer(FTimerDelegate::CreateUObject(this, &AEnemySpawner::OnWaveDue, Rest), 0.5f);
 	}
 
 	UE_LOG(LogTemp, Log, TEXT("Wave '%s' at '%s': spawned %d, remaining %d (Alive=%d/%d)"),
@@ -200,18 +213,18 @@ TSubclassOf<AEnemyPawn> AEnemySpawner::ResolveClassFor(const FString& Type, cons
 	return EnemyClassDefault;
 }
 
-void AEnemySpawner::SpawnOne(const FString& Type, const FString& Symbol)
+AEnemyPawn* AEnemySpawner::SpawnOne(const FString& Type, const FString& Symbol)
 {
 	// Usar la unin de spawns (deduplicada) sin importar el smbolo
 	const TArray<FVector>& Candidates = AllSpawnLocs;
-	if (Candidates.Num() == 0 || !Grid) return;
+	if (Candidates.Num() == 0 || !Grid) return nullptr;
 
 	// Pedimos orden a la policy; si no hay, baraja fallback
 	TArray<int32> Indices;
 	if (SpawnPointPolicy)
 	{
 		FSpawnPointContext Ctx;
-		if (APawn* P = UGameplayStatics::GetPlayerPawn(this, 0)) Ctx.PlayerLoc = P->GetActorLocation();
+		if (const UBattleTargetRegistry* Targets = GetWorld()->GetSubsystem<UBattleTargetRegistry>()) Targets->GetPlayerLocation(Ctx.PlayerLoc);
 		Ctx.bHasBase = Grid->HasBase();
 		if (Ctx.bHasBase) Ctx.BaseLoc = Grid->GetBaseWorldLocation();
 
@@ -250,14 +263,13 @@ void AEnemySpawner::SpawnOne(const FString& Type, const FString& Symbol)
 	if (!bFound)
 	{
 		// Reintenta pronto (tal vez por colisiones transitorias)
-		FTimerHandle H;
 		FTimerDelegate D;
 		D.BindWeakLambda(this, [this, Type, Symbol]()
 			{
 				SpawnOne(Type, Symbol);
 			});
-		GetWorldTimerManager().SetTimer(H, D, 0.25f, false);
-		return;
+		SetSpawnTimer(MoveTemp(D), 0.25f);
+		return nullptr;
 	}
 
 	// Marca celda como "reclamada" este tick
@@ -266,14 +278,18 @@ void AEnemySpawner::SpawnOne(const FString& Type, const FString& Symbol)
 	const FRotator SpawnRot = FRotator::ZeroRotator;
 
 	TSubclassOf<AEnemyPawn> Chosen = ResolveClassFor(Type, Symbol);
-	if (!Chosen) return;
-
-	FActorSpawnParameters Params;
-	Params.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
-	Params.Owner = this;
-
-	AEnemyPawn* E = GetWorld()->SpawnActor<AEnemyPawn>(Chosen, SpawnLoc, SpawnRot, Params);
-	if (!E) return;
+	if (!Chosen) return nullptr;
+
+	// Diferido: la config de policy del tipo entra antes de BeginPlay (un solo enlace, sin copias)
+	const FTransform SpawnXform(SpawnRot, SpawnLoc);
+	AEnemyPawn* E = GetWorld()->SpawnActorDeferred<AEnemyPawn>(Chosen, SpawnXform, this, nullptr,
+		ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn);
+	if (!E) return nullptr;
+	if (E->MovementComp)
+	{
+		if (UEnemyMovePolicy* Config = GetPolicyConfigFor(Chosen)) E->MovementComp->SetPolicyConfig(Config);
+	}
+	E->FinishSpawning(SpawnXform);
 
 	// ---- Asignacin de meta por poltica ----
 	FEnemySpawnContext Ctx;
@@ -282,7 +298,8 @@ void AEnemySpawner::SpawnOne(const FString& Type, const FString& Symbol)
 	Ctx.EnemiesSpawned = EnemiesSpawned;
 	Ctx.MaxAlive = MaxAlive;
 	Ctx.bHasBase = Grid->HasBase();
-	Ctx.bHasPlayer = (UGameplayStatics::GetPlayerPawn(this, 0) != nullptr);
+	const UBattleTargetRegistry* Targets = GetWorld()->GetSubsystem<UBattleTargetRegistry>();
+	Ctx.bHasPlayer = Targets && Targets->HasPlayer();
 
 	if (GoalPolicy)
 		E->Goal = GoalPolicy->DecideGoalOnSpawn(Ctx);
@@ -301,31 +318,102 @@ void AEnemySpawner::SpawnOne(const FString& Type, const FString& Symbol)
 
 	if (GoalPolicy) GoalPolicy->OnAliveCountChanged(AliveCount);
 
-	if (UEnemyMovementComponent* Move = E->FindComponentByClass<UEnemyMovementComponent>())
+	// Cuando muera:
+	E->OnDestroyed.AddDynamic(this, &AEnemySpawner::HandleActorDestroyed);
+	return E;
+}
+
+UEnemyMovePolicy* AEnemySpawner::GetPolicyConfigFor(TSubclassOf<AEnemyPawn> Cls)
+{
+	const AEnemyPawn* CDO = Cls ? Cls->GetDefaultObject<AEnemyPawn>() : nullptr;
+	const UEnemyMovementComponent* TemplateMove = CDO ? CDO->MovementComp : nullptr;
+	if (!TemplateMove) return nullptr;
+
+	const EEnemyType Type = CDO->EnemyType;
+	const TPair<const UClass*, EEnemyType> Key(Cls.Get(), Type);
+	if (UEnemyMovePolicy** Found = PolicyConfigByType.Find(Key)) return *Found;
+
+	// Copia (con sus sub-policies) de la config del template, ajustada por tipo
+	UEnemyMovePolicy* Base = TemplateMove->GetPolicyConfig();
+	UEnemyMovePolicy* Config = NewObject<UEnemyMovePolicy>(this, Base->GetClass(), NAME_None, RF_Transient, Base);
+	ForEachPathFollow(Config, [this, Type](UEnemyMovePolicy_PathFollow* PF)
+		{
+			PF->Cost = PathDefaults.GetCostFor(Type);
+			PF->ReplanInterval = PathDefaults.ReplanInterval;
+			PF->HorizonSteps = PathDefaults.HorizonSteps;
+			PF->bTargetIsPlayer = PathDefaults.bTargetIsPlayer;
+		});
+
+	// Compartida ya resuelta: al enlazar cada enemigo slo se comparan punteros
+	if (UEnemyAIManager* Mgr = GetWorld()->GetSubsystem<UEnemyAIManager>())
 	{
-		auto ApplyDefaultsTo = [this](UEnemyMovePolicy* Policy)
-			{
-				if (auto* PF = Cast<UEnemyMovePolicy_PathFollow>(Policy))
-				{
-					PF->Cost = PathDefaults.Cost;
-					PF->ReplanInterval = PathDefaults.ReplanInterval;
-					PF->HorizonSteps = PathDefaults.HorizonSteps;
-					PF->bTargetIsPlayer = PathDefaults.bTargetIsPlayer;
-				}
-			};
-
-		if (auto* Comp = Cast<UEnemyMovePolicy_Composite>(Move->MovePolicy)) 
+		if (UEnemyMovePolicy* Shared = Mgr->GetSharedPolicy(Config)) Config = Shared;
+	}
+	PolicyConfigs.Add(Config);
+	PolicyConfigByType.Add(Key, Config);
+	return Config;
+}
+
+void AEnemySpawner::ForEachPathFollow(UEnemyMovePolicy* Root, TFunctionRef<void(UEnemyMovePolicy_PathFollow*)> Fn)
+{
+	if (auto* Comp = Cast<UEnemyMovePolicy_Composite>(Root))
+	{
+		for (UEnemyMovePolicy* Sub : Comp->Policies)
+		{
+			if (auto* PF = Cast<UEnemyMovePolicy_PathFollow>(Sub)) Fn(PF);
+		}
+	}
+	else if (auto* Pipe = Cast<UEnemyMovePolicy_AxisPathShoot>(Root))
+	{
+		if (Pipe->PathFollow) Fn(Pipe->PathFollow);
+	}
+	else if (auto* PF = Cast<UEnemyMovePolicy_PathFollow>(Root))
+	{
+		Fn(PF);
+	}
+}
+
+void AEnemySpawner::FormSquads(const TArray<AEnemyPawn*>& Batch)
+{
+	if (!Grid || Batch.Num() < 2) return;
+
+	TArray<FIntPoint> Cells;
+	Cells.SetNum(Batch.Num());
+	for (int32 i = 0; i < Batch.Num(); ++i)
+	{
+		int32 X = -999, Y = -999;
+		Grid->WorldToGrid(Batch[i]->GetActorLocation(), X, Y);
+		Cells[i] = FIntPoint(X, Y);
+	}
+
+	// Agrupacin voraz: mismo objetivo y spawn cercano al del primero del grupo
+	TArray<bool> Used;
+	Used.SetNumZeroed(Batch.Num());
+	for (int32 i = 0; i < Batch.Num(); ++i)
+	{
+		if (Used[i]) continue;
+		Used[i] = true;
+
+		TSharedPtr<FEnemySquad> Squad = MakeShared<FEnemySquad>();
+		Squad->AddMember(Batch[i]);
+		for (int32 j = i + 1; j < Batch.Num() && Squad->Num() < SquadMaxSize; ++j)
 		{
-			for (UEnemyMovePolicy* Sub : Comp->Policies) ApplyDefaultsTo(Sub);
+			if (Used[j] || Batch[j]->Goal != Batch[i]->Goal) continue;
+			if (FMath::Abs(Cells[j].X - Cells[i].X) + FMath::Abs(Cells[j].Y - Cells[i].Y) > SquadClusterCells) continue;
+			Used[j] = true;
+			Squad->AddMember(Batch[j]);
 		}
-		else if (UEnemyMovePolicy* Single = Move->MovePolicy)
+		if (Squad->Num() < 2) continue;
+
+		for (int32 Slot = 0; Slot < Squad->Num(); ++Slot)
 		{
-			ApplyDefaultsTo(Single);
+			AEnemyPawn* Member = Squad->GetMember(Slot);
+			UEnemyMovementComponent* Move = Member ? Member->FindComponentByClass<UEnemyMovementComponent>() : nullptr;
+			if (!Move) continue;
+			ForEachPathFollow(Move->MovePolicy, [&Squad, Move](UEnemyMovePolicy_PathFollow* PF) { PF->SetSquad(Move->GetMoveAgent(), Squad); });
 		}
+		Squads.Add(Squad);
 	}
-
-	// Cuando muera:
-	E->OnDestroyed.AddDynamic(this, &AEnemySpawner::HandleActorDestroyed);
 }
 
 bool AEnemySpawner::IsSpawnPointFree(const FVector& Location) const
@@ -361,6 +449,7 @@ void AEnemySpawner::HandleActorDestroyed(AActor* Dead)
 {
 	AliveCount = FMath::Max(0, AliveCount - 1);
 	LivingEnemies.RemoveAll([Dead](const TWeakObjectPtr<AEnemyPawn>& W) { return !W.IsValid() || W.Get() == Dead; });
+	Squads.RemoveAll([](const TSharedPtr<FEnemySquad>& S) { S->Prune(); return S->Num() <= 1; });
 	if (GoalPolicy)
 	{
 		if (AEnemyPawn* EP = Cast<AEnemyPawn>(Dead)) GoalPolicy->OnEnemyDestroyed(EP);
@@ -393,9 +482,12 @@ void AEnemySpawner::Tick(float DeltaSeconds)
 			(E->Goal == EEnemyGoal::HuntBase ? HuntBase : HuntPlayer)++;
 
 	const FString PolicyName = GoalPolicy ? GoalPolicy->GetClass()->GetName() : TEXT("None");
+	int32 LeaderPlans = 0, FollowerRoutes = 0;
+	for (const TSharedPtr<FEnemySquad>& S : Squads) { LeaderPlans += S->GetLeaderPlans(); FollowerRoutes += S->GetFollowerRoutes(); }
+
 	const FString Msg = FString::Printf(
-		TEXT("[AI] Alive=%d  Spawned=%d/%d  HB=%d  HP=%d  Policy=%s"),
-		AliveCount, EnemiesSpawned, EnemiesPlanned, HuntBase, HuntPlayer, *PolicyName);
+		TEXT("[AI] Alive=%d  Spawned=%d/%d  HB=%d  HP=%d  Policy=%s  Squads=%d (rutas lider %d / seguidores %d)"),
+		AliveCount, EnemiesSpawned, EnemiesPlanned, HuntBase, HuntPlayer, *PolicyName, Squads.Num(), LeaderPlans, FollowerRoutes);
 
 	if (GEngine) GEngine->AddOnScreenDebugMessage(0xBADC0DE, 0.55f, FColor::Yellow, Msg);
 }
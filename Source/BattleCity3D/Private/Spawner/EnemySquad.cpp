@@ -0,0 +1,78 @@
+#include "Spawner/EnemySquad.h"
+#include "Enemies/EnemyPawn.h"
+
+void FEnemySquad::AddMember(AEnemyPawn* Pawn)
+{
+	if (Pawn && GetSlot(Pawn) == INDEX_NONE) Members.Add(Pawn);
+}
+
+void FEnemySquad::Prune()
+{
+	// Orden estable: los slots (y la columna) se mantienen
+	Members.RemoveAll([](const TWeakObjectPtr<AEnemyPawn>& W) { return !W.IsValid(); });
+}
+
+int32 FEnemySquad::GetSlot(const AEnemyPawn* Pawn) const
+{
+	for (int32 i = 0; i < Members.Num(); ++i)
+	{
+		if (Members[i].Get() == Pawn) return i;
+	}
+	return INDEX_NONE;
+}
+
+static bool AreAdjacent(const FIntPoint& A, const FIntPoint& B)
+{
+	return FMath::Abs(A.X - B.X) + FMath::Abs(A.Y - B.Y) == 1;
+}
+
+void FEnemySquad::RecordLeaderCell(const FIntPoint& Cell)
+{
+	if (Trail.Num() > 0 && Trail.Last() == Cell) return;
+	// Salto (frame largo, empujn): el rastro viejo ya no se une con el nuevo
+	if (Trail.Num() > 0 && !AreAdjacent(Trail.Last(), Cell)) Trail.Reset();
+	if (Trail.Num() >= MaxTrail) Trail.RemoveAt(0, Trail.Num() - MaxTrail + 1, EAllowShrinking::No);
+	Trail.Add(Cell);
+}
+
+void FEnemySquad::PublishLeaderPath(const FGridPathRef& Path, const FIntPoint& InGoalCell)
+{
+	LeaderPath = Path;
+	GoalCell = InGoalCell;
+	++Version;
+	++LeaderPlans;
+}
+
+bool FEnemySquad::BuildFollowerRoute(const FIntPoint& From, int32 MaxDivergeCells, TArray<FIntPoint>& OutCells) const
+{
+	OutCells.Reset();
+	if (!LeaderPath.IsValid()) return false;
+
+	// Secuencia completa: rastro + ruta publicada (su primera celda suele ser la ltima del rastro;
+	// si no empalma, slo la ruta)
+	const FIntPoint PathStart = LeaderPath->GetStartCell();
+	if (Trail.Num() > 0 && (Trail.Last() == PathStart || AreAdjacent(Trail.Last(), PathStart))) OutCells.Append(Trail);
+	LeaderPath->ForEachCell([&OutCells](const FIntPoint& C)
+		{
+			if (OutCells.Num() == 0 || OutCells.Last() != C) OutCells.Add(C);
+		});
+
+	int32 Best = INDEX_NONE;
+	int32 BestDist = MAX_int32;
+	for (int32 i = 0; i < OutCells.Num(); ++i)
+	{
+		const int32 D = FMath::Abs(OutCells[i].X - From.X) + FMath::Abs(OutCells[i].Y - From.Y);
+		if (D <= BestDist) { BestDist = D; Best = i; }
+	}
+	if (Best == INDEX_NONE || BestDist > MaxDivergeCells)
+	{
+		OutCells.Reset();
+		return false;
+	}
+
+	OutCells.RemoveAt(0, Best, EAllowShrinking::No);
+	// Pegado al rastro: se une directamente. Ms lejos el hueco puede tener muros y lo puentea quien llama.
+	if (AreAdjacent(OutCells[0], From)) OutCells.Insert(From, 0);
+	++FollowerRoutes;
+	return true;
+}
@@ -0,0 +1,61 @@
+#include "Components/EnemyMovement/EnemyAIManager.h"
+#include "Components/EnemyMovement/EnemyMovementComponent.h"
+#include "Misc/AutomationTest.h"
+#include "UObject/Package.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+// Misma forma que la fase de aplicacin de UEnemyAIManager::TickAgents: ndices fijados antes,
+// bajas de otros agentes (anteriores y posteriores) en mitad del recorrido.
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FEnemyAIAgentsDeferredRemovalTest, "BattleCity3D.AI.Agents.UnregisterDuringApply",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FEnemyAIAgentsDeferredRemovalTest::RunTest(const FString& Parameters)
+{
+	constexpr int32 NumAgents = 6;
+	FEnemyAIAgents Agents;
+	TArray<UEnemyMovementComponent*> Comps;
+	for (int32 i = 0; i < NumAgents; ++i)
+	{
+		UEnemyMovementComponent* Comp = NewObject<UEnemyMovementComponent>(GetTransientPackage());
+		Comps.Add(Comp);
+		Agents.Add(Comp, nullptr, nullptr, FVector2D(1.f, 0.f), 0);
+	}
+
+	TArray<int32> Due;
+	for (int32 i = 0; i < NumAgents; ++i) Due.Add(i);
+
+	// El 2 "dispara" y da de baja al 0 (ya aplicado) y al 4 (pendiente)
+	TMap<UEnemyMovementComponent*, int32> Applied;
+	Agents.BeginDeferRemovals();
+	for (const int32 i : Due)
+	{
+		if (!Agents.IsLive(i)) continue;
+		Applied.FindOrAdd(Agents.Components[i])++;
+		if (i == 2)
+		{
+			Agents.Remove(0);
+			Agents.Remove(4);
+		}
+	}
+	const int32 FirstMoved = Agents.EndDeferRemovals();
+
+	TestEqual(TEXT("Primer ndice movido"), FirstMoved, 0);
+	TestEqual(TEXT("Agentes tras compactar"), Agents.Num(), NumAgents - 2);
+	TestEqual(TEXT("Aplicado el 0 antes de su baja"), Applied.FindRef(Comps[0]), 1);
+	TestEqual(TEXT("El 4 no se aplica tras su baja"), Applied.FindRef(Comps[4]), 0);
+	for (const int32 i : { 1, 2, 3, 5 })
+	{
+		TestEqual(FString::Printf(TEXT("Agente %d aplicado una vez"), i), Applied.FindRef(Comps[i]), 1);
+	}
+
+	// Orden de registro intacto
+	const UEnemyMovementComponent* Expected[] = { Comps[1], Comps[2], Comps[3], Comps[5] };
+	for (int32 i = 0; i < Agents.Num(); ++i)
+	{
+		TestTrue(FString::Printf(TEXT("Orden en %d"), i), Agents.Components[i] == Expected[i]);
+	}
+	return true;
+}
+
+#endif
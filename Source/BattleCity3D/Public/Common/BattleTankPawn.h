@@ -39,6 +39,9 @@ public:
 	FVector2D RawMoveInput = FVector2D::ZeroVector;
 	FVector2D GetFacingDir() const { return FacingDir; }
 
+	// Coste de un giro en unidades de FreeCost por celda (parn de TurnDelay + re-aceleracin)
+	float GetTurnPathCost(float TileSize, float FreeCost = 1.f) const;
+
 protected:
 	// Lgica central de fsica (Bigotes + Rieles)
 	void UpdateTankMovement(float DT);
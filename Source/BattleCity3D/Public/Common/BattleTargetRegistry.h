@@ -0,0 +1,104 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "Engine/EngineBaseTypes.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "BattleTargetRegistry.generated.h"
+
+class UBattleTargetRegistry;
+class UMapGridSubsystem;
+
+UENUM(BlueprintType)
+enum class EBattleTargetKind : uint8 { Base, Player, Enemy };
+
+UENUM(BlueprintType)
+enum class EBattleTeam : uint8 { Player, Enemy };
+
+// Foto de un objetivo al inicio del frame
+struct FBattleTargetEntry
+{
+	TWeakObjectPtr<AActor> Actor;
+	FObjectKey Key;
+	EBattleTargetKind Kind = EBattleTargetKind::Enemy;
+	EBattleTeam Team = EBattleTeam::Enemy;
+	FVector Location = FVector::ZeroVector;
+	FIntPoint Cell = FIntPoint(INDEX_NONE, INDEX_NONE);
+	bool bHasCell = false;
+	uint32 Serial = 0; // orden de registro
+};
+
+// Refresco de la foto: TG_PrePhysics con prioridad alta, antes de que tickeen tanques e IA
+USTRUCT()
+struct FBattleTargetTickFunction : public FTickFunction
+{
+	GENERATED_BODY()
+
+	UBattleTargetRegistry* Registry = nullptr;
+
+	virtual void ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent) override;
+	virtual FString DiagnosticMessage() override { return TEXT("UBattleTargetRegistry::Tick"); }
+	virtual FName DiagnosticContext(bool bDetailed) override { return FName(TEXT("BattleTargetRegistry")); }
+};
+
+template<>
+struct TStructOpsTypeTraits<FBattleTargetTickFunction> : public TStructOpsTypeTraitsBase2<FBattleTargetTickFunction>
+{
+	enum { WithCopy = false };
+};
+
+/**
+ * Pizarra del mundo: bases, jugador y enemigos se registran en BeginPlay y se dan de baja en
+ * EndPlay. Una vez por frame, antes de los tanques, se toma una foto de posicin, celda y
+ * equipo de cada uno; durante el frame es de slo lectura y es lo que consultan la IA, las
+ * policies y el spawner en vez de GetAllActorsOfClass / GetPlayerPawn. Las consultas son O(1).
+ */
+UCLASS()
+class BATTLECITY3D_API UBattleTargetRegistry : public UWorldSubsystem
+{
+	GENERATED_BODY()
+public:
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	virtual void Deinitialize() override;
+
+	void Register(AActor* Actor, EBattleTargetKind Kind, EBattleTeam Team);
+	void Unregister(AActor* Actor);
+
+	// Jugador principal (el primero registrado que siga vivo)
+	const FBattleTargetEntry* GetPlayer() const { return PlayerIndex != INDEX_NONE ? &Entries[PlayerIndex] : nullptr; }
+	bool HasPlayer() const { return PlayerIndex != INDEX_NONE; }
+	bool GetPlayerLocation(FVector& Out) const;
+	bool GetPlayerCell(FIntPoint& Out) const;
+
+	// Base del equipo Team (los enemigos atacan la del jugador)
+	const FBattleTargetEntry* GetBase(EBattleTeam Team) const;
+
+	const FBattleTargetEntry* Find(const AActor* Actor) const;
+	int32 GetNumOfKind(EBattleTargetKind Kind) const { return KindCount[(int32)Kind]; }
+	const TArray<FBattleTargetEntry>& GetEntries() const { return Entries; }
+
+	// N de frame de la foto actual (para cachs que dependan de ella)
+	uint32 GetSnapshotFrame() const { return SnapshotFrame; }
+
+	void RefreshSnapshot();
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	void UpdateEntry(FBattleTargetEntry& E) const;
+	void RemoveAtSwap(int32 Index);
+	void RefreshRoles();
+
+	TArray<FBattleTargetEntry> Entries;
+	TMap<FObjectKey, int32> IndexOf;
+	int32 KindCount[3] = { 0, 0, 0 };
+
+	// ndices cacheados de jugador y bases
+	int32 PlayerIndex = INDEX_NONE;
+	int32 BaseIndex[2] = { INDEX_NONE, INDEX_NONE };
+
+	uint32 SnapshotFrame = 0;
+	uint32 RegisterSerial = 0;
+	TWeakObjectPtr<UMapGridSubsystem> Grid;
+	FBattleTargetTickFunction TickFunction;
+};
@@ -0,0 +1,76 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "Engine/EngineBaseTypes.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Common/GameplayTimerWheel.h"
+#include "GameplayTimerSubsystem.generated.h"
+
+class UGameplayTimerSubsystem;
+
+// Avance de las ruedas: TG_PrePhysics, antes de tanques e IA (como FTimerManager, antes del frame)
+USTRUCT()
+struct FGameplayTimerTickFunction : public FTickFunction
+{
+	GENERATED_BODY()
+
+	UGameplayTimerSubsystem* Timers = nullptr;
+
+	virtual void ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent) override;
+	virtual FString DiagnosticMessage() override { return TEXT("UGameplayTimerSubsystem::Tick"); }
+	virtual FName DiagnosticContext(bool bDetailed) override { return FName(TEXT("GameplayTimerSubsystem")); }
+};
+
+template<>
+struct TStructOpsTypeTraits<FGameplayTimerTickFunction> : public TStructOpsTypeTraitsBase2<FGameplayTimerTickFunction>
+{
+	enum { WithCopy = false };
+};
+
+/**
+ * Timers de gameplay sobre dos FGameplayTimerWheel: una en tiempo de juego (segundos cuantizados
+ * a SlotSeconds; pausa y dilatacin como FTimerManager) y otra en frames. Programar y cancelar son
+ * O(1) y cada frame slo se visitan los cubos vencidos, que se disparan en lote. Lo usan el disparo
+ * de los enemigos, los reintentos del spawner y la cadencia de decisin de UEnemyAIManager.
+ * Hay que cancelar los timers propios en EndPlay: los delegates UObject se saltan si el objeto
+ * muri, los FGameplayTimerTarget no.
+ */
+UCLASS(Config = Game)
+class BATTLECITY3D_API UGameplayTimerSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+public:
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	virtual void Deinitialize() override;
+
+	// Segundos de juego. FirstDelay < 0: el primer disparo a los Rate segundos
+	FGameplayTimerHandle SetTimer(FTimerDelegate&& Delegate, float Rate, bool bLoop = false, float FirstDelay = -1.f);
+	FGameplayTimerHandle SetTimer(FGameplayTimerTarget* Target, uint32 Payload, float Rate, bool bLoop = false, float FirstDelay = -1.f);
+	// Frames: vence en el avance nmero Frames desde ahora (0 y 1: el prximo).
+	// FirstDelayFrames >= 0: el primer disparo a esos frames y luego cada Frames
+	FGameplayTimerHandle SetFrameTimer(FGameplayTimerTarget* Target, uint32 Payload, int32 Frames, bool bLoop = false, int32 FirstDelayFrames = -1);
+	// Capacidad para NumTimers timers de frames vivos sin reservar memoria al programarlos
+	void ReserveFrameTimers(int32 NumTimers) { FrameWheel.Reserve(NumTimers); }
+
+	void ClearTimer(FGameplayTimerHandle& Handle);
+	bool IsTimerActive(const FGameplayTimerHandle& Handle) const;
+	int32 GetNumTimers() const { return TimeWheel.GetNumScheduled() + FrameWheel.GetNumScheduled(); }
+
+	// Resolucin de la rueda de tiempo
+	UPROPERTY(Config, EditAnywhere, Category = "Timers", meta = (ClampMin = "0.001")) float SlotSeconds = 1.f / 60.f;
+
+	void TickTimers();
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	enum : uint8 { TimeWheelId = 0, FrameWheelId = 1 };
+
+	int64 SecondsToSlot(double Seconds) const;
+	int64 GetExpireSlot(float Delay) const;
+	uint32 GetIntervalSlots(float Rate) const;
+
+	FGameplayTimerWheel TimeWheel{ TimeWheelId };
+	FGameplayTimerWheel FrameWheel{ FrameWheelId };
+	FGameplayTimerTickFunction TickFunction;
+};
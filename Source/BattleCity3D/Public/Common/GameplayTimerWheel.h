@@ -0,0 +1,118 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "TimerManager.h" // FTimerDelegate
+
+// Handle de un timer de FGameplayTimerWheel. El serial cambia en cada alta, as que un handle de
+// un timer ya disparado o cancelado no toca al que reutilice su hueco.
+struct FGameplayTimerHandle
+{
+	int32 Index = INDEX_NONE;
+	uint32 Serial = 0;
+	uint8 Wheel = 0;
+
+	bool IsValid() const { return Serial != 0; }
+	void Invalidate() { Index = INDEX_NONE; Serial = 0; }
+};
+
+// Receptor sin delegate (no reserva memoria): para quien programa un timer por agente y frame,
+// como la cadencia de UEnemyAIManager. Tiene que cancelar sus timers antes de destruirse.
+class BATTLECITY3D_API FGameplayTimerTarget
+{
+public:
+	virtual ~FGameplayTimerTarget() = default;
+	virtual void OnGameplayTimer(uint32 Payload) = 0;
+};
+
+/**
+ * Rueda de timers jerrquica sobre un contador de slots (segundos cuantizados o frames, lo decide
+ * quien la avanza). 4 niveles de 64 slots: el nivel 0 tiene un slot por unidad y cada nivel
+ * superior cubre 64 veces ms; al dar la vuelta un nivel se recoloca ("cascada") el cubo que toca
+ * del siguiente. Programar y cancelar son O(1) (listas doblemente enlazadas por cubo) y avanzar
+ * slo visita los cubos vencidos, as que miles de timers esperando no cuestan nada.
+ *
+ * Los vencidos de un AdvanceTo se recogen primero y se disparan despus en lote, en orden de
+ * vencimiento: los callbacks pueden programar y cancelar (tambin su propio timer) sin invalidar
+ * nada. Las entradas van en bloques de tamao fijo (direcciones estables, sin realloc).
+ */
+class BATTLECITY3D_API FGameplayTimerWheel
+{
+public:
+	static constexpr int32 LevelBits = 6;
+	static constexpr int32 SlotsPerLevel = 1 << LevelBits;
+	static constexpr int32 NumLevels = 4;
+	// Retraso mximo: lo que cubren los 4 niveles (~77 h con slots de 1/60 s)
+	static constexpr int64 MaxDelaySlots = (int64(1) << (LevelBits * NumLevels)) - 1;
+
+	explicit FGameplayTimerWheel(uint8 InId = 0);
+
+	// Vence en el slot ExpireSlot (si ya pas, en el prximo AdvanceTo). IntervalSlots > 0: se repite.
+	FGameplayTimerHandle Schedule(FTimerDelegate&& Delegate, int64 ExpireSlot, uint32 IntervalSlots = 0);
+	FGameplayTimerHandle Schedule(FGameplayTimerTarget* Target, uint32 Payload, int64 ExpireSlot, uint32 IntervalSlots = 0);
+
+	// Deja el handle invalidado; false si ya no estaba activo
+	bool Cancel(FGameplayTimerHandle& Handle);
+	bool IsActive(const FGameplayTimerHandle& Handle) const;
+
+	// Procesa los slots hasta Slot (incluido) y dispara lo vencido. Devuelve cuntos vencieron.
+	int32 AdvanceTo(int64 Slot);
+
+	// ltimo slot procesado
+	int64 GetCurrentSlot() const { return CurrentSlot; }
+	int32 GetNumScheduled() const { return NumLinked; }
+	int32 GetCapacity() const { return Chunks.Num() * ChunkSize; }
+
+	// Suelta todos los timers sin dispararlos y empieza a contar desde StartSlot
+	void Reset(int64 StartSlot);
+	// Reserva bloques para NumEntries timers vivos: programar hasta ah no reserva memoria
+	void Reserve(int32 NumEntries);
+
+private:
+	static constexpr int32 ChunkSize = 256;
+
+	struct FEntry
+	{
+		FTimerDelegate Delegate;
+		FGameplayTimerTarget* Target = nullptr;
+		int64 Expire = 0;
+		uint32 Payload = 0;
+		uint32 Interval = 0;
+		uint32 Serial = 0;      // 0 = libre
+		int32 Prev = INDEX_NONE;
+		int32 Next = INDEX_NONE; // tambin enlaza la lista libre
+		int16 Bucket = INDEX_NONE;
+		bool bPendingFree = false; // cancelado desde su propio callback
+	};
+
+	struct FFired
+	{
+		int32 Index;
+		uint32 Serial;
+	};
+
+	FEntry& Get(int32 Index) { return Chunks[Index / ChunkSize][Index % ChunkSize]; }
+	const FEntry& Get(int32 Index) const { return Chunks[Index / ChunkSize][Index % ChunkSize]; }
+
+	int32 Allocate(int64 ExpireSlot, uint32 IntervalSlots);
+	void AddChunk();
+	void Release(int32 Index);
+	FGameplayTimerHandle MakeHandle(int32 Index) const;
+
+	void Link(int32 Index);
+	void Unlink(int32 Index);
+	// Saca la lista de un cubo entera (las entradas quedan sin enlazar)
+	int32 DetachBucket(int32 Bucket);
+	void Cascade(int32 Level, int32 Slot);
+
+	TArray<TUniquePtr<FEntry[]>> Chunks;
+	int32 FreeHead = INDEX_NONE;
+	int32 Heads[NumLevels * SlotsPerLevel];
+	int32 Tails[NumLevels * SlotsPerLevel];
+	int64 CurrentSlot = 0;
+	int32 NumLinked = 0;
+	uint32 NextSerial = 1;
+	int32 Executing = INDEX_NONE;
+	uint8 Id = 0;
+
+	// Vencidos del AdvanceTo en curso (se reutiliza)
+	TArray<FFired> Batch;
+};
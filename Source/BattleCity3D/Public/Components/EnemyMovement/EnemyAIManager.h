@@ -0,0 +1,228 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "Engine/EngineBaseTypes.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Components/EnemyMovement/EnemyMovePolicies/EnemyMovePolicy.h"
+#include "Common/GameplayTimerWheel.h"
+#include "EnemyAIManager.generated.h"
+
+// bc.ai.alloccount: contador de reservas por fase del tick (fuera en Shipping)
+#define BC_AI_ALLOC_COUNT !UE_BUILD_SHIPPING
+
+class UEnemyAIManager;
+class UEnemyMovementComponent;
+class UEnemyMovePolicy;
+class AEnemyPawn;
+class UMapGridSubsystem;
+class UProjectileLaneSubsystem;
+class UGameplayTimerSubsystem;
+
+#if BC_AI_ALLOC_COUNT
+// Reservas (nmero y bytes pedidos) hechas en este hilo mientras vive el scope, con el mismo
+// contador de -bcaialloccount (sin l, IsInstalled() es false y todo da 0). Lo usa bc.path.bench.
+struct BATTLECITY3D_API FBCAllocCountScope
+{
+	FBCAllocCountScope();
+	~FBCAllocCountScope();
+	int64 GetAllocs() const;
+	int64 GetBytes() const;
+	static bool IsInstalled();
+
+private:
+	int64 StartAllocs = 0;
+	int64 StartBytes = 0;
+};
+#endif
+
+// Tick propio del manager: una sola entrada en el TickTaskManager para todos los enemigos
+USTRUCT()
+struct FEnemyAITickFunction : public FTickFunction
+{
+	GENERATED_BODY()
+
+	UEnemyAIManager* Manager = nullptr;
+
+	virtual void ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent) override;
+	virtual FString DiagnosticMessage() override { return TEXT("UEnemyAIManager::Tick"); }
+	virtual FName DiagnosticContext(bool bDetailed) override { return FName(TEXT("EnemyAIManager")); }
+};
+
+template<>
+struct TStructOpsTypeTraits<FEnemyAITickFunction> : public TStructOpsTypeTraitsBase2<FEnemyAITickFunction>
+{
+	enum { WithCopy = false };
+};
+
+// Estado de IA por agente en arrays paralelos (SoA), en orden de registro. El ndice de un agente
+// es el mismo en todos; los componentes slo guardan ese ndice.
+struct FEnemyAIAgents
+{
+	TArray<UEnemyMovementComponent*> Components;
+	TArray<AEnemyPawn*> Pawns;
+	TArray<UEnemyMovePolicy*> Policies;
+	// UEnemyMovePolicy::IsParallelSafe, cacheado al registrar / cambiar de policy
+	TArray<bool> ParallelSafe;
+
+	// ltima orden cardinal (la usan las consultas de frente) y lock de eje vigente
+	TArray<FVector2D> Facing;
+	TArray<EMoveLockAxis> LockAxis;
+	TArray<double> LockUntil;
+
+	// LOD: relevancia [0..), nivel y ltimo frame en que decidi
+	TArray<float> Score;
+	TArray<EEnemyAILOD> Tier;
+	TArray<uint32> LastDecisionFrame;
+	// Cadencia: el timer de frames del agente (en bucle, periodo DecisionPeriod) marca DecisionDue
+	TArray<bool> DecisionDue;
+	TArray<FGameplayTimerHandle> DecisionTimer;
+	TArray<int32> DecisionPeriod;
+
+	// Contexto y decisin del frame (se reutilizan)
+	TArray<FMoveContext> Contexts;
+	TArray<FMoveDecision> Decisions;
+
+	int32 Num() const { return Components.Num(); }
+	void Add(UEnemyMovementComponent* Comp, AEnemyPawn* Pawn, UEnemyMovePolicy* Policy, const FVector2D& InFacing, uint32 InLastDecisionFrame);
+	void RemoveAt(int32 Index);
+	void Reset();
+
+	// Durante el tick del manager una baja slo vaca su hueco (componente, pawn y policy a null):
+	// los ndices guardados en el frame siguen apuntando al mismo agente. EndDeferRemovals compacta
+	// y devuelve el primer ndice que se movi (INDEX_NONE si ninguno).
+	void BeginDeferRemovals() { bDeferRemovals = true; }
+	int32 EndDeferRemovals();
+	// RemoveAt, o hueco vaco si se estn difiriendo las bajas
+	void Remove(int32 Index);
+	bool IsLive(int32 Index) const { return Components.IsValidIndex(Index) && Components[Index] != nullptr; }
+
+	bool bDeferRemovals = false;
+	TArray<int32> PendingRemovals;
+};
+
+/**
+ * Actualiza la IA de todos los enemigos en un solo bucle por frame. Con bc.ai.batched (por
+ * defecto) los UEnemyMovementComponent no tickean: se registran en BeginPlay y el manager
+ * recorre los agentes en orden de registro, as que el orden es determinista. Con
+ * bc.ai.batched 0 cada componente vuelve a tickear por su cuenta sobre el mismo estado.
+ *
+ * El tick por lotes va en tres fases: contextos (hilo de juego), decisiones (ParallelFor para las
+ * policies IsParallelSafe, en serie el resto) y aplicacin en orden de agente (hilo de juego).
+ * Nada modifica el grid ni los pawns hasta la aplicacin, as que durante las decisiones el grid
+ * es una foto fija y el resultado no depende del nmero de hilos.
+ *
+ * LOD (bc.ai.lod): la relevancia de cada agente (cerca del jugador o de la base, visible, en lnea
+ * de fuego o alineado con el jugador) fija su nivel y cada nivel decide cada N frames: tras decidir,
+ * cada agente programa su siguiente turno en la rueda de frames de UGameplayTimerSubsystem. Los
+ * agentes que tocan decidir se toman en round-robin hasta MaxDecisionsPerFrame; el resto sigue con
+ * su ltima orden. Un agente que va a chocar decide aunque no le toque.
+ */
+UCLASS(Config = Game)
+class BATTLECITY3D_API UEnemyAIManager : public UWorldSubsystem
+{
+	GENERATED_BODY()
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	virtual void Deinitialize() override;
+
+	// Devuelve el ndice del agente (INDEX_NONE si no hay pawn)
+	int32 RegisterAgent(UEnemyMovementComponent* Comp);
+	void UnregisterAgent(UEnemyMovementComponent* Comp);
+	// El componente cambi de policy (editor)
+	void RefreshAgentPolicy(UEnemyMovementComponent* Comp);
+
+	// Flyweight: una instancia por clase y configuracin (mismos valores editables, sub-policies
+	// incluidas) para todos los enemigos. Config no se guarda: si es nueva se copia. nullptr con
+	// bc.ai.sharedpolicies 0.
+	UEnemyMovePolicy* GetSharedPolicy(UEnemyMovePolicy* Config);
+	const TArray<TObjectPtr<UEnemyMovePolicy>>& GetSharedPolicies() const { return SharedPolicies; }
+
+	// Un paso de IA del agente: contexto -> policy -> lock -> aplicar
+	void UpdateAgent(int32 Index, double Now);
+
+	// Venci el timer de cadencia del agente (lo llama su componente)
+	void MarkDecisionDue(int32 Index);
+
+	bool IsBatched() const { return bBatched; }
+	int32 GetNumAgents() const { return Agents.Num(); }
+
+	// === LOD
+	// Frames entre decisiones por nivel
+	UPROPERTY(Config, EditAnywhere, Category = "AI|LOD", meta = (ClampMin = "1")) int32 HighIntervalFrames = 1;
+	UPROPERTY(Config, EditAnywhere, Category = "AI|LOD", meta = (ClampMin = "1")) int32 MediumIntervalFrames = 3;
+	UPROPERTY(Config, EditAnywhere, Category = "AI|LOD", meta = (ClampMin = "1")) int32 LowIntervalFrames = 8;
+	// Relevancia mnima de cada nivel
+	UPROPERTY(Config, EditAnywhere, Category = "AI|LOD") float HighScore = 0.6f;
+	UPROPERTY(Config, EditAnywhere, Category = "AI|LOD") float MediumScore = 0.3f;
+	// Pesos de la relevancia; la cercana cae de 1 a 0 entre NearCells y FarCells
+	UPROPERTY(Config, EditAnywhere, Category = "AI|LOD") float PlayerWeight = 0.5f;
+	UPROPERTY(Config, EditAnywhere, Category = "AI|LOD") float BaseWeight = 0.4f;
+	UPROPERTY(Config, EditAnywhere, Category = "AI|LOD") float VisibleWeight = 0.15f;
+	UPROPERTY(Config, EditAnywhere, Category = "AI|LOD") float ThreatWeight = 0.6f;
+	UPROPERTY(Config, EditAnywhere, Category = "AI|LOD") float NearCells = 5.f;
+	UPROPERTY(Config, EditAnywhere, Category = "AI|LOD") float FarCells = 24.f;
+	// Decisiones mximas por frame (0 = sin lmite)
+	UPROPERTY(Config, EditAnywhere, Category = "AI|LOD", meta = (ClampMin = "0")) int32 MaxDecisionsPerFrame = 48;
+	// Agentes previstos: se reservan de antemano sus timers de cadencia y sus arrays
+	UPROPERTY(Config, EditAnywhere, Category = "AI|LOD", meta = (ClampMin = "0")) int32 MaxAgents = 256;
+
+	FEnemyAIAgents& GetAgents() { return Agents; }
+	const FEnemyAIAgents& GetAgents() const { return Agents; }
+
+	void TickAgents(float DeltaTime);
+
+	// bc.ai.objstats: GC completo cronometrado y UObjects por enemigo
+	void LogObjectStats();
+
+#if BC_AI_ALLOC_COUNT
+	// Mide las reservas de memoria de cada fase durante los prximos Ticks ticks por lotes
+	void StartAllocCount(int32 Ticks);
+	// Con -bcaialloccount en la lnea de comandos envuelve GMalloc en el contador. Slo al arrancar
+	// el mdulo, antes de que haya hilos reservando: queda instalado hasta salir.
+	static void InstallAllocCounter();
+#endif
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	void SetBatched(bool bInBatched);
+	void ResetDecision(int32 Index);
+
+	// Relevancia y nivel de todos los agentes; avisa a la policy si cambia
+	void UpdateLOD();
+	int32 GetIntervalFrames(EEnemyAILOD InTier) const;
+	// Agentes que deciden este frame, en orden de agente
+	void SelectDueAgents(bool bUseLOD);
+	// Timer de cadencia en bucle con el periodo del nivel; slo se rearma al registrar o si cambia
+	// el nivel o su periodo (decidir no toca la rueda)
+	void RescheduleDecision(int32 Index);
+	void CancelDecisionTimer(int32 Index);
+	// AIAgentIndex de los componentes desde Index (tras compactar)
+	void RenumberAgentsFrom(int32 Index);
+
+	TArray<int32> DueAgents;
+	uint32 FrameCounter = 0;
+	int32 RoundRobinCursor = 0;
+	uint32 RegisterSerial = 0;
+	TWeakObjectPtr<UMapGridSubsystem> Grid;
+	TWeakObjectPtr<UProjectileLaneSubsystem> Lanes;
+	TWeakObjectPtr<UGameplayTimerSubsystem> Timers;
+
+	// ndices del frame por fase (se reutilizan)
+	TArray<int32> ParallelAgents;
+	TArray<int32> SerialAgents;
+
+#if BC_AI_ALLOC_COUNT
+	void FinishAllocCountTick();
+	int32 AllocCountTicks = 0;
+	int32 AllocCountTicksLeft = 0;
+	int64 AllocCountAgentTicks = 0;
+#endif
+
+	UPROPERTY(Transient) TArray<TObjectPtr<UEnemyMovePolicy>> SharedPolicies;
+
+	FEnemyAIAgents Agents;
+	FEnemyAITickFunction TickFunction;
+	bool bBatched = true;
+};
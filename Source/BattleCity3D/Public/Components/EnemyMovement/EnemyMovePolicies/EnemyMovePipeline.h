@@ -0,0 +1,85 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "EnemyMovePolicy.h"
+
+namespace EnemyMovePipeline
+{
+	// Orden previa a una etapa: tras ella se mezcla (lo usan Composite y los pipelines nativos)
+	struct FPrevMove
+	{
+		FVector2D Input;
+		EMoveLockAxis LockAxis;
+		float LockTime;
+		bool bShot;
+	};
+
+	FORCEINLINE FPrevMove Save(const FMoveDecision& Out)
+	{
+		return { Out.RawMoveInput, Out.LockAxis, Out.LockTime, Out.bRequestFrontShot };
+	}
+
+	// Mezcla: priorizamos campos no triviales del ltimo que habl
+	FORCEINLINE void Merge(FMoveDecision& Out, const FPrevMove& Prev)
+	{
+		if (Out.RawMoveInput.IsNearlyZero()) Out.RawMoveInput = Prev.Input;
+		if (Out.LockAxis == EMoveLockAxis::None) { Out.LockAxis = Prev.LockAxis; Out.LockTime = Prev.LockTime; }
+		Out.bRequestFrontShot |= Prev.bShot;
+	}
+}
+
+/**
+ * Cadena de policies nativas fijada en compilacin: misma mezcla que Composite (bStartFromEmpty)
+ * pero sin TArray ni despacho virtual por etapa. Cada etapa se llama con su clase exacta
+ * (Stage->TStage::ComputeMove), as que una subclase C++ puesta en su hueco no cambia la llamada.
+ * Los huecos nulos se saltan, como en Composite.
+ */
+template<typename... TStages>
+struct TEnemyMovePipeline
+{
+	static void ComputeMove(const FMoveContext& Ctx, FMoveDecision& Out, TStages*... Stages)
+	{
+		Out.Reset();
+		(RunStage(Stages, Ctx, Out), ...);
+	}
+
+	static bool IsParallelSafe(const TStages*... Stages)
+	{
+		return ((!Stages || Stages->TStages::IsParallelSafe()) && ...);
+	}
+
+	static void PrepareParallel(TStages*... Stages)
+	{
+		((Stages ? Stages->TStages::PrepareParallel() : void()), ...);
+	}
+
+	static void Initialize(UWorld* World, TStages*... Stages)
+	{
+		((Stages ? Stages->TStages::Initialize(World) : void()), ...);
+	}
+
+	static int32 LayoutState(int32 Offset, TStages*... Stages)
+	{
+		((Offset = Stages ? Stages->TStages::LayoutState(Offset) : Offset), ...);
+		return Offset;
+	}
+
+	static void ConstructState(FEnemyMoveAgent& Agent, const TStages*... Stages)
+	{
+		((Stages ? Stages->TStages::ConstructState(Agent) : void()), ...);
+	}
+
+	static void DestroyState(FEnemyMoveAgent& Agent, const TStages*... Stages)
+	{
+		((Stages ? Stages->TStages::DestroyState(Agent) : void()), ...);
+	}
+
+private:
+	template<typename TStage>
+	static FORCEINLINE void RunStage(TStage* Stage, const FMoveContext& Ctx, FMoveDecision& Out)
+	{
+		if (!Stage) return;
+		const EnemyMovePipeline::FPrevMove Prev = EnemyMovePipeline::Save(Out);
+		Stage->TStage::ComputeMove(Ctx, Out);
+		EnemyMovePipeline::Merge(Out, Prev);
+	}
+};
@@ -5,10 +5,86 @@
 
 class UEnemyMovementComponent;
 class UMapGridSubsystem;
+class AEnemyPawn;
 
 UENUM()
 enum class EMoveLockAxis : uint8 { None, X, Y };
 
+// Nivel de detalle de la IA (UEnemyAIManager): cada cunto decide y con qu calidad planifica
+UENUM()
+enum class EEnemyAILOD : uint8 { High, Medium, Low };
+
+// Traza de depuracin de la decisin: etiquetas fijas en vez de texto, fuera en Shipping
+#define BC_AI_DEBUG_TRACE !UE_BUILD_SHIPPING
+
+enum class EMoveDebugTag : uint8
+{
+    None,
+    StopShootFrontBrick, GoX, GoY, FallbackX, FallbackY, KeepX, KeepY, MajorX, MajorY, BlockedWait,
+    PathFollow, PathFollowWait, PathFollowSquadWait,
+    WanderFar, ShootCheck, Dodge, DodgeShoot,
+};
+
+struct BATTLECITY3D_API FMoveDebugTrace
+{
+#if BC_AI_DEBUG_TRACE
+    static constexpr int32 MaxTags = 8;
+    EMoveDebugTag Tags[MaxTags];
+    uint8 Num = 0;
+
+    void Add(EMoveDebugTag Tag) { if (Num < MaxTags) Tags[Num++] = Tag; }
+    void Reset() { Num = 0; }
+    // Slo para logs/pantalla, nunca en el tick
+    FString ToString() const;
+#else
+    FORCEINLINE void Add(EMoveDebugTag) {}
+    FORCEINLINE void Reset() {}
+    FString ToString() const { return FString(); }
+#endif
+};
+
+// Agente que usa una policy (no es UObject, vive en el MovementComponent). Las policies son
+// compartidas: lo que cambia por enemigo va en State, un bloque del pool de la policy raz.
+struct BATTLECITY3D_API FEnemyMoveAgent
+{
+    UEnemyMovementComponent* Component = nullptr;
+    AEnemyPawn* Pawn = nullptr;
+    // Nivel de LOD que fija UEnemyAIManager
+    EEnemyAILOD LODTier = EEnemyAILOD::High;
+    uint8* State = nullptr;
+};
+
+// Bloques de tamao fijo en trozos (las direcciones no cambian) con lista libre
+struct BATTLECITY3D_API FEnemyMoveStatePool
+{
+    ~FEnemyMoveStatePool();
+
+    void SetBlockSize(int32 InSize) { check(Chunks.Num() == 0); BlockSize = Align(FMath::Max(InSize, 1), 16); }
+    uint8* Allocate();
+    void Free(uint8* Block);
+
+    int32 GetNumLive() const { return NumLive; }
+    int64 GetReservedBytes() const { return (int64)Chunks.Num() * BlocksPerChunk * BlockSize; }
+
+private:
+    static constexpr int32 BlocksPerChunk = 32;
+    int32 BlockSize = 0;
+    int32 NumLive = 0;
+    TArray<uint8*> Chunks;
+    TArray<uint8*> FreeList;
+};
+
+// Consultas al grid que el MovementComponent ofrece a las policies. FMoveContext slo guarda un
+// puntero (no posee nada, sin capturas ni memoria dinmica).
+class BATTLECITY3D_API FEnemyMoveQueries
+{
+public:
+    virtual ~FEnemyMoveQueries() = default;
+    virtual bool IsAheadBlocked(bool bAxisX, int Dir, float DistWorld) const = 0;
+    virtual uint8 QueryFrontObstacle(float MaxDistanceWorld, FVector* OutHitWorld) const = 0; // 0=None,1=Brick,2=Steel
+    virtual uint8 CheckCardinalLineToTarget(const FVector& From, const FVector& To, FVector* OutFirstHitWorld) const = 0; // 0=NotCardinal,1=Clear,2=Brick,3=Steel
+};
+
 USTRUCT(BlueprintType)
 struct FMoveContext
 {
@@ -21,14 +97,24 @@ struct FMoveContext
     UPROPERTY(BlueprintReadOnly) float AlignEpsilon = 50.f;
     UPROPERTY(BlueprintReadOnly) float TieDeadband = 20.f;
     UPROPERTY(BlueprintReadOnly) int32 LookAheadTiles = 1;
+    UPROPERTY(BlueprintReadOnly) float MinLockTime = 0.3f;
+    UPROPERTY(BlueprintReadOnly) bool bPreferShootWhenFrontBrick = true;
 
     // Estado
     UPROPERTY(BlueprintReadOnly) bool bFireReady = false;
+    // Tiempo de mundo al construir el contexto
+    UPROPERTY(BlueprintReadOnly) double Now = 0.0;
+
+    // Agente y su bloque de estado (las policies compartidas no guardan nada por enemigo)
+    FEnemyMoveAgent* Agent = nullptr;
 
     // Consultas (implementadas por el MovementComponent)
-    TFunction<bool(bool /*bAxisX*/, int /*Dir*/, float /*DistWorld*/)> IsAheadBlocked;
-    TFunction<uint8(float /*DistWorld*/, FVector* /*OutHitWorld*/)>     FrontObstacle; // 0=None,1=Brick,2=Steel
-    TFunction<uint8(const FVector& /*From*/, const FVector& /*To*/, FVector* /*OutFirstHit*/)> CardinalLineToTarget; // 0=NotCardinal,1=Clear,2=Brick,3=Steel
+    const FEnemyMoveQueries* Queries = nullptr;
+
+    bool HasQueries() const { return Queries != nullptr; }
+    bool IsAheadBlocked(bool bAxisX, int Dir, float DistWorld) const { return Queries && Queries->IsAheadBlocked(bAxisX, Dir, DistWorld); }
+    uint8 FrontObstacle(float DistWorld, FVector* OutHitWorld) const { return Queries ? Queries->QueryFrontObstacle(DistWorld, OutHitWorld) : 0; }
+    uint8 CardinalLineToTarget(const FVector& From, const FVector& To, FVector* OutFirstHit) const { return Queries ? Queries->CheckCardinalLineToTarget(From, To, OutFirstHit) : 0; }
 };
 
 USTRUCT(BlueprintType)
@@ -39,19 +125,59 @@ struct FMoveDecision
     UPROPERTY(BlueprintReadWrite) EMoveLockAxis LockAxis = EMoveLockAxis::None;
     UPROPERTY(BlueprintReadWrite) float LockTime = 0.f;
     UPROPERTY(BlueprintReadWrite) bool bRequestFrontShot = false; // pedir disparo frontal este tick
-    UPROPERTY(BlueprintReadWrite) FString DebugText;
+    FMoveDebugTrace Debug;
+
+    // Limpia la orden sin tocar la traza (Composite la acumula)
+    void ResetMove()
+    {
+        RawMoveInput = FVector2D::ZeroVector;
+        LockAxis = EMoveLockAxis::None;
+        LockTime = 0.f;
+        bRequestFrontShot = false;
+    }
+    void Reset() { ResetMove(); Debug.Reset(); }
 };
 
+// La policy slo guarda configuracin y dependencias del mundo: UEnemyAIManager comparte una
+// instancia por clase y configuracin entre todos los enemigos. Lo que cambia por enemigo va en
+// un struct de estado (LayoutState / ConstructState / DestroyState) dentro del bloque del agente.
 UCLASS(Abstract, Blueprintable, EditInlineNew, DefaultToInstanced)
 class BATTLECITY3D_API UEnemyMovePolicy : public UObject
 {
     GENERATED_BODY()
 public:
-    virtual void Initialize(UEnemyMovementComponent* InOwner);
+    // Una vez por instancia (hilo de juego): resolver subsistemas
+    virtual void Initialize(UWorld* World) {}
     virtual void ComputeMove(const FMoveContext& Ctx, FMoveDecision& Out) PURE_VIRTUAL(UEnemyMovePolicy::ComputeMove, );
 
     virtual bool BuildCandidateOrder(UMapGridSubsystem* Grid, TArray<FIntPoint>& Out);
 
+    // true si ComputeMove slo lee estado compartido (grid, subsistemas) y escribe el del agente:
+    // UEnemyAIManager la evala entonces en paralelo. Por defecto en serie, en el hilo de juego.
+    virtual bool IsParallelSafe() const { return false; }
+    // Hilo de juego, justo antes de la fase paralela: poner al da lo que se calcula bajo demanda
+    virtual void PrepareParallel() {}
+
+    // Estado por agente: reserva su hueco a partir de Offset y devuelve el final
+    virtual int32 LayoutState(int32 Offset) { return Offset; }
+    virtual void ConstructState(FEnemyMoveAgent& Agent) const {}
+    virtual void DestroyState(FEnemyMoveAgent& Agent) const {}
+
+    // Slo en la policy raz: bloque de estado del agente desde el pool
+    void AcquireAgentState(FEnemyMoveAgent& Agent);
+    void ReleaseAgentState(FEnemyMoveAgent& Agent);
+    const FEnemyMoveStatePool& GetStatePool() const { return StatePool; }
+    int32 GetStateSize() const { return StateSize; }
+
 protected:
-    UPROPERTY(Transient) TWeakObjectPtr<UEnemyMovementComponent> Owner;
+    template<typename T> int32 LayoutStateAs(int32 Offset) { StateOffset = Align(Offset, (int32)alignof(T)); return StateOffset + (int32)sizeof(T); }
+    template<typename T> void ConstructStateAs(FEnemyMoveAgent& Agent) const { new (Agent.State + StateOffset) T(); }
+    template<typename T> void DestroyStateAs(FEnemyMoveAgent& Agent) const { reinterpret_cast<T*>(Agent.State + StateOffset)->~T(); }
+    template<typename T> T& StateOf(const FEnemyMoveAgent& Agent) const { return *reinterpret_cast<T*>(Agent.State + StateOffset); }
+    template<typename T> T* GetState(const FMoveContext& Ctx) const { return (Ctx.Agent && Ctx.Agent->State) ? reinterpret_cast<T*>(Ctx.Agent->State + StateOffset) : nullptr; }
+
+private:
+    int32 StateOffset = 0;
+    int32 StateSize = INDEX_NONE;
+    FEnemyMoveStatePool StatePool;
 };
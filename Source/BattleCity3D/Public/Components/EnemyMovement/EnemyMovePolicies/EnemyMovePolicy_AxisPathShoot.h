@@ -0,0 +1,35 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "EnemyMovePolicy.h"
+#include "EnemyMovePipeline.h"
+#include "EnemyMovePolicy_GridAxisLock.h"
+#include "EnemyMovePolicy_PathFollow.h"
+#include "EnemyMovePolicy_ShootWhenBlocking.h"
+#include "EnemyMovePolicy_AxisPathShoot.generated.h"
+
+// Pipeline nativo GridAxisLock -> PathFollow -> ShootWhenBlocking: mismo resultado que un Composite
+// con esas tres hijas, encadenado en compilacin (TEnemyMovePipeline). Para probar otras mezclas
+// sigue estando Composite; bc.ai.pipelinebench compara los dos.
+UCLASS(EditInlineNew, DefaultToInstanced, BlueprintType)
+class BATTLECITY3D_API UEnemyMovePolicy_AxisPathShoot : public UEnemyMovePolicy
+{
+	GENERATED_BODY()
+public:
+	UEnemyMovePolicy_AxisPathShoot();
+
+	UPROPERTY(EditAnywhere, Instanced, NoClear, Category = "Pipeline") TObjectPtr<UEnemyMovePolicy_GridAxisLock> AxisLock;
+	UPROPERTY(EditAnywhere, Instanced, NoClear, Category = "Pipeline") TObjectPtr<UEnemyMovePolicy_PathFollow> PathFollow;
+	UPROPERTY(EditAnywhere, Instanced, NoClear, Category = "Pipeline") TObjectPtr<UEnemyMovePolicy_ShootWhenBlocking> Shoot;
+
+	virtual void Initialize(UWorld* World) override;
+	virtual void ComputeMove(const FMoveContext& Ctx, FMoveDecision& Out) override;
+	virtual bool IsParallelSafe() const override;
+	virtual void PrepareParallel() override;
+
+	virtual int32 LayoutState(int32 Offset) override;
+	virtual void ConstructState(FEnemyMoveAgent& Agent) const override;
+	virtual void DestroyState(FEnemyMoveAgent& Agent) const override;
+
+private:
+	using FPipeline = TEnemyMovePipeline<UEnemyMovePolicy_GridAxisLock, UEnemyMovePolicy_PathFollow, UEnemyMovePolicy_ShootWhenBlocking>;
+};
@@ -14,6 +14,14 @@ public:
 	UPROPERTY(EditAnywhere, Category = "Policies")
 	bool bStartFromEmpty = true;
 
-	virtual void Initialize(UEnemyMovementComponent* InOwner) override;
+	virtual void Initialize(UWorld* World) override;
 	virtual void ComputeMove(const FMoveContext& Ctx, FMoveDecision& Out) override;
+	// En paralelo slo si todas las hijas lo admiten
+	virtual bool IsParallelSafe() const override;
+	virtual void PrepareParallel() override;
+
+	// El estado de las hijas va seguido en el bloque del agente
+	virtual int32 LayoutState(int32 Offset) override;
+	virtual void ConstructState(FEnemyMoveAgent& Agent) const override;
+	virtual void DestroyState(FEnemyMoveAgent& Agent) const override;
 };
@@ -0,0 +1,46 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "EnemyMovePolicy.h"
+#include "Components/GridPathFollow/GridPathTypes.h"
+#include "EnemyMovePolicy_Dodge.generated.h"
+
+class UMapGridSubsystem;
+class UProjectileLaneSubsystem;
+
+// Estado por agente de UEnemyMovePolicy_Dodge
+struct FEnemyDodgeState
+{
+	FVector2D DodgeInput = FVector2D::ZeroVector;
+	float DodgeUntil = -1.f;
+};
+
+// Esquiva: si una bala del jugador va a pasar por su celda, paso lateral a una celda fuera de la lnea
+// de fuego (o disparo de frente si no hay hueco). Sin amenaza no toca la decisin: va la ltima en un Composite.
+UCLASS(EditInlineNew, DefaultToInstanced, BlueprintType)
+class BATTLECITY3D_API UEnemyMovePolicy_Dodge : public UEnemyMovePolicy
+{
+	GENERATED_BODY()
+public:
+	// Reacciona si la bala llega a su celda antes de esto (s)
+	UPROPERTY(EditAnywhere, Category = "Dodge") float ReactSeconds = 0.35f;
+	// Tras decidir, mantiene el paso lateral este tiempo
+	UPROPERTY(EditAnywhere, Category = "Dodge") float CommitSeconds = 0.25f;
+	// Sin hueco lateral: dispara a la bala si viene de frente
+	UPROPERTY(EditAnywhere, Category = "Dodge") bool bShootIncoming = true;
+	// Celdas vlidas para apartarse (por defecto el ladrillo es muro)
+	UPROPERTY(EditAnywhere, Category = "Dodge") FGridCostProfile Cost = { 1.f, 1e9f, 1e9f };
+
+	virtual void Initialize(UWorld* World) override;
+	virtual void ComputeMove(const FMoveContext& Ctx, FMoveDecision& Out) override;
+	virtual bool IsParallelSafe() const override { return true; }
+
+	virtual int32 LayoutState(int32 Offset) override { return LayoutStateAs<FEnemyDodgeState>(Offset); }
+	virtual void ConstructState(FEnemyMoveAgent& Agent) const override { ConstructStateAs<FEnemyDodgeState>(Agent); }
+	virtual void DestroyState(FEnemyMoveAgent& Agent) const override { DestroyStateAs<FEnemyDodgeState>(Agent); }
+
+private:
+	UPROPERTY(Transient) TObjectPtr<UMapGridSubsystem> Grid = nullptr;
+	UPROPERTY(Transient) TObjectPtr<UProjectileLaneSubsystem> Lanes = nullptr;
+	// Cost compilado en Initialize (se consulta por celda vecina)
+	FGridCostLUT CostLut{ FGridCostProfile() };
+};
@@ -9,4 +9,5 @@ class BATTLECITY3D_API UEnemyMovePolicy_GridAxisLock : public UEnemyMovePolicy
     GENERATED_BODY()
 public:
     virtual void ComputeMove(const FMoveContext& Ctx, FMoveDecision& Out) override;
+    virtual bool IsParallelSafe() const override { return true; }
 };
@@ -2,12 +2,34 @@
 #include "CoreMinimal.h"
 #include "EnemyMovePolicy.h"
 #include "Components/GridPAthFollow/GridPathTypes.h"
+#include "Components/GridPathFollow/GridPathFollower.h"
 #include "EnemyMovePolicy_PathFollow.generated.h"
 
 class UGridPathManager;
-class UGridPathFollowComponent;
 class UMapGridSubsystem;
-class UEnemyMovementComponent;
+class FEnemySquad;
+
+// Estado por agente de UEnemyMovePolicy_PathFollow (ruta, plan cooperativo y escuadra)
+struct FEnemyPathFollowState
+{
+	FGridPathFollower Follower;
+
+	float LastReplanTime = -1000.f;
+	bool bHasPlanned = false;
+	FIntPoint LastGoalCell = FIntPoint(-999, -999);
+
+	// Plan cooperativo: CoopPlan[i] = celda en el tick CoopPlanTick + i
+	uint16 CoopAgent = 0;
+	TArray<FIntPoint> CoopPlan;
+	int64 CoopPlanTick = 0;
+	int64 CoopNextReplanTick = 0;
+
+	TSharedPtr<FEnemySquad> Squad;
+	uint32 SquadRouteVersion = 0;
+	float LastSquadCheckTime = -1000.f;
+	bool bFollowingSquad = false;
+	TArray<FIntPoint> SquadRoute;
+};
 
 UCLASS(EditInlineNew, DefaultToInstanced, BlueprintType)
 class BATTLECITY3D_API UEnemyMovePolicy_PathFollow : public UEnemyMovePolicy
@@ -23,21 +45,51 @@ public:
 	// Objetivo: true=jugador (parcial), false=base (completa). Usa Ctx.TargetWorld.
 	UPROPERTY(EditAnywhere, Category = "Goal") bool bTargetIsPlayer = true;
 
+	// Planner TurnAware: cada giro cuesta lo que el tanque pierde en TurnDelay + re-aceleracin
+	UPROPERTY(EditAnywhere, Category = "Path") bool bTurnAware = false;
+	UPROPERTY(EditAnywhere, Category = "Path", meta = (EditCondition = "bTurnAware", ClampMin = "0")) float TurnCostScale = 1.f;
+
+	// LOD del manager: ReplanInterval se multiplica por esto en Medium/Low; TurnAware slo en High
+	UPROPERTY(EditAnywhere, Category = "LOD", meta = (ClampMin = "1")) float MediumReplanScale = 2.f;
+	UPROPERTY(EditAnywhere, Category = "LOD", meta = (ClampMin = "1")) float LowReplanScale = 4.f;
+
+	// WHCA*: reserva sus prximos pasos en el PathMgr para no chocar con otros enemigos en pasillos
+	UPROPERTY(EditAnywhere, Category = "Cooperative") bool bCooperative = false;
+
+	// Escuadra (la asigna AEnemySpawner): distancia mnima al compaero de delante, en celdas
+	UPROPERTY(EditAnywhere, Category = "Squad") float SquadSpacingCells = 1.5f;
+	// Ms lejos que esto del rastro del lder (o con otra meta) el seguidor planifica solo
+	UPROPERTY(EditAnywhere, Category = "Squad") int32 SquadDivergeCells = 3;
+
 public:
-	virtual void Initialize(UEnemyMovementComponent* InOwner) override;
+	virtual void Initialize(UWorld* World) override;
 	virtual void ComputeMove(const FMoveContext& Ctx, FMoveDecision& Out) override;
 
+	virtual int32 LayoutState(int32 Offset) override { return LayoutStateAs<FEnemyPathFollowState>(Offset); }
+	virtual void ConstructState(FEnemyMoveAgent& Agent) const override { ConstructStateAs<FEnemyPathFollowState>(Agent); }
+	// Suelta la reserva cooperativa del agente
+	virtual void DestroyState(FEnemyMoveAgent& Agent) const override;
+
+	// Sin escuadra (nullptr) cada enemigo planifica su ruta; en modo cooperativo se ignora
+	void SetSquad(FEnemyMoveAgent& Agent, const TSharedPtr<FEnemySquad>& InSquad) const;
+
 private:
-	UPROPERTY(Transient) TWeakObjectPtr<UEnemyMovementComponent> EnemyMoveOwner;
-	UPROPERTY(Transient) TObjectPtr<UGridPathFollowComponent> Follower = nullptr;
 	UPROPERTY(Transient) TObjectPtr<UGridPathManager> PathMgr = nullptr;
 	UPROPERTY(Transient) TObjectPtr<UMapGridSubsystem> Grid = nullptr;
 
-	float LastReplanTime = -1000.f;
-	FIntPoint LastGoalCell = FIntPoint(-999, -999);
-
-	void EnsureDeps(const FMoveContext& Ctx);
 	bool TryWorldToGrid(const FVector& World, FIntPoint& OutCell) const;
-	void MaybeReplan(const FMoveContext& Ctx, const FIntPoint& StartCell, const FIntPoint& GoalCell);
+	void MaybeReplan(FEnemyPathFollowState& S, const FMoveContext& Ctx, const FIntPoint& StartCell, const FIntPoint& GoalCell) const;
+	void MaybeRefineNextSegment(FEnemyPathFollowState& S, const FMoveContext& Ctx, const FIntPoint& GoalCell) const;
+	// Rellena TurnCost y StartDir (orientacin actual del tanque) si bTurnAware
+	void ApplyTurnModel(const FMoveContext& Ctx, FGridPathRequest& Req) const;
+	// true si el plan cooperativo pide esperar este tick
+	bool UpdateCooperativePlan(FEnemyPathFollowState& S, const FMoveContext& Ctx, const FIntPoint& StartCell, const FIntPoint& GoalCell) const;
+	// Lder: publica su ruta. Seguidor: recorre la del lder; false si debe planificar solo
+	bool UpdateSquad(FEnemyPathFollowState& S, const FMoveContext& Ctx, const FIntPoint& StartCell, const FIntPoint& GoalCell) const;
+	// Seguidor a varias celdas del rastro: antepone a SquadRoute un A* corto hasta la celda de unin
+	bool BridgeToSquadRoute(FEnemyPathFollowState& S, const FIntPoint& StartCell) const;
+	// Evitacin local: el compaero de delante est demasiado cerca en la direccin de avance
+	bool IsBlockedBySquadmate(const FEnemyPathFollowState& S, const FMoveContext& Ctx) const;
+	void PublishToSquad(const FEnemyPathFollowState& S, const FMoveContext& Ctx, const FGridPathRef& Path, const FIntPoint& GoalCell) const;
 	static FVector2D ToCardinalInput(const FVector& DirWorld);
 };
\ No newline at end of file
@@ -4,6 +4,9 @@
 #include "Components/GridPathFollow/GridPathTypes.h"
 #include "EnemyMovePolicy_ShootWhenBlocking.generated.h"
 
+class UMapGridSubsystem;
+class UMapTopologySubsystem;
+
 UCLASS(EditInlineNew, DefaultToInstanced, BlueprintType)
 class BATTLECITY3D_API UEnemyMovePolicy_ShootWhenBlocking : public UEnemyMovePolicy
 {
@@ -14,8 +17,20 @@ public:
 	UPROPERTY(EditAnywhere, Category = "Brick")
 	FGridCostProfile Cost = { 1.f, 10.f, 1e9f };
 
+	// Enemigo sin ruta abierta a la base: slo rompe ladrillos de la brecha/corte mnimo de
+	// UMapTopologySubsystem, as todos concentran el fuego en vez de abrir cada uno su camino
+	UPROPERTY(EditAnywhere, Category = "Brick")
+	bool bOnlyBreachBricks = false;
+
+	virtual void Initialize(UWorld* World) override;
 	virtual void ComputeMove(const FMoveContext& Ctx, FMoveDecision& Out) override;
+	virtual bool IsParallelSafe() const override { return true; }
+	virtual void PrepareParallel() override;
 
 private:
+	UPROPERTY(Transient) TObjectPtr<UMapGridSubsystem> Grid = nullptr;
+	UPROPERTY(Transient) TObjectPtr<UMapTopologySubsystem> Topo = nullptr;
+
 	bool IsFrontBrick(const FMoveContext& Ctx) const;
+	bool IsBreachTarget(const FMoveContext& Ctx, const FVector& HitWorld) const;
 };
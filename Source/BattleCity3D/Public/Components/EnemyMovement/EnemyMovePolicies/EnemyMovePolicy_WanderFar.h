@@ -5,9 +5,19 @@
 #include "EnemyMovePolicy_WanderFar.generated.h"
 
 class UMapGridSubsystem;
-class UEnemyMovementComponent;
 class AEnemyPawn;
 
+// Estado por agente de UEnemyMovePolicy_WanderFar: tramo actual
+struct FEnemyWanderState
+{
+	int32 StepsLeft = 0;
+	FVector2D CurrentDir = FVector2D::ZeroVector;
+	double NextRechooseTime = 0.0;
+
+	// Aleatoriedad propia (no FMath::Rand global): igual resultado en serie o en paralelo
+	FRandomStream Rng;
+};
+
 UCLASS(EditInlineNew, DefaultToInstanced, BlueprintType)
 class BATTLECITY3D_API UEnemyMovePolicy_WanderFar : public UEnemyMovePolicy
 {
@@ -28,21 +38,20 @@ public:
 	UPROPERTY(EditAnywhere, Category = "Wander") FGridCostProfile Cost = { 1.f, 1e5f, 1e9f };
 
 public:
-	virtual void Initialize(UEnemyMovementComponent* InOwner) override;
+	virtual void Initialize(UWorld* World) override;
 	virtual void ComputeMove(const FMoveContext& Ctx, FMoveDecision& Out) override;
+	virtual bool IsParallelSafe() const override { return true; }
 
-private:
-	TWeakObjectPtr<UEnemyMovementComponent> MoveOwner;
-	TWeakObjectPtr<AEnemyPawn> Pawn;
-	TWeakObjectPtr<UMapGridSubsystem> Grid;
+	virtual int32 LayoutState(int32 Offset) override { return LayoutStateAs<FEnemyWanderState>(Offset); }
+	virtual void ConstructState(FEnemyMoveAgent& Agent) const override;
+	virtual void DestroyState(FEnemyMoveAgent& Agent) const override { DestroyStateAs<FEnemyWanderState>(Agent); }
 
-	// Estado de tramo actual
-	int32 StepsLeft = 0;
-	FVector2D CurrentDir = FVector2D::ZeroVector;
-	double NextRechooseTime = 0.0;
+private:
+	UPROPERTY(Transient) TObjectPtr<UMapGridSubsystem> Grid = nullptr;
+	// Cost compilado en Initialize (se consulta por celda vecina)
+	FGridCostLUT CostLut{ FGridCostProfile() };
 
-	bool IsHuntPlayer() const; // lee Goal del Pawn
 	bool IsPassableAhead(const FIntPoint& From, const FVector2D& Dir) const;
-	int  ScoreDir(const FIntPoint& From, const FVector2D& Dir, const FIntPoint& GoalCell) const;
-	void ChooseNewDir(const FMoveContext& Ctx, const FIntPoint& FromCell, const FIntPoint& GoalCell);
-};
+	int  ScoreDir(FEnemyWanderState& S, const FIntPoint& From, const FVector2D& Dir, const FIntPoint& GoalCell) const;
+	void ChooseNewDir(FEnemyWanderState& S, const FMoveContext& Ctx, const FIntPoint& FromCell, const FIntPoint& GoalCell) const;
+};
\ No newline at end of file
@@ -1,23 +1,27 @@
 #pragma once
 #include "CoreMinimal.h"
 #include "Components/EnemyMovement/EnemyMovePolicies/EnemyMovePolicy.h"
+#include "Common/GameplayTimerWheel.h"
 #include "Components/ActorComponent.h"
 #include "EnemyMovementComponent.generated.h"
 
 class AEnemyPawn;
 class UMapGridSubsystem;
 class UEnemyMovePolicy;
+class UEnemyAIManager;
 
 static int32 Sign01(float V) { return (V > 0.f) ? +1 : (V < 0.f) ? -1 : 0; }
 
 UCLASS(ClassGroup = (Custom), meta = (BlueprintSpawnableComponent))
-class BATTLECITY3D_API UEnemyMovementComponent : public UActorComponent
+class BATTLECITY3D_API UEnemyMovementComponent : public UActorComponent, public FEnemyMoveQueries, public FGameplayTimerTarget
 {
     GENERATED_BODY()
 public:
     UEnemyMovementComponent();
 
     // === Policy Class + Instance (patrn robusto para editor)
+    // En juego la instancia inline (o el CDO de la clase) es slo la configuracin: en BeginPlay
+    // MovePolicy pasa a apuntar a la compartida de UEnemyAIManager (bc.ai.sharedpolicies)
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Move|Policy")
     TSubclassOf<UEnemyMovePolicy> MovePolicyClass;
 
@@ -38,17 +42,34 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Move") UMapGridSubsystem* GetGrid() const;
     UFUNCTION(BlueprintCallable, Category = "Move") AEnemyPawn* GetPawn() const { return CachedPawn.Get(); }
 
-    // Helpers consultables por policies
-    bool IsAheadBlocked(bool bAxisX, int Dir, float DistWorld) const;
-    uint8 QueryFrontObstacle(float MaxDistanceWorld, FVector* OutHitWorld = nullptr) const; // 0=None,1=Brick,2=Steel
-    uint8 CheckCardinalLineToTarget(const FVector& From, const FVector& To, FVector* OutFirstHitWorld = nullptr) const; // 0=NotCardinal,1=Clear,2=Brick,3=Steel
+    // Helpers consultables por policies (FEnemyMoveQueries, va FMoveContext::Queries)
+    virtual bool IsAheadBlocked(bool bAxisX, int Dir, float DistWorld) const override;
+    virtual uint8 QueryFrontObstacle(float MaxDistanceWorld, FVector* OutHitWorld = nullptr) const override; // 0=None,1=Brick,2=Steel
+    virtual uint8 CheckCardinalLineToTarget(const FVector& From, const FVector& To, FVector* OutFirstHitWorld = nullptr) const override; // 0=NotCardinal,1=Clear,2=Brick,3=Steel
     bool  IsFireReady() const;
 
     // Aplicacin de decisin
     void  ApplyDecision(const FMoveDecision& D);
 
+    // Configuracin de policy preparada fuera (el spawner, una por clase y tipo) en vez de la propia.
+    // Antes de BeginPlay (SpawnActorDeferred) el componente slo se enlaza una vez.
+    void  SetPolicyConfig(UEnemyMovePolicy* Config);
+    // Configuracin propia: la instancia inline o el CDO de MovePolicyClass (GridAxisLock por defecto)
+    UEnemyMovePolicy* GetPolicyConfig() const;
+    // Agente y bloque de estado de la policy (para SetSquad y similares)
+    FEnemyMoveAgent& GetMoveAgent() { return MoveAgent; }
+
+    // Paso de IA (lo llama UEnemyAIManager): contexto del frame y lock de eje sobre la decisin
+    void  BuildMoveContext(FMoveContext& Ctx) const;
+    void  ApplyAxisLock(FMoveDecision& D, double Now);
+    int32 GetAIAgentIndex() const { return AIAgentIndex; }
+
+    // Timer de cadencia del manager (rueda de frames de UGameplayTimerSubsystem)
+    virtual void OnGameplayTimer(uint32 Payload) override;
+
     // Tick
     virtual void BeginPlay() override;
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
     virtual void TickComponent(float /*DT*/, enum ELevelTick /*TickType*/, FActorComponentTickFunction* /*ThisTickFunction*/) override;
 
 #if WITH_EDITOR
@@ -59,12 +80,21 @@ private:
     TWeakObjectPtr<AEnemyPawn>        CachedPawn;
     TWeakObjectPtr<UMapGridSubsystem> CachedGrid;
 
-    FVector2D LastFacingDir = FVector2D(1.f, 0.f);
+    // Facing y lock viven en el SoA del manager (FEnemyAIAgents); aqu slo el ndice
+    UPROPERTY(Transient) TObjectPtr<UEnemyAIManager> AIManager = nullptr;
+    int32 AIAgentIndex = INDEX_NONE;
+    friend class UEnemyAIManager;
+
+    // Estado de este enemigo para la policy (compartida o no)
+    FEnemyMoveAgent MoveAgent;
+
+    // SetPolicyConfig
+    UPROPERTY(Transient) TObjectPtr<UEnemyMovePolicy> ConfigOverride = nullptr;
 
-    // Estado de lock
-    EMoveLockAxis AxisLock = EMoveLockAxis::None;
-    double        LockUntilTime = 0.0;
+    FVector2D GetLastFacingDir() const;
 
     float GetTileSizeSafe() const;
     void  EnsurePolicy();
+    void  BindPolicy(UEnemyMovePolicy* Config);
+    void  ReleasePolicyState();
 };
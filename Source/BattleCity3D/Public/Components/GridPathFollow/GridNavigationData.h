@@ -0,0 +1,80 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "NavigationData.h"
+#include "GridPathTypes.h"
+#include "GridNavigationData.generated.h"
+
+class UMapGridSubsystem;
+class UGridPathManager;
+
+/**
+ * NavigationData sobre el grid lgico: AAIController::MoveTo, EQS y Behavior Trees sin navmesh.
+ * No genera nada (el grid ya es el "navmesh"): FindPath delega en UGridPathManager y convierte
+ * las celdas a FNavPathPoints (slo esquinas; NodeRef = ndice de celda).
+ * Un cambio de celda (ladrillo destruido) invalida slo las rutas activas que pasan cerca,
+ * que se recalculan solas va RequestRePath. Slo consultas sncronas (el manager no es thread-safe).
+ */
+UCLASS(NotPlaceable, Transient)
+class BATTLECITY3D_API AGridNavigationData : public ANavigationData
+{
+	GENERATED_BODY()
+public:
+	AGridNavigationData(const FObjectInitializer& ObjectInitializer = FObjectInitializer::Get());
+
+	// Spawnea (si no existe) y registra la instancia del mundo. La llama AMapGenerator tras cargar el grid.
+	static AGridNavigationData* EnsureForWorld(UWorld* World);
+
+	// Costes de las consultas. La IA estndar no dispara: por defecto el ladrillo es muro.
+	UPROPERTY(EditAnywhere, Category = "GridNav")
+	FGridCostProfile CostProfile;
+
+	// Rutas activas a esta distancia (celdas) de un cambio se invalidan y se recalculan
+	UPROPERTY(EditAnywhere, Category = "GridNav", meta = (ClampMin = "0"))
+	int32 InvalidationRadiusCells = 2;
+
+	// ANavigationData
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+	virtual FBox GetBounds() const override;
+
+	virtual FNavLocation GetRandomPoint(FSharedConstNavQueryFilter Filter = nullptr, const UObject* Querier = nullptr) const override;
+	virtual bool GetRandomReachablePointInRadius(const FVector& Origin, float Radius, FNavLocation& OutResult, FSharedConstNavQueryFilter Filter = nullptr, const UObject* Querier = nullptr) const override;
+	virtual bool GetRandomPointInNavigableRadius(const FVector& Origin, float Radius, FNavLocation& OutResult, FSharedConstNavQueryFilter Filter = nullptr, const UObject* Querier = nullptr) const override;
+
+	virtual bool ProjectPoint(const FVector& Point, FNavLocation& OutLocation, const FVector& Extent, FSharedConstNavQueryFilter Filter = nullptr, const UObject* Querier = nullptr) const override;
+	virtual void BatchProjectPoints(TArray<FNavigationProjectionWork>& Workload, const FVector& Extent, FSharedConstNavQueryFilter Filter = nullptr, const UObject* Querier = nullptr) const override;
+	virtual void BatchProjectPoints(TArray<FNavigationProjectionWork>& Workload, FSharedConstNavQueryFilter Filter = nullptr, const UObject* Querier = nullptr) const override;
+	virtual void BatchRaycast(TArray<FNavigationRaycastWork>& Workload, FSharedConstNavQueryFilter QueryFilter, const UObject* Querier = nullptr) const override;
+
+	virtual ENavigationQueryResult::Type CalcPathCost(const FVector& PathStart, const FVector& PathEnd, FVector::FReal& OutPathCost, FSharedConstNavQueryFilter QueryFilter = nullptr, const UObject* Querier = nullptr) const override;
+	virtual ENavigationQueryResult::Type CalcPathLength(const FVector& PathStart, const FVector& PathEnd, FVector::FReal& OutPathLength, FSharedConstNavQueryFilter QueryFilter = nullptr, const UObject* Querier = nullptr) const override;
+	virtual ENavigationQueryResult::Type CalcPathLengthAndCost(const FVector& PathStart, const FVector& PathEnd, FVector::FReal& OutPathLength, FVector::FReal& OutPathCost, FSharedConstNavQueryFilter QueryFilter = nullptr, const UObject* Querier = nullptr) const override;
+	virtual bool DoesNodeContainLocation(NavNodeRef NodeRef, const FVector& WorldSpaceLocation) const override;
+
+	// Implementaciones estticas que usa ANavigationData (FindPathImplementation, etc.)
+	static FPathFindingResult FindPath(const FNavAgentProperties& AgentProperties, const FPathFindingQuery& Query);
+	static bool TestPath(const FNavAgentProperties& AgentProperties, const FPathFindingQuery& Query, int32* NumVisitedNodes);
+	static bool Raycast(const ANavigationData* NavData, const FVector& RayStart, const FVector& RayEnd, FVector& HitLocation,
+		FNavigationRaycastAdditionalResults* AdditionalResults, FSharedConstNavQueryFilter QueryFilter, const UObject* Querier);
+
+private:
+	UMapGridSubsystem* GetGrid() const;
+	UGridPathManager* GetPathManager() const;
+
+	// Lut: CostProfile compilado una vez por consulta
+	bool IsNavigableCell(const UMapGridSubsystem& Grid, const FGridCostLUT& Lut, const FIntPoint& Cell) const;
+	FVector CellToWorld(const UMapGridSubsystem& Grid, const FIntPoint& Cell, float Z) const;
+	NavNodeRef CellToNodeRef(const UMapGridSubsystem& Grid, const FIntPoint& Cell) const { return (NavNodeRef)(Cell.X + Cell.Y * Grid.GetWidth()); }
+
+	// Celda navegable ms cercana a Point dentro de Extent (XY)
+	bool ProjectToCell(const UMapGridSubsystem& Grid, const FGridCostLUT& Lut, const FVector& Point, const FVector& Extent, FIntPoint& OutCell) const;
+
+	// Esquinas de la ruta completa (tramos HPA* ya refinados) entre dos posiciones de mundo
+	bool ComputeGridPath(const FVector& From, const FVector& To, bool bAllowPartial, TArray<FIntPoint>& OutCorners, float& OutCost, bool& bOutReachedGoal) const;
+	// Esquinas -> puntos de ruta (Start, esquinas, End si se alcanz)
+	void BuildPathPoints(const UMapGridSubsystem& Grid, const TArray<FIntPoint>& Corners, const FVector& Start, const FVector& End, bool bReachedGoal, TArray<FNavPathPoint>& OutPoints) const;
+	ENavigationQueryResult::Type CalcLengthAndCost(const FVector& PathStart, const FVector& PathEnd, FVector::FReal* OutLength, FVector::FReal* OutCost) const;
+
+	void HandleGridCellChanged(FIntPoint Cell);
+	FDelegateHandle CellChangedHandle;
+};
@@ -0,0 +1,69 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "GridPathTypes.h"
+
+class UMapGridSubsystem;
+
+/**
+ * Ruta inmutable compartida (la sirve la cach de UGridPathManager a varios enemigos).
+ * Codificacin compacta: celda inicial + runs de 1 byte (2 bits direccin N/E/S/O, 6 bits longitud-1).
+ * Las esquinas (celdas donde cambia la direccin, ms inicio y fin) se precalculan en mundo
+ * al construirla, as el seguidor no convierte grid->mundo en cada tick. El tamao real
+ * (GetAllocatedSize) lo mide bc.path.bench por consulta.
+ */
+struct BATTLECITY3D_API FGridPath
+{
+	// Cells debe ser contiguo en cardinal (repetir celda = esperar) y dentro del grid; si no
+	// (o vaco, o sin Grid) la ruta sale vaca e invlida.
+	static TSharedRef<FGridPath, ESPMode::ThreadSafe> Make(TConstArrayView<FIntPoint> Cells, const UMapGridSubsystem* Grid);
+	static TSharedRef<FGridPath, ESPMode::ThreadSafe> FromResult(const FGridPathResult& R, const UMapGridSubsystem* Grid);
+
+	void ToResult(FGridPathResult& Out) const;
+	void Decode(TArray<FIntPoint>& OutCells) const;
+
+	// Recorre todas las celdas (incluida la inicial) sin descomprimir a un array
+	template<typename FVisit>
+	void ForEachCell(FVisit&& Visit) const
+	{
+		if (NumCells == 0) return;
+		FIntPoint C = StartCell;
+		Visit(C);
+		for (uint8 Run : Runs)
+		{
+			const FIntPoint D = RunDir(Run);
+			for (int32 i = RunLen(Run); i > 0; --i) { C += D; Visit(C); }
+		}
+	}
+
+	bool IsValid() const { return NumCells > 0; }
+	int32 GetNumCells() const { return NumCells; }
+	FIntPoint GetStartCell() const { return StartCell; }
+	FIntPoint GetEndCell() const { return CornerCells.Num() > 0 ? CornerCells.Last() : StartCell; }
+
+	const TArray<FIntPoint>& GetCornerCells() const { return CornerCells; }
+	const TArray<FVector>& GetCornersWorld() const { return CornersWorld; }
+
+	SIZE_T GetAllocatedSize() const
+	{
+		return sizeof(FGridPath) + Runs.GetAllocatedSize() + CornerCells.GetAllocatedSize()
+			+ CornersWorld.GetAllocatedSize() + PendingWaypoints.GetAllocatedSize();
+	}
+
+	// HPA*: waypoints an sin refinar (ver FGridPathResult)
+	TArray<FIntPoint> PendingWaypoints;
+	float TotalCost = 0.f;
+	bool bReachedGoal = false;
+
+private:
+	FIntPoint StartCell = FIntPoint::ZeroValue;
+	int32 NumCells = 0;
+	TArray<uint8> Runs;
+	TArray<FIntPoint> CornerCells;
+	TArray<FVector> CornersWorld;
+
+	static FIntPoint RunDir(uint8 Run);
+	static int32 RunLen(uint8 Run) { return (Run & 0x3F) + 1; }
+	void AppendStep(int32 Dir);
+};
+
+typedef TSharedPtr<const FGridPath, ESPMode::ThreadSafe> FGridPathRef;
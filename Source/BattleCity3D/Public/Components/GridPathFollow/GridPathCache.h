@@ -0,0 +1,90 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "GridPathTypes.h"
+#include "GridPath.h"
+
+// Clave de cach: todo lo que determina el resultado de ComputePath.
+struct FGridPathCacheKey
+{
+	FIntPoint Start = FIntPoint::ZeroValue;
+	FIntPoint Goal = FIntPoint::ZeroValue;
+	uint32 CostHash = 0;
+	uint32 LayoutVersion = 0;
+	int32 MaxSteps = 0;
+	int32 MaxExpansions = 0;
+	uint8 Planner = 0;
+	bool bAllowPartial = true;
+
+	bool operator==(const FGridPathCacheKey& O) const
+	{
+		return Start == O.Start && Goal == O.Goal && CostHash == O.CostHash && LayoutVersion == O.LayoutVersion
+			&& MaxSteps == O.MaxSteps && MaxExpansions == O.MaxExpansions && Planner == O.Planner && bAllowPartial == O.bAllowPartial;
+	}
+
+	friend uint32 GetTypeHash(const FGridPathCacheKey& K)
+	{
+		uint32 H = HashCombine(GetTypeHash(K.Start), GetTypeHash(K.Goal));
+		H = HashCombine(H, K.CostHash);
+		H = HashCombine(H, K.LayoutVersion);
+		H = HashCombine(H, GetTypeHash(K.MaxSteps));
+		H = HashCombine(H, GetTypeHash(K.MaxExpansions));
+		return HashCombine(H, (uint32)K.Planner | ((uint32)K.bAllowPartial << 8));
+	}
+};
+
+/**
+ * LRU de rutas compartidas con invalidacin por regin.
+ * Cada entrada se indexa por las regiones (RegionSize x RegionSize celdas) que recorre;
+ * un cambio de celda expulsa slo las rutas que pasan por su regin, no toda la cach.
+ * Slo guarda rutas que llegan a la meta: una parcial (horizonte agotado o meta
+ * inalcanzable) depende de toda la frontera explorada, no slo de sus celdas, y no se
+ * podra invalidar as. Una ruta completa sigue siendo transitable mientras no cambie
+ * ninguna celda de sus regiones, aunque otro cambio pudiera acortarla.
+ */
+class BATTLECITY3D_API FGridPathCache
+{
+public:
+	void Configure(int32 InCapacity, int32 InRegionSize);
+
+	FGridPathRef Find(const FGridPathCacheKey& Key);
+	void Add(const FGridPathCacheKey& Key, const FGridPathRef& Path);
+
+	void InvalidateCell(const FIntPoint& Cell);
+	void Reset();
+	void ResetStats();
+
+	const FGridPathCacheStats& GetStats() const { return Stats; }
+	int32 GetCapacity() const { return Capacity; }
+
+private:
+	struct FEntry
+	{
+		FGridPathCacheKey Key;
+		FGridPathRef Path;
+		TArray<uint32, TInlineAllocator<8>> Regions;
+		int32 Prev = INDEX_NONE;
+		int32 Next = INDEX_NONE;
+		int64 Bytes = 0;
+	};
+
+	int32 Capacity = 256;
+	int32 RegionSize = 8;
+
+	TArray<FEntry> Entries;
+	TArray<int32> FreeSlots;
+	TMap<FGridPathCacheKey, int32> SlotByKey;
+	TMap<uint32, TArray<int32>> SlotsByRegion;
+
+	// Lista doble: Head = ms reciente, Tail = candidata a expulsin
+	int32 Head = INDEX_NONE;
+	int32 Tail = INDEX_NONE;
+
+	FGridPathCacheStats Stats;
+
+	static uint32 PackRegion(int32 RX, int32 RY) { return ((uint32)RX & 0xFFFF) | (((uint32)RY & 0xFFFF) << 16); }
+	uint32 RegionOf(const FIntPoint& Cell) const { return PackRegion(Cell.X / RegionSize, Cell.Y / RegionSize); }
+
+	void Unlink(int32 Slot);
+	void LinkFront(int32 Slot);
+	void RemoveSlot(int32 Slot);
+};
@@ -0,0 +1,37 @@
+#pragma once
+#include "CoreMinimal.h"
+
+class UMapGridSubsystem;
+
+/**
+ * Base de datos de rutas sobre la topologa esttica (acero y agua no cambian en partida;
+ * los ladrillos se tratan como libres). Para cada celda origen guarda el primer movimiento
+ * hacia cada destino, comprimido en runs (destino inicial + direccin) sobre el orden fila a fila.
+ * Los destinos inalcanzables no rompen runs (nunca se consultan).
+ * La ruta se obtiene encadenando primeros movimientos; el manager comprueba los ladrillos encima
+ * y slo busca si la ruta esttica pisa alguno.
+ */
+class BATTLECITY3D_API FGridPathDatabase
+{
+public:
+	static constexpr uint8 NoMove = 4;
+
+	void Build(const UMapGridSubsystem* Grid);
+	void Reset();
+
+	bool IsBuilt() const { return RowStart.Num() > 0; }
+
+	// ndice en GridSearch::Dir4 del primer paso From -> To (NoMove si no hay datos)
+	uint8 GetFirstMove(const FIntPoint& From, const FIntPoint& To) const;
+
+	int32 GetNumRuns() const { return Runs.Num(); }
+	SIZE_T GetAllocatedSize() const { return RowStart.GetAllocatedSize() + Runs.GetAllocatedSize(); }
+
+private:
+	int32 Width = 0, Height = 0;
+
+	// Runs del origen S en [RowStart[S], RowStart[S+1])
+	TArray<int32>  RowStart;
+	// (destino inicial << 3) | direccin
+	TArray<uint32> Runs;
+};
@@ -2,69 +2,36 @@
 #include "CoreMinimal.h"
 #include "Components/ActorComponent.h"
 #include "GridPathTypes.h"
+#include "GridPath.h"
+#include "GridPathFollower.h"
 #include "GridPathFollowComponent.generated.h"
 
 class UMapGridSubsystem;
 
+// Envoltorio Blueprint de FGridPathFollower (los enemigos usan el struct directamente)
 UCLASS(ClassGroup = (BattleCity), meta = (BlueprintSpawnableComponent))
 class BATTLECITY3D_API UGridPathFollowComponent : public UActorComponent
 {
 	GENERATED_BODY()
 public:
 	UFUNCTION(BlueprintCallable, Category = "GridPath")
-	void SetPath(UMapGridSubsystem* InGrid, const FGridPathResult& InPath)
-	{
-		Grid = InGrid; Path = InPath; Index = (Path.Cells.Num() > 1) ? 1 : 0;
-	}
+	void SetPath(UMapGridSubsystem* InGrid, const FGridPathResult& InPath);
 
-	UFUNCTION(BlueprintCallable, Category = "GridPath")
-	bool HasPath() const { return Path.bValid && Path.Cells.Num() > 1 && Grid != nullptr; }
-
-	// Celda objetivo actual (waypoint)
-	bool GetCurrentTargetCell(FIntPoint& OutCell) const
-	{
-		if (!HasPath()) return false;
-		OutCell = Path.Cells[Index];
-		return true;
-	}
-
-	// Avanza si ya alcanz la celda actual (en espacio mundo)
-	void AdvanceIfReached(const FVector& WorldPos, float TileSize, float SnapTolWorld = 5.f)
-	{
-		if (!HasPath()) return;
-		FIntPoint Target;
-		if (!GetCurrentTargetCell(Target)) return;
-
-		const FVector TargetW = GridToWorld(Target, TileSize);
-		if (FVector::Dist2D(WorldPos, TargetW) <= SnapTolWorld)
-		{
-			if (Index + 1 < Path.Cells.Num()) ++Index;
-		}
-	}
+	// Sin copia: varios enemigos pueden seguir la misma ruta cacheada
+	void SetSharedPath(UMapGridSubsystem* InGrid, const FGridPathRef& InPath) { Grid = InGrid; Follower.SetSharedPath(InPath); }
 
-	// Direccin cardinal deseada hacia la celda objetivo (unidad en X/Y mundo)
-	FVector GetDesiredDirWorld(const FVector& WorldPos, float TileSize) const
-	{
-		if (!HasPath()) return FVector::ZeroVector;
-		FIntPoint Target;
-		if (!GetCurrentTargetCell(Target)) return FVector::ZeroVector;
-
-		const FVector TargetW = GridToWorld(Target, TileSize);
-		const FVector Delta = TargetW - WorldPos;
-		// Proyecta a eje dominante para cardinal puro
-		if (FMath::Abs(Delta.X) >= FMath::Abs(Delta.Y))
-			return FVector(FMath::Sign(Delta.X), 0, 0);
-		else
-			return FVector(0, FMath::Sign(Delta.Y), 0);
-	}
+	UFUNCTION(BlueprintCallable, Category = "GridPath")
+	bool HasPath() const { return Follower.HasPath() && Grid != nullptr; }
 
-	// Lleg al final?
-	bool IsAtLastCell() const { return HasPath() && Index >= Path.Cells.Num() - 1; }
+	bool GetCurrentTargetCell(FIntPoint& OutCell) const { return Grid && Follower.GetCurrentTargetCell(OutCell); }
+	void AdvanceIfReached(const FVector& WorldPos, float SnapTolWorld = 5.f) { if (Grid) Follower.AdvanceIfReached(WorldPos, SnapTolWorld); }
+	FVector GetDesiredDirWorld(const FVector& WorldPos) const { return Grid ? Follower.GetDesiredDirWorld(WorldPos) : FVector::ZeroVector; }
+	bool IsAtLastCell() const { return Grid && Follower.IsAtLastCell(); }
+	bool HasPendingSegments() const { return Grid && Follower.HasPendingSegments(); }
+	const FGridPathRef& GetPath() const { return Follower.GetPath(); }
+	void ContinueWith(const FGridPathRef& Next) { Follower.ContinueWith(Next); }
 
 private:
 	UPROPERTY() TObjectPtr<UMapGridSubsystem> Grid = nullptr;
-	FGridPathResult Path;
-	int32 Index = 0;
-
-	FVector GridToWorld(const FIntPoint& C, float TileSize) const;
+	FGridPathFollower Follower;
 };
@@ -0,0 +1,66 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "GridPath.h"
+
+/**
+ * Seguidor de ruta sin UObject: ruta compartida + ndice de esquina. Lo usa PathFollow dentro del
+ * bloque de estado de cada agente y UGridPathFollowComponent para Blueprint.
+ */
+struct BATTLECITY3D_API FGridPathFollower
+{
+	// Sin copia: varios enemigos pueden seguir la misma ruta cacheada
+	void SetSharedPath(const FGridPathRef& InPath)
+	{
+		Path = InPath; Index = (Path.IsValid() && Path->GetCornerCells().Num() > 1) ? 1 : 0;
+	}
+
+	void Reset() { Path.Reset(); Index = 0; }
+
+	bool HasPath() const { return Path.IsValid() && Path->GetCornerCells().Num() > 1; }
+
+	// Celda objetivo actual (esquina de la ruta)
+	bool GetCurrentTargetCell(FIntPoint& OutCell) const
+	{
+		if (!HasPath()) return false;
+		OutCell = Path->GetCornerCells()[Index];
+		return true;
+	}
+
+	// Avanza si ya alcanz la esquina actual (en espacio mundo, precalculada)
+	void AdvanceIfReached(const FVector& WorldPos, float SnapTolWorld = 5.f)
+	{
+		if (!HasPath()) return;
+		const TArray<FVector>& Corners = Path->GetCornersWorld();
+		if (FVector::Dist2D(WorldPos, Corners[Index]) <= SnapTolWorld)
+		{
+			if (Index + 1 < Corners.Num()) ++Index;
+		}
+	}
+
+	// Direccin cardinal deseada hacia la esquina objetivo (unidad en X/Y mundo)
+	FVector GetDesiredDirWorld(const FVector& WorldPos) const
+	{
+		if (!HasPath()) return FVector::ZeroVector;
+
+		const FVector Delta = Path->GetCornersWorld()[Index] - WorldPos;
+		// Proyecta a eje dominante para cardinal puro
+		if (FMath::Abs(Delta.X) >= FMath::Abs(Delta.Y))
+			return FVector(FMath::Sign(Delta.X), 0, 0);
+		else
+			return FVector(0, FMath::Sign(Delta.Y), 0);
+	}
+
+	// Lleg al final?
+	bool IsAtLastCell() const { return HasPath() && Index >= Path->GetCornerCells().Num() - 1; }
+
+	// HPA*: quedan tramos sin refinar tras la ltima celda
+	bool HasPendingSegments() const { return HasPath() && Path->PendingWaypoints.Num() > 0; }
+	const FGridPathRef& GetPath() const { return Path; }
+
+	// Sustituye el tramo actual por el siguiente; Next empieza en la celda objetivo actual
+	void ContinueWith(const FGridPathRef& Next) { Path = Next; Index = 0; }
+
+private:
+	FGridPathRef Path;
+	int32 Index = 0; // ndice de esquina
+};
@@ -0,0 +1,82 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "GridPathTypes.h"
+#include "GridSearch.h"
+
+class UMapGridSubsystem;
+
+/**
+ * Abstraccin jerrquica (HPA*) sobre UMapGridSubsystem para un perfil de costes.
+ * El mapa se parte en clusters de ClusterSize x ClusterSize; en cada frontera entre
+ * clusters vecinos se crean nodos de entrada y, dentro de cada cluster, aristas con la
+ * distancia exacta (cacheada) entre sus entradas. Un cambio de celda slo reconstruye
+ * el cluster afectado (y sus fronteras si la celda est en el borde).
+ */
+class BATTLECITY3D_API FGridPathHierarchy
+{
+public:
+	void Build(const UMapGridSubsystem* InGrid, const FGridCostProfile& InCost, int32 InClusterSize);
+	void OnCellChanged(const FIntPoint& Cell);
+
+	// Ruta abstracta Start -> ... -> Goal (celdas de entrada intermedias). false si no hay conexin.
+	bool FindAbstractPath(const FIntPoint& Start, const FIntPoint& Goal, TArray<FIntPoint>& OutWaypoints, float* OutCost = nullptr, int32* OutNodesExpanded = nullptr);
+
+	// Rectngulo de bsqueda para refinar el tramo A -> B (mismo cluster o vecinos).
+	FGridSearchBounds GetSegmentBounds(const FIntPoint& A, const FIntPoint& B) const;
+	FGridSearchBounds GetClusterBounds(int32 Cluster) const;
+	int32 GetClusterOf(const FIntPoint& Cell) const;
+
+	bool IsBuilt() const { return Grid != nullptr; }
+	const FGridCostProfile& GetCostProfile() const { return Cost; }
+	float MinStepCost() const { return Lut.MinStep; }
+	int32 GetClusterSize() const { return ClusterSize; }
+	int32 GetNumNodes() const { return Nodes.Num() - FreeNodes.Num(); }
+	SIZE_T GetAllocatedSize() const;
+
+private:
+	struct FEdge
+	{
+		int32 To = INDEX_NONE;
+		float Cost = 0.f;
+	};
+	struct FNode
+	{
+		FIntPoint Cell = FIntPoint::ZeroValue;
+		int32 Cluster = INDEX_NONE;
+		bool bAlive = false;
+		TArray<FEdge> Edges; // intra (mismo cluster) + inter (cluster vecino)
+	};
+
+	const UMapGridSubsystem* Grid = nullptr;
+	FGridCostProfile Cost;
+	FGridCostLUT Lut = FGridCostLUT(FGridCostProfile());
+	int32 ClusterSize = 16;
+	int32 ClustersX = 0, ClustersY = 0;
+
+	TArray<FNode> Nodes;
+	TArray<int32> FreeNodes;
+	TArray<TArray<int32>> ClusterNodes;
+	TMap<FIntPoint, int32> NodeByCell;
+
+	FGridSearchScratch Scratch;
+
+	float CellCost(const FIntPoint& C) const;
+	bool IsOpenCell(const FIntPoint& C) const { return CellCost(C) < Cost.ImpassableCost; }
+
+	int32 FindOrAddNode(const FIntPoint& Cell);
+	void  RemoveNode(int32 NodeIdx);
+
+	// Frontera entre cluster A y su vecino derecho (bVertical) o inferior
+	void BuildBorder(int32 ClusterA, bool bVertical);
+	void ClearBorder(int32 ClusterA, bool bVertical);
+	void AddEntrance(const FIntPoint& A, const FIntPoint& B);
+
+	void RebuildIntra(int32 Cluster);
+
+	// Dijkstra acotado al cluster de Cell; los costes quedan en Scratch
+	FGridSearchBounds RunClusterDijkstra(const FIntPoint& Cell, int32* InOutExpanded = nullptr);
+	float ScratchCost(const FGridSearchBounds& B, const FIntPoint& Cell) const;
+
+	// Bsqueda abstracta (ndices de nodo + Start/Goal virtuales)
+	FGridSearchScratch AbstractScratch;
+};
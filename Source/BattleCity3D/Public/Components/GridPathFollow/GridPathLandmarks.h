@@ -0,0 +1,69 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "GridPathTypes.h"
+
+class UMapGridSubsystem;
+
+/**
+ * Heursticas precalculadas para A* sobre un perfil de costes.
+ * - ALT: K landmarks con la distancia d(L->v) a todas las celdas; por desigualdad triangular
+ *   h(n,g) = max_L { d(L,g) - d(L,n), d(n,L) - d(g,L) } es admisible y mucho ms informada
+ *   que Manhattan cuando ladrillos y acero obligan a rodear.
+ * - Tabla exacta: en mapas pequeos (p.ej. 26x26) distancias todos-contra-todos en uint16
+ *   (costes enteros); la ruta sale bajando por la tabla sin expandir nodos.
+ * Al destruirse un ladrillo los costes slo bajan: se reparan las filas propagando la mejora
+ * desde la celda (no se recalcula todo).
+ */
+class BATTLECITY3D_API FGridPathLandmarks
+{
+public:
+	static constexpr uint16 ExactUnreached = 0xFFFF;
+
+	void Build(const UMapGridSubsystem* InGrid, const FGridCostProfile& InCost, int32 InNumLandmarks, int32 InExactMaxCells);
+	void OnCellChanged(const FIntPoint& Cell);
+
+	// Cota inferior admisible del coste Cell -> Goal (0 si no hay informacin)
+	float Heuristic(const FIntPoint& Cell, const FIntPoint& Goal) const;
+
+	// Distancia exacta From -> To (slo con tabla). false si no hay tabla o no se alcanza.
+	bool GetExactDistance(const FIntPoint& From, const FIntPoint& To, int32& OutCost) const;
+
+	// Coste de entrar en la celda segn el perfil (cacheado)
+	float GetCellCost(const FIntPoint& C) const;
+
+	bool IsBuilt() const { return Grid != nullptr && !bNeedsRebuild; }
+	bool HasExactTable() const { return Exact.Num() > 0; }
+	const FGridCostProfile& GetCostProfile() const { return Cost; }
+	int32 GetNumLandmarks() const { return Landmarks.Num(); }
+	SIZE_T GetAllocatedSize() const
+	{
+		return CellCosts.GetAllocatedSize() + Landmarks.GetAllocatedSize() + FromLandmark.GetAllocatedSize()
+			+ Exact.GetAllocatedSize() + Heap.GetAllocatedSize();
+	}
+
+private:
+	const UMapGridSubsystem* Grid = nullptr;
+	FGridCostProfile Cost;
+	FGridCostLUT Lut = FGridCostLUT(FGridCostProfile());
+	int32 Width = 0, Height = 0;
+	bool bNeedsRebuild = false;
+
+	// Coste de entrar en cada celda (MAX = impasable)
+	TArray<float>  CellCosts;
+	// Celdas landmark (ndice X + Y*W) y filas d(L->v), [L*N + v]
+	TArray<int32>  Landmarks;
+	TArray<float>  FromLandmark;
+	// Tabla exacta: [s*N + v] = d(s->v) (ExactUnreached si no se alcanza)
+	TArray<uint16> Exact;
+
+	// Heap (coste, celda) reutilizado por los Dijkstra de construccin y reparacin
+	TArray<TPair<float, int32>> Heap;
+
+	int32 NumCells() const { return Width * Height; }
+	void ChooseLandmarks(int32 NumLandmarks);
+
+	// Dijkstra desde Source sobre una fila (float o uint16) y propagacin de mejoras
+	template<typename TDist> void FillRow(TDist* Row, int32 Source, TDist Inf);
+	template<typename TDist> void RepairRow(TDist* Row, int32 Source, int32 Changed, TDist Inf);
+	template<typename TDist> void Propagate(TDist* Row, int32 Source, TDist Inf);
+};
@@ -2,23 +2,187 @@
 #include "CoreMinimal.h"
 #include "Subsystems/GameInstanceSubsystem.h"
 #include "GridPathTypes.h"
+#include "GridSearch.h"
+#include "GridPathHierarchy.h"
+#include "GridPathLandmarks.h"
+#include "GridPathDatabase.h"
+#include "GridReservationTable.h"
+#include "GridPathTrace.h"
+#include "GridPathCache.h"
+#include "GridPath.h"
+#include "Map/GridBitboard.h"
 #include "GridPathManager.generated.h"
 
+class UMapGridSubsystem;
+class FProjectileLaneIndex;
+
 // Manager sencillo para pathfinding sobre UMapGridSubsystem (cardinal).
-UCLASS()
+UCLASS(Config = Game)
 class BATTLECITY3D_API UGridPathManager : public UGameInstanceSubsystem
 {
 	GENERATED_BODY()
 public:
-	virtual void Initialize(FSubsystemCollectionBase& Collection) override {}
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
 
 	// Sin colas an: resolucin inmediata (podemos time-slicear en Fase 4).
 	UFUNCTION(BlueprintCallable, Category = "GridPath")
-	bool ComputePath(const FGridPathRequest& Req, FGridPathResult& OutResult) const;
+	bool ComputePath(const FGridPathRequest& Req, FGridPathResult& OutResult);
+
+	// Igual que ComputePath pero sin copias: devuelve la ruta compartida (cacheada si procede).
+	FGridPathRef ComputePathShared(const FGridPathRequest& Req);
+
+	// Siguiente tramo HPA* de Current como nueva ruta compartida (nullptr si no hay/no es transitable)
+	FGridPathRef RefineNextSegmentShared(const FGridPathRequest& Req, const FGridPath& Current);
+
+	// HPA*: refina el siguiente tramo de InOutResult.PendingWaypoints desde la ltima celda de Cells.
+	// Reemplaza Cells por el nuevo tramo. false si no queda nada o el tramo ya no es transitable.
+	UFUNCTION(BlueprintCallable, Category = "GridPath")
+	bool RefineNextSegment(const FGridPathRequest& Req, UPARAM(ref) FGridPathResult& InOutResult);
+
+	// Tamao de cluster (celdas por lado) del planificador jerrquico
+	UPROPERTY(Config, EditAnywhere, Category = "GridPath|Hierarchical")
+	int32 HierarchicalClusterSize = 16;
+
+	// Auto usa HPA* a partir de este nmero de celdas (ancho*alto)
+	UPROPERTY(Config, EditAnywhere, Category = "GridPath|Hierarchical")
+	int32 HierarchicalMinMapCells = 128 * 128;
+
+	// Tramos abstractos que se refinan por adelantado en cada ComputePath
+	UPROPERTY(Config, EditAnywhere, Category = "GridPath|Hierarchical")
+	int32 HierarchicalRefineAhead = 2;
+
+	// Landmarks ALT por perfil de costes (0 = sin ALT)
+	UPROPERTY(Config, EditAnywhere, Category = "GridPath|Landmarks")
+	int32 LandmarkCount = 8;
+
+	// Auto usa landmarks hasta este nmero de celdas (memoria: LandmarkCount * celdas * 4 bytes)
+	UPROPERTY(Config, EditAnywhere, Category = "GridPath|Landmarks")
+	int32 LandmarkMaxMapCells = 256 * 256;
+
+	// Hasta este nmero de celdas se guarda la tabla exacta todos-contra-todos (celdas * 2 bytes)
+	UPROPERTY(Config, EditAnywhere, Category = "GridPath|Landmarks")
+	int32 ExactTableMaxCells = 32 * 32;
+
+	// Base de datos de primeros movimientos hasta este nmero de celdas (se construye al primer uso)
+	UPROPERTY(Config, EditAnywhere, Category = "GridPath|PathDatabase")
+	int32 PathDatabaseMaxMapCells = 64 * 64;
+
+	// WHCA*: pasos (ticks) que cada agente planifica y reserva por adelantado
+	UPROPERTY(Config, EditAnywhere, Category = "GridPath|Cooperative")
+	int32 CooperativeWindow = 16;
+
+	// Duracin de un tick de reserva (~ lo que tarda un tanque en cruzar una celda)
+	UPROPERTY(Config, EditAnywhere, Category = "GridPath|Cooperative")
+	float CooperativeStepSeconds = 0.25f;
+
+	// Agentes simultneos previstos (dimensiona la tabla de reservas)
+	UPROPERTY(Config, EditAnywhere, Category = "GridPath|Cooperative")
+	int32 CooperativeMaxAgents = 64;
+
+	// Coste de esperar un tick en la misma celda
+	UPROPERTY(Config, EditAnywhere, Category = "GridPath|Cooperative")
+	float CooperativeWaitCost = 1.f;
+
+	// Trazas de diagnstico guardadas (bc.path.trace / bc.path.trace.slowms)
+	UPROPERTY(Config, EditAnywhere, Category = "GridPath|Trace")
+	int32 TraceCapacity = 32;
+
+	// Expansiones mximas registradas por traza
+	UPROPERTY(Config, EditAnywhere, Category = "GridPath|Trace")
+	int32 TraceMaxSamples = 8192;
+
+	// Cach LRU de rutas (0 = desactivada)
+	UPROPERTY(Config, EditAnywhere, Category = "GridPath|Cache")
+	int32 PathCacheCapacity = 256;
+
+	// Lado (en celdas) de las regiones usadas para invalidar la cach
+	UPROPERTY(Config, EditAnywhere, Category = "GridPath|Cache")
+	int32 PathCacheRegionSize = 8;
+
+	UFUNCTION(BlueprintCallable, Category = "GridPath|Cache")
+	FGridPathCacheStats GetCacheStats() const { return Cache.GetStats(); }
+
+	UFUNCTION(BlueprintCallable, Category = "GridPath|Cache")
+	void ResetCache();
+
+	// ==== Cooperativo (WHCA*) ====
+	// Id de agente para la tabla de reservas (0 = sin hueco)
+	uint16 RegisterCooperativeAgent();
+	void UnregisterCooperativeAgent(uint16 Agent);
+	int64 GetCooperativeTick(double WorldSeconds) const;
+	// Tick del prximo replan del agente: cada media ventana, desfasado por agente para repartir el coste
+	int64 GetNextCooperativeReplanTick(uint16 Agent, int64 Tick) const;
+
+	// A* espacio-tiempo de CooperativeWindow pasos (esperas incluidas) que evita las reservas de otros
+	// agentes (celda y cruces) y reserva las suyas. OutTimedCells[i] = celda en StartTick + i.
+	// Slo termina en la meta si puede quedarse en ella hasta el final de la ventana; si una reserva
+	// falla, el plan se corta en ese tick. false si el agente est encerrado (el plan es esperar en Start).
+	bool ComputeCooperativePath(const FGridPathRequest& Req, uint16 Agent, int64 StartTick, TArray<FIntPoint>& OutTimedCells);
+
+	const FGridReservationTable& GetReservations() const { return Reservations; }
+
+	const FGridPathTraceRing& GetTraces() const { return Traces; }
+
+	// Lneas de fuego para perfiles con ThreatCost (las publica UProjectileLaneSubsystem; nullptr = sin amenaza)
+	void SetThreatLanes(const FProjectileLaneIndex* InLanes) { ThreatLanes = InLanes; }
+	const FProjectileLaneIndex* GetThreatLanes() const { return ThreatLanes; }
+
+	// Mtricas de la ltima consulta / memoria de trabajo (benchmark bc.path.bench)
+	int32 GetLastNodesExpanded() const { return LastNodesExpanded; }
+	SIZE_T GetScratchAllocatedSize() const;
 
 private:
 	// A* cardinal con heurstica Manhattan; cae a Dijkstra si Manhattan=0.
-	bool AStar_Internal(const FGridPathRequest& Req, FGridPathResult& OutResult) const;
+	bool AStar_Internal(const FGridPathRequest& Req, FGridPathResult& OutResult);
+	bool Hierarchical_Internal(const FGridPathRequest& Req, FGridPathResult& OutResult);
+	bool Landmarks_Internal(const FGridPathRequest& Req, FGridPathResult& OutResult);
+	bool PathDatabase_Internal(const FGridPathRequest& Req, FGridPathResult& OutResult);
+	bool BitBFS_Internal(const FGridPathRequest& Req, FGridPathResult& OutResult);
+	bool TurnAware_Internal(const FGridPathRequest& Req, FGridPathResult& OutResult);
+
+	EGridPathPlanner ResolvePlanner(const FGridPathRequest& Req) const;
+	// La amenaza cambia cada frame: A* plano y fuera de la cach
+	bool UsesThreat(const FGridPathRequest& Req) const { return ThreatLanes && Req.Cost.ThreatCost > 0.f; }
+	// Construye los datos perezosos que usar el planificador (antes de cronometrar la consulta)
+	void PreparePlanner(EGridPathPlanner Planner, const FGridPathRequest& Req);
+	bool RunPlanner(EGridPathPlanner Planner, const FGridPathRequest& Req, FGridPathResult& OutResult);
+	void FinishTrace(FGridSearchTrace& Trace, EGridPathPlanner Planner, const FGridPathRequest& Req, const FGridPathResult& R, bool bOk, float Millis);
+
+	// A* restringido a un rectngulo (tramos HPA*)
+	bool SearchBounded(const FGridPathRequest& Req, const FIntPoint& From, const FIntPoint& To,
+		const FGridSearchBounds& Bounds, bool bAllowPartial, FGridSearchResult& Out);
+
+	// Jerarqua por perfil de costes, construida bajo demanda y mantenida con OnGridCellChanged
+	FGridPathHierarchy* GetHierarchy(UMapGridSubsystem* Grid, const FGridCostProfile& Cost);
+	FGridPathLandmarks* GetLandmarks(UMapGridSubsystem* Grid, const FGridCostProfile& Cost);
+	void EnsureBoundTo(UMapGridSubsystem* Grid);
+	void HandleGridCellChanged(FIntPoint Cell);
+
+	TWeakObjectPtr<UMapGridSubsystem> BoundGrid;
+	FDelegateHandle CellChangedHandle;
+	uint32 BoundLayoutVersion = 0;
+
+	TMap<uint32, TUniquePtr<FGridPathHierarchy>> Hierarchies;
+	TMap<uint32, TUniquePtr<FGridPathLandmarks>> LandmarkSets;
+	FGridPathDatabase PathDatabase;
+
+	FGridReservationTable Reservations;
+	FGridSearchScratch CoopScratch;
+
+	FGridPathTraceRing Traces;
+	FGridSearchTrace* ActiveTrace = nullptr; // la usan las bsquedas mientras se captura
+	const FProjectileLaneIndex* ThreatLanes = nullptr;
+	TArray<uint16> FreeAgentIds;
+	uint16 NextAgentId = 1;
+	FGridSearchScratch Scratch;
+	FGridBitBFS Bfs;
+	TArray<uint16> BfsDist;
+	FGridPathCache Cache;
+	int32 LastNodesExpanded = 0;
+
+	FGridPathCacheKey MakeCacheKey(const FGridPathRequest& Req, EGridPathPlanner Planner) const;
+	void PublishCacheStats() const;
 
 	static int32 Heuristic_Manhattan(const FIntPoint& A, const FIntPoint& B)
 	{
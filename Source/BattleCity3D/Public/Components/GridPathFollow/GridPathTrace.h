@@ -0,0 +1,47 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "GridSearch.h"
+
+class UWorld;
+class UMapGridSubsystem;
+
+/**
+ * Anillo de trazas de bsqueda de tamao fijo (Capacity trazas x MaxSamples expansiones).
+ * Los slots se reutilizan sin liberar memoria: capturar no asigna una vez caliente.
+ * Se rellena desde UGridPathManager con bc.path.trace 1 o, solo para consultas lentas,
+ * con bc.path.trace.slowms (la consulta se repite con traza, sin coste para el resto).
+ */
+class BATTLECITY3D_API FGridPathTraceRing
+{
+public:
+	void Configure(int32 InCapacity, int32 InMaxSamples);
+
+	// Slot para la prxima traza (no cuenta hasta Commit; si no se confirma se reutiliza)
+	FGridSearchTrace& BeginTrace();
+	void Commit();
+	void Reset();
+
+	int32 Num() const { return Count; }
+	// 0 = la ms reciente
+	const FGridSearchTrace& GetRecent(int32 Index) const;
+
+	// Formato binario compacto (.bctr): cabecera + por traza celdas en uint16
+	bool ExportBinary(const FString& FilePath) const;
+	void Draw(UWorld* World, const UMapGridSubsystem* Grid, int32 NumTraces, float Seconds) const;
+
+	SIZE_T GetAllocatedSize() const;
+
+private:
+	TArray<FGridSearchTrace> Slots;
+	int32 Head = 0;  // siguiente slot a escribir
+	int32 Count = 0;
+	int32 MaxSamples = 4096;
+};
+
+namespace GridPathTrace
+{
+	// bc.path.trace
+	bool IsCaptureEnabled();
+	// bc.path.trace.slowms (0 = sin auto-captura; siempre 0 en Shipping)
+	float GetSlowQueryMs();
+}
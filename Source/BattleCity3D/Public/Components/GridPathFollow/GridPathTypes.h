@@ -19,6 +19,95 @@ struct FGridCostProfile
 	// Costo para acero/agua: usamos un "infinito" efectivo = bloqueado
 	UPROPERTY(EditAnywhere, BlueprintReadWrite)
 	float ImpassableCost = 1e9f;
+
+	// Suplementos por terreno (se suman al coste de la celda, libre o ladrillo)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	float IceExtraCost = 0.f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	float ForestExtraCost = 0.f;
+
+	// Amenaza: suplemento por entrar en una celda por la que pasar una bala del jugador antes de
+	// ThreatHorizon segundos (FProjectileLaneIndex). 0 = ignorar. Slo lo aplica el A* plano y sin cach.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	float ThreatCost = 0.f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (ClampMin = "0"))
+	float ThreatHorizon = 0.5f;
+
+	// Coste de cada cambio de direccin (el tanque se para TurnDelay y vuelve a acelerar).
+	// > 0: Auto usa el planificador TurnAware. Ver ABattleTankPawn::GetTurnPathCost.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (ClampMin = "0"))
+	float TurnCost = 0.f;
+
+	bool operator==(const FGridCostProfile& O) const
+	{
+		return FreeCost == O.FreeCost && BrickCost == O.BrickCost && ImpassableCost == O.ImpassableCost
+			&& IceExtraCost == O.IceExtraCost && ForestExtraCost == O.ForestExtraCost
+			&& ThreatCost == O.ThreatCost && ThreatHorizon == O.ThreatHorizon && TurnCost == O.TurnCost;
+	}
+	bool operator!=(const FGridCostProfile& O) const { return !(*this == O); }
+
+	// Slo los costes por celda (sin amenaza ni giro): lo que usan los datos precalculados y su hash
+	FGridCostProfile GetBaseCosts() const
+	{
+		FGridCostProfile B = *this;
+		B.ThreatCost = 0.f;
+		B.ThreatHorizon = FGridCostProfile().ThreatHorizon;
+		B.TurnCost = 0.f;
+		return B;
+	}
+};
+
+// Hash del perfil: los datos precalculados (jerarqua, etc.) dependen de los costes.
+// La amenaza y el giro no entran: ningn dato precalculado los usa (la cach aade el giro a su clave).
+FORCEINLINE uint32 GetTypeHash(const FGridCostProfile& P)
+{
+	uint32 H = GetTypeHash(P.FreeCost);
+	H = HashCombine(H, GetTypeHash(P.BrickCost));
+	H = HashCombine(H, GetTypeHash(P.ImpassableCost));
+	H = HashCombine(H, GetTypeHash(P.IceExtraCost));
+	H = HashCombine(H, GetTypeHash(P.ForestExtraCost));
+	return H;
+}
+
+// Cdigo de celda de 4 bits: terreno (bits 0-1) | obstculo (bits 2-3). Lo mantiene UMapGridSubsystem.
+FORCEINLINE uint8 PackGridCellCode(uint8 Terrain, uint8 Obstacle) { return (uint8)((Terrain & 3) | ((Obstacle & 3) << 2)); }
+
+// Perfil compilado: coste de entrar en la celda indexado por su cdigo (una lectura por expansin).
+struct BATTLECITY3D_API FGridCostLUT
+{
+	float Costs[16];
+	// Menor coste transitable (escala admisible para Manhattan)
+	float MinStep = 1.f;
+	float ImpassableCost = 1e9f;
+	// Todos los costes transitables son enteros
+	bool bIntegral = true;
+
+	explicit FGridCostLUT(const FGridCostProfile& P);
+
+	float operator[](uint8 Code) const { return Costs[Code & 15]; }
+	bool IsPassable(uint8 Code) const { return Costs[Code & 15] < ImpassableCost; }
+};
+
+// Algoritmo a usar por UGridPathManager.
+UENUM(BlueprintType)
+enum class EGridPathPlanner : uint8
+{
+	// Jerrquico en mapas grandes (rutas completas), landmarks en mapas medianos/pequeos, A* plano en el resto.
+	Auto,
+	// A* cardinal sobre todo el grid.
+	AStar,
+	// HPA*: bsqueda sobre clusters/entradas + refinamiento perezoso por tramos.
+	Hierarchical,
+	// A* con heurstica ALT (landmarks); en mapas pequeos, tabla exacta sin bsqueda.
+	Landmarks,
+	// Primeros movimientos precalculados sobre acero/agua; bsqueda slo si la ruta pisa ladrillo.
+	PathDatabase,
+	// BFS por bitboards: coste unitario, ladrillos = muro. MaxSteps = capas del frente (= pasos).
+	BitBFS,
+	// A* con orientacin (celda x 4 direcciones): penaliza cada giro con Cost.TurnCost.
+	TurnAware
 };
 
 USTRUCT(BlueprintType)
@@ -41,13 +130,27 @@ struct FGridPathRequest
 	UPROPERTY(EditAnywhere, BlueprintReadWrite)
 	FGridCostProfile Cost;
 
-	// Limitar horizonte (0 = ruta completa)
+	// Horizonte en pasos de ruta: la ruta se corta a MaxSteps movimientos (0 = ruta completa).
+	// Igual en todos los planificadores; con bAllowPartial = false, una ruta ms larga falla.
 	UPROPERTY(EditAnywhere, BlueprintReadWrite)
 	int32 MaxSteps = 0;
 
+	// Presupuesto de la bsqueda en nodos expandidos (0 = sin lmite). Slo A*, landmarks y
+	// TurnAware (ah cuenta estados celda x orientacin); agotado, parcial o fallo segn bAllowPartial.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	int32 MaxExpansions = 0;
+
 	// Permitir devolver ruta parcial si no se alcanza la meta en el horizonte
 	UPROPERTY(EditAnywhere, BlueprintReadWrite)
 	bool bAllowPartial = true;
+
+	// Planificador (Auto decide segn tamao de mapa y horizonte)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	EGridPathPlanner Planner = EGridPathPlanner::Auto;
+
+	// Orientacin inicial para TurnAware (ndice GridSearch::Dir4: N, E, S, O). INDEX_NONE = libre.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	int32 StartDir = INDEX_NONE;
 };
 
 USTRUCT(BlueprintType)
@@ -70,4 +173,27 @@ struct FGridPathResult
 	// Ruta vlida?
 	UPROPERTY(EditAnywhere, BlueprintReadWrite)
 	bool bValid = false;
+
+	// HPA*: waypoints abstractos an sin refinar (el ltimo es Goal).
+	// Cells slo cubre el primer tramo; UGridPathManager::RefineNextSegment contina.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	TArray<FIntPoint> PendingWaypoints;
+};
+
+// Estadsticas de la cach de rutas (acumuladas desde el ltimo reset).
+USTRUCT(BlueprintType)
+struct FGridPathCacheStats
+{
+	GENERATED_BODY()
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly) int32 Hits = 0;
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly) int32 Misses = 0;
+	// Expulsadas por capacidad (LRU)
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly) int32 Evictions = 0;
+	// Expulsadas por cambio de celda en su regin
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly) int32 Invalidations = 0;
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly) int32 Entries = 0;
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly) int64 Bytes = 0;
+
+	float GetHitRate() const { const int32 Total = Hits + Misses; return Total > 0 ? (float)Hits / (float)Total : 0.f; }
 };
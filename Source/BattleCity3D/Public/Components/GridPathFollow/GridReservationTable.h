@@ -0,0 +1,61 @@
+#pragma once
+#include "CoreMinimal.h"
+
+/**
+ * Tabla de reservas espacio-tiempo para pathfinding cooperativo (WHCA*).
+ * Anillo de Depth ticks; cada tick es una tabla hash pequea (direccionamiento abierto) de
+ * celda -> agente con capacidad para MaxAgents reservas. Memoria fija: Depth * NextPow2(2*MaxAgents) slots,
+ * independiente del tamao del mapa. Un bucket se vaca de golpe al reciclarlo para un tick nuevo.
+ */
+class BATTLECITY3D_API FGridReservationTable
+{
+public:
+	static constexpr uint16 NoAgent = 0;
+
+	void Configure(int32 InDepth, int32 InMaxAgents);
+	void Reset();
+
+	// Avanza el anillo: los ticks anteriores a Tick dejan de existir
+	void AdvanceTo(int64 Tick);
+
+	int64 GetCurrentTick() const { return CurrentTick; }
+	int32 GetDepth() const { return Depth; }
+	bool IsInWindow(int64 Tick) const { return Tick >= CurrentTick && Tick < CurrentTick + Depth; }
+
+	// Agente que reserva Cell en Tick (NoAgent si libre o fuera de la ventana)
+	uint16 GetReserver(int32 Cell, int64 Tick) const;
+	bool IsReservedByOther(int32 Cell, int64 Tick, uint16 Agent) const
+	{
+		const uint16 R = GetReserver(Cell, Tick);
+		return R != NoAgent && R != Agent;
+	}
+
+	// false si ya est reservada por otro, fuera de ventana o el tick est lleno
+	bool Reserve(int32 Cell, int64 Tick, uint16 Agent);
+	// Libera todas las reservas vigentes del agente
+	void ReleaseAgent(uint16 Agent);
+
+	int32 GetNumReservations() const;
+	SIZE_T GetAllocatedSize() const;
+
+private:
+	struct FSlot
+	{
+		uint32 Cell = MAX_uint32; // MAX = nunca usado (corta el sondeo)
+		uint16 Agent = NoAgent;   // NoAgent con Cell vlida = borrado (el sondeo sigue)
+	};
+
+	int32 Depth = 0;
+	int32 SlotsPerTick = 0;
+	int64 CurrentTick = 0;
+
+	TArray<FSlot> Slots;      // [Bucket * SlotsPerTick + i]
+	TArray<int64> BucketTick; // tick absoluto que ocupa cada bucket (INDEX_NONE = vaco)
+
+	// Reservas por agente (celda, tick) para liberarlas sin recorrer la tabla
+	TArray<TArray<TPair<int32, int64>>> ByAgent;
+
+	int32 BucketOf(int64 Tick) const { return (int32)(Tick % Depth); }
+	static uint32 HashCell(int32 Cell) { return (uint32)Cell * 2654435761u; }
+	const FSlot* FindSlot(int32 Cell, int64 Tick) const;
+};
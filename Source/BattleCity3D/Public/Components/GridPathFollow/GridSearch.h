@@ -0,0 +1,347 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "Algo/Reverse.h"
+
+// Ncleo de bsqueda cardinal compartido por los planificadores de UGridPathManager.
+// Trabaja sobre un rectngulo del grid con arrays planos (ndice local) y un heap binario,
+// en lugar de TMap/TSet por celda.
+
+// Rectngulo inclusivo en coordenadas de celda.
+struct FGridSearchBounds
+{
+	int32 MinX = 0, MinY = 0, MaxX = -1, MaxY = -1;
+
+	FGridSearchBounds() = default;
+	FGridSearchBounds(int32 InMinX, int32 InMinY, int32 InMaxX, int32 InMaxY)
+		: MinX(InMinX), MinY(InMinY), MaxX(InMaxX), MaxY(InMaxY) {}
+
+	static FGridSearchBounds FromSize(int32 Width, int32 Height) { return FGridSearchBounds(0, 0, Width - 1, Height - 1); }
+
+	int32 Width()  const { return MaxX - MinX + 1; }
+	int32 Height() const { return MaxY - MinY + 1; }
+	int32 Num()    const { return (MaxX >= MinX && MaxY >= MinY) ? Width() * Height() : 0; }
+
+	bool Contains(const FIntPoint& C) const { return C.X >= MinX && C.X <= MaxX && C.Y >= MinY && C.Y <= MaxY; }
+	int32 ToIndex(const FIntPoint& C) const { return (C.X - MinX) + (C.Y - MinY) * Width(); }
+	FIntPoint ToCell(int32 Idx) const { const int32 W = Width(); return FIntPoint(MinX + Idx % W, MinY + Idx / W); }
+
+	FGridSearchBounds Union(const FGridSearchBounds& O) const
+	{
+		return FGridSearchBounds(FMath::Min(MinX, O.MinX), FMath::Min(MinY, O.MinY), FMath::Max(MaxX, O.MaxX), FMath::Max(MaxY, O.MaxY));
+	}
+};
+
+// Memoria reutilizable entre bsquedas. Los sellos de generacin evitan limpiar los arrays.
+struct FGridSearchScratch
+{
+	struct FEntry
+	{
+		float F = 0.f;
+		float G = 0.f;
+		int32 Idx = INDEX_NONE;
+	};
+	struct FEntryLess
+	{
+		// Menor F primero; en empate, el ms profundo (mayor G) para reducir expansiones.
+		bool operator()(const FEntry& A, const FEntry& B) const { return A.F < B.F || (A.F == B.F && A.G > B.G); }
+	};
+
+	TArray<float>  G;
+	TArray<int32>  Parent;
+	TArray<uint32> SeenStamp;
+	TArray<uint32> ClosedStamp;
+	TArray<FEntry> Heap;
+	uint32 Generation = 0;
+
+	void Begin(int32 NumCells)
+	{
+		if (G.Num() < NumCells)
+		{
+			G.SetNumUninitialized(NumCells);
+			Parent.SetNumUninitialized(NumCells);
+			SeenStamp.SetNumZeroed(NumCells);
+			ClosedStamp.SetNumZeroed(NumCells);
+		}
+		if (++Generation == 0)
+		{
+			FMemory::Memzero(SeenStamp.GetData(), SeenStamp.Num() * sizeof(uint32));
+			FMemory::Memzero(ClosedStamp.GetData(), ClosedStamp.Num() * sizeof(uint32));
+			Generation = 1;
+		}
+		Heap.Reset();
+	}
+
+	bool IsSeen(int32 Idx) const   { return SeenStamp[Idx] == Generation; }
+	bool IsClosed(int32 Idx) const { return ClosedStamp[Idx] == Generation; }
+	void Close(int32 Idx)          { ClosedStamp[Idx] = Generation; }
+
+	void Relax(int32 Idx, float NewG, int32 From, float H)
+	{
+		SeenStamp[Idx] = Generation;
+		G[Idx] = NewG;
+		Parent[Idx] = From;
+		Heap.HeapPush(FEntry{ NewG + H, NewG, Idx }, FEntryLess());
+	}
+
+	bool PopOpen(FEntry& Out)
+	{
+		while (Heap.Num() > 0)
+		{
+			Heap.HeapPop(Out, FEntryLess(), EAllowShrinking::No);
+			// Descartar entradas obsoletas (lazy deletion)
+			if (!IsClosed(Out.Idx) && Out.G <= G[Out.Idx]) return true;
+		}
+		return false;
+	}
+
+	SIZE_T GetAllocatedSize() const
+	{
+		return G.GetAllocatedSize() + Parent.GetAllocatedSize() + SeenStamp.GetAllocatedSize() + ClosedStamp.GetAllocatedSize() + Heap.GetAllocatedSize();
+	}
+
+	// Coste final de una celda cerrada (MAX si no se alcanz)
+	float GetClosedCost(int32 Idx) const { return IsClosed(Idx) ? G[Idx] : TNumericLimits<float>::Max(); }
+};
+
+// Traza de una consulta (diagnstico, ver FGridPathTraceRing). Acotada a MaxSamples expansiones.
+struct FGridSearchTrace
+{
+	FIntPoint Start = FIntPoint::ZeroValue;
+	FIntPoint Goal = FIntPoint::ZeroValue;
+	uint8 Planner = 0;
+	bool bReachedGoal = false;
+	bool bSlow = false;       // capturada automticamente por superar bc.path.trace.slowms
+	bool bTruncated = false;
+	float Millis = 0.f;
+	int32 NodesExpanded = 0;
+	double CaptureTime = 0.0;
+
+	TArray<FIntPoint> Expanded; // en orden de expansin
+	TArray<int32> OpenSize;     // tamao del open set en cada expansin
+	TArray<FIntPoint> Path;
+	int32 MaxSamples = 0;
+
+	FORCEINLINE void OnExpand(const FIntPoint& Cell, int32 OpenNum)
+	{
+		if (Expanded.Num() < MaxSamples)
+		{
+			Expanded.Add(Cell);
+			OpenSize.Add(OpenNum);
+		}
+		else
+		{
+			bTruncated = true;
+		}
+	}
+};
+
+struct FGridSearchQuery
+{
+	FIntPoint Start = FIntPoint::ZeroValue;
+	FIntPoint Goal = FIntPoint::ZeroValue;
+	FGridSearchBounds Bounds;
+	float ImpassableCost = 1e9f;
+	// Horizonte en expansiones (0 = sin lmite)
+	int32 MaxExpansions = 0;
+	bool bAllowPartial = true;
+	// Opcional: registra expansiones (nullptr = sin coste)
+	FGridSearchTrace* Trace = nullptr;
+};
+
+struct FGridSearchResult
+{
+	TArray<FIntPoint> Cells;
+	float TotalCost = 0.f;
+	bool bReachedGoal = false;
+	int32 NodesExpanded = 0;
+};
+
+namespace GridSearch
+{
+	// Vecinos en el mismo orden que UMapGridSubsystem::GetNeighbors4 (N, E, S, O).
+	static const FIntPoint Dir4[4] = { FIntPoint(0, -1), FIntPoint(1, 0), FIntPoint(0, 1), FIntPoint(-1, 0) };
+
+	// A* cardinal. CostOf(Cell) = coste de ENTRAR en la celda; H(Cell) admisible.
+	// Con MaxExpansions agotado o meta inalcanzable devuelve la ruta a la celda cerrada de
+	// menor F (si bAllowPartial). El horizonte en pasos (MaxSteps) lo aplica el manager despus.
+	template<typename FCostFunc, typename FHeuristicFunc>
+	bool RunAStar(FGridSearchScratch& S, const FGridSearchQuery& Q, FCostFunc&& CostOf, FHeuristicFunc&& H, FGridSearchResult& Out)
+	{
+		Out = FGridSearchResult{};
+		const FGridSearchBounds& B = Q.Bounds;
+		if (!B.Contains(Q.Start)) return false;
+
+		S.Begin(B.Num());
+		const int32 StartIdx = B.ToIndex(Q.Start);
+		const int32 GoalIdx = B.Contains(Q.Goal) ? B.ToIndex(Q.Goal) : INDEX_NONE;
+
+		S.Relax(StartIdx, 0.f, INDEX_NONE, H(Q.Start));
+
+		int32 ReachedIdx = INDEX_NONE;
+		int32 BestIdx = StartIdx;
+		float BestF = TNumericLimits<float>::Max();
+
+		FGridSearchScratch::FEntry Cur;
+		while (S.PopOpen(Cur))
+		{
+			if (Cur.Idx == GoalIdx) { ReachedIdx = GoalIdx; break; }
+
+			S.Close(Cur.Idx);
+			++Out.NodesExpanded;
+			if (Cur.F < BestF) { BestF = Cur.F; BestIdx = Cur.Idx; }
+
+			const FIntPoint C = B.ToCell(Cur.Idx);
+			if (Q.Trace) Q.Trace->OnExpand(C, S.Heap.Num());
+			for (const FIntPoint& D : Dir4)
+			{
+				const FIntPoint N = C + D;
+				if (!B.Contains(N)) continue;
+				const int32 NIdx = B.ToIndex(N);
+				if (S.IsClosed(NIdx)) continue;
+
+				const float MoveCost = CostOf(N);
+				if (MoveCost >= Q.ImpassableCost) continue;
+
+				const float TentG = Cur.G + MoveCost;
+				if (!S.IsSeen(NIdx) || TentG < S.G[NIdx])
+				{
+					S.Relax(NIdx, TentG, Cur.Idx, H(N));
+				}
+			}
+
+			if (Q.MaxExpansions > 0 && Out.NodesExpanded >= Q.MaxExpansions) break;
+		}
+
+		if (ReachedIdx == INDEX_NONE)
+		{
+			if (!Q.bAllowPartial) return false;
+			ReachedIdx = BestIdx;
+		}
+
+		for (int32 Idx = ReachedIdx; Idx != INDEX_NONE; Idx = S.Parent[Idx])
+		{
+			Out.Cells.Add(B.ToCell(Idx));
+		}
+		Algo::Reverse(Out.Cells);
+
+		Out.TotalCost = S.G[ReachedIdx];
+		Out.bReachedGoal = (ReachedIdx == GoalIdx);
+		return true;
+	}
+
+	// Dijkstra completo dentro de Bounds; los costes quedan en S (GetClosedCost).
+	template<typename FCostFunc>
+	int32 RunDijkstra(FGridSearchScratch& S, const FGridSearchBounds& B, const FIntPoint& Start, float ImpassableCost, FCostFunc&& CostOf)
+	{
+		if (!B.Contains(Start)) return 0;
+		S.Begin(B.Num());
+		S.Relax(B.ToIndex(Start), 0.f, INDEX_NONE, 0.f);
+
+		int32 Expanded = 0;
+		FGridSearchScratch::FEntry Cur;
+		while (S.PopOpen(Cur))
+		{
+			S.Close(Cur.Idx);
+			++Expanded;
+			const FIntPoint C = B.ToCell(Cur.Idx);
+			for (const FIntPoint& D : Dir4)
+			{
+				const FIntPoint N = C + D;
+				if (!B.Contains(N)) continue;
+				const int32 NIdx = B.ToIndex(N);
+				if (S.IsClosed(NIdx)) continue;
+				const float MoveCost = CostOf(N);
+				if (MoveCost >= ImpassableCost) continue;
+				const float TentG = Cur.G + MoveCost;
+				if (!S.IsSeen(NIdx) || TentG < S.G[NIdx]) S.Relax(NIdx, TentG, Cur.Idx, 0.f);
+			}
+		}
+		return Expanded;
+	}
+
+	// A* con orientacin: estado = celda local * 4 + direccin con la que se entr (Dir4), en el mismo
+	// scratch/heap que RunAStar con 4x estados. Cambiar de direccin suma TurnCost (el tanque se para y
+	// espera TurnDelay). StartDir = INDEX_NONE: orientacin inicial libre. h aade un giro si es inevitable.
+	template<typename FCostFunc, typename FHeuristicFunc>
+	bool RunTurnAwareAStar(FGridSearchScratch& S, const FGridSearchQuery& Q, int32 StartDir, float TurnCost,
+		FCostFunc&& CostOf, FHeuristicFunc&& H, FGridSearchResult& Out)
+	{
+		Out = FGridSearchResult{};
+		const FGridSearchBounds& B = Q.Bounds;
+		if (!B.Contains(Q.Start)) return false;
+
+		S.Begin(B.Num() * 4);
+		const int32 GoalIdx = B.Contains(Q.Goal) ? B.ToIndex(Q.Goal) : INDEX_NONE;
+
+		// Giro mnimo que an falta desde (C, Dir) hasta la meta
+		auto TurnH = [&Q, TurnCost](const FIntPoint& C, int32 Dir)
+			{
+				const int32 Dx = Q.Goal.X - C.X, Dy = Q.Goal.Y - C.Y;
+				if (Dx != 0 && Dy != 0) return TurnCost;
+				if (Dx == 0 && Dy == 0) return 0.f;
+				const FIntPoint Want(FMath::Sign(Dx), FMath::Sign(Dy));
+				return Dir4[Dir] == Want ? 0.f : TurnCost;
+			};
+
+		const int32 StartIdx = B.ToIndex(Q.Start);
+		for (int32 Dir = 0; Dir < 4; ++Dir)
+		{
+			if (StartDir != INDEX_NONE && Dir != StartDir) continue;
+			S.Relax(StartIdx * 4 + Dir, 0.f, INDEX_NONE, H(Q.Start) + TurnH(Q.Start, Dir));
+		}
+
+		int32 ReachedState = INDEX_NONE;
+		int32 BestState = StartIdx * 4 + FMath::Max(0, StartDir);
+		float BestF = TNumericLimits<float>::Max();
+
+		FGridSearchScratch::FEntry Cur;
+		while (S.PopOpen(Cur))
+		{
+			const int32 CellIdx = Cur.Idx >> 2;
+			const int32 Dir = Cur.Idx & 3;
+			if (CellIdx == GoalIdx) { ReachedState = Cur.Idx; break; }
+
+			S.Close(Cur.Idx);
+			++Out.NodesExpanded;
+			if (Cur.F < BestF) { BestF = Cur.F; BestState = Cur.Idx; }
+
+			const FIntPoint C = B.ToCell(CellIdx);
+			if (Q.Trace) Q.Trace->OnExpand(C, S.Heap.Num());
+			for (int32 NDir = 0; NDir < 4; ++NDir)
+			{
+				const FIntPoint N = C + Dir4[NDir];
+				if (!B.Contains(N)) continue;
+				const int32 NState = B.ToIndex(N) * 4 + NDir;
+				if (S.IsClosed(NState)) continue;
+
+				const float MoveCost = CostOf(N);
+				if (MoveCost >= Q.ImpassableCost) continue;
+
+				const float TentG = Cur.G + MoveCost + (NDir != Dir ? TurnCost : 0.f);
+				if (!S.IsSeen(NState) || TentG < S.G[NState])
+				{
+					S.Relax(NState, TentG, Cur.Idx, H(N) + TurnH(N, NDir));
+				}
+			}
+
+			if (Q.MaxExpansions > 0 && Out.NodesExpanded >= Q.MaxExpansions) break;
+		}
+
+		if (ReachedState == INDEX_NONE)
+		{
+			if (!Q.bAllowPartial) return false;
+			ReachedState = BestState;
+			if (!S.IsSeen(ReachedState)) return false;
+		}
+
+		for (int32 St = ReachedState; St != INDEX_NONE; St = S.Parent[St])
+		{
+			Out.Cells.Add(B.ToCell(St >> 2));
+		}
+		Algo::Reverse(Out.Cells);
+
+		Out.TotalCost = S.G[ReachedState];
+		Out.bReachedGoal = (ReachedState >> 2) == GoalIdx;
+		return true;
+	}
+}
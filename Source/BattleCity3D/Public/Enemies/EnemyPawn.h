@@ -2,13 +2,14 @@
 #include "CoreMinimal.h"
 #include "Common/BattleTankPawn.h" // Heredar de la base
 #include "EnemyEnums.h"
+#include "Common/GameplayTimerWheel.h"
 #include "EnemyPawn.generated.h"
 
 class UEnemyMovementComponent;
 
 // Heredamos de ABattleTankPawn
 UCLASS()
-class BATTLECITY3D_API AEnemyPawn : public ABattleTankPawn
+class BATTLECITY3D_API AEnemyPawn : public ABattleTankPawn, public FGameplayTimerTarget
 {
 	GENERATED_BODY()
 
@@ -16,7 +17,10 @@ public:
 	AEnemyPawn();
 
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 	virtual void Tick(float DeltaSeconds) override;
+	// Turno de decisin de UpdateAI (rueda de timers)
+	virtual void OnGameplayTimer(uint32 Payload) override;
 
 	void ApplyHit(int32 Dmg);
 
@@ -57,8 +61,18 @@ public:
 	UEnemyMovementComponent* MovementComp = nullptr;
 
 private:
-	double NextAIDecisionTime = 0.0;
-	FTimerHandle FireTimer;
+	// Foto de objetivos del frame (base, jugador)
+	UPROPERTY() class UBattleTargetRegistry* Targets = nullptr;
+
+	FGameplayTimerHandle FireTimer; // en UGameplayTimerSubsystem
+	FTimerHandle FireTimerFallback; // en FTimerManager si el mundo no tiene el subsistema
+
+	// Cadencia de UpdateAI: un timer de una vez marca el turno; cada decisin programa el siguiente
+	bool bAIDecisionDue = false;
+	FGameplayTimerHandle AIDecisionTimer;
+	FTimerHandle AIDecisionTimerFallback;
+	void ScheduleAIDecision(float Delay);
+	void MarkAIDecisionDue() { bAIDecisionDue = true; }
 
 	// Lgica de cerebro (decidir A DONDE ir)
 	void UpdateAI(float DT);
@@ -0,0 +1,69 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "MassEntityTypes.h"
+#include "Enemies/EnemyEnums.h"
+#include "HordeFragments.generated.h"
+
+// Sin direccin (ndices de GridSearch::Dir4)
+static constexpr uint8 HordeNoDir = 0xFF;
+
+// Posicin en unidades de celda (entero = centro de celda, igual que GridToWorld) y celda actual.
+// Held/Ahead: celdas reclamadas en UHordeSubsystem (la que ocupa y la que est entrando).
+USTRUCT()
+struct BATTLECITY3D_API FHordeGridFragment : public FMassFragment
+{
+	GENERATED_BODY()
+
+	FVector2f Pos = FVector2f::ZeroVector;
+	FIntPoint Cell = FIntPoint::ZeroValue;
+	FIntPoint Held = FIntPoint(INDEX_NONE, INDEX_NONE);
+	FIntPoint Ahead = FIntPoint(INDEX_NONE, INDEX_NONE);
+	int32 ClaimId = 0;
+};
+
+// Orientacin del tanque (Dir4)
+USTRUCT()
+struct BATTLECITY3D_API FHordeFacingFragment : public FMassFragment
+{
+	GENERATED_BODY()
+
+	uint8 Dir = 2;
+};
+
+// Rapidez sobre el eje de Facing (celdas/s) y parn de giro pendiente
+USTRUCT()
+struct BATTLECITY3D_API FHordeVelocityFragment : public FMassFragment
+{
+	GENERATED_BODY()
+
+	float Speed = 0.f;
+	float TurnDelayLeft = 0.f;
+};
+
+// Objetivo y direccin que toma en el prximo centro de celda
+USTRUCT()
+struct BATTLECITY3D_API FHordeGoalFragment : public FMassFragment
+{
+	GENERATED_BODY()
+
+	EEnemyGoal Goal = EEnemyGoal::HuntBase;
+	uint8 WantDir = HordeNoDir;
+};
+
+// Tipo, vida y disparo. Seed reparte los empates para que la horda no vaya en fila india.
+USTRUCT()
+struct BATTLECITY3D_API FHordeTankFragment : public FMassFragment
+{
+	GENERATED_BODY()
+
+	EEnemyType Type = EEnemyType::Basic;
+	int32 HitPoints = 1;
+	float FireCooldown = 0.f;
+	uint32 Seed = 0;
+};
+
+USTRUCT()
+struct BATTLECITY3D_API FHordeTag : public FMassTag
+{
+	GENERATED_BODY()
+};
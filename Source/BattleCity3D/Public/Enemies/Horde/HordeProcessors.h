@@ -0,0 +1,78 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "MassProcessor.h"
+#include "MassEntityQuery.h"
+#include "HordeProcessors.generated.h"
+
+class UHordeSubsystem;
+
+/**
+ * Procesadores de la horda. No se registran en las fases de Mass (no usamos MassSimulation):
+ * UHordeSubsystem los crea y los ejecuta en este orden una vez por frame, con el grid y los
+ * campos de distancia como foto fija. Decisin y movimiento van en paralelo por chunk.
+ */
+UCLASS(Abstract)
+class BATTLECITY3D_API UHordeProcessorBase : public UMassProcessor
+{
+	GENERATED_BODY()
+public:
+	UHordeProcessorBase();
+
+	UPROPERTY(Transient) TObjectPtr<UHordeSubsystem> Horde;
+};
+
+// Elige la direccin del prximo centro de celda bajando por el campo de distancia del objetivo
+UCLASS()
+class BATTLECITY3D_API UHordeDecisionProcessor : public UHordeProcessorBase
+{
+	GENERATED_BODY()
+public:
+	UHordeDecisionProcessor();
+protected:
+	virtual void ConfigureQueries(const TSharedRef<FMassEntityManager>& EntityManager) override;
+	virtual void Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context) override;
+private:
+	FMassEntityQuery EntityQuery;
+};
+
+// Movimiento cardinal del tanque: aceleracin, giro slo en centros de celda con TurnDelay y parada ante celdas cerradas
+UCLASS()
+class BATTLECITY3D_API UHordeMovementProcessor : public UHordeProcessorBase
+{
+	GENERATED_BODY()
+public:
+	UHordeMovementProcessor();
+protected:
+	virtual void ConfigureQueries(const TSharedRef<FMassEntityManager>& EntityManager) override;
+	virtual void Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context) override;
+private:
+	FMassEntityQuery EntityQuery;
+};
+
+// Dispara a ladrillos de frente o a la base/jugador en lnea; los disparos se encolan en el subsistema
+UCLASS()
+class BATTLECITY3D_API UHordeFireProcessor : public UHordeProcessorBase
+{
+	GENERATED_BODY()
+public:
+	UHordeFireProcessor();
+protected:
+	virtual void ConfigureQueries(const TSharedRef<FMassEntityManager>& EntityManager) override;
+	virtual void Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context) override;
+private:
+	FMassEntityQuery EntityQuery;
+};
+
+// Transforms de instancias (ISM) y ocupacin por celda para los impactos
+UCLASS()
+class BATTLECITY3D_API UHordeRenderProcessor : public UHordeProcessorBase
+{
+	GENERATED_BODY()
+public:
+	UHordeRenderProcessor();
+protected:
+	virtual void ConfigureQueries(const TSharedRef<FMassEntityManager>& EntityManager) override;
+	virtual void Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context) override;
+private:
+	FMassEntityQuery EntityQuery;
+};
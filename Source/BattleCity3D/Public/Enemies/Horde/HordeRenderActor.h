@@ -0,0 +1,29 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "HordeRenderActor.generated.h"
+
+class UInstancedStaticMeshComponent;
+class UStaticMesh;
+class UMaterialInterface;
+
+// Representacin de la horda: un ISM con una instancia por entidad, reescrito cada frame
+UCLASS(NotPlaceable, Transient)
+class BATTLECITY3D_API AHordeRenderActor : public AActor
+{
+	GENERATED_BODY()
+public:
+	AHordeRenderActor();
+
+	void SetupMesh(UStaticMesh* Mesh, UMaterialInterface* Material);
+
+	// Ajusta el n de instancias (slo aade/quita al final) y sube todos los transforms de golpe
+	void UpdateInstances(const TArray<FTransform>& Transforms);
+
+protected:
+	UPROPERTY(VisibleAnywhere, Category = "Horde") UInstancedStaticMeshComponent* TanksISM;
+
+private:
+	TArray<int32> RemoveScratch;
+	TArray<FTransform> AddScratch;
+};
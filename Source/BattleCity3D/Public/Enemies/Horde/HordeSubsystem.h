@@ -0,0 +1,167 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "MassEntityTypes.h"
+#include "MassArchetypeTypes.h"
+#include "Map/GridBitboard.h"
+#include "Enemies/EnemyEnums.h"
+#include "HordeSubsystem.generated.h"
+
+// stat BCHorde (lo comparten el subsistema y los procesadores)
+DECLARE_STATS_GROUP(TEXT("BattleCity Horde"), STATGROUP_BCHorde, STATCAT_Advanced);
+
+class AEnemyPawn;
+class AProjectile;
+class AHordeRenderActor;
+class UMapGridSubsystem;
+class UMassProcessor;
+struct FMassEntityManager;
+
+// Parmetros de movimiento y combate de un tipo, en unidades de celda (salen del CDO de la clase de enemigo)
+struct FHordeTypeParams
+{
+	float Speed = 5.f;      // celdas/s
+	float AccelRate = 6.f;
+	float TurnDelay = 0.06f;
+	float FireInterval = 1.5f;
+	int32 HitPoints = 1;
+};
+
+// Disparo pedido por UHordeFireProcessor; se spawnea en el hilo de juego tras el pipeline
+struct FHordeShot
+{
+	FVector2f Pos;
+	uint8 Dir;
+};
+
+/**
+ * Modo horda: miles de tanques enemigos como entidades de MassEntity en vez de AEnemyPawn.
+ * Cada entidad lleva fragmentos de celda, orientacin, velocidad, objetivo y tanque; los
+ * procesadores de decisin, movimiento, disparo y render se ejecutan una vez por frame desde
+ * aqu, con las mismas reglas de grid que los pawns (ejes cardinales, giros en centro de celda
+ * con TurnDelay, agua y acero cierran, los ladrillos se rompen a tiros).
+ *
+ * La navegacin no es A* por entidad: hay un campo de distancia por objetivo (FGridBitBFS sobre
+ * WalkableBits) hacia la base, que slo cambia con el mapa, y otro hacia el jugador, que se
+ * rehace cuando cambia de celda; cada entidad baja por el suyo. Las balas del jugador consultan
+ * la ocupacin por celda (HitAt) y, con bc.horde.promote, las entidades cerca del jugador pasan a
+ * ser AEnemyPawn completos (hasta MaxPromotedActors).
+ *
+ * La horda no cuenta para oleadas ni victoria: es un modo de carga aparte del EnemySpawner.
+ */
+UCLASS(Config = Game)
+class BATTLECITY3D_API UHordeSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+public:
+	UHordeSubsystem();
+
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	// Crea Count entidades repartidas entre los spawns. Type < 0 = tipos mezclados. Devuelve las creadas.
+	int32 SpawnHorde(int32 Count, int32 Type = -1);
+	void ClearHorde();
+	int32 GetNumEntities() const { return NumEntities; }
+
+	// Impacto de una bala del jugador en WorldPos: daa a la primera entidad que toque. O(1)
+	bool HitAt(const FVector& WorldPos, float Radius);
+
+	// === Consultas de los procesadores (slo lectura durante el pipeline)
+	const UMapGridSubsystem* GetGrid() const { return Grid; }
+	const FHordeTypeParams& GetParams(EEnemyType Type) const { return TypeParams[(int32)Type & 3]; }
+	uint16 GetGoalDistance(EEnemyGoal Goal, const FIntPoint& Cell) const;
+	bool IsOpenCell(const FIntPoint& Cell) const;
+	bool IsBrickCell(const FIntPoint& Cell) const;
+	bool HasPlayer() const { return bHasPlayer; }
+	const FIntPoint& GetPlayerCell() const { return PlayerCell; }
+	bool IsBaseCell(const FIntPoint& Cell) const;
+	// Libre para entrar: abierta y sin base ni pawns (jugador o enemigos) de la foto del frame
+	bool CanEnterCell(const FIntPoint& Cell) const;
+	// Reserva atmica de celdas entre entidades (se llaman desde el movimiento en paralelo).
+	// ClaimCell: true si la celda queda (o ya era) de ClaimId; ReleaseCell slo suelta las propias.
+	bool ClaimCell(const FIntPoint& Cell, int32 ClaimId);
+	void ReleaseCell(const FIntPoint& Cell, int32 ClaimId);
+	FVector CellToWorld(const FVector2f& Pos, float Z = 0.f) const;
+	FRotator DirToRotation(uint8 Dir) const;
+	// Malla del tanque relativa al actor y altura del actor sobre el grid
+	const FTransform& GetMeshRelative() const { return MeshRelative; }
+	float GetTankZ() const { return TankZ; }
+
+	// === Ajustes
+	// Clase de enemigo de referencia (velocidad, giro, vida, malla) y la que se usa al promocionar
+	UPROPERTY(Config, EditAnywhere, Category = "Horde") TSubclassOf<AEnemyPawn> EnemyClass;
+	UPROPERTY(Config, EditAnywhere, Category = "Horde") TSubclassOf<AProjectile> ProjectileClass;
+	// Probabilidad de que una entidad nueva cace al jugador en vez de la base
+	UPROPERTY(Config, EditAnywhere, Category = "Horde", meta = (ClampMin = "0", ClampMax = "1")) float HuntPlayerChance = 0.3f;
+	// Alcance en celdas al buscar base o jugador en lnea
+	UPROPERTY(Config, EditAnywhere, Category = "Horde", meta = (ClampMin = "1")) int32 FireRangeCells = 12;
+	// Balas nuevas por frame como mucho (el resto espera a su siguiente cooldown)
+	UPROPERTY(Config, EditAnywhere, Category = "Horde", meta = (ClampMin = "0")) int32 MaxShotsPerFrame = 24;
+	// Radio de impacto de una entidad en celdas
+	UPROPERTY(Config, EditAnywhere, Category = "Horde") float HitRadiusCells = 0.45f;
+	UPROPERTY(Config, EditAnywhere, Category = "Horde|Promote") float PromoteRadiusCells = 4.f;
+	UPROPERTY(Config, EditAnywhere, Category = "Horde|Promote", meta = (ClampMin = "0")) int32 MaxPromotedActors = 8;
+	UPROPERTY(Config, EditAnywhere, Category = "Horde|Promote") float PromoteIntervalSeconds = 0.25f;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	friend class UHordeFireProcessor;
+	friend class UHordeRenderProcessor;
+
+	bool EnsureSetup();
+	void LoadTypeParams();
+	void RefreshFields();
+	void RefreshPawnCells();
+	void RunPipeline(float DeltaTime);
+	void FlushKills();
+	void SpawnShots();
+	void PromoteNearPlayer(float DeltaTime);
+	FVector2f WorldToCellPos(const FVector& WorldPos) const;
+
+	UPROPERTY(Transient) TObjectPtr<UMapGridSubsystem> Grid;
+	UPROPERTY(Transient) TObjectPtr<AHordeRenderActor> RenderActor;
+	UPROPERTY(Transient) TArray<TObjectPtr<UMassProcessor>> Processors;
+	TSharedPtr<FMassEntityManager> EntityManager;
+	FMassArchetypeHandle Archetype;
+
+	FHordeTypeParams TypeParams[4];
+	uint32 SpawnSerial = 0;
+	int32 NumEntities = 0;
+
+	// Campos de distancia (FGridBitBFS::Unreached = inalcanzable)
+	FGridBitBFS Bfs;
+	TArray<uint16> BaseField;
+	TArray<uint16> PlayerField;
+	uint32 FieldsLayoutVersion = 0;
+	FIntPoint PlayerCell = FIntPoint(INDEX_NONE, INDEX_NONE);
+	bool bHasPlayer = false;
+
+	// Ejes del grid en mundo (por celda), para pasar de posicin en celdas a mundo
+	FVector GridOrigin = FVector::ZeroVector;
+	FVector GridAxisX = FVector::ForwardVector;
+	FVector GridAxisY = FVector::RightVector;
+	FTransform MeshRelative = FTransform::Identity;
+	float TankZ = 0.f;
+
+	// Dueo de cada celda para el movimiento (ClaimId de la entidad, 0 = libre) y celdas con pawns
+	TArray<int32> CellClaims;
+	FGridBitboard PawnCells;
+
+	// Ocupacin del ltimo frame para impactos y promocin: lista enlazada por celda sobre Occupants
+	TArray<int32> CellHead;
+	TArray<int32> NextInCell;
+	TArray<FMassEntityHandle> Occupants;
+	TArray<FVector2f> OccupantPos;
+
+	TArray<FTransform> InstanceTransforms;
+	TArray<FHordeShot> Shots;
+	TArray<FMassEntityHandle> PendingKills;
+
+	TArray<TWeakObjectPtr<AEnemyPawn>> Promoted;
+	float PromoteAccum = 0.f;
+};
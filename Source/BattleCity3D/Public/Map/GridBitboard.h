@@ -0,0 +1,99 @@
+#pragma once
+#include "CoreMinimal.h"
+
+/**
+ * Mscara de bits por celda: cada fila del grid son ceil(W/64) palabras uint64 (bit x = columna x).
+ * Los bits fuera del ancho quedan siempre a 0, as los desplazamientos no "salen" del mapa.
+ */
+class BATTLECITY3D_API FGridBitboard
+{
+public:
+	void Init(int32 InWidth, int32 InHeight);
+
+	int32 GetWidth() const { return Width; }
+	int32 GetHeight() const { return Height; }
+	int32 GetWordsPerRow() const { return WordsPerRow; }
+	bool IsEmpty() const { return Words.Num() == 0; }
+
+	bool Get(int32 X, int32 Y) const
+	{
+		return X >= 0 && Y >= 0 && X < Width && Y < Height && ((Words[Y * WordsPerRow + (X >> 6)] >> (X & 63)) & 1ull);
+	}
+	void Set(int32 X, int32 Y, bool bValue)
+	{
+		uint64& W = Words[Y * WordsPerRow + (X >> 6)];
+		const uint64 Bit = 1ull << (X & 63);
+		W = bValue ? (W | Bit) : (W & ~Bit);
+	}
+
+	const uint64* GetRow(int32 Y) const { return Words.GetData() + Y * WordsPerRow; }
+	uint64* GetRow(int32 Y) { return Words.GetData() + Y * WordsPerRow; }
+
+	int32 CountSet() const;
+	SIZE_T GetAllocatedSize() const { return Words.GetAllocatedSize(); }
+
+private:
+	friend class FGridBitBFS;
+
+	int32 Width = 0, Height = 0, WordsPerRow = 0;
+	TArray<uint64> Words;
+};
+
+/**
+ * BFS de coste unitario por frentes de onda: cada capa expande 64 celdas por palabra con
+ * desplazamientos y mscaras (E/O dentro de la fila con acarreo entre palabras, N/S = fila vecina).
+ * Los bucles por palabra son planos para que el compilador los vectorice (SSE/AVX/NEON).
+ * Reutiliza sus buffers entre llamadas: conviene mantener una instancia por usuario.
+ */
+class BATTLECITY3D_API FGridBitBFS
+{
+public:
+	static constexpr uint16 Unreached = 0xFFFF;
+
+	// Alcanzables desde Seeds (incluidas) en como mucho MaxLayers pasos (0 = sin lmite). Devuelve n de capas.
+	int32 Flood(const FGridBitboard& Passable, TConstArrayView<FIntPoint> Seeds, FGridBitboard& OutReached, int32 MaxLayers = 0);
+
+	// Distancia en pasos desde el Seed ms cercano (Unreached si no se alcanza). Devuelve n de capas.
+	int32 DistanceField(const FGridBitboard& Passable, TConstArrayView<FIntPoint> Seeds, TArray<uint16>& OutDist, int32 MaxLayers = 0);
+
+	// Distancia Start->Goal en pasos (INDEX_NONE si no se alcanza dentro de MaxLayers)
+	int32 LayerDistance(const FGridBitboard& Passable, const FIntPoint& Start, const FIntPoint& Goal, int32 MaxLayers = 0);
+
+	bool IsReachable(const FGridBitboard& Passable, const FIntPoint& Start, const FIntPoint& Goal)
+	{
+		return LayerDistance(Passable, Start, Goal) != INDEX_NONE;
+	}
+
+	SIZE_T GetAllocatedSize() const { return Frontier.GetAllocatedSize() + Next.GetAllocatedSize() + Visited.GetAllocatedSize(); }
+
+private:
+	TArray<uint64> Frontier;
+	TArray<uint64> Next;
+	TArray<uint64> Visited;
+	int32 RowMin = 0, RowMax = -1;
+
+	void Begin(const FGridBitboard& Passable, TConstArrayView<FIntPoint> Seeds);
+
+	// Una capa: Next = vecinos(Frontier) & Passable & ~Visited. false si el frente se agot.
+	bool Step(const FGridBitboard& Passable);
+
+	// Visita las celdas del frente actual (recin alcanzadas)
+	template<typename FVisit>
+	void ForEachFrontierCell(int32 WordsPerRow, FVisit&& Visit) const
+	{
+		for (int32 Y = RowMin; Y <= RowMax; ++Y)
+		{
+			const uint64* Row = Frontier.GetData() + Y * WordsPerRow;
+			for (int32 W = 0; W < WordsPerRow; ++W)
+			{
+				uint64 Bits = Row[W];
+				while (Bits)
+				{
+					const int32 Bit = (int32)FMath::CountTrailingZeros64(Bits);
+					Visit((W << 6) + Bit, Y);
+					Bits &= Bits - 1;
+				}
+			}
+		}
+	}
+};
@@ -0,0 +1,119 @@
+#pragma once
+#include "CoreMinimal.h"
+
+class UMapGridSubsystem;
+
+/**
+ * Estructura del mapa entre los spawns enemigos y la base:
+ *  - Articulaciones del grafo abierto (celdas cuya prdida parte el mapa) y chokepoints: las que
+ *    separan la base de algn spawn (Tarjan iterativo con raz en la base).
+ *  - Brecha: ladrillos a romper por la ruta con menos ladrillos de cada spawn (0-1 BFS desde la base).
+ *  - Corte mnimo de ladrillos: max-flow spawns->base con capacidad 1 en ladrillo e infinita en suelo
+ *    (Edmonds-Karp sobre el grafo con nodos desdoblados). Toda ruta de un spawn a la base cruza el corte.
+ * Al caer un ladrillo las distancias y el flujo se actualizan desde esa celda (slo pueden mejorar);
+ * las articulaciones se recalculan, O(celdas), en la siguiente consulta.
+ */
+class BATTLECITY3D_API FGridTopology
+{
+public:
+	static constexpr uint16 Unreached = 0xFFFF;
+
+	// MaxFlowCells: por encima no se calcula el corte (memoria del flujo ~ 36 bytes por celda)
+	void Build(const UMapGridSubsystem& Grid, int32 MaxFlowCells);
+	void Reset();
+	bool IsBuilt() const { return Width > 0; }
+
+	// Ladrillo destruido (o cualquier cambio de celda). false si hace falta Build.
+	bool OnCellChanged(const UMapGridSubsystem& Grid, const FIntPoint& Cell);
+
+	// Pone al da lo que se recalcula bajo demanda (articulaciones, brecha, corte)
+	void Refresh();
+
+	const TArray<FIntPoint>& GetArticulationCells() const { return ArticulationCells; }
+	const TArray<FIntPoint>& GetChokepoints() const { return Chokepoints; }
+	bool IsChokepoint(const FIntPoint& Cell) const { return ChokepointSet.Contains(Cell); }
+
+	// Ladrillos en la ruta con menos ladrillos hasta la base (Unreached si ni rompiendo se llega)
+	uint16 GetBricksToBase(const FIntPoint& Cell) const
+	{
+		const int32 Idx = CellIndex(Cell);
+		return Idx == INDEX_NONE ? Unreached : BrickDist[Idx];
+	}
+	const TArray<FIntPoint>& GetBreachBricks() const { return BreachBricks; }
+
+	// Corte mnimo (vaco si la base ya est abierta desde algn spawn o el mapa es demasiado grande)
+	const TArray<FIntPoint>& GetMinBrickCut() const { return MinCut; }
+	bool IsBaseOpen() const { return bBaseOpen; }
+	bool HasFlow() const { return bFlowEnabled; }
+
+	// Mtricas
+	int32 GetFullBuilds() const { return FullBuilds; }
+	int32 GetIncrementalUpdates() const { return IncrementalUpdates; }
+	int32 GetAugmentations() const { return Augmentations; }
+	SIZE_T GetAllocatedSize() const;
+
+private:
+	static constexpr int32 InfCap = MAX_int32 / 4;
+
+	int32 CellIndex(const FIntPoint& C) const
+	{
+		return (C.X >= 0 && C.Y >= 0 && C.X < Width && C.Y < Height) ? C.X + C.Y * Width : INDEX_NONE;
+	}
+	FIntPoint IndexToCell(int32 Idx) const { return FIntPoint(Idx % Width, Idx / Width); }
+	int32 Neighbor(int32 Idx, int32 Dir) const;
+
+	// Capacidad de la celda: 0 muro (agua/acero), 1 ladrillo, InfCap suelo, spawns y base
+	int32 CellCapacity(const UMapGridSubsystem& Grid, int32 Idx) const;
+	bool IsOpen(int32 Idx) const { return Cap[Idx] >= InfCap; }
+
+	void BuildBrickDistances();
+	// Relaja desde las celdas de BfsCur, que ya tienen distancia FromDist (slo mejoras)
+	void PropagateBrickDistance(uint16 FromDist);
+	void BuildArticulations();
+	void BuildBreach();
+
+	// Edmonds-Karp: aumenta hasta agotar; el ltimo BFS deja marcados los estados alcanzables
+	void Augment();
+	bool FindAugmentingPath(int32& OutSinkState);
+	bool VisitState(int32 State, int32 From);
+	void BuildCutFromReachable();
+
+	int32 Width = 0;
+	int32 Height = 0;
+	TArray<int32> Cap;
+	TArray<int32> Sources; // spawns
+	TArray<int32> Sinks;   // base
+	TBitArray<> IsSource;
+	TBitArray<> IsSink;
+
+	// 0-1 BFS: ladrillos hasta la base y direccin (GridSearch::Dir4) hacia ella
+	TArray<uint16> BrickDist;
+	TArray<uint8> BrickParent;
+	TArray<int32> BfsCur, BfsNext;
+
+	// Flujo: NodeFlow por celda (entrada->salida) y ArcFlow por arco salida(v)->entrada(vecino d)
+	bool bFlowEnabled = false;
+	bool bFlowDirty = false;
+	bool bBaseOpen = false;
+	TArray<int32> NodeFlow;
+	TArray<int32> ArcFlow;
+	TArray<int32> StateParent; // estado = celda*2 + (0 entrada, 1 salida)
+	TArray<uint32> StateVisit;
+	uint32 VisitEpoch = 0;
+	TArray<int32> StateQueue;
+
+	// Tarjan
+	bool bArticulationDirty = true;
+	TArray<int32> Disc, Low, Fin;
+	TArray<FIntPoint> ArticulationCells;
+	TArray<FIntPoint> Chokepoints;
+	TSet<FIntPoint> ChokepointSet;
+
+	bool bBreachDirty = true;
+	TArray<FIntPoint> BreachBricks;
+	TArray<FIntPoint> MinCut;
+
+	int32 FullBuilds = 0;
+	int32 IncrementalUpdates = 0;
+	int32 Augmentations = 0;
+};
@@ -64,6 +64,10 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Map|Tanks")
 	TSubclassOf<ATankPawn> PlayerTankClass = nullptr;
 
+	// Registra AGridNavigationData para que MoveTo/EQS/BT funcionen sobre el grid sin navmesh
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Map|Navigation")
+	bool bSpawnGridNavigationData = true;
+
 	// Cmara fija
 	UPROPERTY(EditAnywhere, Category = "Map|Camera")
 	FName FixedCameraTag = "FixedCamera";
@@ -3,6 +3,7 @@
 #include "Subsystems/GameInstanceSubsystem.h"
 #include "Utils/JsonMapUtils.h"
 #include "Components/GridPathFollow/GridPathTypes.h"
+#include "Map/GridBitboard.h"
 #include "MapGridSubsystem.generated.h"
 
 class UMapConfigAsset;
@@ -28,6 +29,9 @@ public:
 		AMapGenerator* VisualOwner,
 		int32 InSubdivisionsPerTile);
 
+	// Sin asset ni visual: mapas procedurales / benchmarks headless
+	bool InitializeFromConfig(const FMapConfig& Map, const FTransform& MapTransform);
+
 	// Grid <-> Mundo
 	bool WorldToGrid(const FVector& WorldPos, int32& OutX, int32& OutY) const;
 	FVector GridToWorld(int32 X, int32 Y, float ZOffset = 0.f) const;
@@ -70,6 +74,7 @@ public:
 	void GetBaseWorldLocations(TArray<FVector>& Out) const;
 	const TArray<FIntPoint>& GetPlayerSpawnCells() const { return PlayerSpawnCells; }
 	const TArray<FIntPoint>& GetEnemySpawnCells() const { return EnemySpawnCells; }
+	const TArray<FIntPoint>& GetBaseCells() const { return BaseCells; }
 
 
 	// Verifica si un punto exacto del mundo (sin redondear) toca un obstculo
@@ -88,10 +93,46 @@ public:
 
 	// ==== Pathfinding utils ====
 	void GetNeighbors4(const FIntPoint& Cell, TArray<FIntPoint>& OutNeighbors) const;
+	// Consulta suelta: compila el perfil en cada llamada. En bucles, FGridCostLUT una vez y la versin de abajo.
 	float GetTileCost(const FIntPoint& Cell, const FGridCostProfile& Profile) const;
-	bool IsPassableCell(const FIntPoint& Cell, const FGridCostProfile& Profile) const
+	// Versin rpida para bsquedas: perfil ya compilado, una lectura de tabla
+	float GetTileCost(const FIntPoint& Cell, const FGridCostLUT& Lut) const
+	{
+		return IsInside(Cell) && CellCodes.Num() > 0 ? Lut[CellCodes[XYToIndex(Cell.X, Cell.Y)]] : Lut.ImpassableCost;
+	}
+	// Cdigo de 4 bits (terreno | obstculo) de la celda, ver PackGridCellCode
+	uint8 GetCellCode(const FIntPoint& Cell) const
+	{
+		return IsInside(Cell) && CellCodes.Num() > 0 ? CellCodes[XYToIndex(Cell.X, Cell.Y)] : PackGridCellCode((uint8)ETerrainType::Water, 0);
+	}
+	bool IsPassableCell(const FIntPoint& Cell, const FGridCostLUT& Lut) const
+	{
+		return GetTileCost(Cell, Lut) < Lut.ImpassableCost;
+	}
+
+	// ==== Bitboards (BFS por bits, ver FGridBitBFS) ====
+	// Celdas por donde un tanque pasa ya (sin agua ni obstculo)
+	const FGridBitboard& GetOpenBits() const { return OpenBits; }
+	// Celdas atravesables rompiendo ladrillos (sin agua ni acero); no cambia durante la partida
+	const FGridBitboard& GetWalkableBits() const { return WalkableBits; }
+	// Componente conexa de WalkableBits (INDEX_NONE si no es atravesable). Distinta regin => no hay ruta.
+	int32 GetWalkableRegion(const FIntPoint& Cell) const
+	{
+		return IsInside(Cell) && WalkableRegion.Num() > 0 ? WalkableRegion[XYToIndex(Cell.X, Cell.Y)] : INDEX_NONE;
+	}
+
+	// ==== Siguiente obstculo (ladrillo o acero) por fila y columna ====
+	// Primera celda con obstculo estrictamente despus de From en la direccin cardinal Step. O(1);
+	// false si no hay ninguno hasta el borde.
+	bool FindNextObstacle(const FIntPoint& From, const FIntPoint& Step, FIntPoint& OutCell) const
 	{
-		return GetTileCost(Cell, Profile) < Profile.ImpassableCost;
+		if (!IsInside(From) || NextObstacleE.Num() == 0) return false;
+		const int32 Idx = XYToIndex(From.X, From.Y);
+		const uint16 C = Step.X > 0 ? NextObstacleE[Idx] : Step.X < 0 ? NextObstacleW[Idx]
+			: Step.Y > 0 ? NextObstacleS[Idx] : Step.Y < 0 ? NextObstacleN[Idx] : NoObstacle;
+		if (C == NoObstacle) return false;
+		OutCell = Step.X != 0 ? FIntPoint(C, From.Y) : FIntPoint(From.X, C);
+		return true;
 	}
 
 	// NUEVO: unin de celdas de spawn de todos los smbolos (excepto ".")
@@ -100,6 +141,9 @@ public:
 	// Evento: ladrillo destruido, etc.
 	FOnGridCellChanged OnGridCellChanged;
 
+	// Cambia en cada carga de mapa (los datos derivados deben reconstruirse)
+	uint32 GetLayoutVersion() const { return LayoutVersion; }
+
 private:
 	// Datos mapa
 	int32 MapWidth = 0, MapHeight = 0;
@@ -113,6 +157,23 @@ private:
 	TArray<ETerrainType>  TerrainGrid;
 	TArray<EObstacleType> ObstacleGrid;
 	TArray<uint8>         ObstacleHPGrid;
+	uint32                LayoutVersion = 0;
+
+	TArray<uint8> CellCodes;
+	FGridBitboard OpenBits;
+	FGridBitboard WalkableBits;
+	TArray<int32> WalkableRegion;
+
+	// Coordenada (x en las filas, y en las columnas) del siguiente obstculo en cada direccin
+	static constexpr uint16 NoObstacle = 0xFFFF;
+	TArray<uint16> NextObstacleE, NextObstacleW, NextObstacleS, NextObstacleN;
+
+	void RebuildDerivedLayers();
+	void RebuildObstacleTables();
+	// Slo el tramo de fila y columna entre los obstculos vecinos de (X, Y)
+	void PatchObstacleTables(int32 X, int32 Y);
+	// Ladrillo destruido: actualiza capas derivadas y notifica OnGridCellChanged
+	void NotifyCellChanged(int32 X, int32 Y);
 
 	TArray<FIntPoint> PlayerSpawnCells;
 	TArray<FIntPoint> EnemySpawnCells;
@@ -0,0 +1,47 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "Map/GridTopology.h"
+#include "MapTopologySubsystem.generated.h"
+
+class UMapGridSubsystem;
+
+// Servicio de topologa sobre UMapGridSubsystem (ver FGridTopology). Se construye al primer uso,
+// se actualiza con OnGridCellChanged y se reconstruye al cargar otro mapa.
+UCLASS(Config = Game)
+class BATTLECITY3D_API UMapTopologySubsystem : public UGameInstanceSubsystem
+{
+	GENERATED_BODY()
+public:
+	virtual void Deinitialize() override;
+
+	// Corte mnimo slo hasta este nmero de celdas (memoria del flujo)
+	UPROPERTY(Config, EditAnywhere, Category = "MapTopology")
+	int32 MaxFlowCells = 256 * 256;
+
+	// Consultas (ponen al da lo pendiente; nullptr/vaco si no hay mapa)
+	const FGridTopology* GetTopology();
+
+	const TArray<FIntPoint>& GetArticulationCells();
+	const TArray<FIntPoint>& GetChokepoints();
+	bool IsChokepoint(const FIntPoint& Cell);
+	// Ladrillos en la ruta ms barata hasta la base (FGridTopology::Unreached si no hay)
+	int32 GetBricksToBase(const FIntPoint& Cell);
+	const TArray<FIntPoint>& GetBreachBricks();
+	const TArray<FIntPoint>& GetMinBrickCut();
+	bool IsBaseOpen();
+
+	// Ladrillo de la brecha o del corte mnimo ms cercano a From (Manhattan). false si no queda ninguno.
+	bool FindNearestBreachBrick(const FIntPoint& From, FIntPoint& OutCell);
+	bool IsBreachBrick(const FIntPoint& Cell);
+
+private:
+	bool EnsureUpToDate();
+	void HandleGridCellChanged(FIntPoint Cell);
+
+	FGridTopology Topology;
+	TWeakObjectPtr<UMapGridSubsystem> BoundGrid;
+	FDelegateHandle CellChangedHandle;
+	uint32 BoundLayoutVersion = 0;
+	bool bNeedsBuild = true;
+};
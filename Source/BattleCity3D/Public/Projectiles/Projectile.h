@@ -7,6 +7,7 @@ class USphereComponent;
 class UProjectileMovementComponent;
 class UStaticMeshComponent;
 class UMapGridSubsystem;
+class UHordeSubsystem;
 
 UENUM(BlueprintType)
 enum class EProjectileTeam : uint8 { Player, Enemy };
@@ -25,6 +26,7 @@ public:
 
 protected:
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 	virtual void Tick(float DeltaSeconds) override;
 
 	void DoManualSweep(float DeltaSeconds);
@@ -44,4 +46,5 @@ protected:
 	FVector LastLocation = FVector::ZeroVector;
 
 	UPROPERTY() UMapGridSubsystem* Grid = nullptr;
+	UPROPERTY() UHordeSubsystem* Horde = nullptr;
 };
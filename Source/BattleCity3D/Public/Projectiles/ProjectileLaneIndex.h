@@ -0,0 +1,90 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "Projectiles/Projectile.h"
+
+class UMapGridSubsystem;
+
+// Estado de un proyectil que necesita el ndice (lo copia UProjectileLaneSubsystem cada frame)
+struct FProjectileLaneSample
+{
+	FVector Location = FVector::ZeroVector;
+	FVector Velocity = FVector::ZeroVector;
+	EProjectileTeam Team = EProjectileTeam::Player;
+};
+
+// Un proyectil dentro de su carril (fila si va en X, columna si va en Y)
+struct FProjectileLaneEntry
+{
+	FIntPoint Cell = FIntPoint::ZeroValue; // celda actual
+	uint8 Dir = 0;                         // GridSearch::Dir4 (N, E, S, W)
+	EProjectileTeam Team = EProjectileTeam::Player;
+	float CellsPerSecond = 0.f;
+	float Offset = 0.f;                    // avance dentro de la celda, en celdas (-0.5..0.5)
+	float EntryTime = 0.f;                 // segundos hasta entrar en la siguiente celda
+	int32 RangeCells = 0;                  // celdas por delante antes de chocar o salir del horizonte
+
+	// Segundos hasta llegar a una celda a K pasos por delante (0 = la actual)
+	float GetArrivalTime(int32 K) const
+	{
+		return K <= 0 ? 0.f : FMath::Max(0.f, (float)K - 0.5f - Offset) / CellsPerSecond;
+	}
+};
+
+/**
+ * ndice por frame de las balas en vuelo sobre el grid. Se reconstruye en O(proyectiles * celdas de alcance):
+ *  - carriles por fila y por columna (CSR) con las entradas ordenadas por EntryTime;
+ *  - una capa por equipo con el primer instante en que una bala llega a cada celda, as que
+ *    "pasa una bala por esta celda antes de T?" es una lectura.
+ * Slo se limpian las celdas tocadas en el frame anterior. Las balas paran en ladrillo/acero.
+ */
+class BATTLECITY3D_API FProjectileLaneIndex
+{
+public:
+	void Build(const UMapGridSubsystem& Grid, TConstArrayView<FProjectileLaneSample> Samples, float LookaheadSeconds);
+	void Reset();
+
+	// Segundos hasta que una bala de Team entra en Cell (MAX_flt si ninguna dentro del horizonte)
+	float GetArrivalTime(const FIntPoint& Cell, EProjectileTeam Team) const
+	{
+		const int32 Idx = CellIndex(Cell);
+		return Idx == INDEX_NONE ? MAX_flt : Arrival[(int32)Team][Idx];
+	}
+	bool IsThreatened(const FIntPoint& Cell, EProjectileTeam Team, float WithinSeconds) const
+	{
+		return GetArrivalTime(Cell, Team) <= WithinSeconds;
+	}
+
+	// Bala de Team que llega antes a Cell (recorre su fila y su columna). false si ninguna antes de WithinSeconds.
+	bool FindIncoming(const FIntPoint& Cell, EProjectileTeam Team, float WithinSeconds, FProjectileLaneEntry& OutEntry, float& OutArrival) const;
+
+	TConstArrayView<FProjectileLaneEntry> GetRowLane(int32 Y) const { return GetLane(Y); }
+	TConstArrayView<FProjectileLaneEntry> GetColumnLane(int32 X) const { return GetLane(Height + X); }
+
+	int32 Num() const { return Entries.Num(); }
+	int32 GetNumThreatenedCells(EProjectileTeam Team) const { return Touched[(int32)Team].Num(); }
+	SIZE_T GetAllocatedSize() const;
+
+private:
+	int32 CellIndex(const FIntPoint& C) const
+	{
+		return (C.X >= 0 && C.Y >= 0 && C.X < Width && C.Y < Height) ? C.X + C.Y * Width : INDEX_NONE;
+	}
+	// Carriles: [0, Height) filas, [Height, Height + Width) columnas
+	TConstArrayView<FProjectileLaneEntry> GetLane(int32 Lane) const
+	{
+		if (Lane < 0 || Lane + 1 >= LaneStart.Num()) return {};
+		return TConstArrayView<FProjectileLaneEntry>(Entries.GetData() + LaneStart[Lane], LaneStart[Lane + 1] - LaneStart[Lane]);
+	}
+
+	int32 Width = 0;
+	int32 Height = 0;
+
+	TArray<FProjectileLaneEntry> Entries; // agrupadas por carril
+	TArray<int32> LaneStart;              // Height + Width + 1
+	TArray<FProjectileLaneEntry> Pending; // sin ordenar (reutilizado)
+	TArray<int32> PendingLane;
+	TArray<int32> LaneFill;
+
+	TArray<float> Arrival[2];  // por EProjectileTeam, [X + Y*W]
+	TArray<int32> Touched[2];
+};
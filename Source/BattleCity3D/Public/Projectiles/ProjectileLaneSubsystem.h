@@ -0,0 +1,48 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Projectiles/ProjectileLaneIndex.h"
+#include "ProjectileLaneSubsystem.generated.h"
+
+class AProjectile;
+class UGridPathManager;
+
+/**
+ * Mantiene FProjectileLaneIndex con las balas vivas (se registran en BeginPlay/EndPlay) y lo
+ * reconstruye una vez por frame, tras el tick de los actores. Lo consultan los perfiles de coste
+ * con ThreatCost (va UGridPathManager) y la poltica de movimiento Dodge.
+ */
+UCLASS()
+class BATTLECITY3D_API UProjectileLaneSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+public:
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	void RegisterProjectile(AProjectile* Projectile);
+	void UnregisterProjectile(AProjectile* Projectile);
+
+	// Pasar una bala de Team por Cell en los prximos WithinSeconds? O(1)
+	bool IsCellInFireLane(const FIntPoint& Cell, float WithinSeconds, EProjectileTeam Team) const
+	{
+		return Index.IsThreatened(Cell, Team, WithinSeconds);
+	}
+	const FProjectileLaneIndex& GetIndex() const { return Index; }
+
+	// Horizonte del ndice: ms all no se marca ninguna celda
+	float LookaheadSeconds = 1.5f;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	TArray<TWeakObjectPtr<AProjectile>> Projectiles;
+	TArray<FProjectileLaneSample> Samples; // reutilizado cada frame
+	FProjectileLaneIndex Index;
+
+	TWeakObjectPtr<UGridPathManager> PathMgr;
+	void DrawDebug() const;
+};
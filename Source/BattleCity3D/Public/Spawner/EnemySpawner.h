@@ -9,6 +9,9 @@ class UMapGridSubsystem;
 class USpawnPointPolicy;
 class AEnemyPawn;
 class UEnemyGoalPolicy;
+class UEnemyMovePolicy;
+class UEnemyMovePolicy_PathFollow;
+class FEnemySquad;
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnEnemyEvent, AEnemyPawn*, Enemy);
 
@@ -17,9 +20,29 @@ struct FEnemyPathDefaults
 {
 	GENERATED_BODY()
 	UPROPERTY(EditAnywhere) FGridCostProfile Cost = { 1.f, 10.f, 1e9f };
+	// Perfil por tipo de enemigo (si no est, se usa Cost)
+	UPROPERTY(EditAnywhere) TMap<EEnemyType, FGridCostProfile> CostByType;
 	UPROPERTY(EditAnywhere) float ReplanInterval = 0.35f;
 	UPROPERTY(EditAnywhere) int32 HorizonSteps = 6;
 	UPROPERTY(EditAnywhere) bool  bTargetIsPlayer = true;
+
+	FEnemyPathDefaults()
+	{
+		// Rpidos: evitan el hielo (derrapan). Blindados: prefieren abrirse paso por el ladrillo.
+		FGridCostProfile FastCost = Cost;
+		FastCost.IceExtraCost = 4.f;
+		CostByType.Add(EEnemyType::Fast, FastCost);
+
+		FGridCostProfile ArmoredCost = Cost;
+		ArmoredCost.BrickCost = 3.f;
+		CostByType.Add(EEnemyType::Armored, ArmoredCost);
+	}
+
+	const FGridCostProfile& GetCostFor(EEnemyType Type) const
+	{
+		const FGridCostProfile* P = CostByType.Find(Type);
+		return P ? *P : Cost;
+	}
 };
 
 USTRUCT()
@@ -66,6 +89,12 @@ public:
 
 	UPROPERTY(EditAnywhere, Category = "AI|Path") FEnemyPathDefaults PathDefaults;
 
+	// === AI|Squads: la misma tanda desde la misma zona de spawn sigue la ruta de un lder ===
+	UPROPERTY(EditAnywhere, Category = "AI|Squads") bool bFormSquads = true;
+	UPROPERTY(EditAnywhere, Category = "AI|Squads", meta = (ClampMin = "2")) int32 SquadMaxSize = 4;
+	// Distancia (celdas, Manhattan) entre spawns para agruparlos
+	UPROPERTY(EditAnywhere, Category = "AI|Squads", meta = (ClampMin = "0")) int32 SquadClusterCells = 4;
+
 	// Selector + instancia de SpawnPointPolicy
 	UPROPERTY(EditAnywhere, Category = "Spawn|Policy")
 	TSubclassOf<USpawnPointPolicy> SpawnPointPolicyClass;
@@ -123,9 +152,21 @@ private:
 	// Lista de vivos (para polticas)
 	TArray<TWeakObjectPtr<AEnemyPawn>> LivingEnemies;
 
+	TArray<TSharedPtr<FEnemySquad>> Squads;
+
+	// Config de policy por (clase de enemigo, tipo) con PathDefaults aplicado; se prepara una vez.
+	// Con bc.ai.sharedpolicies guarda ya la instancia compartida.
+	UEnemyMovePolicy* GetPolicyConfigFor(TSubclassOf<AEnemyPawn> Cls);
+	TMap<TPair<const UClass*, EEnemyType>, UEnemyMovePolicy*> PolicyConfigByType;
+	UPROPERTY(Transient) TArray<TObjectPtr<UEnemyMovePolicy>> PolicyConfigs;
+
 	void ScheduleWaves();
 	void OnWaveDue(FPendingWave Wave);
-	void SpawnOne(const FString& Type, const FString& Symbol);
+	// Timer de un disparo (oleadas y reintentos) en UGameplayTimerSubsystem
+	void SetSpawnTimer(FTimerDelegate&& Delegate, float Delay);
+	AEnemyPawn* SpawnOne(const FString& Type, const FString& Symbol);
+	void FormSquads(const TArray<AEnemyPawn*>& Batch);
+	static void ForEachPathFollow(UEnemyMovePolicy* Root, TFunctionRef<void(UEnemyMovePolicy_PathFollow*)> Fn);
 	bool IsSpawnPointFree(const FVector& Location) const;
 
 	TSubclassOf<AEnemyPawn> ResolveClassFor(const FString& Type, const FString& Symbol) const;
@@ -0,0 +1,56 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "Components/GridPathFollow/GridPath.h"
+
+class AEnemyPawn;
+
+/**
+ * Escuadra de enemigos con una sola ruta: el lder (slot 0) planifica con UGridPathManager y la publica;
+ * los seguidores recorren su rastro + esa ruta en columna (cada slot detrs del anterior) y slo
+ * replanifican por su cuenta si se alejan ms de un umbral. La forma AEnemySpawner con cada tanda
+ * de la misma zona de spawn y la comparten las polticas PathFollow de sus miembros.
+ */
+class BATTLECITY3D_API FEnemySquad
+{
+public:
+	// Celdas recientes del lder que se conservan para los rezagados
+	static constexpr int32 MaxTrail = 64;
+
+	void AddMember(AEnemyPawn* Pawn);
+	// Quita los muertos; si cae el lder asciende el siguiente
+	void Prune();
+
+	int32 Num() const { return Members.Num(); }
+	// 0 = lder, INDEX_NONE si no es miembro
+	int32 GetSlot(const AEnemyPawn* Pawn) const;
+	AEnemyPawn* GetMember(int32 Slot) const { return Members.IsValidIndex(Slot) ? Members[Slot].Get() : nullptr; }
+
+	// === Lder ===
+	void RecordLeaderCell(const FIntPoint& Cell);
+	void PublishLeaderPath(const FGridPathRef& Path, const FIntPoint& InGoalCell);
+
+	const FGridPathRef& GetLeaderPath() const { return LeaderPath; }
+	FIntPoint GetGoalCell() const { return GoalCell; }
+	// Cambia con cada ruta publicada (los seguidores rehacen su recorrido)
+	uint32 GetVersion() const { return Version; }
+
+	// === Seguidores ===
+	// Rastro del lder + su ruta desde la celda ms cercana a From (la ms avanzada si empatan).
+	// Empieza en From si est en el rastro o a una celda; si no, en la celda de unin y el hueco hay
+	// que buscarlo aparte. false si From queda a ms de MaxDivergeCells: el seguidor debe planificar solo.
+	bool BuildFollowerRoute(const FIntPoint& From, int32 MaxDivergeCells, TArray<FIntPoint>& OutCells) const;
+
+	// Mtricas: rutas del lder / recorridos de seguidores servidos sin bsqueda
+	int32 GetLeaderPlans() const { return LeaderPlans; }
+	int32 GetFollowerRoutes() const { return FollowerRoutes; }
+
+private:
+	TArray<TWeakObjectPtr<AEnemyPawn>> Members;
+	TArray<FIntPoint> Trail;
+	FGridPathRef LeaderPath;
+	FIntPoint GoalCell = FIntPoint(-999, -999);
+	uint32 Version = 0;
+
+	int32 LeaderPlans = 0;
+	mutable int32 FollowerRoutes = 0;
+};